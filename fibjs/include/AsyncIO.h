@@ -35,6 +35,10 @@ public:
     result_t connect(exlib::string host, int32_t port, AsyncEvent* ac, Timer_base* timer);
     result_t accept(obj_ptr<Socket_base>& retVal, AsyncEvent* ac);
     result_t write(Buffer_base* data, AsyncEvent* ac);
+    result_t writev(std::vector<obj_ptr<Buffer>>& datas, AsyncEvent* ac);
+#ifdef Linux
+    result_t sendfile(int32_t fd, int64_t pos, int64_t bytes, int64_t& retVal, AsyncEvent* ac);
+#endif
     result_t read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
         AsyncEvent* ac, bool bRead, Timer_base* timer);
 
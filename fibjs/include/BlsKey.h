@@ -59,6 +59,10 @@ public:
         return CALL_E_INVALID_CALL;
     }
 
+public:
+    static bool verify_batch(std::vector<BlsKey_g1*>& keys, std::vector<Buffer_base*>& data,
+        std::vector<Buffer_base*>& sigs);
+
 private:
     result_t check_opts(v8::Local<v8::Object> opts, AsyncEvent* ac);
 };
@@ -87,6 +91,10 @@ public:
     virtual result_t proofGen(Buffer_base* sig, v8::Local<v8::Array> messages, v8::Local<v8::Array> idx, v8::Local<v8::Object> opts, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
     virtual result_t proofVerify(v8::Local<v8::Array> messages, v8::Local<v8::Array> idx, Buffer_base* proof, v8::Local<v8::Object> opts, bool& retVal, AsyncEvent* ac);
 
+public:
+    static bool verify_batch(std::vector<BlsKey_g2*>& keys, std::vector<Buffer_base*>& data,
+        std::vector<Buffer_base*>& sigs);
+
 private:
     blst_p2 get_pk();
     blst_scalar get_sk();
@@ -11,10 +11,11 @@ class Buffer : public Buffer_base {
 public:
     class store {
     public:
-        store(const void* _data, size_t _length)
+        store(const void* _data, size_t _length, Isolate* isolate = NULL)
             : m_length(_length)
         {
-            m_store = NewBackingStore(_length);
+            if (!pool_alloc(_length, isolate))
+                m_store = NewBackingStore(_length);
             if (_data)
                 memcpy(data(), _data, _length);
         }
@@ -58,6 +59,9 @@ public:
             return m_length;
         }
 
+    private:
+        bool pool_alloc(size_t _length, Isolate* isolate);
+
     public:
         std::shared_ptr<v8::BackingStore> m_store;
         size_t m_offset = 0;
@@ -65,8 +69,9 @@ public:
     };
 
 public:
-    Buffer(const void* data = NULL, size_t length = 0)
-        : m_store(data, length)
+    // isolate names the owner of a buffer that is filled on an io thread
+    Buffer(const void* data = NULL, size_t length = 0, Isolate* isolate = NULL)
+        : m_store(data, length, isolate)
     {
         extMemory(length);
     }
@@ -76,6 +81,11 @@ public:
     {
     }
 
+    Buffer(Buffer* buf, size_t offset, size_t length)
+        : m_store(buf->m_store.m_store, buf->m_store.m_offset + offset, length)
+    {
+    }
+
     Buffer(v8::Local<v8::Uint8Array> ui)
         : m_store(ui)
     {
@@ -207,16 +217,17 @@ public:
     result_t fill(exlib::string v, exlib::string codec);
 
 private:
-    static void proto_compare(const v8::FunctionCallbackInfo<v8::Value>& args);
-    static void proto_equals(const v8::FunctionCallbackInfo<v8::Value>& args);
-    static void proto_indexOf(const v8::FunctionCallbackInfo<v8::Value>& args);
-
     static void proto_copy(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void proto_fill(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void proto_write(const v8::FunctionCallbackInfo<v8::Value>& args);
 
 private:
     static void class_byteLength(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void class_indexOf(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static int32_t class_indexOf_fast(v8::Local<v8::Object> receiver, const v8::FastApiTypedArray<uint8_t>& buf,
+        const v8::FastApiTypedArray<uint8_t>& v, int32_t offset, v8::FastApiCallbackOptions& options);
+    static int32_t class_compare_fast(v8::Local<v8::Object> receiver, const v8::FastApiTypedArray<uint8_t>& buf1,
+        const v8::FastApiTypedArray<uint8_t>& buf2, v8::FastApiCallbackOptions& options);
 
 private:
     store m_store;
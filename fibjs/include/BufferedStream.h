@@ -8,17 +8,27 @@
 #pragma once
 
 #include "ifs/BufferedStream.h"
+#include "ifs/Socket.h"
 #include "StringBuffer.h"
 #include "encoding_iconv.h"
+#include "GatherWriter.h"
 
 namespace fibjs {
 
-class BufferedStream : public BufferedStream_base {
+#define BUFFERED_READ_MIN 2048
+#define BUFFERED_READ_MAX 262144
+
+class BufferedStream : public BufferedStream_base,
+                       public GatherWriter {
 public:
     BufferedStream(Stream_base* stm)
         : m_stm(stm)
+        , m_sock(dynamic_cast<Socket_base*>(stm))
+        , m_data(NULL)
+        , m_len(0)
         , m_pos(0)
         , m_temp(0)
+        , m_readSize(BUFFERED_READ_MIN)
     {
 #ifdef _WIN32
         m_eol.assign("\r\n", 2);
@@ -37,6 +47,10 @@ public:
     virtual result_t close(AsyncEvent* ac);
     virtual result_t copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal, AsyncEvent* ac);
 
+public:
+    // GatherWriter
+    virtual result_t writev(std::vector<obj_ptr<Buffer>>& datas, AsyncEvent* ac);
+
 public:
     // BufferedStream_base
     virtual result_t readText(int32_t size, exlib::string& retVal, AsyncEvent* ac);
@@ -51,25 +65,53 @@ public:
     virtual result_t get_EOL(exlib::string& retVal);
     virtual result_t set_EOL(exlib::string newVal);
 
+public:
+    result_t readHead(int32_t maxline, int32_t maxlines, exlib::string& retVal, AsyncEvent* ac);
+
 public:
     void append(int32_t n)
     {
         if (n > 0) {
-            if (m_pos == 0 && n == (int32_t)m_buf.length())
-                m_strbuf.append(m_buf);
-            else {
-                exlib::string s1(m_buf.substr(m_pos, n));
-                m_strbuf.append(s1);
-            }
+            m_strbuf.append(m_data + m_pos, n);
             m_pos += n;
         }
     }
 
+    void fill(Buffer_base* buf)
+    {
+        m_buf = Buffer::Cast(buf);
+        m_data = m_buf ? (const char*)m_buf->data() : NULL;
+        m_len = m_buf ? (int32_t)m_buf->length() : 0;
+        m_pos = 0;
+    }
+
+    // hands out the next n buffered bytes as a view of the read buffer
+    obj_ptr<Buffer_base> slice(int32_t n)
+    {
+        obj_ptr<Buffer_base> buf = new Buffer(m_buf, m_pos, n);
+        m_pos += n;
+        return buf;
+    }
+
+    // socket reads grow while they come back full and shrink when they
+    // come back mostly empty
+    void adapt(int32_t n)
+    {
+        if (n >= m_readSize && m_readSize < BUFFERED_READ_MAX)
+            m_readSize *= 2;
+        else if (n < m_readSize / 4 && m_readSize > BUFFERED_READ_MIN)
+            m_readSize /= 2;
+    }
+
 public:
     obj_ptr<Stream_base> m_stm;
-    exlib::string m_buf;
+    Socket_base* m_sock;
+    obj_ptr<Buffer> m_buf;
+    const char* m_data;
+    int32_t m_len;
     int32_t m_pos;
     int32_t m_temp;
+    int32_t m_readSize;
     exlib::string m_eol;
     StringBuffer m_strbuf;
     encoding_iconv m_iconv;
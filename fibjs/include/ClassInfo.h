@@ -11,6 +11,7 @@
  */
 
 #include <v8/include/v8.h>
+#include <v8/include/v8-fast-api-calls.h>
 #include <string>
 
 namespace fibjs {
@@ -36,6 +37,7 @@ struct ClassData {
         v8::FunctionCallback invoker;
         bool is_static;
         bool is_async;
+        const v8::CFunction* fast;
     };
 
     struct ClassObject {
@@ -218,7 +220,7 @@ public:
 
         for (i = 0; i < m_cd.mc; i++) {
             if (m_cd.cms[i].is_static) {
-                v8::Local<v8::Function> func = isolate->NewFunction(m_cd.cms[i].name, m_cd.cms[i].invoker);
+                v8::Local<v8::Function> func = isolate->NewFunction(m_cd.cms[i].name, m_cd.cms[i].invoker, m_cd.cms[i].fast);
                 v8::Local<v8::Function> pfunc;
                 v8::Local<v8::Name> name = get_prop_name(isolate, m_cd.cms[i].name);
 
@@ -371,7 +373,9 @@ private:
             int32_t i;
             for (i = 0; i < m_cd.mc; i++)
                 if (!m_cd.cms[i].is_static) {
-                    v8::Local<v8::FunctionTemplate> ft = v8::FunctionTemplate::New(isolate->m_isolate, m_cd.cms[i].invoker);
+                    v8::Local<v8::FunctionTemplate> ft = v8::FunctionTemplate::New(isolate->m_isolate, m_cd.cms[i].invoker,
+                        v8::Local<v8::Value>(), v8::Local<v8::Signature>(), 0, v8::ConstructorBehavior::kAllow,
+                        v8::SideEffectType::kHasSideEffect, m_cd.cms[i].fast);
 
                     pt->Set(get_prop_name(isolate, m_cd.cms[i].name), ft);
                     if (m_cd.has_async) {
@@ -0,0 +1,363 @@
+/*
+ * DBColumns.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#pragma once
+
+#include "v8_api.h"
+#include <unordered_map>
+
+namespace fibjs {
+
+// column oriented query result, the cells of each column are kept in one
+// native vector and handed to javascript as a typed array, strings are
+// dictionary encoded and nulls are recorded in a bitmap per column
+class DBColumns : public NObject {
+private:
+    enum {
+        C_NONE = 0,
+        C_INT,
+        C_DOUBLE,
+        C_STRING,
+        C_VALUE
+    };
+
+    class Column {
+    public:
+        Column()
+            : m_type(C_NONE)
+            , m_count(0)
+            , m_wide(false)
+            , m_hasNull(false)
+        {
+        }
+
+    public:
+        bool isNull(int32_t row) const
+        {
+            return m_hasNull && (m_nulls[row >> 3] & (1 << (row & 7)));
+        }
+
+        void setNull()
+        {
+            size_t sz = (m_count >> 3) + 1;
+            if (m_nulls.size() < sz)
+                m_nulls.resize(sz);
+
+            m_nulls[m_count >> 3] |= (uint8_t)(1 << (m_count & 7));
+            m_hasNull = true;
+
+            switch (m_type) {
+            case C_INT:
+                m_ints.push_back(0);
+                break;
+            case C_DOUBLE:
+                m_dbls.push_back(0);
+                break;
+            case C_STRING:
+                m_codes.push_back(-1);
+                break;
+            case C_VALUE:
+                m_values.push_back(Variant().setNull());
+                break;
+            }
+
+            m_count++;
+        }
+
+        void setType(int32_t type)
+        {
+            int32_t i;
+
+            if (m_type == type)
+                return;
+
+            if (m_type == C_NONE) {
+                // the leading cells were all null
+                switch (type) {
+                case C_INT:
+                    m_ints.resize(m_count);
+                    break;
+                case C_DOUBLE:
+                    m_dbls.resize(m_count);
+                    break;
+                case C_STRING:
+                    m_codes.resize(m_count, -1);
+                    break;
+                case C_VALUE:
+                    m_values.resize(m_count);
+                    for (i = 0; i < m_count; i++)
+                        m_values[i].setNull();
+                    break;
+                }
+            } else if (m_type == C_INT && type == C_DOUBLE) {
+                m_dbls.resize(m_count);
+                for (i = 0; i < m_count; i++)
+                    m_dbls[i] = (double)m_ints[i];
+                std::vector<int64_t>().swap(m_ints);
+            } else if (type == C_VALUE) {
+                m_values.resize(m_count);
+                for (i = 0; i < m_count; i++)
+                    if (isNull(i))
+                        m_values[i].setNull();
+                    else if (m_type == C_INT)
+                        m_values[i] = (double)m_ints[i];
+                    else if (m_type == C_DOUBLE)
+                        m_values[i] = m_dbls[i];
+                    else
+                        m_values[i] = m_dict[m_codes[i]];
+
+                std::vector<int64_t>().swap(m_ints);
+                std::vector<double>().swap(m_dbls);
+                std::vector<int32_t>().swap(m_codes);
+                std::vector<exlib::string>().swap(m_dict);
+                m_index.clear();
+            }
+
+            m_type = type;
+        }
+
+    public:
+        exlib::string m_name;
+        int32_t m_type;
+        int32_t m_count;
+        bool m_wide;
+        bool m_hasNull;
+        std::vector<uint8_t> m_nulls;
+        std::vector<int64_t> m_ints;
+        std::vector<double> m_dbls;
+        std::vector<int32_t> m_codes;
+        std::vector<exlib::string> m_dict;
+        std::unordered_map<exlib::string, int32_t> m_index;
+        std::vector<Variant> m_values;
+    };
+
+public:
+    DBColumns(int32_t sz, int64_t affected = 0, int64_t insertId = 0)
+        : m_rows(0)
+    {
+        if (sz)
+            m_columns.resize(sz);
+
+        add("affected", (double)affected);
+        add("insertId", (double)insertId);
+    }
+
+public:
+    void setField(int32_t i, const exlib::string& s)
+    {
+        m_columns[i].m_name = s;
+    }
+
+    void beginRow()
+    {
+    }
+
+    void endRow()
+    {
+        m_rows++;
+    }
+
+    void rowNull(int32_t i)
+    {
+        m_columns[i].setNull();
+    }
+
+    void rowInt(int32_t i, int64_t v)
+    {
+        Column& c = m_columns[i];
+
+        if (c.m_type == C_NONE)
+            c.setType(C_INT);
+
+        if (c.m_type == C_INT) {
+            if (v < INT32_MIN || v > INT32_MAX)
+                c.m_wide = true;
+            c.m_ints.push_back(v);
+        } else if (c.m_type == C_DOUBLE)
+            c.m_dbls.push_back((double)v);
+        else {
+            c.setType(C_VALUE);
+            c.m_values.push_back((double)v);
+        }
+
+        c.m_count++;
+    }
+
+    void rowDouble(int32_t i, double v)
+    {
+        Column& c = m_columns[i];
+
+        if (c.m_type == C_NONE || c.m_type == C_INT)
+            c.setType(C_DOUBLE);
+
+        if (c.m_type == C_DOUBLE)
+            c.m_dbls.push_back(v);
+        else {
+            c.setType(C_VALUE);
+            c.m_values.push_back(v);
+        }
+
+        c.m_count++;
+    }
+
+    void rowString(int32_t i, const char* s, size_t len)
+    {
+        Column& c = m_columns[i];
+
+        if (c.m_type == C_NONE)
+            c.setType(C_STRING);
+
+        if (c.m_type == C_STRING) {
+            exlib::string str(s, len);
+            std::unordered_map<exlib::string, int32_t>::iterator it = c.m_index.find(str);
+            int32_t code;
+
+            if (it == c.m_index.end()) {
+                code = (int32_t)c.m_dict.size();
+                c.m_index.emplace(str, code);
+                c.m_dict.push_back(str);
+            } else
+                code = it->second;
+
+            c.m_codes.push_back(code);
+        } else {
+            c.setType(C_VALUE);
+            c.m_values.push_back(exlib::string(s, len));
+        }
+
+        c.m_count++;
+    }
+
+    void rowValue(int32_t i, Variant& v)
+    {
+        switch (v.type()) {
+        case Variant::VT_Undefined:
+        case Variant::VT_Null:
+            rowNull(i);
+            break;
+        case Variant::VT_Integer:
+        case Variant::VT_Long:
+            rowInt(i, v.longVal());
+            break;
+        case Variant::VT_Number:
+            rowDouble(i, v.dblVal());
+            break;
+        case Variant::VT_String: {
+            exlib::string s = v.string();
+            rowString(i, s.c_str(), s.length());
+            break;
+        }
+        default: {
+            Column& c = m_columns[i];
+
+            c.setType(C_VALUE);
+            c.m_values.push_back(v);
+            c.m_count++;
+            break;
+        }
+        }
+    }
+
+public:
+    // object_base
+    virtual result_t valueOf(v8::Local<v8::Value>& retVal)
+    {
+        Isolate* isolate = holder();
+        v8::Local<v8::Context> context = isolate->context();
+        v8::Local<v8::Object> obj = v8::Object::New(isolate->m_isolate);
+        v8::Local<v8::Array> fields = v8::Array::New(isolate->m_isolate, (int32_t)m_columns.size());
+        v8::Local<v8::Object> columns = v8::Object::New(isolate->m_isolate);
+        v8::Local<v8::Object> nulls = v8::Object::New(isolate->m_isolate);
+
+        retVal = obj;
+        NObject::valueOf(retVal);
+
+        for (int32_t i = 0; i < (int32_t)m_columns.size(); i++) {
+            Column& c = m_columns[i];
+            v8::Local<v8::String> name = isolate->NewString(c.m_name);
+
+            fields->Set(context, i, name).IsJust();
+            columns->Set(context, name, column(isolate, c)).IsJust();
+
+            if (c.m_hasNull) {
+                c.m_nulls.resize((m_rows + 7) >> 3);
+                nulls->Set(context, name, array<v8::Uint8Array>(isolate, c.m_nulls.data(), c.m_nulls.size())).IsJust();
+            }
+        }
+
+        obj->Set(context, isolate->NewString("rows"), v8::Integer::New(isolate->m_isolate, m_rows)).IsJust();
+        obj->Set(context, isolate->NewString("fields"), fields).IsJust();
+        obj->Set(context, isolate->NewString("columns"), columns).IsJust();
+        obj->Set(context, isolate->NewString("nulls"), nulls).IsJust();
+
+        return 0;
+    }
+
+private:
+    template <typename A, typename T>
+    static v8::Local<v8::Value> array(Isolate* isolate, const T* data, size_t len)
+    {
+        std::shared_ptr<v8::BackingStore> store = NewBackingStore(len * sizeof(T));
+
+        if (len)
+            memcpy(store->Data(), data, len * sizeof(T));
+
+        return A::New(v8::ArrayBuffer::New(isolate->m_isolate, store), 0, len);
+    }
+
+    v8::Local<v8::Value> column(Isolate* isolate, Column& c)
+    {
+        v8::Local<v8::Context> context = isolate->context();
+        int32_t i;
+
+        switch (c.m_type) {
+        case C_INT:
+            if (c.m_wide)
+                return array<v8::BigInt64Array>(isolate, c.m_ints.data(), c.m_ints.size());
+            else {
+                std::vector<int32_t> ints(c.m_ints.begin(), c.m_ints.end());
+                return array<v8::Int32Array>(isolate, ints.data(), ints.size());
+            }
+        case C_DOUBLE:
+            return array<v8::Float64Array>(isolate, c.m_dbls.data(), c.m_dbls.size());
+        case C_STRING: {
+            v8::Local<v8::Object> o = v8::Object::New(isolate->m_isolate);
+            v8::Local<v8::Array> dict = v8::Array::New(isolate->m_isolate, (int32_t)c.m_dict.size());
+
+            for (i = 0; i < (int32_t)c.m_dict.size(); i++)
+                dict->Set(context, i, isolate->NewString(c.m_dict[i])).IsJust();
+
+            o->Set(context, isolate->NewString("dictionary"), dict).IsJust();
+            o->Set(context, isolate->NewString("indices"),
+                 array<v8::Int32Array>(isolate, c.m_codes.data(), c.m_codes.size()))
+                .IsJust();
+
+            return o;
+        }
+        case C_VALUE: {
+            v8::Local<v8::Array> arr = v8::Array::New(isolate->m_isolate, (int32_t)c.m_values.size());
+
+            for (i = 0; i < (int32_t)c.m_values.size(); i++)
+                arr->Set(context, i, c.m_values[i]).IsJust();
+
+            return arr;
+        }
+        }
+
+        // no value other than null has been seen, the column is all nulls
+        v8::Local<v8::Array> arr = v8::Array::New(isolate->m_isolate, c.m_count);
+        for (i = 0; i < c.m_count; i++)
+            arr->Set(context, i, v8::Null(isolate->m_isolate)).IsJust();
+
+        return arr;
+    }
+
+private:
+    std::vector<Column> m_columns;
+    int32_t m_rows;
+};
+
+} /* namespace fibjs */
@@ -0,0 +1,408 @@
+/*
+ * DirWalker.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "object.h"
+#include "ifs/os.h"
+#include "path.h"
+#include "Stat.h"
+#include "AsyncUV.h"
+#include <deque>
+
+namespace fibjs {
+
+#define WALK_MAX_WORKERS 16
+
+inline bool glob_class(const char*& p, char ch)
+{
+    const char* q = p + 1;
+    bool negate = false;
+    bool matched = false;
+
+    if (*q == '!' || *q == '^') {
+        negate = true;
+        q++;
+    }
+
+    while (*q && *q != ']') {
+        if (q[1] == '-' && q[2] && q[2] != ']') {
+            if (ch >= q[0] && ch <= q[2])
+                matched = true;
+            q += 3;
+        } else {
+            if (ch == *q)
+                matched = true;
+            q++;
+        }
+    }
+
+    // an unterminated class is a plain '['
+    if (!*q) {
+        matched = ch == '[';
+        negate = false;
+    } else
+        p = q;
+
+    return matched != negate;
+}
+
+// '*' and '?' stop at '/', '**' crosses directories and "**/" also matches
+// no directory at all
+inline bool glob_match(const char* p, const char* s)
+{
+    while (*p) {
+        if (*p == '*') {
+            bool deep = p[1] == '*';
+
+            p += deep ? 2 : 1;
+            if (deep && *p == '/' && glob_match(p + 1, s))
+                return true;
+
+            while (true) {
+                if (glob_match(p, s))
+                    return true;
+                if (!*s || (!deep && *s == '/'))
+                    return false;
+                s++;
+            }
+        }
+
+        if (!*s)
+            return false;
+
+        if (*p == '?') {
+            if (*s == '/')
+                return false;
+        } else if (*p == '[') {
+            if (*s == '/' || !glob_class(p, *s))
+                return false;
+        } else if (*p != *s)
+            return false;
+
+        p++;
+        s++;
+    }
+
+    return !*s;
+}
+
+class DirWalker : public object_base {
+public:
+    class Node {
+    public:
+        Node(exlib::string path)
+            : m_path(path)
+        {
+        }
+
+    public:
+        exlib::string m_path;
+        std::vector<exlib::string> m_names;
+        std::vector<obj_ptr<Stat>> m_stats;
+        std::vector<Node*> m_children;
+    };
+
+public:
+    DirWalker(bool recursive = false, bool stat = false)
+        : m_recursive(recursive)
+        , m_stat(stat)
+        , m_busy(0)
+        , m_idle(0)
+        , m_hr(0)
+    {
+    }
+
+    ~DirWalker()
+    {
+        for (size_t i = 0; i < m_nodes.size(); i++)
+            delete m_nodes[i];
+    }
+
+public:
+    result_t parse(v8::Local<v8::Object> opts)
+    {
+        Isolate* isolate = Isolate::current(opts);
+        result_t hr;
+
+        hr = GetConfigValue(isolate, opts, "recursive", m_recursive);
+        if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+            return hr;
+
+        hr = GetConfigValue(isolate, opts, "stat", m_stat, true);
+        if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+            return hr;
+
+        hr = get_patterns(isolate, opts, "filter", m_filter);
+        if (hr < 0)
+            return hr;
+
+        return get_patterns(isolate, opts, "ignore", m_ignore);
+    }
+
+    result_t walk(exlib::string path)
+    {
+        m_root = path;
+
+        Node* root = new Node("");
+        m_nodes.push_back(root);
+
+        if (!m_recursive)
+            return scan(root);
+
+        m_queue.push_back(root);
+
+        int32_t cpus = 0;
+        os_base::cpuNumbers(cpus);
+
+        int32_t worker_count = cpus > 2 ? cpus - 2 : 1;
+        if (worker_count > WALK_MAX_WORKERS)
+            worker_count = WALK_MAX_WORKERS;
+
+        // the helper jobs come out of one budget shared by every walk in the process,
+        // once it is used up a walk goes on with the thread that called it alone
+        exlib::atomic& running = helpers();
+        int32_t helper_count = 0;
+
+        while (helper_count < worker_count - 1) {
+            if (running.inc() > worker_count - 1) {
+                running.dec();
+                break;
+            }
+            helper_count++;
+        }
+
+        std::vector<exlib::Event> evs(helper_count + 1);
+        int32_t i;
+
+        m_events = evs.data();
+        for (i = 0; i < helper_count; i++)
+            asyncCall(walk_job, this, CALL_E_LONGSYNC);
+
+        work();
+
+        for (i = 1; i <= helper_count; i++)
+            evs[i].wait();
+
+        return m_hr;
+    }
+
+    void result(obj_ptr<NArray>& retVal)
+    {
+        obj_ptr<NArray> arr = new NArray();
+        std::deque<Node*> queue;
+
+        // the same breadth first order a serial walk produces
+        queue.push_back(m_nodes[0]);
+        while (!queue.empty()) {
+            Node* node = queue.front();
+            queue.pop_front();
+
+            for (size_t i = 0; i < node->m_names.size(); i++) {
+                if (m_stat)
+                    arr->append(node->m_stats[i]);
+                else
+                    arr->append(node->m_names[i]);
+            }
+
+            queue.insert(queue.end(), node->m_children.begin(), node->m_children.end());
+        }
+
+        retVal = arr;
+    }
+
+private:
+    static result_t get_patterns(Isolate* isolate, v8::Local<v8::Object> opts, const char* key,
+        std::vector<exlib::string>& patterns)
+    {
+        v8::Local<v8::Value> v;
+        result_t hr;
+
+        hr = GetConfigValue(isolate, opts, key, v);
+        if (hr == CALL_E_PARAMNOTOPTIONAL)
+            return 0;
+        if (hr < 0)
+            return hr;
+        if (v->IsUndefined())
+            return 0;
+
+        if (v->IsArray()) {
+            v8::Local<v8::Array> a = v8::Local<v8::Array>::Cast(v);
+            int32_t len = a->Length();
+
+            for (int32_t i = 0; i < len; i++) {
+                exlib::string s;
+
+                hr = GetConfigValue(isolate, a, i, s, true);
+                if (hr < 0)
+                    return hr;
+                patterns.push_back(s);
+            }
+
+            return 0;
+        }
+
+        exlib::string s;
+        hr = GetArgumentValue(isolate, v, s, true);
+        if (hr < 0)
+            return hr;
+        patterns.push_back(s);
+
+        return 0;
+    }
+
+    // patterns without '/' test the entry name, the others the path
+    // relative to the root, always with '/' as separator
+    static bool match(std::vector<exlib::string>& patterns, exlib::string& rel, const char* name)
+    {
+        for (size_t i = 0; i < patterns.size(); i++) {
+            const char* p = patterns[i].c_str();
+
+            if (qstrchr(p, '/') ? glob_match(p, rel.c_str()) : glob_match(p, name))
+                return true;
+        }
+
+        return false;
+    }
+
+    result_t scan(Node* node)
+    {
+        exlib::string dir = node->m_path.empty() ? m_root : m_root + PATH_SLASH + node->m_path;
+
+        AutoReq req;
+        int32_t ret = uv_fs_scandir(NULL, &req, dir.c_str(), 0, NULL);
+        if (ret < 0)
+            return ret;
+
+        uv_dirent_t dirent;
+        while (uv_fs_scandir_next(&req, &dirent) != UV_EOF) {
+            exlib::string rel = node->m_path.empty() ? exlib::string(dirent.name)
+                                                     : node->m_path + PATH_SLASH + dirent.name;
+
+            if (!m_filter.empty() || !m_ignore.empty()) {
+                exlib::string slash_rel = rel;
+#ifdef _WIN32
+                for (size_t i = 0; i < slash_rel.length(); i++)
+                    if (slash_rel[i] == '\\')
+                        slash_rel[i] = '/';
+#endif
+                if (match(m_ignore, slash_rel, dirent.name))
+                    continue;
+
+                if (dirent.type == UV_DIRENT_DIR && m_recursive)
+                    node->m_children.push_back(new Node(rel));
+
+                if (!m_filter.empty() && !match(m_filter, slash_rel, dirent.name))
+                    continue;
+            } else if (dirent.type == UV_DIRENT_DIR && m_recursive)
+                node->m_children.push_back(new Node(rel));
+
+            if (m_stat) {
+                AutoReq st_req;
+                exlib::string full = dir + PATH_SLASH + dirent.name;
+
+                // entries removed while the walk runs are left out
+                if (uv_fs_lstat(NULL, &st_req, full.c_str(), NULL) < 0)
+                    continue;
+
+                obj_ptr<Stat> st = new Stat();
+                st->fill(full, &st_req.statbuf);
+                st->name = rel;
+                node->m_stats.push_back(st);
+            }
+
+            node->m_names.push_back(rel);
+        }
+
+        return 0;
+    }
+
+    void work()
+    {
+        while (true) {
+            m_lock.lock();
+
+            if (m_hr < 0 || (m_queue.empty() && m_busy == 0)) {
+                while (m_idle > 0) {
+                    m_idle--;
+                    m_sem.Post();
+                }
+                m_lock.unlock();
+                break;
+            }
+
+            if (m_queue.empty()) {
+                m_idle++;
+                m_lock.unlock();
+                m_sem.Wait();
+                continue;
+            }
+
+            Node* node = m_queue.front();
+            m_queue.pop_front();
+            m_busy++;
+            m_lock.unlock();
+
+            result_t hr = scan(node);
+
+            m_lock.lock();
+            m_busy--;
+            if (hr < 0) {
+                if (m_hr >= 0)
+                    m_hr = hr;
+            } else {
+                m_nodes.insert(m_nodes.end(), node->m_children.begin(), node->m_children.end());
+                m_queue.insert(m_queue.end(), node->m_children.begin(), node->m_children.end());
+            }
+
+            size_t wake = hr < 0 || m_queue.empty() ? m_idle : node->m_children.size();
+            while (wake > 0 && m_idle > 0) {
+                m_idle--;
+                m_sem.Post();
+                wake--;
+            }
+            m_lock.unlock();
+        }
+    }
+
+    static exlib::atomic& helpers()
+    {
+        static exlib::atomic s_helpers;
+        return s_helpers;
+    }
+
+    static result_t walk_job(DirWalker* walker)
+    {
+        obj_ptr<DirWalker> _walker = walker;
+        int32_t idx = walker->m_started.inc();
+
+        walker->work();
+        helpers().dec();
+        walker->m_events[idx].set();
+
+        return 0;
+    }
+
+private:
+    exlib::string m_root;
+    bool m_recursive;
+    bool m_stat;
+    std::vector<exlib::string> m_filter;
+    std::vector<exlib::string> m_ignore;
+
+    exlib::spinlock m_lock;
+    std::deque<Node*> m_queue;
+    std::vector<Node*> m_nodes;
+    int32_t m_busy;
+    int32_t m_idle;
+    exlib::OSSemaphore m_sem;
+    result_t m_hr;
+
+    exlib::atomic m_started;
+    exlib::Event* m_events;
+};
+}
@@ -75,6 +75,12 @@ public:
     result_t open(exlib::string fname, exlib::string flags);
     result_t close();
     result_t Write(const char* p, int32_t sz);
+#ifdef Linux
+    result_t copy_range(int32_t fd, int64_t bytes, int64_t& retVal);
+#endif
+#ifndef _WIN32
+    result_t pread(int64_t pos, int32_t bytes, obj_ptr<Buffer_base>& retVal);
+#endif
 
     result_t Write(exlib::string data)
     {
@@ -0,0 +1,26 @@
+/*
+ * GatherWriter.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "ifs/Stream.h"
+#include "Buffer.h"
+#include <vector>
+
+namespace fibjs {
+
+// streams that can take a chain of buffers in one write without joining them
+class GatherWriter {
+public:
+    virtual result_t writev(std::vector<obj_ptr<Buffer>>& datas, AsyncEvent* ac) = 0;
+};
+
+// writes the chain through GatherWriter when the stream has it, otherwise
+// the buffers are joined and handed to write()
+result_t stream_writev(Stream_base* stm, std::vector<obj_ptr<Buffer>>& datas, AsyncEvent* ac);
+
+}
@@ -0,0 +1,157 @@
+/*
+ * Http2Session.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#pragma once
+
+#include "ifs/Stream.h"
+#include "ifs/BufferedStream.h"
+#include "ifs/HttpRequest.h"
+#include "ifs/HttpResponse.h"
+#include "hpack.h"
+#include "date.h"
+#include <list>
+#include <map>
+
+namespace fibjs {
+
+// the client connection preface, a plain text client sends it as the request line of
+// "PRI * HTTP/2.0" followed by the rest
+#define H2_PREFACE_HEAD "PRI * HTTP/2.0\r\n\r\n"
+#define H2_PREFACE H2_PREFACE_HEAD "SM\r\n\r\n"
+
+class HttpHandler;
+
+class Http2Session : public obj_base {
+public:
+    Http2Session(HttpHandler* hdlr, Stream_base* stm, BufferedStream_base* stmBuffered,
+        Isolate* isolate);
+
+    // the client side of a connection that negotiated h2, see start()
+    Http2Session(Stream_base* stm, int32_t maxHeadersCount, int32_t maxHeaderSize,
+        int32_t maxBodySize, Isolate* isolate);
+
+public:
+    // read frames until the peer goes away, preface is the number of connection
+    // preface bytes still waiting in stmBuffered
+    result_t run(int32_t preface, AsyncEvent* ac);
+    result_t send(int32_t id, HttpResponse_base* rep, bool headOnly, AsyncEvent* ac);
+    void stream_end(int32_t id);
+
+public:
+    // client: send the preface and read frames in the background until the connection ends
+    void start();
+    // client: run req on a new stream, waits while the peer's concurrent stream limit is reached
+    result_t request(HttpRequest_base* req, exlib::string scheme, exlib::string authority,
+        SeekableStream_base* response_body, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
+    // client: false once the connection is closed or going away, no new stream can be opened
+    bool available();
+    // client: true when no stream was open for timeout ms
+    bool expired(date_t& d, int32_t timeout);
+    // client: send GOAWAY and close the connection when the open streams are done
+    void shutdown();
+
+    Isolate* isolate()
+    {
+        return m_isolate;
+    }
+
+private:
+    class Stream : public obj_base {
+    public:
+        Stream(int32_t window)
+            : m_window(window)
+            , m_size(0)
+            , m_remote(false)
+            , m_local(false)
+            , m_reset(false)
+            , m_response(false)
+            , m_ac(NULL)
+        {
+        }
+
+    public:
+        obj_ptr<HttpRequest_base> m_req;
+        int64_t m_window;
+        int64_t m_size;
+        bool m_remote;
+        bool m_local;
+        bool m_reset;
+
+        // client side, the response being read and the request waiting for it
+        obj_ptr<HttpResponse_base> m_rep;
+        bool m_response;
+        AsyncEvent* m_ac;
+        exlib::string m_error;
+    };
+
+    class asyncSession;
+    class asyncRead;
+    class asyncWrite;
+    class asyncSend;
+    class asyncRequest;
+
+private:
+    int32_t on_frame(uint8_t type, uint8_t flags, int32_t id, exlib::string& data);
+    int32_t on_settings(uint8_t flags, exlib::string& data);
+    int32_t on_headers(int32_t id, uint8_t flags, exlib::string& data);
+    int32_t on_data(int32_t id, uint8_t flags, exlib::string& data);
+    int32_t headers_done();
+    void dispatch(int32_t id, Stream* stm);
+    int32_t on_response(int32_t id, bool end, std::vector<hpack_field>& fields);
+    int32_t on_goaway(exlib::string& data);
+    void finish(int32_t id, Stream* stm, exlib::string error, bool reset);
+    void fail_all(int32_t lastId, exlib::string error);
+
+    void frame(uint8_t type, uint8_t flags, int32_t id, const char* data, size_t len);
+    void headers(int32_t id, exlib::string& block, bool last);
+    void window_update(int32_t id, int32_t inc);
+    void release(Stream* stm);
+    void rst_stream(int32_t id, int32_t code);
+    void goaway(int32_t code);
+
+    void flush(exlib::string& frames);
+    void wake();
+    void check_close();
+
+private:
+    obj_ptr<HttpHandler> m_hdlr;
+    obj_ptr<Stream_base> m_stm;
+    obj_ptr<BufferedStream_base> m_stmBuffered;
+    Isolate* m_isolate;
+    bool m_client;
+
+    int32_t m_maxHeadersCount;
+    int32_t m_maxHeaderSize;
+    int32_t m_maxBodySize;
+
+    HPackDecoder m_decoder;
+    exlib::string m_headerBlock;
+    int32_t m_headerId;
+    bool m_headerEnd;
+    int32_t m_lastId;
+
+    exlib::spinlock m_lock;
+    std::map<int32_t, obj_ptr<Stream>> m_streams;
+    std::list<AsyncEvent*> m_waiters;
+    int64_t m_window;
+    int32_t m_initWindow;
+    int32_t m_maxFrame;
+    int32_t m_active;
+    int64_t m_buffered;
+    bool m_closed;
+
+    int32_t m_nextId;
+    int32_t m_maxStreams;
+    bool m_goaway;
+    bool m_shutdown;
+    date_t m_idle;
+
+    exlib::string m_out;
+    bool m_writing;
+    AsyncEvent* m_closer;
+};
+
+} /* namespace fibjs */
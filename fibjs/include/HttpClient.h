@@ -10,6 +10,10 @@
 #include "HttpCookie.h"
 #include "ifs/ssl.h"
 #include "Url.h"
+#include "Timer.h"
+#include "Http2Session.h"
+#include <list>
+#include <unordered_map>
 
 namespace fibjs {
 
@@ -22,12 +26,18 @@ public:
         , m_enableCookie(true)
         , m_autoRedirect(true)
         , m_enableEncoding(true)
+        , m_enableHttp2(false)
         , m_sslVerification(-1)
         , m_maxHeadersCount(128)
         , m_maxHeaderSize(8192)
         , m_maxBodySize(-1)
         , m_poolSize(128)
         , m_poolTimeout(10000)
+        , m_poolMaxActive(0)
+        , m_reaping(false)
+        , m_hits(0)
+        , m_misses(0)
+        , m_evictions(0)
     {
         m_cookies = new NArray();
         m_userAgent = "Mozilla/5.0 AppleWebKit/537.36 (KHTML, like Gecko) Chrome/54.0.2840.98 Safari/537.36";
@@ -44,6 +54,8 @@ public:
     virtual result_t set_autoRedirect(bool newVal);
     virtual result_t get_enableEncoding(bool& retVal);
     virtual result_t set_enableEncoding(bool newVal);
+    virtual result_t get_enableHttp2(bool& retVal);
+    virtual result_t set_enableHttp2(bool newVal);
     virtual result_t get_maxHeadersCount(int32_t& retVal);
     virtual result_t set_maxHeadersCount(int32_t newVal);
     virtual result_t get_maxHeaderSize(int32_t& retVal);
@@ -56,6 +68,9 @@ public:
     virtual result_t set_poolSize(int32_t newVal);
     virtual result_t get_poolTimeout(int32_t& retVal);
     virtual result_t set_poolTimeout(int32_t newVal);
+    virtual result_t get_poolMaxActive(int32_t& retVal);
+    virtual result_t set_poolMaxActive(int32_t newVal);
+    virtual result_t get_poolStats(v8::Local<v8::Object>& retVal);
     virtual result_t get_http_proxy(exlib::string& retVal);
     virtual result_t set_http_proxy(exlib::string newVal);
     virtual result_t get_https_proxy(exlib::string& retVal);
@@ -89,60 +104,27 @@ public:
     }
 
 public:
-    void clean_coon(date_t d)
-    {
-        std::vector<obj_ptr<Conn>> keep_conns;
-
-        m_lock.lock();
-        while (((int32_t)m_conns.size() > m_poolSize)
-            || (m_conns.size() && d.diff(m_conns[0]->d) >= (double)m_poolTimeout)) {
-            keep_conns.push_back(m_conns[0]);
-            m_conns.erase(m_conns.begin());
-        }
-        m_lock.unlock();
-    }
-
-    void save_conn(exlib::string url, Stream_base* _conn)
-    {
-        obj_ptr<Conn> conn = new Conn();
-
-        conn->d.now();
-        conn->url = url;
-        conn->conn = _conn;
-
-        clean_coon(conn->d);
-
-        m_lock.lock();
-        m_conns.push_back(conn);
-        if ((int32_t)m_conns.size() > m_poolSize) {
-            conn = m_conns[0];
-            m_conns.erase(m_conns.begin());
-        }
-        m_lock.unlock();
-    }
-
-    bool get_conn(exlib::string url, obj_ptr<Stream_base>& _conn)
-    {
-        date_t d;
-
-        d.now();
-        clean_coon(d);
-
-        m_lock.lock();
-        for (std::vector<obj_ptr<Conn>>::iterator it = m_conns.begin(); it != m_conns.end(); it++)
-            if ((*it)->url == url) {
-                _conn = (*it)->conn;
-                m_conns.erase(it);
-
-                m_lock.unlock();
-                return true;
-            }
-        m_lock.unlock();
-        return false;
-    }
+    class Waiter;
+
+    // returns CALL_E_PENDDING when the origin is at poolMaxActive and ac was queued in waiter,
+    // otherwise takes an active slot and sets _conn if an idle connection was reused.
+    // call again with the same waiter once ac is posted to pick up the slot handed over
+    result_t get_conn(exlib::string url, obj_ptr<Stream_base>& _conn, obj_ptr<Waiter>& waiter,
+        AsyncEvent* ac);
+    void save_conn(exlib::string url, Stream_base* _conn);
+    void release_conn(exlib::string url);
+    void clean_conn();
+    bool reap_conn();
+
+    // the h2 session of an origin, requests share it instead of taking pool slots
+    void get_session(exlib::string url, obj_ptr<Http2Session>& retVal);
+    // false when the origin already has a live session, the caller keeps its own for one request
+    bool put_session(exlib::string url, Http2Session* session);
 
 private:
     result_t update(HttpCookie_base* cookie);
+    result_t request(Stream_base* conn, Http2Session* session, HttpRequest_base* req,
+        SeekableStream_base* response_body, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac);
 
 private:
     obj_ptr<NArray> m_cookies;
@@ -151,6 +133,7 @@ private:
     bool m_enableCookie;
     bool m_autoRedirect;
     bool m_enableEncoding;
+    bool m_enableHttp2;
     int32_t m_sslVerification;
     int32_t m_maxHeadersCount;
     int32_t m_maxHeaderSize;
@@ -159,17 +142,67 @@ private:
     obj_ptr<X509Cert_base> m_crt;
     obj_ptr<PKey_base> m_key;
 
+public:
+    // a request queued behind poolMaxActive, it times out with the client timeout
+    class Waiter : public Timer {
+    public:
+        Waiter(HttpClient* hc, exlib::string url, AsyncEvent* ac, int32_t timeout)
+            : Timer(timeout > 0 ? timeout : TIMEOUT_MAX)
+            , m_hc(hc)
+            , m_url(url)
+            , m_ac(ac)
+            , m_granted(false)
+        {
+        }
+
+    public:
+        virtual void on_timer()
+        {
+            m_hc->timeout_conn(this);
+        }
+
+    public:
+        obj_ptr<HttpClient> m_hc;
+        exlib::string m_url;
+        AsyncEvent* m_ac;
+        obj_ptr<Stream_base> m_conn;
+        bool m_granted;
+    };
+
 private:
     class Conn : public obj_base {
     public:
         date_t d;
-        exlib::string url;
         obj_ptr<Stream_base> conn;
     };
 
-    std::vector<obj_ptr<Conn>> m_conns;
+    class Origin {
+    public:
+        Origin()
+            : m_active(0)
+        {
+        }
+
+    public:
+        std::vector<obj_ptr<Conn>> m_idle;
+        std::list<obj_ptr<Waiter>> m_waiters;
+        int32_t m_active;
+        obj_ptr<Http2Session> m_h2;
+    };
+
+    void expire_conn(Origin& o, date_t& d, std::vector<obj_ptr<Conn>>& drop_conns);
+    void wake_conn(Origin& o, std::vector<obj_ptr<Waiter>>& waiters);
+    void timeout_conn(Waiter* w);
+
+    exlib::spinlock m_poolLock;
+    std::unordered_map<exlib::string, Origin> m_pool;
     int32_t m_poolSize;
     int32_t m_poolTimeout;
+    int32_t m_poolMaxActive;
+    bool m_reaping;
+    int64_t m_hits;
+    int64_t m_misses;
+    int64_t m_evictions;
     exlib::string m_http_proxy;
     exlib::string m_https_proxy;
 };
@@ -16,8 +16,10 @@ class HttpCollection : public HttpCollection_base {
 public:
     HttpCollection()
         : m_count(0)
+        , m_rawCount(0)
     {
         m_map.resize(16);
+        m_raw.resize(16);
     }
 
 public:
@@ -51,6 +53,8 @@ public:
 
     result_t add(exlib::string& name, exlib::string value)
     {
+        materialize();
+
         if (m_map.size() < m_count + 1)
             m_map.resize(m_count + 1);
 
@@ -73,6 +77,15 @@ public:
             }
         }
 
+        for (i = 0; i < m_rawCount; i++) {
+            raw& _raw = m_raw[i];
+
+            if (is_raw(_raw, name)) {
+                retVal = raw_value(_raw);
+                return 0;
+            }
+        }
+
         return CALL_RETURN_NULL;
     }
 
@@ -88,6 +101,13 @@ public:
                 list->append(_pair.second);
         }
 
+        for (i = 0; i < m_rawCount; i++) {
+            raw& _raw = m_raw[i];
+
+            if (is_raw(_raw, name))
+                list->append(raw_value(_raw));
+        }
+
         retVal = list;
         return 0;
     }
@@ -97,6 +117,7 @@ public:
         obj_ptr<NObject> map = new NObject();
         size_t i;
 
+        materialize();
         map->enable_multi_value();
 
         for (i = 0; i < m_count; i++) {
@@ -114,10 +135,63 @@ public:
     result_t parse(exlib::string& str, const char* sep = "&", const char* eq = "=");
     result_t parseCookie(exlib::string& str);
 
+public:
+    // headers read from the wire are kept as offsets into m_arena and are
+    // only turned into strings when they are looked up or enumerated
+    exlib::string& arena()
+    {
+        return m_arena;
+    }
+
+    void add_raw(int32_t name, int32_t szName, int32_t value, int32_t szValue)
+    {
+        if (m_raw.size() < m_rawCount + 1)
+            m_raw.resize(m_rawCount + 1);
+
+        raw& _raw = m_raw[m_rawCount++];
+        _raw.name = name;
+        _raw.szName = szName;
+        _raw.value = value;
+        _raw.szValue = szValue;
+    }
+
+    void materialize();
+
+    template <typename T>
+    void each(T fn)
+    {
+        materialize();
+
+        for (size_t i = 0; i < m_count; i++)
+            fn(m_map[i].first, m_map[i].second);
+    }
+
+private:
+    struct raw {
+        int32_t name;
+        int32_t szName;
+        int32_t value;
+        int32_t szValue;
+    };
+
+    bool is_raw(raw& _raw, exlib::string& name)
+    {
+        return _raw.szName == (int32_t)name.length()
+            && !qstricmp(m_arena.c_str() + _raw.name, name.c_str(), _raw.szName);
+    }
+
+    exlib::string raw_value(raw& _raw)
+    {
+        return exlib::string(m_arena.c_str() + _raw.value, _raw.szValue);
+    }
+
 private:
     typedef std::pair<exlib::string, exlib::string> pair;
     std::vector<pair> m_map;
     size_t m_count;
+    exlib::string m_arena;
+    std::vector<raw> m_raw;
+    size_t m_rawCount;
 };
 
 } /* namespace fibjs */
@@ -10,6 +10,7 @@
 #include "ifs/Handler.h"
 #include <unordered_map>
 #include "path.h"
+#include "date.h"
 
 namespace fibjs {
 
@@ -32,10 +33,31 @@ public:
 
     result_t set_mimes(v8::Local<v8::Object> mimes);
 
+public:
+    enum {
+        MISSING_BR = 1,
+        MISSING_GZ = 2
+    };
+
+    // remembers which precompressed siblings of a file are missing, so requests stop probing them
+    int32_t get_missing(const exlib::string& path, const exlib::string& etag);
+    void set_missing(const exlib::string& path, const exlib::string& etag, int32_t missing);
+
+private:
+    class Missing {
+    public:
+        exlib::string m_etag;
+        date_t m_d;
+        int32_t m_missing;
+    };
+
 private:
     exlib::string m_root;
     bool m_autoIndex;
     std::unordered_map<exlib::string, exlib::string> m_mimes;
+
+    exlib::spinlock m_missingLock;
+    std::unordered_map<exlib::string, Missing> m_missing;
 };
 
 } /* namespace fibjs */
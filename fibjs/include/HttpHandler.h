@@ -8,11 +8,18 @@
 #pragma once
 
 #include "ifs/HttpHandler.h"
+#include <list>
+#include <map>
+#include <unordered_map>
 
 namespace fibjs {
 
+class Http2Session;
+class HttpRequest_base;
+
 class HttpHandler : public HttpHandler_base {
     FIBER_FREE();
+    friend class Http2Session;
 
 public:
     HttpHandler();
@@ -25,6 +32,7 @@ public:
 public:
     // HttpHandler_base
     virtual result_t enableCrossOrigin(exlib::string allowHeaders);
+    virtual result_t setEncodingOptions(exlib::string type, v8::Local<v8::Object> opts);
     virtual result_t get_maxHeadersCount(int32_t& retVal);
     virtual result_t set_maxHeadersCount(int32_t newVal);
     virtual result_t get_maxHeaderSize(int32_t& retVal);
@@ -33,11 +41,41 @@ public:
     virtual result_t set_maxBodySize(int32_t newVal);
     virtual result_t get_enableEncoding(bool& retVal);
     virtual result_t set_enableEncoding(bool newVal);
+    virtual result_t get_streamForm(bool& retVal);
+    virtual result_t set_streamForm(bool newVal);
+    virtual result_t get_encodingCacheSize(int32_t& retVal);
+    virtual result_t set_encodingCacheSize(int32_t newVal);
     virtual result_t get_serverName(exlib::string& retVal);
     virtual result_t set_serverName(exlib::string newVal);
     virtual result_t get_handler(obj_ptr<Handler_base>& retVal);
     virtual result_t set_handler(Handler_base* newVal);
 
+public:
+    class EncodingOptions {
+    public:
+        EncodingOptions(int32_t minSize = 128, int32_t level = -1)
+            : m_minSize(minSize)
+            , m_level(level)
+        {
+        }
+
+    public:
+        int32_t m_minSize;
+        int32_t m_level;
+    };
+
+public:
+    bool encodingOptions(exlib::string type, EncodingOptions& retVal);
+    bool getCache(const exlib::string& key, exlib::string& retVal);
+    void putCache(const exlib::string& key, const exlib::string& data);
+    void invoke_h2(Http2Session* session, int32_t streamId, HttpRequest_base* req);
+    void copy_settings(HttpHandler* from);
+
+private:
+    class asyncInvoke;
+
+    void trimCache();
+
 private:
     obj_ptr<Handler_base> m_hdlr;
 
@@ -47,7 +85,17 @@ private:
     int32_t m_maxHeaderSize;
     int32_t m_maxBodySize;
     bool m_enableEncoding;
+    bool m_streamForm;
     exlib::string m_serverName;
+
+    std::map<exlib::string, EncodingOptions> m_encodingOptions;
+
+    typedef std::list<std::pair<exlib::string, exlib::string>> cache_list;
+    exlib::spinlock m_cacheLock;
+    int32_t m_cacheSize;
+    size_t m_cacheUsed;
+    cache_list m_cacheList;
+    std::unordered_map<exlib::string, cache_list::iterator> m_cacheMap;
 };
 
 } /* namespace fibjs */
@@ -21,6 +21,7 @@ public:
         , m_maxHeadersCount(128)
         , m_maxHeaderSize(8192)
         , m_maxBodySize(64)
+        , m_streamForm(false)
     {
         m_headers = new HttpCollection();
         clear();
@@ -68,12 +69,12 @@ public:
         AsyncEvent* ac);
     result_t sendHeader(Stream_base* stm, exlib::string& strCommand,
         AsyncEvent* ac);
-    result_t readFrom(Stream_base* stm, AsyncEvent* ac);
+    result_t readHead(BufferedStream_base* stm, AsyncEvent* ac);
+    result_t readFrom(BufferedStream_base* stm, int32_t pos, AsyncEvent* ac);
 
 public:
-    void addHeader(const char* name, int32_t szName, const char* value,
-        int32_t szValue);
-    result_t addHeader(exlib::string& strLine);
+    int32_t headLine(int32_t pos, int32_t& sz);
+    result_t addHeader(int32_t pos, int32_t sz);
     size_t size();
     size_t getData(char* buf, size_t sz);
 
@@ -93,9 +94,11 @@ public:
     int32_t m_maxHeadersCount;
     int32_t m_maxHeaderSize;
     int32_t m_maxBodySize;
+    bool m_streamForm;
     exlib::string m_origin;
     exlib::string m_encoding;
     obj_ptr<HttpCollection> m_headers;
+    obj_ptr<HttpCollection_base> m_form;
 };
 
 } /* namespace fibjs */
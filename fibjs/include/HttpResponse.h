@@ -118,6 +118,8 @@ public:
         return 0;
     }
 
+    void flushCookies();
+
 public:
     obj_ptr<HttpMessage> m_message;
     int32_t m_statusCode;
@@ -20,13 +20,16 @@ public:
     // TcpServer_base
     virtual result_t start();
     virtual result_t stop(AsyncEvent* ac);
+    virtual result_t reload(AsyncEvent* ac);
     virtual result_t get_socket(obj_ptr<Socket_base>& retVal);
     virtual result_t get_handler(obj_ptr<Handler_base>& retVal);
     virtual result_t set_handler(Handler_base* newVal);
+    virtual result_t get_stats(v8::Local<v8::Object>& retVal);
 
 public:
     // HttpServer_base
     virtual result_t enableCrossOrigin(exlib::string allowHeaders);
+    virtual result_t setEncodingOptions(exlib::string type, v8::Local<v8::Object> opts);
     virtual result_t get_maxHeadersCount(int32_t& retVal);
     virtual result_t set_maxHeadersCount(int32_t newVal);
     virtual result_t get_maxHeaderSize(int32_t& retVal);
@@ -35,11 +38,20 @@ public:
     virtual result_t set_maxBodySize(int32_t newVal);
     virtual result_t get_enableEncoding(bool& retVal);
     virtual result_t set_enableEncoding(bool newVal);
+    virtual result_t get_streamForm(bool& retVal);
+    virtual result_t set_streamForm(bool newVal);
+    virtual result_t get_encodingCacheSize(int32_t& retVal);
+    virtual result_t set_encodingCacheSize(int32_t newVal);
     virtual result_t get_serverName(exlib::string& retVal);
     virtual result_t set_serverName(exlib::string newVal);
 
 public:
     result_t create(exlib::string addr, int32_t port, Handler_base* hdlr);
+    result_t create(v8::Local<v8::Object> opts, Handler_base* hdlr);
+    result_t create_workers(v8::Local<v8::Object> opts);
+
+private:
+    result_t init(Handler_base* hdlr, obj_ptr<TcpServer>& retVal);
 
 private:
     obj_ptr<TcpServer_base> m_server;
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "ifs/HttpCollection.h"
+#include "ifs/SeekableStream.h"
 #include "QuickArray.h"
 
 namespace fibjs {
@@ -44,7 +45,8 @@ public:
     virtual result_t _named_deleter(exlib::string property, v8::Local<v8::Boolean>& retVal);
 
 public:
-    void parse(exlib::string& str, const char* boundary);
+    result_t parse(SeekableStream_base* body, const char* type);
+    result_t parser(const char* type, obj_ptr<Stream_base>& retVal);
 
     result_t all(exlib::string name, obj_ptr<NArray>& retVal)
     {
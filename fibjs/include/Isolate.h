@@ -138,6 +138,21 @@ public:
         return func;
     }
 
+    v8::Local<v8::Function> NewFunction(const char* funcName, v8::FunctionCallback callback,
+        const v8::CFunction* fast)
+    {
+        if (!fast)
+            return NewFunction(funcName, callback);
+
+        v8::Local<v8::FunctionTemplate> ft = v8::FunctionTemplate::New(m_isolate, callback,
+            v8::Local<v8::Value>(), v8::Local<v8::Signature>(), 0, v8::ConstructorBehavior::kThrow,
+            v8::SideEffectType::kHasSideEffect, fast);
+        v8::Local<v8::Function> func = ft->GetFunction(context()).FromMaybe(v8::Local<v8::Function>());
+        if (!func.IsEmpty())
+            func->SetName(NewString(funcName));
+        return func;
+    }
+
     v8::Local<v8::Context> context()
     {
         return m_isolate->GetCurrentContext();
@@ -240,6 +255,11 @@ public:
     void Ref();
     void Unref(int32_t hr = 0);
 
+    // for isolates started on demand, like server workers. the fibers leave once the
+    // job queue runs dry and the last one frees the heap and disposes the v8 isolate
+    void dispose();
+    void free_heap();
+
 public:
     int32_t m_id;
     int32_t m_hr;
@@ -264,6 +284,7 @@ public:
     uint32_t m_sandboxId = 0;
 
     bool m_intask = false;
+    bool m_disposing = false;
 
     obj_ptr<HttpClient> m_httpclient;
     v8::Global<v8::Object> STATUS_CODES;
@@ -306,6 +327,11 @@ public:
     bool m_enable_FileSystem;
     bool m_safe_buffer;
 
+    // the slab that --buffer-pool-size carves the small buffers of this isolate out of
+    exlib::spinlock m_buffer_slab_lock;
+    std::shared_ptr<v8::BackingStore> m_buffer_slab;
+    size_t m_buffer_slab_used = 0;
+
     obj_ptr<X509Cert_base> m_ca;
 
 public:
@@ -0,0 +1,91 @@
+/*
+ * Pool.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#pragma once
+
+#include "ifs/Pool.h"
+#include "ifs/DbConnection.h"
+#include <vector>
+
+namespace fibjs {
+
+class Pool : public Pool_base {
+public:
+    Pool(exlib::string connString, int32_t max)
+        : m_connString(connString)
+        , m_sem(max)
+        , m_min(0)
+        , m_max(max)
+        , m_timeout(10000)
+        , m_idleTimeout(60000)
+        , m_check(30000)
+        , m_count(0)
+        , m_waiting(0)
+        , m_acquires(0)
+        , m_timeouts(0)
+        , m_errors(0)
+        , m_waitTime(0)
+        , m_maxWaitTime(0)
+        , m_reaping(false)
+        , m_closed(false)
+    {
+    }
+
+    FIBER_FREE();
+
+public:
+    // Pool_base
+    virtual result_t get_connString(exlib::string& retVal);
+    virtual result_t get_size(int32_t& retVal);
+    virtual result_t get_stats(v8::Local<v8::Object>& retVal);
+    virtual result_t acquire(obj_ptr<DbConnection_base>& retVal);
+    virtual result_t release(DbConnection_base* conn, bool error);
+    virtual result_t run(v8::Local<v8::Function> func, v8::Local<v8::Value>& retVal);
+    virtual result_t execute(exlib::string sql, OptArgs args, obj_ptr<NArray>& retVal);
+    virtual result_t close();
+
+public:
+    result_t open(int32_t min);
+    bool reap();
+
+private:
+    struct Conn {
+        obj_ptr<DbConnection_base> conn;
+        date_t d;
+    };
+
+    result_t check_closed();
+    result_t new_conn(obj_ptr<DbConnection_base>& retVal);
+    bool take_conn(DbConnection_base* conn);
+    void put_conn(DbConnection_base* conn, bool error);
+    bool ping(DbConnection_base* conn);
+
+public:
+    exlib::string m_connString;
+    exlib::Semaphore m_sem;
+    int32_t m_min;
+    int32_t m_max;
+    int32_t m_timeout;
+    int32_t m_idleTimeout;
+    int32_t m_check;
+
+private:
+    // guards everything below, the reaper runs outside the isolate thread
+    exlib::spinlock m_lock;
+    std::vector<Conn> m_idle;
+    std::vector<obj_ptr<DbConnection_base>> m_active;
+    int32_t m_count;
+    int32_t m_waiting;
+    int64_t m_acquires;
+    int64_t m_timeouts;
+    int64_t m_errors;
+    double m_waitTime;
+    double m_maxWaitTime;
+    bool m_reaping;
+    bool m_closed;
+};
+
+} /* namespace fibjs */
@@ -12,6 +12,7 @@
 #include "ifs/io.h"
 #include "ifs/RangeStream.h"
 #include "Stat.h"
+#include "File.h"
 
 namespace fibjs {
 
@@ -19,6 +20,10 @@ class RangeStream : public RangeStream_base {
 public:
     RangeStream(SeekableStream_base* stream, int64_t begin, int64_t end);
 
+public:
+    // parses a comma separated range set, the `bytes=` token must be cut off first
+    static result_t parse(exlib::string range, int64_t fsize, std::vector<std::pair<int64_t, int64_t>>& retVal);
+
 private:
     int64_t get_c_pos();
     int64_t valid_end();
@@ -51,6 +56,7 @@ public:
 
 private:
     obj_ptr<SeekableStream_base> m_stream;
+    File* m_file; // set when m_stream is a file, reads then go straight to the fd
     int64_t b_pos; // begin position
     int64_t real_pos; // real position
     int64_t e_pos; // end position
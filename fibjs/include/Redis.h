@@ -15,9 +15,12 @@
 #include "Buffer.h"
 #include <unordered_map>
 #include <inttypes.h>
+#include <vector>
 
 namespace fibjs {
 
+#define REDIS_GATHER_SIZE 4096
+
 class Redis : public Redis_base {
 public:
     // Redis_base
@@ -78,36 +81,45 @@ public:
 
 public:
     result_t connect(const char* host, int32_t port, AsyncEvent* ac);
-    result_t _command(exlib::string& req, Variant& retVal, AsyncEvent* ac);
-    ASYNC_MEMBERVALUE2_AC(Redis, _command, exlib::string, Variant);
+    result_t _command(std::vector<obj_ptr<Buffer>>& req, Variant& retVal, AsyncEvent* ac);
+    ASYNC_MEMBERVALUE2_AC(Redis, _command, std::vector<obj_ptr<Buffer>>, Variant);
 
+    // the command goes out as one buffer chain: the framing and the small arguments
+    // are packed together, large buffer arguments are sent from their own memory
     class _param {
     public:
         _param()
-            : m_size(0)
+            : m_count(0)
         {
+            m_heads.resize(1);
         }
 
     public:
         result_t add(exlib::string& str)
         {
-            char numStr[64];
+            exlib::string& head = m_heads.back();
 
-            m_size += snprintf(numStr, sizeof(numStr), "$%d", (int32_t)str.length());
-            m_params.append(numStr);
-
-            m_params.append(str);
-            m_size += (int32_t)str.length() + 4;
+            add_len(str.length());
+            head.append(str);
+            head.append("\r\n", 2);
 
             return 0;
         }
 
         result_t add(Buffer_base* buf)
         {
-            exlib::string str;
+            Buffer* b = Buffer::Cast(buf);
 
-            buf->toString(str);
-            return add(str);
+            if (b->length() < REDIS_GATHER_SIZE) {
+                exlib::string str((const char*)b->data(), b->length());
+                return add(str);
+            }
+
+            add_len(b->length());
+            m_bufs.push_back(b);
+            m_heads.push_back("\r\n");
+
+            return 0;
         }
 
         result_t add(const char* v)
@@ -197,43 +209,57 @@ public:
 
         result_t add(v8::Local<v8::Value> v)
         {
+            Isolate* isolate = Isolate::current();
             result_t hr;
             exlib::string str;
 
-            hr = GetArgumentValue(Isolate::current(), v, str);
+            obj_ptr<Buffer_base> buf;
+            if (GetArgumentValue(isolate, v, buf, true) >= 0)
+                return add((Buffer_base*)buf);
+
+            hr = GetArgumentValue(isolate, v, str);
             if (hr < 0)
                 return CHECK_ERROR(hr);
             return add(str);
         }
 
-        exlib::string str()
+        std::vector<obj_ptr<Buffer>> chain()
         {
-            exlib::string str;
+            std::vector<obj_ptr<Buffer>> datas;
             char numStr[64];
-            int32_t sz, i;
-            char* p;
+            size_t i;
 
-            sz = snprintf(numStr, sizeof(numStr), "*%d\r\n", (int32_t)m_params.size() / 2);
+            snprintf(numStr, sizeof(numStr), "*%d\r\n", m_count);
 
-            str.resize(sz + m_size);
-            p = str.data();
+            exlib::string first(numStr);
+            first.append(m_heads[0]);
+            datas.push_back(new Buffer(first.c_str(), first.length()));
 
-            memcpy(p, numStr, sz);
-            p += sz;
+            for (i = 0; i < m_bufs.size(); i++) {
+                datas.push_back(m_bufs[i]);
 
-            for (i = 0; i < (int32_t)m_params.size(); i++) {
-                exlib::string& str = m_params[i];
-                memcpy(p, str.c_str(), str.length());
-                p += str.length();
-                *p++ = '\r';
-                *p++ = '\n';
+                exlib::string& head = m_heads[i + 1];
+                datas.push_back(new Buffer(head.c_str(), head.length()));
             }
 
-            return str;
+            return datas;
+        }
+
+    private:
+        void add_len(size_t len)
+        {
+            char numStr[64];
+
+            snprintf(numStr, sizeof(numStr), "$%d\r\n", (int32_t)len);
+            m_heads.back().append(numStr);
+            m_count++;
         }
 
-        QuickArray<exlib::string> m_params;
-        int32_t m_size;
+    private:
+        // m_heads[i] goes out before m_bufs[i], the last head ends the command
+        std::vector<exlib::string> m_heads;
+        std::vector<obj_ptr<Buffer>> m_bufs;
+        int32_t m_count;
     };
 
 public:
@@ -313,7 +339,7 @@ public:
         if (hr < 0)
             return hr;
 
-        hr = ac__command(ps.str(), v);
+        hr = ac__command(ps.chain(), v);
         if (hr < 0 || hr == CALL_RETURN_NULL)
             return hr;
 
@@ -340,7 +366,7 @@ public:
         if (hr < 0)
             return hr;
 
-        hr = ac__command(ps.str(), v);
+        hr = ac__command(ps.chain(), v);
         if (hr < 0 || hr == CALL_RETURN_NULL)
             return hr;
 
@@ -371,7 +397,7 @@ public:
         if (hr < 0)
             return hr;
 
-        hr = ac__command(ps.str(), v);
+        hr = ac__command(ps.chain(), v);
         if (hr < 0 || hr == CALL_RETURN_NULL)
             return hr;
 
@@ -406,7 +432,7 @@ public:
         if (hr < 0)
             return hr;
 
-        hr = ac__command(ps.str(), v);
+        hr = ac__command(ps.chain(), v);
         if (hr < 0 || hr == CALL_RETURN_NULL)
             return hr;
 
@@ -445,7 +471,7 @@ public:
         if (hr < 0)
             return hr;
 
-        hr = ac__command(ps.str(), v);
+        hr = ac__command(ps.chain(), v);
         if (hr < 0 || hr == CALL_RETURN_NULL)
             return hr;
 
@@ -488,7 +514,7 @@ public:
         if (hr < 0)
             return hr;
 
-        hr = ac__command(ps.str(), v);
+        hr = ac__command(ps.chain(), v);
         if (hr < 0 || hr == CALL_RETURN_NULL)
             return hr;
 
@@ -0,0 +1,64 @@
+/*
+ * ServerWorker.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lion
+ */
+
+#pragma once
+
+#include "ifs/Handler.h"
+
+namespace fibjs {
+
+class TcpServer;
+class HttpHandler;
+
+// one isolate of a TcpServer running in worker mode. it loads the handler module into its own
+// sandbox, binds its own SO_REUSEPORT listener and serves the connections the kernel hands it
+class ServerWorker : public obj_base {
+public:
+    enum {
+        C_START = 0,
+        C_RELOAD,
+        C_STOP
+    };
+
+public:
+    ServerWorker(exlib::string fname, exlib::string addr, int32_t port, int32_t backlog);
+    ~ServerWorker();
+
+public:
+    // object_base
+    virtual void Delete();
+
+public:
+    // runs op in the worker isolate and posts the result to ac
+    result_t post(int32_t op, HttpHandler* http, AsyncEvent* ac);
+
+public:
+    exlib::string m_error;
+
+private:
+    static result_t worker_fiber(ServerWorker* pThis);
+    static result_t exit_fiber(ServerWorker* pThis);
+    result_t load(obj_ptr<Handler_base>& retVal);
+    result_t run();
+    bool serving();
+
+private:
+    Isolate* m_isolate;
+    exlib::string m_fname;
+    exlib::string m_addr;
+    int32_t m_port;
+    int32_t m_backlog;
+
+    int32_t m_op;
+    obj_ptr<HttpHandler> m_http;
+    AsyncEvent* m_ac;
+
+    obj_ptr<TcpServer> m_server;
+    std::vector<obj_ptr<TcpServer>> m_stopped;
+};
+
+} /* namespace fibjs */
@@ -0,0 +1,140 @@
+/*
+ * SharedCache.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#pragma once
+
+#include "ifs/SharedCache.h"
+#include <unordered_map>
+#include <list>
+#include <map>
+#include <vector>
+
+namespace fibjs {
+
+// the cache data lives outside any isolate and is shared by every SharedCache
+// created with the same name, each shard has its own lock, lru list and
+// expiry index
+class SharedStore : public obj_base {
+public:
+    class Value : public obj_base {
+    public:
+        Value(const char* data, size_t len, bool str)
+            : m_data(data, len)
+            , m_string(str)
+        {
+        }
+
+    public:
+        exlib::string m_data;
+        bool m_string;
+    };
+
+private:
+    struct Entry {
+        obj_ptr<Value> value;
+        size_t bytes;
+        double expire;
+        std::list<const exlib::string*>::iterator lru;
+        std::multimap<double, const exlib::string*>::iterator expires;
+    };
+
+    typedef std::unordered_map<exlib::string, Entry> map_t;
+
+    class Shard {
+    public:
+        Shard()
+            : m_bytes(0)
+            , m_hits(0)
+            , m_misses(0)
+            , m_evictions(0)
+            , m_expirations(0)
+        {
+        }
+
+    public:
+        exlib::spinlock m_lock;
+        map_t m_map;
+        std::list<const exlib::string*> m_lru;
+        std::multimap<double, const exlib::string*> m_expires;
+        int64_t m_bytes;
+        int64_t m_hits;
+        int64_t m_misses;
+        int64_t m_evictions;
+        int64_t m_expirations;
+    };
+
+public:
+    struct Stats {
+        int64_t hits = 0;
+        int64_t misses = 0;
+        int64_t evictions = 0;
+        int64_t expirations = 0;
+        int64_t size = 0;
+        int64_t bytes = 0;
+    };
+
+public:
+    SharedStore(exlib::string name, int64_t budget, int32_t timeout, int32_t shards);
+
+public:
+    static obj_ptr<SharedStore> open(exlib::string name, int64_t budget, int32_t timeout, int32_t shards);
+
+public:
+    bool get(exlib::string& key, obj_ptr<Value>& retVal, bool touch);
+    void set(exlib::string& key, Value* value, int32_t timeout);
+    bool remove(exlib::string& key);
+    void clear();
+    void stats(Stats& st);
+
+    // drop expired entries, returns true while entries with a timeout remain
+    bool sweep();
+
+public:
+    exlib::string m_name;
+    int64_t m_budget;
+    int32_t m_timeout;
+
+private:
+    Shard& shard(exlib::string& key)
+    {
+        return m_shards[std::hash<exlib::string>()(key) & (m_shards.size() - 1)];
+    }
+
+    void erase(Shard& s, map_t::iterator it, std::vector<obj_ptr<Value>>& drops);
+
+private:
+    std::vector<Shard> m_shards;
+    int64_t m_shardBudget;
+    exlib::atomic m_sweeping;
+};
+
+class SharedCache : public SharedCache_base {
+public:
+    SharedCache(SharedStore* store)
+        : m_store(store)
+    {
+    }
+
+    FIBER_FREE();
+
+public:
+    // SharedCache_base
+    virtual result_t get_name(exlib::string& retVal);
+    virtual result_t get_size(int32_t& retVal);
+    virtual result_t get_bytes(int64_t& retVal);
+    virtual result_t get_budget(int64_t& retVal);
+    virtual result_t get_stats(v8::Local<v8::Object>& retVal);
+    virtual result_t clear();
+    virtual result_t has(exlib::string name, bool& retVal);
+    virtual result_t get(exlib::string name, v8::Local<v8::Value>& retVal);
+    virtual result_t set(exlib::string name, v8::Local<v8::Value> value, int32_t timeout);
+    virtual result_t remove(exlib::string name, bool& retVal);
+
+private:
+    obj_ptr<SharedStore> m_store;
+};
+
+} /* namespace fibjs */
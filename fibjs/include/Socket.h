@@ -10,11 +10,13 @@
 #include "ifs/Socket.h"
 #include "inetAddr.h"
 #include "AsyncIO.h"
+#include "GatherWriter.h"
 #include "Timer.h"
 
 namespace fibjs {
 
-class Socket : public Socket_base {
+class Socket : public Socket_base,
+               public GatherWriter {
     FIBER_FREE();
 
 public:
@@ -71,6 +73,20 @@ public:
 
 public:
     static result_t create(int32_t family, obj_ptr<Socket_base>& retVal);
+    result_t reusePort();
+
+    virtual result_t writev(std::vector<obj_ptr<Buffer>>& datas, AsyncEvent* ac)
+    {
+        return m_aio.writev(datas, ac);
+    }
+
+#ifdef Linux
+    // pos < 0 sends from the current file position and advances it
+    result_t sendfile(int32_t fd, int64_t pos, int64_t bytes, int64_t& retVal, AsyncEvent* ac)
+    {
+        return m_aio.sendfile(fd, pos, bytes, retVal, ac);
+    }
+#endif
 
 private:
     result_t create(int32_t family);
@@ -32,6 +32,11 @@ public:
     result_t init(v8::Local<v8::Array> certs, Handler_base* hdlr);
     result_t init(X509Cert_base* crt, PKey_base* key, Handler_base* hdlr);
 
+    void set_alpn(const char** protocols)
+    {
+        ((SslSocket*)(SslSocket_base*)m_socket)->set_alpn(protocols);
+    }
+
 private:
     obj_ptr<Handler_base> m_hdlr;
     obj_ptr<SslSocket_base> m_socket;
@@ -20,9 +20,11 @@ public:
     // TcpServer_base
     virtual result_t start();
     virtual result_t stop(AsyncEvent* ac);
+    virtual result_t reload(AsyncEvent* ac);
     virtual result_t get_socket(obj_ptr<Socket_base>& retVal);
     virtual result_t get_handler(obj_ptr<Handler_base>& retVal);
     virtual result_t set_handler(Handler_base* newVal);
+    virtual result_t get_stats(v8::Local<v8::Object>& retVal);
 
 public:
     // SslServer_base
@@ -35,6 +37,18 @@ public:
         Handler_base* listener);
     result_t create(v8::Local<v8::Array> certs, exlib::string addr, int32_t port,
         Handler_base* listener);
+    result_t create(X509Cert_base* crt, PKey_base* key, v8::Local<v8::Object> opts,
+        Handler_base* listener);
+    result_t create(v8::Local<v8::Array> certs, v8::Local<v8::Object> opts,
+        Handler_base* listener);
+
+    void set_alpn(const char** protocols)
+    {
+        ((SslHandler*)(SslHandler_base*)m_hdlr)->set_alpn(protocols);
+    }
+
+private:
+    void init(SslHandler_base* handler, TcpServer_base* server);
 
 private:
     obj_ptr<TcpServer_base> m_server;
@@ -17,10 +17,12 @@
 #include <mbedtls/mbedtls/net_sockets.h>
 #include "PKey.h"
 #include "Routing.h"
+#include "GatherWriter.h"
 
 namespace fibjs {
 
-class SslSocket : public SslSocket_base {
+class SslSocket : public SslSocket_base,
+                  public GatherWriter {
     FIBER_FREE();
 
 private:
@@ -137,6 +139,10 @@ public:
     virtual result_t connect(Stream_base* s, exlib::string server_name, int32_t& retVal, AsyncEvent* ac);
     virtual result_t accept(Stream_base* s, obj_ptr<SslSocket_base>& retVal, AsyncEvent* ac);
 
+public:
+    // GatherWriter
+    virtual result_t writev(std::vector<obj_ptr<Buffer>>& datas, AsyncEvent* ac);
+
 private:
     int32_t my_recv(unsigned char* buf, size_t len);
     static int32_t my_recv(void* ctx, unsigned char* buf, size_t len);
@@ -172,6 +178,18 @@ public:
         return setCert(new Cert(name, crt, key));
     }
 
+    // protocols negotiated through ALPN by accept() and connect(), the list must outlive the socket
+    void set_alpn(const char** protocols)
+    {
+        m_alpn = protocols;
+    }
+
+    exlib::string alpn()
+    {
+        const char* p = mbedtls_ssl_get_alpn_protocol(&m_ssl);
+        return p ? p : "";
+    }
+
 public:
     mbedtls_ssl_context m_ssl;
     mbedtls_ssl_config m_ssl_conf;
@@ -180,6 +198,7 @@ public:
 private:
     obj_ptr<X509Cert> m_ca;
     obj_ptr<Stream_base> m_s;
+    const char** m_alpn;
     exlib::string m_recv;
     int32_t m_recv_pos;
     exlib::string m_send;
@@ -11,6 +11,8 @@
 #include "ifs/Handler.h"
 #include "ifs/TcpServer.h"
 #include "Socket.h"
+#include "HttpHandler.h"
+#include "ServerWorker.h"
 
 namespace fibjs {
 
@@ -19,6 +21,7 @@ class TcpServer : public TcpServer_base {
 
 public:
     TcpServer();
+    ~TcpServer();
 
 public:
     // TcpServer_base
@@ -27,6 +30,26 @@ public:
     virtual result_t get_socket(obj_ptr<Socket_base>& retVal);
     virtual result_t get_handler(obj_ptr<Handler_base>& retVal);
     virtual result_t set_handler(Handler_base* newVal);
+    virtual result_t get_stats(v8::Local<v8::Object>& retVal);
+    virtual result_t reload(AsyncEvent* ac);
+
+public:
+    class Stats {
+    public:
+        Stats()
+            : m_refs(0)
+        {
+        }
+
+    public:
+        exlib::atomic m_accepted;
+        exlib::atomic m_active;
+        exlib::atomic m_listeners;
+
+        // servers using a shared entry, the last one to go removes it
+        int32_t m_refs;
+        exlib::string m_key;
+    };
 
 public:
     class Holder : public object_base {
@@ -35,12 +58,39 @@ public:
     };
 
 public:
-    result_t create(exlib::string addr, int32_t port, Handler_base* listener);
+    result_t create(exlib::string addr, int32_t port, Handler_base* listener,
+        bool reusePort = false, int32_t backlog = 1024);
+    result_t create(v8::Local<v8::Object> opts, Handler_base* listener);
+    result_t create_workers(v8::Local<v8::Object> opts, HttpHandler* http = NULL);
+
+    bool is_worker()
+    {
+        return !m_workers.empty();
+    }
+
+    static Stats* shared_stats(exlib::string addr, int32_t port);
+    static void release_stats(Stats* stats);
+
+    // connections accepted by this server that are still being served
+    int32_t connections()
+    {
+        return (int32_t)m_connections.value();
+    }
+
+private:
+    result_t run_workers(int32_t op, AsyncEvent* ac);
+    ASYNC_MEMBER1_AC(TcpServer, run_workers, int32_t);
 
 private:
     bool m_running;
+    Stats m_local_stats;
+    Stats* m_stats;
+    exlib::atomic m_connections;
     obj_ptr<Socket_base> m_socket;
     obj_ptr<Handler_base> m_hdlr;
+    std::vector<obj_ptr<ServerWorker>> m_workers;
+    obj_ptr<HttpHandler> m_http;
+    obj_ptr<HttpHandler> m_settings;
 };
 
 } /* namespace fibjs */
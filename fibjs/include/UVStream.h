@@ -10,13 +10,15 @@
 #include "ifs/io.h"
 #include "AsyncUV.h"
 #include "Buffer.h"
+#include "GatherWriter.h"
 
 #define STREAM_BLOCK_SIZE 2048
 
 namespace fibjs {
 
 template <typename T>
-class UVStream_tmpl : public T {
+class UVStream_tmpl : public T,
+                      public GatherWriter {
 public:
     class UVTimeout : public uv_timer_t {
     public:
@@ -207,9 +209,28 @@ public:
             , m_this(pThis)
             , m_ac(ac)
         {
-            m_data = Buffer::Cast(data);
-            m_buf.base = (char*)m_data->data();
-            m_buf.len = (uint32_t)m_data->length();
+            add(Buffer::Cast(data));
+        }
+
+        AsyncWrite(UVStream_tmpl* pThis, std::vector<obj_ptr<Buffer>>& datas, AsyncEvent* ac)
+            : UVTimeout(pThis)
+            , m_this(pThis)
+            , m_ac(ac)
+        {
+            for (size_t i = 0; i < datas.size(); i++)
+                add(datas[i]);
+        }
+
+    private:
+        void add(Buffer* data)
+        {
+            uv_buf_t buf;
+
+            buf.base = (char*)data->data();
+            buf.len = (uint32_t)data->length();
+
+            m_data.push_back(data);
+            m_buf.push_back(buf);
         }
 
     public:
@@ -217,7 +238,7 @@ public:
         {
             m_this->queue_write.putTail(this);
             if (m_this->queue_write.count() == 1) {
-                int32_t ret = uv_write(&m_req, &m_this->m_stream, &m_buf, 1, on_write);
+                int32_t ret = uv_write(&m_req, &m_this->m_stream, m_buf.data(), (uint32_t)m_buf.size(), on_write);
                 if (ret < 0)
                     post_all_result(m_this, ret);
             }
@@ -238,7 +259,7 @@ public:
 
             if (pThis->queue_write.count() > 0) {
                 wr = pThis->queue_write.head();
-                int32_t ret = uv_write(&wr->m_req, &pThis->m_stream, &wr->m_buf, 1, on_write);
+                int32_t ret = uv_write(&wr->m_req, &pThis->m_stream, wr->m_buf.data(), (uint32_t)wr->m_buf.size(), on_write);
                 if (ret)
                     post_all_result(pThis, ret);
             }
@@ -259,8 +280,8 @@ public:
     private:
         obj_ptr<UVStream_tmpl> m_this;
         AsyncEvent* m_ac;
-        obj_ptr<Buffer> m_data;
-        uv_buf_t m_buf;
+        std::vector<obj_ptr<Buffer>> m_data;
+        std::vector<uv_buf_t> m_buf;
         uv_write_t m_req;
     };
 
@@ -298,6 +319,16 @@ public:
         return CALL_E_PENDDING;
     }
 
+    // gather write, the buffers go out in one uv_write without being joined
+    virtual result_t writev(std::vector<obj_ptr<Buffer>>& datas, AsyncEvent* ac)
+    {
+        if (ac->isSync())
+            return CHECK_ERROR(CALL_E_NOSYNC);
+
+        uv_post(new AsyncWrite(this, datas, ac));
+        return CALL_E_PENDDING;
+    }
+
     virtual result_t flush(AsyncEvent* ac)
     {
         return 0;
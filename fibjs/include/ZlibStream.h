@@ -342,10 +342,15 @@ public:
 
 class gz : public def_base {
 public:
-    gz(Stream_base* stm)
+    gz(Stream_base* stm, int32_t level = -1)
         : def_base(stm)
     {
-        deflateInit2(&strm, -1, 8, 15 + 16, 8, 0);
+        if (level < zlib_base::C_DEFAULT_COMPRESSION)
+            level = zlib_base::C_DEFAULT_COMPRESSION;
+        else if (level > zlib_base::C_BEST_COMPRESSION)
+            level = zlib_base::C_BEST_COMPRESSION;
+
+        deflateInit2(&strm, level, 8, 15 + 16, 8, 0);
     }
 };
 
@@ -13,20 +13,29 @@
 #include "ifs/coroutine.h"
 #include "ifs/fs.h"
 #include "File.h"
+#include <vector>
 
 namespace fibjs {
 
 #define LOGTIME true
+#define LOG_QUEUE_SIZE 8192
+#define LOG_QUEUE_MAX 1048576
+#define LOG_QUEUE_BYTES (64 * 1024 * 1024)
+#define LOG_BATCH_SIZE 256
 
 class logger : public AsyncEvent {
 public:
-    class item : public exlib::linkitem {
+    enum {
+        LOG_DROP = 0,
+        LOG_BLOCK = 1,
+        LOG_SAMPLE = 2
+    };
+
+    class item {
     public:
-        item(int32_t priority, exlib::string& msg)
-            : m_priority(priority)
-            , m_msg(msg)
+        item()
+            : m_priority(0)
         {
-            m_d.now();
         }
 
         exlib::string full(bool type = LOGTIME)
@@ -64,13 +73,26 @@ public:
 
 public:
     logger()
-        : m_bWorking(false)
+        : m_working(0)
+        , m_head(0)
+        , m_count(0)
+        , m_bytes(0)
+        , m_maxBytes(LOG_QUEUE_BYTES)
+        , m_bWorking(false)
         , m_bStop(false)
+        , m_policy(LOG_DROP)
+        , m_sample(10)
+        , m_overflow(0)
+        , m_dropped(0)
+        , m_written(0)
     {
         int32_t i;
 
         for (i = 0; i < console_base::C_NOTSET; i++)
             m_levels[i] = true;
+
+        m_ring.resize(LOG_QUEUE_SIZE);
+        m_workinglogs.resize(LOG_BATCH_SIZE);
     }
 
     virtual result_t config(Isolate* isolate, v8::Local<v8::Object> o)
@@ -107,6 +129,43 @@ public:
             m_levels[console_base::C_PRINT] = true;
         }
 
+        int32_t queue = LOG_QUEUE_SIZE;
+        hr = GetConfigValue(isolate, o, "queue", queue);
+        if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+            return hr;
+        if (queue < 16 || queue > LOG_QUEUE_MAX)
+            return CHECK_ERROR(Runtime::setError("console: Queue size must between 16 to 1048576."));
+        if (queue != (int32_t)m_ring.size())
+            m_ring.resize(queue);
+
+        double queueBytes = LOG_QUEUE_BYTES;
+        hr = GetConfigValue(isolate, o, "queueBytes", queueBytes);
+        if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+            return hr;
+        if (queueBytes < 1024)
+            return CHECK_ERROR(Runtime::setError("console: Queue bytes must be at least 1024."));
+        m_maxBytes = (size_t)queueBytes;
+
+        exlib::string overflow;
+        hr = GetConfigValue(isolate, o, "overflow", overflow);
+        if (hr >= 0) {
+            if (overflow == "drop")
+                m_policy = LOG_DROP;
+            else if (overflow == "block")
+                m_policy = LOG_BLOCK;
+            else if (overflow == "sample")
+                m_policy = LOG_SAMPLE;
+            else
+                return CHECK_ERROR(Runtime::setError("console: Unknown overflow policy."));
+        } else if (hr != CALL_E_PARAMNOTOPTIONAL)
+            return hr;
+
+        hr = GetConfigValue(isolate, o, "sample", m_sample);
+        if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+            return hr;
+        if (m_sample < 1)
+            return CHECK_ERROR(Runtime::setError("console: Sample rate must be positive."));
+
         return 0;
     }
 
@@ -127,8 +186,30 @@ public:
 
             m_lock.lock();
 
-            m_acLog.getList(m_workinglogs);
-            if (m_workinglogs.empty()) {
+            m_working = 0;
+            while (m_count > 0 && m_working < m_workinglogs.size()) {
+                item& src = m_ring[m_head];
+                item& dst = m_workinglogs[m_working++];
+
+                dst.m_priority = src.m_priority;
+                dst.m_d = src.m_d;
+                m_bytes -= src.m_msg.length();
+                std::swap(dst.m_msg, src.m_msg);
+                src.m_msg = exlib::string();
+
+                m_head = (m_head + 1) % m_ring.size();
+                m_count--;
+            }
+            m_written += m_working;
+
+            if (m_working > 0 && m_policy == LOG_BLOCK)
+                m_space.set();
+
+            if (m_working == 0) {
+                // the last batch is written, do not keep its text around while idle
+                for (size_t i = 0; i < m_workinglogs.size(); i++)
+                    m_workinglogs[i].m_msg = exlib::string();
+
                 m_bWorking = false;
                 bStop = m_bStop;
                 m_lock.unlock();
@@ -157,10 +238,38 @@ public:
 
     virtual void putLog(int32_t priority, exlib::string& msg)
     {
-        item* i = new item(priority, msg);
+        size_t sz = msg.length();
 
         m_lock.lock();
-        m_acLog.putTail(i);
+
+        while (full(sz) && m_count > 0 && m_policy == LOG_BLOCK) {
+            m_space.reset();
+            m_lock.unlock();
+            m_space.wait();
+            m_lock.lock();
+        }
+
+        // the queue is bounded by records and by bytes, the oldest records make room
+        // for the new one, or the new one is dropped when it still does not fit
+        if (full(sz)) {
+            if (m_policy != LOG_SAMPLE || (++m_overflow % m_sample) == 0)
+                while (m_count > 0 && full(sz))
+                    drop_head();
+
+            if (full(sz)) {
+                m_dropped++;
+                m_lock.unlock();
+                return;
+            }
+        }
+
+        item& i = m_ring[(m_head + m_count) % m_ring.size()];
+        i.m_priority = priority;
+        i.m_msg = msg;
+        i.m_d.now();
+        m_count++;
+        m_bytes += sz;
+
         if (!m_bWorking) {
             m_bWorking = true;
             async(CALL_E_NOSYNC);
@@ -176,7 +285,7 @@ public:
 
     void flush()
     {
-        while (!m_acLog.empty() || m_bWorking)
+        while (m_count > 0 || m_bWorking)
             exlib::OSThread::sleep(0);
     }
 
@@ -191,6 +300,45 @@ public:
         m_lock.unlock();
     }
 
+    void stats(Isolate* isolate, v8::Local<v8::Object> o)
+    {
+        v8::Local<v8::Context> context = isolate->context();
+        size_t queued, size, bytes;
+        int64_t dropped, written;
+
+        m_lock.lock();
+        queued = m_count;
+        size = m_ring.size();
+        bytes = m_bytes;
+        dropped = m_dropped;
+        written = m_written;
+        m_lock.unlock();
+
+        o->Set(context, isolate->NewString("queued"), v8::Number::New(isolate->m_isolate, (double)queued)).IsJust();
+        o->Set(context, isolate->NewString("size"), v8::Number::New(isolate->m_isolate, (double)size)).IsJust();
+        o->Set(context, isolate->NewString("bytes"), v8::Number::New(isolate->m_isolate, (double)bytes)).IsJust();
+        o->Set(context, isolate->NewString("dropped"), v8::Number::New(isolate->m_isolate, (double)dropped)).IsJust();
+        o->Set(context, isolate->NewString("written"), v8::Number::New(isolate->m_isolate, (double)written)).IsJust();
+    }
+
+private:
+    bool full(size_t sz)
+    {
+        return m_count == m_ring.size() || m_bytes + sz > m_maxBytes;
+    }
+
+    void drop_head()
+    {
+        item& i = m_ring[m_head];
+
+        m_bytes -= i.m_msg.length();
+        i.m_msg = exlib::string();
+
+        m_head = (m_head + 1) % m_ring.size();
+        m_count--;
+        m_dropped++;
+    }
+
 public:
     static exlib::string notice()
     {
@@ -212,22 +360,33 @@ public:
         return COLOR_TITLE;
     }
 
+public:
+    exlib::string m_type;
+
 protected:
-    exlib::List<item> m_workinglogs;
+    std::vector<item> m_workinglogs;
+    size_t m_working;
 
     void destroy()
     {
-        item* p1;
-        while ((p1 = m_acLog.getHead()) != 0)
-            delete p1;
         delete this;
     }
 
 private:
-    exlib::List<item> m_acLog;
+    std::vector<item> m_ring;
+    size_t m_head;
+    size_t m_count;
+    size_t m_bytes;
+    size_t m_maxBytes;
     bool m_bWorking;
     bool m_bStop;
+    int32_t m_policy;
+    int32_t m_sample;
+    int64_t m_overflow;
+    int64_t m_dropped;
+    int64_t m_written;
     exlib::spinlock m_lock;
+    exlib::Event m_space;
     bool m_levels[console_base::C_NOTSET];
 };
 
@@ -17,6 +17,18 @@ namespace fibjs {
 void base64Encode(const char* data, size_t sz, bool url, exlib::string& retVal);
 void base64Decode(const char* data, size_t sz, exlib::string& retVal);
 
+/**
+ * vectorized kernels for the hex & base64 codecs, each one handles the
+ * whole blocks at the head of the input and returns how much it consumed,
+ * the caller finishes the rest with the scalar code.
+ * decoders stop at the first block holding any character outside the
+ * alphabet, so the scalar code keeps the handling of invalid input.
+ */
+size_t hex_encode_block(const unsigned char* data, size_t sz, bool upper, char* out);
+size_t hex_decode_block(const char* data, size_t len, unsigned char* out);
+size_t base64_encode_block(const unsigned char* data, size_t sz, bool url, char* out);
+size_t base64_decode_block(const char* data, size_t len, unsigned char* out);
+
 /**
  * hex & base64 use encode: binary -> hex ,binary -> base64
  *
@@ -27,5 +39,6 @@ result_t commonEncode(exlib::string codec, const char* data, size_t sz, exlib::s
 result_t commonEncode(exlib::string codec, exlib::string data, exlib::string& retVal);
 
 result_t commonDecode(exlib::string codec, exlib::string data, exlib::string& retVal);
+result_t commonDecode(exlib::string codec, exlib::string data, obj_ptr<Buffer_base>& retVal);
 
 } /* namespace fibjs */
@@ -0,0 +1,50 @@
+/*
+ * hpack.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#pragma once
+
+#include "utils.h"
+#include <deque>
+#include <vector>
+
+namespace fibjs {
+
+typedef std::pair<exlib::string, exlib::string> hpack_field;
+
+class HPackDecoder {
+public:
+    HPackDecoder(size_t maxSize = 4096)
+        : m_size(0)
+        , m_maxSize(maxSize)
+        , m_limit(maxSize)
+    {
+    }
+
+public:
+    // decode one complete header block, fields are appended in wire order
+    result_t decode(const char* data, size_t len, std::vector<hpack_field>& fields,
+        size_t maxListSize);
+
+private:
+    bool get(size_t index, hpack_field& field);
+    void add(hpack_field& field);
+    void evict(size_t maxSize);
+
+private:
+    std::deque<hpack_field> m_table;
+    size_t m_size;
+    size_t m_maxSize;
+    size_t m_limit;
+};
+
+class HPackEncoder {
+public:
+    // emit a field as a literal without indexing, so the peer's dynamic table is never touched
+    static void encode(const exlib::string& name, const exlib::string& value, exlib::string& out);
+    static void encode_status(int32_t status, exlib::string& out);
+};
+
+} /* namespace fibjs */
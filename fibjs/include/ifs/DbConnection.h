@@ -15,6 +15,8 @@
 
 namespace fibjs {
 
+class DbCursor_base;
+
 class DbConnection_base : public object_base {
     DECLARE_CLASS(DbConnection_base);
 
@@ -30,6 +32,10 @@ public:
     virtual result_t trans(exlib::string point, v8::Local<v8::Function> func, bool& retVal) = 0;
     virtual result_t execute(exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent* ac) = 0;
     virtual result_t execute(exlib::string sql, OptArgs args, obj_ptr<NArray>& retVal, AsyncEvent* ac) = 0;
+    virtual result_t executeColumns(exlib::string sql, obj_ptr<NObject>& retVal, AsyncEvent* ac) = 0;
+    virtual result_t executeColumns(exlib::string sql, OptArgs args, obj_ptr<NObject>& retVal, AsyncEvent* ac) = 0;
+    virtual result_t cursor(exlib::string sql, obj_ptr<DbCursor_base>& retVal, AsyncEvent* ac) = 0;
+    virtual result_t cursor(exlib::string sql, OptArgs args, obj_ptr<DbCursor_base>& retVal, AsyncEvent* ac) = 0;
     virtual result_t createTable(v8::Local<v8::Object> opts, AsyncEvent* ac) = 0;
     virtual result_t dropTable(v8::Local<v8::Object> opts, AsyncEvent* ac) = 0;
     virtual result_t createIndex(v8::Local<v8::Object> opts, AsyncEvent* ac) = 0;
@@ -60,6 +66,8 @@ public:
     static void s_rollback(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_trans(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_execute(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_executeColumns(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_cursor(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_createTable(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_dropTable(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_createIndex(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -79,6 +87,10 @@ public:
     ASYNC_MEMBER1(DbConnection_base, rollback, exlib::string);
     ASYNC_MEMBERVALUE2(DbConnection_base, execute, exlib::string, obj_ptr<NArray>);
     ASYNC_MEMBERVALUE3(DbConnection_base, execute, exlib::string, OptArgs, obj_ptr<NArray>);
+    ASYNC_MEMBERVALUE2(DbConnection_base, executeColumns, exlib::string, obj_ptr<NObject>);
+    ASYNC_MEMBERVALUE3(DbConnection_base, executeColumns, exlib::string, OptArgs, obj_ptr<NObject>);
+    ASYNC_MEMBERVALUE2(DbConnection_base, cursor, exlib::string, obj_ptr<DbCursor_base>);
+    ASYNC_MEMBERVALUE3(DbConnection_base, cursor, exlib::string, OptArgs, obj_ptr<DbCursor_base>);
     ASYNC_MEMBER1(DbConnection_base, createTable, v8::Local<v8::Object>);
     ASYNC_MEMBER1(DbConnection_base, dropTable, v8::Local<v8::Object>);
     ASYNC_MEMBER1(DbConnection_base, createIndex, v8::Local<v8::Object>);
@@ -91,6 +103,8 @@ public:
 };
 }
 
+#include "ifs/DbCursor.h"
+
 namespace fibjs {
 inline ClassInfo& DbConnection_base::class_info()
 {
@@ -108,6 +122,10 @@ inline ClassInfo& DbConnection_base::class_info()
         { "trans", s_trans, false, false },
         { "execute", s_execute, false, true },
         { "executeSync", s_execute, false, false },
+        { "executeColumns", s_executeColumns, false, true },
+        { "executeColumnsSync", s_executeColumns, false, false },
+        { "cursor", s_cursor, false, true },
+        { "cursorSync", s_cursor, false, false },
         { "createTable", s_createTable, false, true },
         { "createTableSync", s_createTable, false, false },
         { "dropTable", s_dropTable, false, true },
@@ -291,6 +309,64 @@ inline void DbConnection_base::s_execute(const v8::FunctionCallbackInfo<v8::Valu
     METHOD_RETURN();
 }
 
+inline void DbConnection_base::s_executeColumns(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<NObject> vr;
+
+    ASYNC_METHOD_INSTANCE(DbConnection_base);
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(1, 1);
+
+    ARG(exlib::string, 0);
+
+    if (!cb.IsEmpty())
+        hr = pInst->acb_executeColumns(v0, cb, args);
+    else
+        hr = pInst->ac_executeColumns(v0, vr);
+
+    ASYNC_METHOD_OVER(-1, 1);
+
+    ARG(exlib::string, 0);
+    ARG_LIST(1);
+
+    if (!cb.IsEmpty())
+        hr = pInst->acb_executeColumns(v0, v1, cb, args);
+    else
+        hr = pInst->ac_executeColumns(v0, v1, vr);
+
+    METHOD_RETURN();
+}
+
+inline void DbConnection_base::s_cursor(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<DbCursor_base> vr;
+
+    ASYNC_METHOD_INSTANCE(DbConnection_base);
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(1, 1);
+
+    ARG(exlib::string, 0);
+
+    if (!cb.IsEmpty())
+        hr = pInst->acb_cursor(v0, cb, args);
+    else
+        hr = pInst->ac_cursor(v0, vr);
+
+    ASYNC_METHOD_OVER(-1, 1);
+
+    ARG(exlib::string, 0);
+    ARG_LIST(1);
+
+    if (!cb.IsEmpty())
+        hr = pInst->acb_cursor(v0, v1, cb, args);
+    else
+        hr = pInst->ac_cursor(v0, v1, vr);
+
+    METHOD_RETURN();
+}
+
 inline void DbConnection_base::s_createTable(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     ASYNC_METHOD_INSTANCE(DbConnection_base);
@@ -0,0 +1,99 @@
+/***************************************************************************
+ *                                                                         *
+ *   This file was automatically generated using idlc.js                   *
+ *   PLEASE DO NOT EDIT!!!!                                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+/**
+ @author Leo Hoo <lion@9465.net>
+ */
+
+#include "../object.h"
+
+namespace fibjs {
+
+class DbCursor_base : public object_base {
+    DECLARE_CLASS(DbCursor_base);
+
+public:
+    // DbCursor_base
+    virtual result_t next(int32_t count, obj_ptr<NArray>& retVal, AsyncEvent* ac) = 0;
+    virtual result_t close(AsyncEvent* ac) = 0;
+
+public:
+    static void s__new(const v8::FunctionCallbackInfo<v8::Value>& args)
+    {
+        CONSTRUCT_INIT();
+
+        isolate->m_isolate->ThrowException(
+            isolate->NewString("not a constructor"));
+    }
+
+public:
+    static void s_next(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_close(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+public:
+    ASYNC_MEMBERVALUE2(DbCursor_base, next, int32_t, obj_ptr<NArray>);
+    ASYNC_MEMBER0(DbCursor_base, close);
+};
+}
+
+namespace fibjs {
+inline ClassInfo& DbCursor_base::class_info()
+{
+    static ClassData::ClassMethod s_method[] = {
+        { "next", s_next, false, true },
+        { "nextSync", s_next, false, false },
+        { "close", s_close, false, true },
+        { "closeSync", s_close, false, false }
+    };
+
+    static ClassData s_cd = {
+        "DbCursor", false, s__new, NULL,
+        ARRAYSIZE(s_method), s_method, 0, NULL, 0, NULL, 0, NULL, NULL, NULL,
+        &object_base::class_info(),
+        true
+    };
+
+    static ClassInfo s_ci(s_cd);
+    return s_ci;
+}
+
+inline void DbCursor_base::s_next(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<NArray> vr;
+
+    ASYNC_METHOD_INSTANCE(DbCursor_base);
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(1, 0);
+
+    OPT_ARG(int32_t, 0, 1000);
+
+    if (!cb.IsEmpty())
+        hr = pInst->acb_next(v0, cb, args);
+    else
+        hr = pInst->ac_next(v0, vr);
+
+    METHOD_RETURN();
+}
+
+inline void DbCursor_base::s_close(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    ASYNC_METHOD_INSTANCE(DbCursor_base);
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(0, 0);
+
+    if (!cb.IsEmpty())
+        hr = pInst->acb_close(cb, args);
+    else
+        hr = pInst->ac_close();
+
+    METHOD_VOID();
+}
+}
@@ -17,6 +17,7 @@ namespace fibjs {
 
 class Buffer_base;
 class PKey_base;
+class Stream_base;
 
 class Digest_base : public object_base {
     DECLARE_CLASS(Digest_base);
@@ -25,6 +26,7 @@ public:
     // Digest_base
     virtual result_t update(Buffer_base* data, obj_ptr<Digest_base>& retVal) = 0;
     virtual result_t update(exlib::string data, exlib::string codec, obj_ptr<Digest_base>& retVal) = 0;
+    virtual result_t updateFromStream(Stream_base* stm, obj_ptr<Digest_base>& retVal, AsyncEvent* ac) = 0;
     virtual result_t digest(exlib::string codec, v8::Local<v8::Value>& retVal) = 0;
     virtual result_t sign(PKey_base* key, v8::Local<v8::Object> opts, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac) = 0;
     virtual result_t verify(PKey_base* key, Buffer_base* sign, v8::Local<v8::Object> opts, bool& retVal, AsyncEvent* ac) = 0;
@@ -41,12 +43,14 @@ public:
 
 public:
     static void s_update(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_updateFromStream(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_digest(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_sign(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_verify(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_get_size(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
 
 public:
+    ASYNC_MEMBERVALUE2(Digest_base, updateFromStream, Stream_base*, obj_ptr<Digest_base>);
     ASYNC_MEMBERVALUE3(Digest_base, sign, PKey_base*, v8::Local<v8::Object>, obj_ptr<Buffer_base>);
     ASYNC_MEMBERVALUE4(Digest_base, verify, PKey_base*, Buffer_base*, v8::Local<v8::Object>, bool);
 };
@@ -54,12 +58,15 @@ public:
 
 #include "ifs/Buffer.h"
 #include "ifs/PKey.h"
+#include "ifs/Stream.h"
 
 namespace fibjs {
 inline ClassInfo& Digest_base::class_info()
 {
     static ClassData::ClassMethod s_method[] = {
         { "update", s_update, false, false },
+        { "updateFromStream", s_updateFromStream, false, true },
+        { "updateFromStreamSync", s_updateFromStream, false, false },
         { "digest", s_digest, false, false },
         { "sign", s_sign, false, true },
         { "signSync", s_sign, false, false },
@@ -105,6 +112,25 @@ inline void Digest_base::s_update(const v8::FunctionCallbackInfo<v8::Value>& arg
     METHOD_RETURN();
 }
 
+inline void Digest_base::s_updateFromStream(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<Digest_base> vr;
+
+    ASYNC_METHOD_INSTANCE(Digest_base);
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(1, 1);
+
+    ARG(obj_ptr<Stream_base>, 0);
+
+    if (!cb.IsEmpty())
+        hr = pInst->acb_updateFromStream(v0, cb, args);
+    else
+        hr = pInst->ac_updateFromStream(v0, vr);
+
+    METHOD_RETURN();
+}
+
 inline void Digest_base::s_digest(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     v8::Local<v8::Value> vr;
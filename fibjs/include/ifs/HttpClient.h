@@ -37,6 +37,8 @@ public:
     virtual result_t set_autoRedirect(bool newVal) = 0;
     virtual result_t get_enableEncoding(bool& retVal) = 0;
     virtual result_t set_enableEncoding(bool newVal) = 0;
+    virtual result_t get_enableHttp2(bool& retVal) = 0;
+    virtual result_t set_enableHttp2(bool newVal) = 0;
     virtual result_t get_maxHeadersCount(int32_t& retVal) = 0;
     virtual result_t set_maxHeadersCount(int32_t newVal) = 0;
     virtual result_t get_maxHeaderSize(int32_t& retVal) = 0;
@@ -49,6 +51,9 @@ public:
     virtual result_t set_poolSize(int32_t newVal) = 0;
     virtual result_t get_poolTimeout(int32_t& retVal) = 0;
     virtual result_t set_poolTimeout(int32_t newVal) = 0;
+    virtual result_t get_poolMaxActive(int32_t& retVal) = 0;
+    virtual result_t set_poolMaxActive(int32_t newVal) = 0;
+    virtual result_t get_poolStats(v8::Local<v8::Object>& retVal) = 0;
     virtual result_t get_http_proxy(exlib::string& retVal) = 0;
     virtual result_t set_http_proxy(exlib::string newVal) = 0;
     virtual result_t get_https_proxy(exlib::string& retVal) = 0;
@@ -83,6 +88,8 @@ public:
     static void s_set_autoRedirect(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_enableEncoding(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_enableEncoding(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_enableHttp2(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_enableHttp2(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_maxHeadersCount(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_maxHeadersCount(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_maxHeaderSize(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
@@ -95,6 +102,9 @@ public:
     static void s_set_poolSize(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_poolTimeout(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_poolTimeout(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_poolMaxActive(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_poolMaxActive(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_poolStats(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_get_http_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_http_proxy(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_https_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
@@ -159,12 +169,15 @@ inline ClassInfo& HttpClient_base::class_info()
         { "enableCookie", s_get_enableCookie, s_set_enableCookie, false },
         { "autoRedirect", s_get_autoRedirect, s_set_autoRedirect, false },
         { "enableEncoding", s_get_enableEncoding, s_set_enableEncoding, false },
+        { "enableHttp2", s_get_enableHttp2, s_set_enableHttp2, false },
         { "maxHeadersCount", s_get_maxHeadersCount, s_set_maxHeadersCount, false },
         { "maxHeaderSize", s_get_maxHeaderSize, s_set_maxHeaderSize, false },
         { "maxBodySize", s_get_maxBodySize, s_set_maxBodySize, false },
         { "userAgent", s_get_userAgent, s_set_userAgent, false },
         { "poolSize", s_get_poolSize, s_set_poolSize, false },
         { "poolTimeout", s_get_poolTimeout, s_set_poolTimeout, false },
+        { "poolMaxActive", s_get_poolMaxActive, s_set_poolMaxActive, false },
+        { "poolStats", s_get_poolStats, block_set, false },
         { "http_proxy", s_get_http_proxy, s_set_http_proxy, false },
         { "https_proxy", s_get_https_proxy, s_set_https_proxy, false },
         { "sslVerification", s_get_sslVerification, s_set_sslVerification, false }
@@ -305,6 +318,29 @@ inline void HttpClient_base::s_set_enableEncoding(v8::Local<v8::Name> property,
     PROPERTY_SET_LEAVE();
 }
 
+inline void HttpClient_base::s_get_enableHttp2(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    bool vr;
+
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_enableHttp2(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpClient_base::s_set_enableHttp2(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(bool);
+
+    hr = pInst->set_enableHttp2(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
 inline void HttpClient_base::s_get_maxHeadersCount(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
 {
     int32_t vr;
@@ -443,6 +479,41 @@ inline void HttpClient_base::s_set_poolTimeout(v8::Local<v8::Name> property, v8:
     PROPERTY_SET_LEAVE();
 }
 
+inline void HttpClient_base::s_get_poolMaxActive(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_poolMaxActive(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpClient_base::s_set_poolMaxActive(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = pInst->set_poolMaxActive(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpClient_base::s_get_poolStats(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Object> vr;
+
+    METHOD_INSTANCE(HttpClient_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_poolStats(vr);
+
+    METHOD_RETURN();
+}
+
 inline void HttpClient_base::s_get_http_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
 {
     exlib::string vr;
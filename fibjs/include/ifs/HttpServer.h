@@ -27,7 +27,10 @@ public:
     static result_t _new(int32_t port, Handler_base* hdlr, obj_ptr<HttpServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
     static result_t _new(exlib::string addr, int32_t port, Handler_base* hdlr, obj_ptr<HttpServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
     static result_t _new(exlib::string addr, Handler_base* hdlr, obj_ptr<HttpServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
+    static result_t _new(v8::Local<v8::Object> opts, Handler_base* hdlr, obj_ptr<HttpServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
+    static result_t _new(v8::Local<v8::Object> opts, obj_ptr<HttpServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
     virtual result_t enableCrossOrigin(exlib::string allowHeaders) = 0;
+    virtual result_t setEncodingOptions(exlib::string type, v8::Local<v8::Object> opts) = 0;
     virtual result_t get_maxHeadersCount(int32_t& retVal) = 0;
     virtual result_t set_maxHeadersCount(int32_t newVal) = 0;
     virtual result_t get_maxHeaderSize(int32_t& retVal) = 0;
@@ -36,6 +39,10 @@ public:
     virtual result_t set_maxBodySize(int32_t newVal) = 0;
     virtual result_t get_enableEncoding(bool& retVal) = 0;
     virtual result_t set_enableEncoding(bool newVal) = 0;
+    virtual result_t get_streamForm(bool& retVal) = 0;
+    virtual result_t set_streamForm(bool newVal) = 0;
+    virtual result_t get_encodingCacheSize(int32_t& retVal) = 0;
+    virtual result_t set_encodingCacheSize(int32_t newVal) = 0;
     virtual result_t get_serverName(exlib::string& retVal) = 0;
     virtual result_t set_serverName(exlib::string newVal) = 0;
 
@@ -46,6 +53,7 @@ public:
 public:
     static void s__new(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_enableCrossOrigin(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_setEncodingOptions(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_get_maxHeadersCount(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_maxHeadersCount(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_maxHeaderSize(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
@@ -54,6 +62,10 @@ public:
     static void s_set_maxBodySize(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_enableEncoding(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_enableEncoding(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_streamForm(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_streamForm(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_encodingCacheSize(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_set_encodingCacheSize(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_get_serverName(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_serverName(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
 };
@@ -65,7 +77,8 @@ namespace fibjs {
 inline ClassInfo& HttpServer_base::class_info()
 {
     static ClassData::ClassMethod s_method[] = {
-        { "enableCrossOrigin", s_enableCrossOrigin, false, false }
+        { "enableCrossOrigin", s_enableCrossOrigin, false, false },
+        { "setEncodingOptions", s_setEncodingOptions, false, false }
     };
 
     static ClassData::ClassProperty s_property[] = {
@@ -73,6 +86,8 @@ inline ClassInfo& HttpServer_base::class_info()
         { "maxHeaderSize", s_get_maxHeaderSize, s_set_maxHeaderSize, false },
         { "maxBodySize", s_get_maxBodySize, s_set_maxBodySize, false },
         { "enableEncoding", s_get_enableEncoding, s_set_enableEncoding, false },
+        { "streamForm", s_get_streamForm, s_set_streamForm, false },
+        { "encodingCacheSize", s_get_encodingCacheSize, s_set_encodingCacheSize, false },
         { "serverName", s_get_serverName, s_set_serverName, false }
     };
 
@@ -122,6 +137,19 @@ void HttpServer_base::__new(const T& args)
 
     hr = _new(v0, v1, vr, args.This());
 
+    METHOD_OVER(2, 2);
+
+    ARG(v8::Local<v8::Object>, 0);
+    ARG(obj_ptr<Handler_base>, 1);
+
+    hr = _new(v0, v1, vr, args.This());
+
+    METHOD_OVER(1, 1);
+
+    ARG(v8::Local<v8::Object>, 0);
+
+    hr = _new(v0, vr, args.This());
+
     CONSTRUCT_RETURN();
 }
 
@@ -139,6 +167,21 @@ inline void HttpServer_base::s_enableCrossOrigin(const v8::FunctionCallbackInfo<
     METHOD_VOID();
 }
 
+inline void HttpServer_base::s_setEncodingOptions(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    METHOD_INSTANCE(HttpServer_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(2, 2);
+
+    ARG(exlib::string, 0);
+    ARG(v8::Local<v8::Object>, 1);
+
+    hr = pInst->setEncodingOptions(v0, v1);
+
+    METHOD_VOID();
+}
+
 inline void HttpServer_base::s_get_maxHeadersCount(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
 {
     int32_t vr;
@@ -231,6 +274,52 @@ inline void HttpServer_base::s_set_enableEncoding(v8::Local<v8::Name> property,
     PROPERTY_SET_LEAVE();
 }
 
+inline void HttpServer_base::s_get_streamForm(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    bool vr;
+
+    METHOD_INSTANCE(HttpServer_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_streamForm(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpServer_base::s_set_streamForm(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_INSTANCE(HttpServer_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(bool);
+
+    hr = pInst->set_streamForm(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void HttpServer_base::s_get_encodingCacheSize(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_INSTANCE(HttpServer_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_encodingCacheSize(vr);
+
+    METHOD_RETURN();
+}
+
+inline void HttpServer_base::s_set_encodingCacheSize(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    METHOD_INSTANCE(HttpServer_base);
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = pInst->set_encodingCacheSize(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
 inline void HttpServer_base::s_get_serverName(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
 {
     exlib::string vr;
@@ -30,6 +30,8 @@ public:
     static result_t _new(v8::Local<v8::Array> certs, exlib::string addr, int32_t port, Handler_base* hdlr, obj_ptr<HttpsServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
     static result_t _new(X509Cert_base* crt, PKey_base* key, int32_t port, Handler_base* hdlr, obj_ptr<HttpsServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
     static result_t _new(X509Cert_base* crt, PKey_base* key, exlib::string addr, int32_t port, Handler_base* hdlr, obj_ptr<HttpsServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
+    static result_t _new(v8::Local<v8::Array> certs, v8::Local<v8::Object> opts, Handler_base* hdlr, obj_ptr<HttpsServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
+    static result_t _new(X509Cert_base* crt, PKey_base* key, v8::Local<v8::Object> opts, Handler_base* hdlr, obj_ptr<HttpsServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
     virtual result_t get_verification(int32_t& retVal) = 0;
     virtual result_t set_verification(int32_t newVal) = 0;
     virtual result_t get_ca(obj_ptr<X509Cert_base>& retVal) = 0;
@@ -118,6 +120,23 @@ void HttpsServer_base::__new(const T& args)
 
     hr = _new(v0, v1, v2, v3, v4, vr, args.This());
 
+    METHOD_OVER(3, 3);
+
+    ARG(v8::Local<v8::Array>, 0);
+    ARG(v8::Local<v8::Object>, 1);
+    ARG(obj_ptr<Handler_base>, 2);
+
+    hr = _new(v0, v1, v2, vr, args.This());
+
+    METHOD_OVER(4, 4);
+
+    ARG(obj_ptr<X509Cert_base>, 0);
+    ARG(obj_ptr<PKey_base>, 1);
+    ARG(v8::Local<v8::Object>, 2);
+    ARG(obj_ptr<Handler_base>, 3);
+
+    hr = _new(v0, v1, v2, v3, vr, args.This());
+
     CONSTRUCT_RETURN();
 }
 
@@ -0,0 +1,214 @@
+/***************************************************************************
+ *                                                                         *
+ *   This file was automatically generated using idlc.js                   *
+ *   PLEASE DO NOT EDIT!!!!                                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+/**
+ @author Leo Hoo <lion@9465.net>
+ */
+
+#include "../object.h"
+
+namespace fibjs {
+
+class DbConnection_base;
+
+class Pool_base : public object_base {
+    DECLARE_CLASS(Pool_base);
+
+public:
+    // Pool_base
+    static result_t _new(exlib::string connString, v8::Local<v8::Object> opts, obj_ptr<Pool_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
+    virtual result_t get_connString(exlib::string& retVal) = 0;
+    virtual result_t get_size(int32_t& retVal) = 0;
+    virtual result_t get_stats(v8::Local<v8::Object>& retVal) = 0;
+    virtual result_t acquire(obj_ptr<DbConnection_base>& retVal) = 0;
+    virtual result_t release(DbConnection_base* conn, bool error) = 0;
+    virtual result_t run(v8::Local<v8::Function> func, v8::Local<v8::Value>& retVal) = 0;
+    virtual result_t execute(exlib::string sql, OptArgs args, obj_ptr<NArray>& retVal) = 0;
+    virtual result_t close() = 0;
+
+public:
+    template <typename T>
+    static void __new(const T& args);
+
+public:
+    static void s__new(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_get_connString(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_get_size(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_get_stats(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_acquire(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_release(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_run(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_execute(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_close(const v8::FunctionCallbackInfo<v8::Value>& args);
+};
+}
+
+#include "ifs/DbConnection.h"
+
+namespace fibjs {
+inline ClassInfo& Pool_base::class_info()
+{
+    static ClassData::ClassMethod s_method[] = {
+        { "acquire", s_acquire, false, false },
+        { "release", s_release, false, false },
+        { "run", s_run, false, false },
+        { "execute", s_execute, false, false },
+        { "close", s_close, false, false }
+    };
+
+    static ClassData::ClassProperty s_property[] = {
+        { "connString", s_get_connString, block_set, false },
+        { "size", s_get_size, block_set, false },
+        { "stats", s_get_stats, block_set, false }
+    };
+
+    static ClassData s_cd = {
+        "Pool", false, s__new, NULL,
+        ARRAYSIZE(s_method), s_method, 0, NULL, ARRAYSIZE(s_property), s_property, 0, NULL, NULL, NULL,
+        &object_base::class_info(),
+        false
+    };
+
+    static ClassInfo s_ci(s_cd);
+    return s_ci;
+}
+
+inline void Pool_base::s__new(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    CONSTRUCT_INIT();
+    __new(args);
+}
+
+template <typename T>
+void Pool_base::__new(const T& args)
+{
+    obj_ptr<Pool_base> vr;
+
+    CONSTRUCT_ENTER();
+
+    METHOD_OVER(2, 1);
+
+    ARG(exlib::string, 0);
+    OPT_ARG(v8::Local<v8::Object>, 1, v8::Object::New(isolate->m_isolate));
+
+    hr = _new(v0, v1, vr, args.This());
+
+    CONSTRUCT_RETURN();
+}
+
+inline void Pool_base::s_get_connString(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    exlib::string vr;
+
+    METHOD_INSTANCE(Pool_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_connString(vr);
+
+    METHOD_RETURN();
+}
+
+inline void Pool_base::s_get_size(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_INSTANCE(Pool_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_size(vr);
+
+    METHOD_RETURN();
+}
+
+inline void Pool_base::s_get_stats(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Object> vr;
+
+    METHOD_INSTANCE(Pool_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_stats(vr);
+
+    METHOD_RETURN();
+}
+
+inline void Pool_base::s_acquire(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<DbConnection_base> vr;
+
+    METHOD_INSTANCE(Pool_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = pInst->acquire(vr);
+
+    METHOD_RETURN();
+}
+
+inline void Pool_base::s_release(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    METHOD_INSTANCE(Pool_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(2, 1);
+
+    ARG(obj_ptr<DbConnection_base>, 0);
+    OPT_ARG(bool, 1, false);
+
+    hr = pInst->release(v0, v1);
+
+    METHOD_VOID();
+}
+
+inline void Pool_base::s_run(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Value> vr;
+
+    METHOD_INSTANCE(Pool_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(1, 1);
+
+    ARG(v8::Local<v8::Function>, 0);
+
+    hr = pInst->run(v0, vr);
+
+    METHOD_RETURN();
+}
+
+inline void Pool_base::s_execute(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<NArray> vr;
+
+    METHOD_INSTANCE(Pool_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(-1, 1);
+
+    ARG(exlib::string, 0);
+    ARG_LIST(1);
+
+    hr = pInst->execute(v0, v1, vr);
+
+    METHOD_RETURN();
+}
+
+inline void Pool_base::s_close(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    METHOD_INSTANCE(Pool_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = pInst->close();
+
+    METHOD_VOID();
+}
+}
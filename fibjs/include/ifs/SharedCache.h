@@ -0,0 +1,242 @@
+/***************************************************************************
+ *                                                                         *
+ *   This file was automatically generated using idlc.js                   *
+ *   PLEASE DO NOT EDIT!!!!                                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+/**
+ @author Leo Hoo <lion@9465.net>
+ */
+
+#include "../object.h"
+
+namespace fibjs {
+
+class SharedCache_base : public object_base {
+    DECLARE_CLASS(SharedCache_base);
+
+public:
+    // SharedCache_base
+    static result_t _new(exlib::string name, v8::Local<v8::Object> opts, obj_ptr<SharedCache_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
+    virtual result_t get_name(exlib::string& retVal) = 0;
+    virtual result_t get_size(int32_t& retVal) = 0;
+    virtual result_t get_bytes(int64_t& retVal) = 0;
+    virtual result_t get_budget(int64_t& retVal) = 0;
+    virtual result_t get_stats(v8::Local<v8::Object>& retVal) = 0;
+    virtual result_t clear() = 0;
+    virtual result_t has(exlib::string name, bool& retVal) = 0;
+    virtual result_t get(exlib::string name, v8::Local<v8::Value>& retVal) = 0;
+    virtual result_t set(exlib::string name, v8::Local<v8::Value> value, int32_t timeout) = 0;
+    virtual result_t remove(exlib::string name, bool& retVal) = 0;
+
+public:
+    template <typename T>
+    static void __new(const T& args);
+
+public:
+    static void s__new(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_get_name(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_get_size(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_get_bytes(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_get_budget(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_get_stats(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_clear(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_has(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_get(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_set(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_remove(const v8::FunctionCallbackInfo<v8::Value>& args);
+};
+}
+
+namespace fibjs {
+inline ClassInfo& SharedCache_base::class_info()
+{
+    static ClassData::ClassMethod s_method[] = {
+        { "clear", s_clear, false, false },
+        { "has", s_has, false, false },
+        { "get", s_get, false, false },
+        { "set", s_set, false, false },
+        { "remove", s_remove, false, false }
+    };
+
+    static ClassData::ClassProperty s_property[] = {
+        { "name", s_get_name, block_set, false },
+        { "size", s_get_size, block_set, false },
+        { "bytes", s_get_bytes, block_set, false },
+        { "budget", s_get_budget, block_set, false },
+        { "stats", s_get_stats, block_set, false }
+    };
+
+    static ClassData s_cd = {
+        "SharedCache", false, s__new, NULL,
+        ARRAYSIZE(s_method), s_method, 0, NULL, ARRAYSIZE(s_property), s_property, 0, NULL, NULL, NULL,
+        &object_base::class_info(),
+        false
+    };
+
+    static ClassInfo s_ci(s_cd);
+    return s_ci;
+}
+
+inline void SharedCache_base::s__new(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    CONSTRUCT_INIT();
+    __new(args);
+}
+
+template <typename T>
+void SharedCache_base::__new(const T& args)
+{
+    obj_ptr<SharedCache_base> vr;
+
+    CONSTRUCT_ENTER();
+
+    METHOD_OVER(2, 1);
+
+    ARG(exlib::string, 0);
+    OPT_ARG(v8::Local<v8::Object>, 1, v8::Object::New(isolate->m_isolate));
+
+    hr = _new(v0, v1, vr, args.This());
+
+    CONSTRUCT_RETURN();
+}
+
+inline void SharedCache_base::s_get_name(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    exlib::string vr;
+
+    METHOD_INSTANCE(SharedCache_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_name(vr);
+
+    METHOD_RETURN();
+}
+
+inline void SharedCache_base::s_get_size(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    METHOD_INSTANCE(SharedCache_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_size(vr);
+
+    METHOD_RETURN();
+}
+
+inline void SharedCache_base::s_get_bytes(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int64_t vr;
+
+    METHOD_INSTANCE(SharedCache_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_bytes(vr);
+
+    METHOD_RETURN();
+}
+
+inline void SharedCache_base::s_get_budget(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int64_t vr;
+
+    METHOD_INSTANCE(SharedCache_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_budget(vr);
+
+    METHOD_RETURN();
+}
+
+inline void SharedCache_base::s_get_stats(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Object> vr;
+
+    METHOD_INSTANCE(SharedCache_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_stats(vr);
+
+    METHOD_RETURN();
+}
+
+inline void SharedCache_base::s_clear(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    METHOD_INSTANCE(SharedCache_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = pInst->clear();
+
+    METHOD_VOID();
+}
+
+inline void SharedCache_base::s_has(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    bool vr;
+
+    METHOD_INSTANCE(SharedCache_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(1, 1);
+
+    ARG(exlib::string, 0);
+
+    hr = pInst->has(v0, vr);
+
+    METHOD_RETURN();
+}
+
+inline void SharedCache_base::s_get(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Value> vr;
+
+    METHOD_INSTANCE(SharedCache_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(1, 1);
+
+    ARG(exlib::string, 0);
+
+    hr = pInst->get(v0, vr);
+
+    METHOD_RETURN();
+}
+
+inline void SharedCache_base::s_set(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    METHOD_INSTANCE(SharedCache_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(3, 2);
+
+    ARG(exlib::string, 0);
+    ARG(v8::Local<v8::Value>, 1);
+    OPT_ARG(int32_t, 2, -1);
+
+    hr = pInst->set(v0, v1, v2);
+
+    METHOD_VOID();
+}
+
+inline void SharedCache_base::s_remove(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    bool vr;
+
+    METHOD_INSTANCE(SharedCache_base);
+    METHOD_ENTER();
+
+    METHOD_OVER(1, 1);
+
+    ARG(exlib::string, 0);
+
+    hr = pInst->remove(v0, vr);
+
+    METHOD_RETURN();
+}
+}
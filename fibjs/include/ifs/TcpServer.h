@@ -26,11 +26,15 @@ public:
     static result_t _new(int32_t port, Handler_base* listener, obj_ptr<TcpServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
     static result_t _new(exlib::string addr, int32_t port, Handler_base* listener, obj_ptr<TcpServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
     static result_t _new(exlib::string addr, Handler_base* listener, obj_ptr<TcpServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
+    static result_t _new(v8::Local<v8::Object> opts, Handler_base* listener, obj_ptr<TcpServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
+    static result_t _new(v8::Local<v8::Object> opts, obj_ptr<TcpServer_base>& retVal, v8::Local<v8::Object> This = v8::Local<v8::Object>());
     virtual result_t start() = 0;
     virtual result_t stop(AsyncEvent* ac) = 0;
+    virtual result_t reload(AsyncEvent* ac) = 0;
     virtual result_t get_socket(obj_ptr<Socket_base>& retVal) = 0;
     virtual result_t get_handler(obj_ptr<Handler_base>& retVal) = 0;
     virtual result_t set_handler(Handler_base* newVal) = 0;
+    virtual result_t get_stats(v8::Local<v8::Object>& retVal) = 0;
 
 public:
     template <typename T>
@@ -40,12 +44,15 @@ public:
     static void s__new(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_start(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_stop(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_reload(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_get_socket(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_get_handler(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_set_handler(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_get_stats(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
 
 public:
     ASYNC_MEMBER0(TcpServer_base, stop);
+    ASYNC_MEMBER0(TcpServer_base, reload);
 };
 }
 
@@ -58,12 +65,15 @@ inline ClassInfo& TcpServer_base::class_info()
     static ClassData::ClassMethod s_method[] = {
         { "start", s_start, false, false },
         { "stop", s_stop, false, true },
-        { "stopSync", s_stop, false, false }
+        { "stopSync", s_stop, false, false },
+        { "reload", s_reload, false, true },
+        { "reloadSync", s_reload, false, false }
     };
 
     static ClassData::ClassProperty s_property[] = {
         { "socket", s_get_socket, block_set, false },
-        { "handler", s_get_handler, s_set_handler, false }
+        { "handler", s_get_handler, s_set_handler, false },
+        { "stats", s_get_stats, block_set, false }
     };
 
     static ClassData s_cd = {
@@ -112,6 +122,19 @@ void TcpServer_base::__new(const T& args)
 
     hr = _new(v0, v1, vr, args.This());
 
+    METHOD_OVER(2, 2);
+
+    ARG(v8::Local<v8::Object>, 0);
+    ARG(obj_ptr<Handler_base>, 1);
+
+    hr = _new(v0, v1, vr, args.This());
+
+    METHOD_OVER(1, 1);
+
+    ARG(v8::Local<v8::Object>, 0);
+
+    hr = _new(v0, vr, args.This());
+
     CONSTRUCT_RETURN();
 }
 
@@ -142,6 +165,21 @@ inline void TcpServer_base::s_stop(const v8::FunctionCallbackInfo<v8::Value>& ar
     METHOD_VOID();
 }
 
+inline void TcpServer_base::s_reload(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    ASYNC_METHOD_INSTANCE(TcpServer_base);
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(0, 0);
+
+    if (!cb.IsEmpty())
+        hr = pInst->acb_reload(cb, args);
+    else
+        hr = pInst->ac_reload();
+
+    METHOD_VOID();
+}
+
 inline void TcpServer_base::s_get_socket(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
 {
     obj_ptr<Socket_base> vr;
@@ -176,4 +214,16 @@ inline void TcpServer_base::s_set_handler(v8::Local<v8::Name> property, v8::Loca
 
     PROPERTY_SET_LEAVE();
 }
+
+inline void TcpServer_base::s_get_stats(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Object> vr;
+
+    METHOD_INSTANCE(TcpServer_base);
+    PROPERTY_ENTER();
+
+    hr = pInst->get_stats(vr);
+
+    METHOD_RETURN();
+}
 }
@@ -42,6 +42,7 @@ public:
     static result_t add(v8::Local<v8::Object> cfg);
     static result_t add(v8::Local<v8::Array> cfg);
     static result_t reset();
+    static result_t stats(v8::Local<v8::Array>& retVal);
     static result_t log(exlib::string fmt, OptArgs args);
     static result_t log(OptArgs args);
     static result_t debug(exlib::string fmt, OptArgs args);
@@ -92,6 +93,7 @@ public:
     static void s_static_get_height(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_static_add(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_reset(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_stats(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_log(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_debug(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_info(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -127,6 +129,7 @@ inline ClassInfo& console_base::class_info()
     static ClassData::ClassMethod s_method[] = {
         { "add", s_static_add, true, false },
         { "reset", s_static_reset, true, false },
+        { "stats", s_static_stats, true, false },
         { "log", s_static_log, true, false },
         { "debug", s_static_debug, true, false },
         { "info", s_static_info, true, false },
@@ -262,6 +265,19 @@ inline void console_base::s_static_reset(const v8::FunctionCallbackInfo<v8::Valu
     METHOD_VOID();
 }
 
+inline void console_base::s_static_stats(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Array> vr;
+
+    METHOD_ENTER();
+
+    METHOD_OVER(0, 0);
+
+    hr = stats(vr);
+
+    METHOD_RETURN();
+}
+
 inline void console_base::s_static_log(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     METHOD_ENTER();
@@ -74,6 +74,7 @@ public:
     static result_t pbkdf1(Buffer_base* password, Buffer_base* salt, int32_t iterations, int32_t size, exlib::string algoName, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
     static result_t pbkdf2(Buffer_base* password, Buffer_base* salt, int32_t iterations, int32_t size, int32_t algo, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
     static result_t pbkdf2(Buffer_base* password, Buffer_base* salt, int32_t iterations, int32_t size, exlib::string algoName, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
+    static result_t verifyBatch(v8::Local<v8::Array> items, obj_ptr<NArray>& retVal, AsyncEvent* ac);
     static result_t getHashes(v8::Local<v8::Array>& retVal);
 
 public:
@@ -100,6 +101,7 @@ public:
     static void s_static_generateKey(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_pbkdf1(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_pbkdf2(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_verifyBatch(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_getHashes(const v8::FunctionCallbackInfo<v8::Value>& args);
 
 public:
@@ -113,6 +115,7 @@ public:
     ASYNC_STATICVALUE6(crypto_base, pbkdf1, Buffer_base*, Buffer_base*, int32_t, int32_t, exlib::string, obj_ptr<Buffer_base>);
     ASYNC_STATICVALUE6(crypto_base, pbkdf2, Buffer_base*, Buffer_base*, int32_t, int32_t, int32_t, obj_ptr<Buffer_base>);
     ASYNC_STATICVALUE6(crypto_base, pbkdf2, Buffer_base*, Buffer_base*, int32_t, int32_t, exlib::string, obj_ptr<Buffer_base>);
+    ASYNC_STATICVALUE2(crypto_base, verifyBatch, v8::Local<v8::Array>, obj_ptr<NArray>);
 };
 }
 
@@ -151,6 +154,8 @@ inline ClassInfo& crypto_base::class_info()
         { "pbkdf1Sync", s_static_pbkdf1, true, false },
         { "pbkdf2", s_static_pbkdf2, true, true },
         { "pbkdf2Sync", s_static_pbkdf2, true, false },
+        { "verifyBatch", s_static_verifyBatch, true, true },
+        { "verifyBatchSync", s_static_verifyBatch, true, false },
         { "getHashes", s_static_getHashes, true, false }
     };
 
@@ -480,6 +485,24 @@ inline void crypto_base::s_static_pbkdf2(const v8::FunctionCallbackInfo<v8::Valu
     METHOD_RETURN();
 }
 
+inline void crypto_base::s_static_verifyBatch(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<NArray> vr;
+
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(1, 1);
+
+    ARG(v8::Local<v8::Array>, 0);
+
+    if (!cb.IsEmpty())
+        hr = acb_verifyBatch(v0, cb, args);
+    else
+        hr = ac_verifyBatch(v0, vr);
+
+    METHOD_RETURN();
+}
+
 inline void crypto_base::s_static_getHashes(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     v8::Local<v8::Array> vr;
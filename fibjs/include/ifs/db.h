@@ -15,6 +15,7 @@
 
 namespace fibjs {
 
+class Pool_base;
 class MySQL_base;
 class SQLite_base;
 class DbConnection_base;
@@ -66,6 +67,7 @@ public:
 };
 }
 
+#include "ifs/Pool.h"
 #include "ifs/MySQL.h"
 #include "ifs/SQLite.h"
 #include "ifs/DbConnection.h"
@@ -94,9 +96,13 @@ inline ClassInfo& db_base::class_info()
         { "openRedisSync", s_static_openRedis, true, false }
     };
 
+    static ClassData::ClassObject s_object[] = {
+        { "Pool", Pool_base::class_info }
+    };
+
     static ClassData s_cd = {
         "db", true, s__new, NULL,
-        ARRAYSIZE(s_method), s_method, 0, NULL, 0, NULL, 0, NULL, NULL, NULL,
+        ARRAYSIZE(s_method), s_method, ARRAYSIZE(s_object), s_object, 0, NULL, 0, NULL, NULL, NULL,
         &object_base::class_info(),
         true
     };
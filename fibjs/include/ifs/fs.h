@@ -45,6 +45,7 @@ public:
     static result_t rmdir(exlib::string path, AsyncEvent* ac);
     static result_t rename(exlib::string from, exlib::string to, AsyncEvent* ac);
     static result_t copyFile(exlib::string from, exlib::string to, int32_t mode, AsyncEvent* ac);
+    static result_t cp(exlib::string from, exlib::string to, v8::Local<v8::Object> opts, AsyncEvent* ac);
     static result_t chmod(exlib::string path, int32_t mode, AsyncEvent* ac);
     static result_t lchmod(exlib::string path, int32_t mode, AsyncEvent* ac);
     static result_t chown(exlib::string path, int32_t uid, int32_t gid, AsyncEvent* ac);
@@ -70,6 +71,7 @@ public:
     static result_t readTextFile(exlib::string fname, exlib::string& retVal, AsyncEvent* ac);
     static result_t readFile(exlib::string fname, exlib::string encoding, Variant& retVal, AsyncEvent* ac);
     static result_t readFile(exlib::string fname, v8::Local<v8::Object> options, Variant& retVal, AsyncEvent* ac);
+    static result_t mmap(exlib::string fname, v8::Local<v8::Object> opts, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
     static result_t readLines(exlib::string fname, int32_t maxlines, v8::Local<v8::Array>& retVal);
     static result_t write(FileHandle_base* fd, Buffer_base* buffer, int32_t offset, int32_t length, int32_t position, int32_t& retVal, AsyncEvent* ac);
     static result_t write(FileHandle_base* fd, exlib::string string, int32_t position, exlib::string encoding, int32_t& retVal, AsyncEvent* ac);
@@ -108,6 +110,7 @@ public:
     static void s_static_rmdir(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_rename(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_copyFile(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_cp(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_chmod(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_lchmod(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_chown(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -131,6 +134,7 @@ public:
     static void s_static_openTextStream(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_readTextFile(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_readFile(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_mmap(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_readLines(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_write(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_writeTextFile(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -152,6 +156,7 @@ public:
     ASYNC_STATIC1(fs_base, rmdir, exlib::string);
     ASYNC_STATIC2(fs_base, rename, exlib::string, exlib::string);
     ASYNC_STATIC3(fs_base, copyFile, exlib::string, exlib::string, int32_t);
+    ASYNC_STATIC3(fs_base, cp, exlib::string, exlib::string, v8::Local<v8::Object>);
     ASYNC_STATIC2(fs_base, chmod, exlib::string, int32_t);
     ASYNC_STATIC2(fs_base, lchmod, exlib::string, int32_t);
     ASYNC_STATIC3(fs_base, chown, exlib::string, int32_t, int32_t);
@@ -177,6 +182,7 @@ public:
     ASYNC_STATICVALUE2(fs_base, readTextFile, exlib::string, exlib::string);
     ASYNC_STATICVALUE3(fs_base, readFile, exlib::string, exlib::string, Variant);
     ASYNC_STATICVALUE3(fs_base, readFile, exlib::string, v8::Local<v8::Object>, Variant);
+    ASYNC_STATICVALUE3(fs_base, mmap, exlib::string, v8::Local<v8::Object>, obj_ptr<Buffer_base>);
     ASYNC_STATICVALUE6(fs_base, write, FileHandle_base*, Buffer_base*, int32_t, int32_t, int32_t, int32_t);
     ASYNC_STATICVALUE5(fs_base, write, FileHandle_base*, exlib::string, int32_t, exlib::string, int32_t);
     ASYNC_STATIC2(fs_base, writeTextFile, exlib::string, exlib::string);
@@ -217,6 +223,8 @@ inline ClassInfo& fs_base::class_info()
         { "renameSync", s_static_rename, true, false },
         { "copyFile", s_static_copyFile, true, true },
         { "copyFileSync", s_static_copyFile, true, false },
+        { "cp", s_static_cp, true, true },
+        { "cpSync", s_static_cp, true, false },
         { "chmod", s_static_chmod, true, true },
         { "chmodSync", s_static_chmod, true, false },
         { "lchmod", s_static_lchmod, true, true },
@@ -263,6 +271,8 @@ inline ClassInfo& fs_base::class_info()
         { "readTextFileSync", s_static_readTextFile, true, false },
         { "readFile", s_static_readFile, true, true },
         { "readFileSync", s_static_readFile, true, false },
+        { "mmap", s_static_mmap, true, true },
+        { "mmapSync", s_static_mmap, true, false },
         { "readLines", s_static_readLines, true, false },
         { "write", s_static_write, true, true },
         { "writeSync", s_static_write, true, false },
@@ -446,6 +456,24 @@ inline void fs_base::s_static_copyFile(const v8::FunctionCallbackInfo<v8::Value>
     METHOD_VOID();
 }
 
+inline void fs_base::s_static_cp(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(3, 2);
+
+    ARG(exlib::string, 0);
+    ARG(exlib::string, 1);
+    OPT_ARG(v8::Local<v8::Object>, 2, v8::Object::New(isolate->m_isolate));
+
+    if (!cb.IsEmpty())
+        hr = acb_cp(v0, v1, v2, cb, args);
+    else
+        hr = ac_cp(v0, v1, v2);
+
+    METHOD_VOID();
+}
+
 inline void fs_base::s_static_chmod(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     METHOD_ENTER();
@@ -879,6 +907,25 @@ inline void fs_base::s_static_readFile(const v8::FunctionCallbackInfo<v8::Value>
     METHOD_RETURN();
 }
 
+inline void fs_base::s_static_mmap(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<Buffer_base> vr;
+
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(2, 1);
+
+    ARG(exlib::string, 0);
+    OPT_ARG(v8::Local<v8::Object>, 1, v8::Object::New(isolate->m_isolate));
+
+    if (!cb.IsEmpty())
+        hr = acb_mmap(v0, v1, cb, args);
+    else
+        hr = ac_mmap(v0, v1, vr);
+
+    METHOD_RETURN();
+}
+
 inline void fs_base::s_static_readLines(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     v8::Local<v8::Array> vr;
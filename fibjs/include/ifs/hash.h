@@ -49,6 +49,9 @@ public:
 public:
     // hash_base
     static result_t digest(int32_t algo, Buffer_base* data, obj_ptr<Digest_base>& retVal);
+    static result_t hashMany(int32_t algo, v8::Local<v8::Array> data, obj_ptr<NArray>& retVal);
+    static result_t file(exlib::string path, int32_t algo, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac);
+    static result_t fileMany(exlib::string path, v8::Local<v8::Array> algos, obj_ptr<NArray>& retVal, AsyncEvent* ac);
     static result_t md5(Buffer_base* data, obj_ptr<Digest_base>& retVal);
     static result_t sha1(Buffer_base* data, obj_ptr<Digest_base>& retVal);
     static result_t sha224(Buffer_base* data, obj_ptr<Digest_base>& retVal);
@@ -104,6 +107,9 @@ public:
 
 public:
     static void s_static_digest(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_hashMany(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_file(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void s_static_fileMany(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_md5(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_sha1(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_sha224(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -145,6 +151,10 @@ public:
     static void s_static_hmac_blake2b(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_hmac_blake2sp(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void s_static_hmac_blake2bp(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+public:
+    ASYNC_STATICVALUE3(hash_base, file, exlib::string, int32_t, obj_ptr<Buffer_base>);
+    ASYNC_STATICVALUE3(hash_base, fileMany, exlib::string, v8::Local<v8::Array>, obj_ptr<NArray>);
 };
 }
 
@@ -157,6 +167,11 @@ inline ClassInfo& hash_base::class_info()
 {
     static ClassData::ClassMethod s_method[] = {
         { "digest", s_static_digest, true, false },
+        { "hashMany", s_static_hashMany, true, false },
+        { "file", s_static_file, true, true },
+        { "fileSync", s_static_file, true, false },
+        { "fileMany", s_static_fileMany, true, true },
+        { "fileManySync", s_static_fileMany, true, false },
         { "md5", s_static_md5, true, false },
         { "sha1", s_static_sha1, true, false },
         { "sha224", s_static_sha224, true, false },
@@ -250,6 +265,60 @@ inline void hash_base::s_static_digest(const v8::FunctionCallbackInfo<v8::Value>
     METHOD_RETURN();
 }
 
+inline void hash_base::s_static_hashMany(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<NArray> vr;
+
+    METHOD_ENTER();
+
+    METHOD_OVER(2, 2);
+
+    ARG(int32_t, 0);
+    ARG(v8::Local<v8::Array>, 1);
+
+    hr = hashMany(v0, v1, vr);
+
+    METHOD_RETURN();
+}
+
+inline void hash_base::s_static_file(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<Buffer_base> vr;
+
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(2, 2);
+
+    ARG(exlib::string, 0);
+    ARG(int32_t, 1);
+
+    if (!cb.IsEmpty())
+        hr = acb_file(v0, v1, cb, args);
+    else
+        hr = ac_file(v0, v1, vr);
+
+    METHOD_RETURN();
+}
+
+inline void hash_base::s_static_fileMany(const v8::FunctionCallbackInfo<v8::Value>& args)
+{
+    obj_ptr<NArray> vr;
+
+    METHOD_ENTER();
+
+    ASYNC_METHOD_OVER(2, 2);
+
+    ARG(exlib::string, 0);
+    ARG(v8::Local<v8::Array>, 1);
+
+    if (!cb.IsEmpty())
+        hr = acb_fileMany(v0, v1, cb, args);
+    else
+        hr = ac_fileMany(v0, v1, vr);
+
+    METHOD_RETURN();
+}
+
 inline void hash_base::s_static_md5(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     obj_ptr<Digest_base> vr;
@@ -44,6 +44,8 @@ public:
     static result_t set_autoRedirect(bool newVal);
     static result_t get_enableEncoding(bool& retVal);
     static result_t set_enableEncoding(bool newVal);
+    static result_t get_enableHttp2(bool& retVal);
+    static result_t set_enableHttp2(bool newVal);
     static result_t get_maxHeadersCount(int32_t& retVal);
     static result_t set_maxHeadersCount(int32_t newVal);
     static result_t get_maxHeaderSize(int32_t& retVal);
@@ -56,6 +58,9 @@ public:
     static result_t set_poolSize(int32_t newVal);
     static result_t get_poolTimeout(int32_t& retVal);
     static result_t set_poolTimeout(int32_t newVal);
+    static result_t get_poolMaxActive(int32_t& retVal);
+    static result_t set_poolMaxActive(int32_t newVal);
+    static result_t get_poolStats(v8::Local<v8::Object>& retVal);
     static result_t get_http_proxy(exlib::string& retVal);
     static result_t set_http_proxy(exlib::string newVal);
     static result_t get_https_proxy(exlib::string& retVal);
@@ -94,6 +99,8 @@ public:
     static void s_static_set_autoRedirect(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_static_get_enableEncoding(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_static_set_enableEncoding(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_static_get_enableHttp2(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_static_set_enableHttp2(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_static_get_maxHeadersCount(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_static_set_maxHeadersCount(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_static_get_maxHeaderSize(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
@@ -106,6 +113,9 @@ public:
     static void s_static_set_poolSize(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_static_get_poolTimeout(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_static_set_poolTimeout(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_static_get_poolMaxActive(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
+    static void s_static_set_poolMaxActive(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
+    static void s_static_get_poolStats(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_static_get_http_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
     static void s_static_set_http_proxy(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args);
     static void s_static_get_https_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
@@ -189,12 +199,15 @@ inline ClassInfo& http_base::class_info()
         { "enableCookie", s_static_get_enableCookie, s_static_set_enableCookie, true },
         { "autoRedirect", s_static_get_autoRedirect, s_static_set_autoRedirect, true },
         { "enableEncoding", s_static_get_enableEncoding, s_static_set_enableEncoding, true },
+        { "enableHttp2", s_static_get_enableHttp2, s_static_set_enableHttp2, true },
         { "maxHeadersCount", s_static_get_maxHeadersCount, s_static_set_maxHeadersCount, true },
         { "maxHeaderSize", s_static_get_maxHeaderSize, s_static_set_maxHeaderSize, true },
         { "maxBodySize", s_static_get_maxBodySize, s_static_set_maxBodySize, true },
         { "userAgent", s_static_get_userAgent, s_static_set_userAgent, true },
         { "poolSize", s_static_get_poolSize, s_static_set_poolSize, true },
         { "poolTimeout", s_static_get_poolTimeout, s_static_set_poolTimeout, true },
+        { "poolMaxActive", s_static_get_poolMaxActive, s_static_set_poolMaxActive, true },
+        { "poolStats", s_static_get_poolStats, block_set, true },
         { "http_proxy", s_static_get_http_proxy, s_static_set_http_proxy, true },
         { "https_proxy", s_static_get_https_proxy, s_static_set_https_proxy, true }
     };
@@ -316,6 +329,27 @@ inline void http_base::s_static_set_enableEncoding(v8::Local<v8::Name> property,
     PROPERTY_SET_LEAVE();
 }
 
+inline void http_base::s_static_get_enableHttp2(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    bool vr;
+
+    PROPERTY_ENTER();
+
+    hr = get_enableHttp2(vr);
+
+    METHOD_RETURN();
+}
+
+inline void http_base::s_static_set_enableHttp2(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    PROPERTY_ENTER();
+    PROPERTY_VAL(bool);
+
+    hr = set_enableHttp2(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
 inline void http_base::s_static_get_maxHeadersCount(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
 {
     int32_t vr;
@@ -442,6 +476,38 @@ inline void http_base::s_static_set_poolTimeout(v8::Local<v8::Name> property, v8
     PROPERTY_SET_LEAVE();
 }
 
+inline void http_base::s_static_get_poolMaxActive(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    int32_t vr;
+
+    PROPERTY_ENTER();
+
+    hr = get_poolMaxActive(vr);
+
+    METHOD_RETURN();
+}
+
+inline void http_base::s_static_set_poolMaxActive(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void>& args)
+{
+    PROPERTY_ENTER();
+    PROPERTY_VAL(int32_t);
+
+    hr = set_poolMaxActive(v0);
+
+    PROPERTY_SET_LEAVE();
+}
+
+inline void http_base::s_static_get_poolStats(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
+{
+    v8::Local<v8::Object> vr;
+
+    PROPERTY_ENTER();
+
+    hr = get_poolStats(vr);
+
+    METHOD_RETURN();
+}
+
 inline void http_base::s_static_get_http_proxy(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args)
 {
     exlib::string vr;
@@ -33,14 +33,17 @@ public:
 
 public:
     static void s_static_now(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static double s_static_now_fast(v8::Local<v8::Object> receiver, v8::FastApiCallbackOptions& options);
 };
 }
 
 namespace fibjs {
 inline ClassInfo& performance_base::class_info()
 {
+    static const v8::CFunction s_static_now_cfunc = v8::CFunction::Make(s_static_now_fast);
+
     static ClassData::ClassMethod s_method[] = {
-        { "now", s_static_now, true, false }
+        { "now", s_static_now, true, false, &s_static_now_cfunc }
     };
 
     static ClassData s_cd = {
@@ -66,4 +69,15 @@ inline void performance_base::s_static_now(const v8::FunctionCallbackInfo<v8::Va
 
     METHOD_RETURN();
 }
+
+inline double performance_base::s_static_now_fast(v8::Local<v8::Object> receiver, v8::FastApiCallbackOptions& options)
+{
+    double vr;
+
+    FAST_METHOD_ENTER();
+
+    hr = now(vr);
+
+    FAST_METHOD_RETURN();
+}
 }
@@ -16,6 +16,7 @@
 namespace fibjs {
 
 class LruCache_base;
+class SharedCache_base;
 class TextDecoder_base;
 class TextEncoder_base;
 class types_base;
@@ -160,6 +161,7 @@ public:
 }
 
 #include "ifs/LruCache.h"
+#include "ifs/SharedCache.h"
 #include "ifs/TextDecoder.h"
 #include "ifs/TextEncoder.h"
 #include "ifs/types.h"
@@ -231,6 +233,7 @@ inline ClassInfo& util_base::class_info()
 
     static ClassData::ClassObject s_object[] = {
         { "LruCache", LruCache_base::class_info },
+        { "SharedCache", SharedCache_base::class_info },
         { "TextDecoder", TextDecoder_base::class_info },
         { "TextEncoder", TextEncoder_base::class_info },
         { "types", types_base::class_info }
@@ -29,6 +29,8 @@ extern bool g_uv_socket;
 
 extern bool g_track_native_object;
 
+extern int32_t g_buffer_pool_size;
+
 struct OptData {
     const char* name;
     int32_t size;
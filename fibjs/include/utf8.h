@@ -29,6 +29,19 @@ ssize_t utf_convert(const char16_t* src, ssize_t srclen, char* dst, ssize_t dstl
 ssize_t utf_convert(const char* src, ssize_t srclen, char32_t* dst, ssize_t dstlen);
 ssize_t utf_convert(const char32_t* src, ssize_t srclen, char* dst, ssize_t dstlen);
 
+/**
+ * vectorized kernels behind utf_convert, each one handles the blocks at the
+ * head of the source that it can take and returns how many source units it
+ * consumed, the caller converts the rest one code point at a time.
+ * dst must have room for the whole srclen, converted.
+ */
+size_t utf8_ascii_length(const char* src, size_t srclen);
+size_t ascii_to16_block(const char* src, size_t srclen, char16_t* dst);
+size_t utf8_3byte_to16_block(const char* src, size_t srclen, char16_t* dst);
+size_t ascii_to8_block(const char16_t* src, size_t srclen, char* dst);
+size_t utf16_3byte_to8_block(const char16_t* src, size_t srclen, char* dst);
+size_t utf16_to8_length_block(const char16_t* src, size_t srclen, size_t& count);
+
 inline ssize_t utf8_strlen(const char* src, ssize_t srclen)
 {
     if (srclen == -1)
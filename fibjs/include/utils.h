@@ -77,6 +77,7 @@ typedef int32_t SOCKET;
 #include "qstring.h"
 
 #include <v8/include/v8.h>
+#include <v8/include/v8-fast-api-calls.h>
 #include "v8_api.h"
 
 #include "obj_ptr.h"
@@ -335,6 +336,63 @@ enum {
     }                                         \
     THROW_ERROR()
 
+// a fast api call can not throw on older v8, it asks v8 to repeat the call
+// through the regular callback, which then reports the error
+#if V8_MAJOR_VERSION < 12
+#define FAST_METHOD_FALLBACK(hr) options.fallback = true
+#else
+#define FAST_METHOD_FALLBACK(hr)                \
+    do {                                        \
+        v8::HandleScope scope(options.isolate); \
+        ThrowResult(hr);                        \
+    } while (0)
+#endif
+
+#define FAST_METHOD_INSTANCE(cls)                 \
+    cls* pInst = cls::getInstance(receiver);      \
+    if (pInst == NULL) {                          \
+        FAST_METHOD_FALLBACK(CALL_E_NOTINSTANCE); \
+        return {};                                \
+    }
+
+#define FAST_METHOD_ENTER() \
+    result_t hr;
+
+#define FAST_METHOD_RETURN()      \
+    if (hr < 0) {                 \
+        FAST_METHOD_FALLBACK(hr); \
+        return {};                \
+    }                             \
+    return vr;
+
+#define FAST_METHOD_VOID() \
+    if (hr < 0)            \
+        FAST_METHOD_FALLBACK(hr);
+
+// elements of a typed array passed to a fast api call, used in place when v8
+// hands out aligned storage and copied out only when it does not
+template <typename T>
+class FastArrayData {
+public:
+    FastArrayData(const v8::FastApiTypedArray<T>& arr)
+        : m_length(arr.length())
+    {
+        if (!arr.getStorageIfAligned(&m_data)) {
+            m_copy.resize(m_length);
+            for (size_t i = 0; i < m_length; i++)
+                m_copy[i] = arr.get(i);
+            m_data = m_copy.data();
+        }
+    }
+
+public:
+    T* m_data;
+    size_t m_length;
+
+private:
+    std::vector<T> m_copy;
+};
+
 #define CONSTRUCT_RETURN()                                                                                \
     CHECK_ARGUMENT()                                                                                      \
     if (hr >= 0) {                                                                                        \
@@ -323,8 +323,10 @@ class Buffer extends Uint8Array {
                         super(allocPool, offset, byte_length);
 
                     this.write(bufferOrLength, codec);
-                } else
-                    super(encoding.decode(bufferOrLength, codec).buffer);
+                } else {
+                    const buf = encoding.decode(bufferOrLength, codec);
+                    super(buf.buffer, buf.byteOffset, buf.length);
+                }
             }
             else
                 super(bufferOrLength, byte_offset, byte_length);
@@ -1180,33 +1182,10 @@ class Buffer extends Uint8Array {
     }
 
     indexOf(val, byteOffset) {
-        if (typeof val === 'number')
-            return super.indexOf(val, byteOffset);
-
         if (typeof val === 'string')
             val = encoding.decode(val);
 
-        let arrLength = this.length;
-        let valLength = val.length;
-
-        if (byteOffset === undefined)
-            byteOffset = 0;
-
-        let foundIndex = -1;
-        for (let i = byteOffset; i < arrLength; i++) {
-            if (this[i] === val[foundIndex === -1 ? 0 : i - foundIndex]) {
-                if (foundIndex === -1)
-                    foundIndex = i;
-                if (i - foundIndex + 1 === valLength)
-                    return foundIndex;
-            } else {
-                if (foundIndex !== -1)
-                    i -= i - foundIndex;
-                foundIndex = -1;
-            }
-        }
-
-        return -1;
+        return Buffer.native_indexOf(this, val, byteOffset === undefined ? 0 : byteOffset);
     }
 
     equals(otherBuffer) {
@@ -216,6 +216,10 @@ const untar = (function () {
     };
 
     return function (arrayBuffer) {
+        // a Buffer may only be a view into a larger shared store
+        if (ArrayBuffer.isView(arrayBuffer))
+            arrayBuffer = arrayBuffer.buffer.slice(arrayBuffer.byteOffset, arrayBuffer.byteOffset + arrayBuffer.byteLength);
+
         var bstream = new ByteStream(arrayBuffer);
         var localFiles = [];
         // While we don't encounter an empty block, keep making TarLocalFiles.
@@ -450,7 +450,7 @@ function download_module() {
                         t = tgz;
                     tgz = null;
 
-                    const untar_files = untar(t.buffer);
+                    const untar_files = untar(t);
 
                     // most package from registry is archived with root directory `package`
                     archive_root_name = `package`;
@@ -544,7 +544,7 @@ function download_module() {
                     t = tgz;
                 tgz = null;
 
-                const untar_files = untar(t.buffer);
+                const untar_files = untar(t);
                 t = null;
 
                 archive_root_name = path.dirname(untar_files[0].filename);
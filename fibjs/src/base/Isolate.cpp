@@ -339,6 +339,40 @@ void Isolate::Unref(int32_t hr)
     }
 }
 
+void Isolate::dispose()
+{
+    m_disposing = true;
+    m_sem.post();
+}
+
+void Isolate::free_heap()
+{
+    int32_t i;
+
+    Runtime::current()->m_promise_error.Reset();
+
+    m_topSandbox.Release();
+    m_sandboxes.clear();
+    m_httpclient.Release();
+    for (i = 0; i < 3; i++)
+        m_stdio[i].Release();
+    m_channel.Release();
+    m_worker.Release();
+    m_ca.Release();
+    m_buffer_slab.reset();
+
+    STATUS_CODES.Reset();
+    m_AssertionError.Reset();
+    m_env.Reset();
+    m_global_template.Reset();
+    m_context.Reset();
+
+    // a full gc runs the weak callbacks of everything the context held, then the
+    // objects queued by the callbacks are freed while the heap is still there
+    m_isolate->LowMemoryNotification();
+    fb_GCCallback(m_isolate, v8::kGCTypeMarkSweepCompact, v8::kNoGCCallbackFlags);
+}
+
 void Isolate::start_profiler()
 {
     if (g_prof) {
@@ -35,6 +35,8 @@ bool g_uv_socket = false;
 
 bool g_track_native_object = false;
 
+int32_t g_buffer_pool_size = 0;
+
 exlib::string g_exec_code;
 
 #ifdef DEBUG
@@ -59,6 +61,8 @@ static void printHelp()
          "\n"
          "  --use-uv-socket[=on|off]\n"
          "                        use uv as socket backend.\n"
+         "  --buffer-pool-size=n  allocate small native buffers from shared slabs of n bytes (default: 0, disabled).\n"
+         "                        each isolate has its own slab, socket reads use the slab of the reading isolate.\n"
          "\n"
          "  --init                write a package.json file.\n"
          "  --install [opt] foo   install the dependencies in the local node_modules folder.\n"
@@ -122,6 +126,13 @@ void options(int32_t& pos, char* argv[])
         } else if (!qstrcmp(arg, "--use-uv-socket", 15)) {
             g_uv_socket = (arg[15] == 0 || !qstrcmp(arg + 15, "=on"));
             df++;
+        } else if (!qstrcmp(arg, "--buffer-pool-size=", 19)) {
+            g_buffer_pool_size = atoi(arg + 19);
+            if (g_buffer_pool_size < 0)
+                g_buffer_pool_size = 0;
+            else if (g_buffer_pool_size > 64 * 1024)
+                g_buffer_pool_size = 64 * 1024;
+            df++;
         } else if (!qstrcmp(arg, "--prof")) {
             g_prof = true;
             df++;
@@ -7,6 +7,7 @@
 
 #include "object.h"
 #include "Isolate.h"
+#include "utf8.h"
 #include <limits.h>
 
 namespace fibjs {
@@ -89,18 +90,42 @@ private:
 
 inline bool is_safe_string(const char* s, size_t len)
 {
-    const uint64_t* w = (const uint64_t*)s;
-    size_t lenw = len / sizeof(uint64_t);
-
-    for (size_t i = 0; i < lenw; i++)
-        if (w[i] & 0x8080808080808080)
-            return false;
+    return utf8_ascii_length(s, len) == len;
+}
 
-    for (size_t i = lenw * sizeof(uint64_t); i < len; i++)
-        if (s[i] & 0x80)
-            return false;
+static exlib::string latin1to8String(const exlib::string& str)
+{
+    const char* src = str.c_str();
+    size_t len = str.length();
+    size_t pos = utf8_ascii_length(src, len);
+    size_t extra = 0;
+    size_t i;
+
+    if (pos == len)
+        return str;
+
+    for (i = pos; i < len; i++)
+        extra += (unsigned char)src[i] >> 7;
+
+    exlib::string retVal;
+    retVal.resize(len + extra);
+    char* dst = retVal.data();
+
+    memcpy(dst, src, pos);
+    dst += pos;
+
+    for (i = pos; i < len; i++) {
+        unsigned char ch = (unsigned char)src[i];
+
+        if (ch < 0x80)
+            *dst++ = ch;
+        else {
+            *dst++ = (char)(0xc0 | (ch >> 6));
+            *dst++ = (char)(0x80 | (ch & 0x3f));
+        }
+    }
 
-    return true;
+    return retVal;
 }
 
 #define SMALL_STRING 1024
@@ -159,9 +184,25 @@ exlib::string ToString(v8::Isolate* isolate, v8::Local<v8::String> str)
     else if (str->IsExternal())
         return ((ExtStringW*)str->GetExternalStringResource())->str();
 
+    int flags = v8::String::HINT_MANY_WRITES_EXPECTED | v8::String::NO_NULL_TERMINATION;
+    int32_t len = str->Length();
+
+    // one byte strings are latin1, mostly ascii that is already utf8
+    if (str->IsOneByte()) {
+        n.resize(len);
+        str->WriteOneByte(isolate, (uint8_t*)n.data(), 0, len, flags);
+        return latin1to8String(n);
+    }
+
+    // small strings are converted in one pass into the stack
+    if (len < SMALL_STRING) {
+        char buf[SMALL_STRING * 3];
+        int32_t sz = str->WriteUtf8(isolate, buf, sizeof(buf), NULL, flags);
+        return exlib::string(buf, sz);
+    }
+
     int32_t bufUtf8Len = str->Utf8Length(isolate);
     n.resize(bufUtf8Len);
-    int flags = v8::String::HINT_MANY_WRITES_EXPECTED | v8::String::NO_NULL_TERMINATION;
 
     str->WriteUtf8(isolate, n.data(), bufUtf8Len, NULL, flags);
     return n;
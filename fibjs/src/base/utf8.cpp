@@ -326,6 +326,141 @@ inline ssize_t _convert(const T1* src, ssize_t srclen, T2* dst, ssize_t dstlen)
     return count;
 }
 
+template <>
+inline ssize_t _test(const char* src, ssize_t srclen, char16_t* dst)
+{
+    ssize_t count = 0;
+    const char* src_end = src + srclen;
+
+    while (src < src_end) {
+        unsigned char ch = (unsigned char)*src;
+        size_t n;
+
+        if (ch < 0x80) {
+            n = utf8_ascii_length(src, src_end - src);
+            src += n;
+            count += n;
+            continue;
+        }
+
+        if ((ch & 0xf0) == 0xe0) {
+            n = utf8_3byte_to16_block(src, src_end - src, NULL);
+            if (n) {
+                src += n;
+                count += n / 3;
+                continue;
+            }
+        }
+
+        count += _putchar(_getchar(src, src_end), dst, dst);
+    }
+
+    return count;
+}
+
+template <>
+inline ssize_t _convert(const char* src, ssize_t srclen, char16_t* dst, ssize_t dstlen)
+{
+    ssize_t count = 0;
+    const char* src_end = src + srclen;
+    const char16_t* dst_end = dst + dstlen;
+
+    while (src < src_end && dst < dst_end) {
+        unsigned char ch = (unsigned char)*src;
+        size_t len = src_end - src;
+        size_t room = dst_end - dst;
+        size_t n;
+
+        if (ch < 0x80) {
+            n = ascii_to16_block(src, len < room ? len : room, dst);
+            if (n) {
+                src += n;
+                dst += n;
+                count += n;
+                continue;
+            }
+
+            src++;
+            *dst++ = ch;
+            count++;
+            continue;
+        }
+
+        if ((ch & 0xf0) == 0xe0) {
+            n = utf8_3byte_to16_block(src, len < room * 3 ? len : room * 3, dst);
+            if (n) {
+                src += n;
+                dst += n / 3;
+                count += n / 3;
+                continue;
+            }
+        }
+
+        count += _putchar(_getchar(src, src_end), dst, dst_end);
+    }
+
+    return count;
+}
+
+template <>
+inline ssize_t _test(const char16_t* src, ssize_t srclen, char* dst)
+{
+    size_t count = 0;
+    const char16_t* src_end = src + srclen;
+
+    while (src < src_end) {
+        src += utf16_to8_length_block(src, src_end - src, count);
+        if (src < src_end)
+            count += _putchar(_getchar(src, src_end), dst, dst);
+    }
+
+    return count;
+}
+
+template <>
+inline ssize_t _convert(const char16_t* src, ssize_t srclen, char* dst, ssize_t dstlen)
+{
+    ssize_t count = 0;
+    const char16_t* src_end = src + srclen;
+    const char* dst_end = dst + dstlen;
+
+    while (src < src_end && dst < dst_end) {
+        char32_t ch = *src;
+        size_t len = src_end - src;
+        size_t room = dst_end - dst;
+        size_t n;
+
+        if (ch < 0x80) {
+            n = ascii_to8_block(src, len < room ? len : room, dst);
+            if (n) {
+                src += n;
+                dst += n;
+                count += n;
+                continue;
+            }
+
+            src++;
+            *dst++ = (char)ch;
+            count++;
+            continue;
+        }
+
+        if (ch >= 0x800 && (ch & 0xf800) != 0xd800) {
+            n = utf16_3byte_to8_block(src, len < room / 3 ? len : room / 3, dst);
+            if (n) {
+                src += n;
+                dst += n * 3;
+                count += n * 3;
+                continue;
+            }
+        }
+
+        count += _putchar(_getchar(src, src_end), dst, dst_end);
+    }
+
+    return count;
+}
+
 ssize_t utf_convert(const char* src, ssize_t srclen, char16_t* dst, ssize_t dstlen)
 {
     return dst ? _convert(src, srclen, dst, dstlen) : _test(src, srclen, (char16_t*)NULL);
@@ -0,0 +1,303 @@
+/*
+ * utf8_simd.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lion
+ */
+
+#include "utf8.h"
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define UTF8_X86_FAST
+#include <cpuid.h>
+#include <immintrin.h>
+#ifdef __SSE2__
+#define UTF8_SSE2_FAST
+#endif
+#elif defined(__aarch64__)
+#define UTF8_NEON_FAST
+#include <arm_neon.h>
+#endif
+
+namespace fibjs {
+
+#ifdef UTF8_X86_FAST
+
+static bool cpu_has_ssse3()
+{
+    static int32_t s_has = -1;
+
+    if (s_has < 0) {
+        unsigned int a, b, c, d;
+        s_has = __get_cpuid(1, &a, &b, &c, &d) && (c & (1 << 9));
+    }
+
+    return s_has == 1;
+}
+
+// 4 x 3 bytes utf8 -> 4 x utf16
+__attribute__((target("ssse3"))) static size_t utf8_3byte_to16_ssse3(const char* src, size_t srclen, char16_t* dst)
+{
+    const __m128i shuf = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    const __m128i pack = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i form = _mm_set1_epi32(0x00f0c0c0);
+    const __m128i expect = _mm_set1_epi32(0x00e08080);
+    size_t i;
+
+    for (i = 0; i + 16 <= srclen; i += 12) {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + i)), shuf);
+        int32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(v, form), expect));
+
+        if (dst) {
+            __m128i cp = _mm_and_si128(v, _mm_set1_epi32(0x3f));
+            cp = _mm_or_si128(cp, _mm_and_si128(_mm_srli_epi32(v, 2), _mm_set1_epi32(0xfc0)));
+            cp = _mm_or_si128(cp, _mm_and_si128(_mm_srli_epi32(v, 4), _mm_set1_epi32(0xf000)));
+            _mm_storel_epi64((__m128i*)(dst + i / 3), _mm_shuffle_epi8(cp, pack));
+        }
+
+        if (mask != 0xffff)
+            return i + __builtin_ctz(~mask) / 4 * 3;
+    }
+
+    return i;
+}
+
+// 8 x utf16 in U+0800..U+FFFF without surrogates -> 8 x 3 bytes utf8
+__attribute__((target("ssse3"))) static size_t utf16_3byte_to8_ssse3(const char16_t* src, size_t srclen, char* dst)
+{
+    const __m128i m1_0 = _mm_setr_epi8(0, 8, -1, 1, 9, -1, 2, 10, -1, 3, 11, -1, 4, 12, -1, 5);
+    const __m128i m2_0 = _mm_setr_epi8(-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1);
+    const __m128i m1_1 = _mm_setr_epi8(13, -1, 6, 14, -1, 7, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i m2_1 = _mm_setr_epi8(-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i zero = _mm_setzero_si128();
+    size_t i;
+
+    for (i = 0; i + 8 <= srclen; i += 8) {
+        __m128i c = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i bad = _mm_or_si128(_mm_cmpeq_epi16(_mm_subs_epu16(c, _mm_set1_epi16(0x7ff)), zero),
+            _mm_cmpeq_epi16(_mm_and_si128(c, _mm_set1_epi16((short)0xf800)), _mm_set1_epi16((short)0xd800)));
+        int32_t mask = _mm_movemask_epi8(bad);
+
+        __m128i b0 = _mm_or_si128(_mm_srli_epi16(c, 12), _mm_set1_epi16(0xe0));
+        __m128i b1 = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(c, 6), _mm_set1_epi16(0x3f)), _mm_set1_epi16(0x80));
+        __m128i b2 = _mm_or_si128(_mm_and_si128(c, _mm_set1_epi16(0x3f)), _mm_set1_epi16(0x80));
+        __m128i v1 = _mm_packus_epi16(b0, b1);
+        __m128i v2 = _mm_packus_epi16(b2, b2);
+
+        _mm_storeu_si128((__m128i*)(dst + i * 3),
+            _mm_or_si128(_mm_shuffle_epi8(v1, m1_0), _mm_shuffle_epi8(v2, m2_0)));
+        _mm_storel_epi64((__m128i*)(dst + i * 3 + 16),
+            _mm_or_si128(_mm_shuffle_epi8(v1, m1_1), _mm_shuffle_epi8(v2, m2_1)));
+
+        if (mask)
+            return i + __builtin_ctz(mask) / 2;
+    }
+
+    return i;
+}
+
+#endif
+
+size_t utf8_ascii_length(const char* src, size_t srclen)
+{
+    size_t i = 0;
+
+#if defined(UTF8_SSE2_FAST)
+    for (; i + 16 <= srclen; i += 16) {
+        int32_t mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(src + i)));
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+#elif defined(UTF8_NEON_FAST)
+    for (; i + 16 <= srclen; i += 16)
+        if (vmaxvq_u8(vld1q_u8((const uint8_t*)src + i)) >= 0x80)
+            break;
+#endif
+
+    for (; i + 8 <= srclen; i += 8) {
+        uint64_t w;
+
+        memcpy(&w, src + i, sizeof(w));
+        if (w & 0x8080808080808080ull)
+            break;
+    }
+
+    for (; i < srclen; i++)
+        if (src[i] & 0x80)
+            break;
+
+    return i;
+}
+
+size_t ascii_to16_block(const char* src, size_t srclen, char16_t* dst)
+{
+    size_t i = 0;
+
+#if defined(UTF8_SSE2_FAST)
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; i + 16 <= srclen; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        int32_t mask = _mm_movemask_epi8(v);
+
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128((__m128i*)(dst + i + 8), _mm_unpackhi_epi8(v, zero));
+
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+#elif defined(UTF8_NEON_FAST)
+    for (; i + 16 <= srclen; i += 16) {
+        uint8x16x2_t r;
+
+        r.val[0] = vld1q_u8((const uint8_t*)src + i);
+        if (vmaxvq_u8(r.val[0]) >= 0x80)
+            break;
+
+        r.val[1] = vdupq_n_u8(0);
+        vst2q_u8((uint8_t*)(dst + i), r);
+    }
+#endif
+
+    return i;
+}
+
+size_t utf8_3byte_to16_block(const char* src, size_t srclen, char16_t* dst)
+{
+#if defined(UTF8_X86_FAST)
+    if (cpu_has_ssse3())
+        return utf8_3byte_to16_ssse3(src, srclen, dst);
+#elif defined(UTF8_NEON_FAST)
+    const uint8x16_t m_f0 = vdupq_n_u8(0xf0);
+    const uint8x16_t m_c0 = vdupq_n_u8(0xc0);
+    const uint8x16_t m_80 = vdupq_n_u8(0x80);
+    size_t i;
+
+    for (i = 0; i + 48 <= srclen; i += 48) {
+        uint8x16x3_t v = vld3q_u8((const uint8_t*)src + i);
+        uint8x16_t ok = vandq_u8(vceqq_u8(vandq_u8(v.val[0], m_f0), vdupq_n_u8(0xe0)),
+            vandq_u8(vceqq_u8(vandq_u8(v.val[1], m_c0), m_80), vceqq_u8(vandq_u8(v.val[2], m_c0), m_80)));
+
+        if (vminvq_u8(ok) != 0xff)
+            break;
+
+        if (dst) {
+            uint8x16x2_t r;
+
+            r.val[0] = vorrq_u8(vshlq_n_u8(v.val[1], 6), vandq_u8(v.val[2], vdupq_n_u8(0x3f)));
+            r.val[1] = vorrq_u8(vshlq_n_u8(v.val[0], 4), vandq_u8(vshrq_n_u8(v.val[1], 2), vdupq_n_u8(0x0f)));
+            vst2q_u8((uint8_t*)(dst + i / 3), r);
+        }
+    }
+
+    return i;
+#endif
+
+    return 0;
+}
+
+size_t ascii_to8_block(const char16_t* src, size_t srclen, char* dst)
+{
+    size_t i = 0;
+
+#if defined(UTF8_SSE2_FAST)
+    const __m128i high = _mm_set1_epi16((short)0xff80);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; i + 16 <= srclen; i += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(src + i + 8));
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(_mm_or_si128(a, b), high), zero)) != 0xffff)
+            break;
+
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(a, b));
+    }
+#elif defined(UTF8_NEON_FAST)
+    for (; i + 16 <= srclen; i += 16) {
+        uint16x8_t a = vld1q_u16((const uint16_t*)(src + i));
+        uint16x8_t b = vld1q_u16((const uint16_t*)(src + i + 8));
+
+        if (vmaxvq_u16(vmaxq_u16(a, b)) >= 0x80)
+            break;
+
+        vst1q_u8((uint8_t*)dst + i, vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+    }
+#endif
+
+    return i;
+}
+
+size_t utf16_3byte_to8_block(const char16_t* src, size_t srclen, char* dst)
+{
+#if defined(UTF8_X86_FAST)
+    if (cpu_has_ssse3())
+        return utf16_3byte_to8_ssse3(src, srclen, dst);
+#elif defined(UTF8_NEON_FAST)
+    size_t i;
+
+    for (i = 0; i + 16 <= srclen; i += 16) {
+        uint16x8_t a = vld1q_u16((const uint16_t*)(src + i));
+        uint16x8_t b = vld1q_u16((const uint16_t*)(src + i + 8));
+        uint16x8_t ok = vandq_u16(vandq_u16(vcgeq_u16(a, vdupq_n_u16(0x800)), vcgeq_u16(b, vdupq_n_u16(0x800))),
+            vmvnq_u16(vorrq_u16(vceqq_u16(vandq_u16(a, vdupq_n_u16(0xf800)), vdupq_n_u16(0xd800)),
+                vceqq_u16(vandq_u16(b, vdupq_n_u16(0xf800)), vdupq_n_u16(0xd800)))));
+
+        if (vminvq_u16(ok) != 0xffff)
+            break;
+
+        uint8x16x3_t r;
+
+        r.val[0] = vcombine_u8(vmovn_u16(vorrq_u16(vshrq_n_u16(a, 12), vdupq_n_u16(0xe0))),
+            vmovn_u16(vorrq_u16(vshrq_n_u16(b, 12), vdupq_n_u16(0xe0))));
+        r.val[1] = vcombine_u8(vmovn_u16(vorrq_u16(vandq_u16(vshrq_n_u16(a, 6), vdupq_n_u16(0x3f)), vdupq_n_u16(0x80))),
+            vmovn_u16(vorrq_u16(vandq_u16(vshrq_n_u16(b, 6), vdupq_n_u16(0x3f)), vdupq_n_u16(0x80))));
+        r.val[2] = vcombine_u8(vmovn_u16(vorrq_u16(vandq_u16(a, vdupq_n_u16(0x3f)), vdupq_n_u16(0x80))),
+            vmovn_u16(vorrq_u16(vandq_u16(b, vdupq_n_u16(0x3f)), vdupq_n_u16(0x80))));
+
+        vst3q_u8((uint8_t*)dst + i * 3, r);
+    }
+
+    return i;
+#endif
+
+    return 0;
+}
+
+size_t utf16_to8_length_block(const char16_t* src, size_t srclen, size_t& count)
+{
+    size_t i = 0;
+
+#if defined(UTF8_SSE2_FAST)
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; i + 8 <= srclen; i += 8) {
+        __m128i c = _mm_loadu_si128((const __m128i*)(src + i));
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(c, _mm_set1_epi16((short)0xf800)), _mm_set1_epi16((short)0xd800))))
+            break;
+
+        // each unit takes 1 byte, plus one from 0x80 and one more from 0x800
+        int32_t lt80 = __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_subs_epu16(c, _mm_set1_epi16(0x7f)), zero)));
+        int32_t lt800 = __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_subs_epu16(c, _mm_set1_epi16(0x7ff)), zero)));
+
+        count += 24 - (lt80 + lt800) / 2;
+    }
+#elif defined(UTF8_NEON_FAST)
+    for (; i + 8 <= srclen; i += 8) {
+        uint16x8_t c = vld1q_u16((const uint16_t*)(src + i));
+
+        if (vmaxvq_u16(vceqq_u16(vandq_u16(c, vdupq_n_u16(0xf800)), vdupq_n_u16(0xd800))))
+            break;
+
+        uint16x8_t n = vaddq_u16(vshrq_n_u16(vcgeq_u16(c, vdupq_n_u16(0x80)), 15),
+            vshrq_n_u16(vcgeq_u16(c, vdupq_n_u16(0x800)), 15));
+        count += 8 + vaddvq_u16(n);
+    }
+#endif
+
+    return i;
+}
+
+}
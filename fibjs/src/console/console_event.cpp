@@ -36,17 +36,15 @@ result_t event_logger::write(AsyncEvent* ac)
         EVENTLOG_INFORMATION_TYPE,
         EVENTLOG_INFORMATION_TYPE
     };
-    item* p1;
+    for (size_t i = 0; i < m_working; i++) {
+        item& p1 = m_workinglogs[i];
 
-    while ((p1 = m_workinglogs.getHead()) != 0) {
-        if (p1->m_priority != console_base::C_PRINT) {
-            exlib::string str = p1->full(false);
+        if (p1.m_priority != console_base::C_PRINT) {
+            exlib::string str = p1.full(false);
             const char* ptr = str.c_str();
-            ReportEvent(m_event, s_levels[p1->m_priority], 0, 0,
+            ReportEvent(m_event, s_levels[p1.m_priority], 0, 0,
                 NULL, 1, 0, &ptr, NULL);
         }
-
-        delete p1;
     }
 
     return 0;
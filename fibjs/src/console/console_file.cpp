@@ -196,28 +196,24 @@ result_t file_logger::initFile()
 
 result_t file_logger::write(AsyncEvent* ac)
 {
-    item* p1;
+    size_t i = 0;
 
-    while (!m_workinglogs.empty()) {
+    while (i < m_working) {
         exlib::string outBuffer;
         result_t hr;
 
         hr = initFile();
-        if (hr < 0) {
-            while ((p1 = m_workinglogs.getHead()) != 0)
-                delete p1;
-
+        if (hr < 0)
             break;
-        }
 
-        while ((p1 = m_workinglogs.getHead()) != 0) {
-            if (p1->m_priority != console_base::C_PRINT) {
-                outBuffer.append(p1->full());
+        while (i < m_working) {
+            item& p1 = m_workinglogs[i++];
+
+            if (p1.m_priority != console_base::C_PRINT) {
+                outBuffer.append(p1.full());
                 outBuffer.append("\n", 1);
             }
 
-            delete p1;
-
             if (outBuffer.length() > STREAM_BUFF_SIZE)
                 break;
 
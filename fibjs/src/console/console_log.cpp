@@ -20,6 +20,7 @@ public:
     logger_initer()
     {
         s_std = new std_logger;
+        s_std->m_type = "console";
     }
 } s_logger_initer;
 
@@ -146,6 +147,8 @@ result_t console_base::add(v8::Local<v8::Object> cfg)
         return CHECK_ERROR(Runtime::setError("console: Unknown log type."));
 
     if (lgr) {
+        lgr->m_type = *s;
+
         result_t hr = lgr->config(isolate, cfg);
         if (hr < 0) {
             lgr->stop();
@@ -213,4 +216,34 @@ result_t console_base::reset()
 
     return 0;
 }
+
+result_t console_base::stats(v8::Local<v8::Array>& retVal)
+{
+    Isolate* isolate = Isolate::current();
+    v8::Local<v8::Context> context = isolate->context();
+    int32_t i;
+
+    retVal = v8::Array::New(isolate->m_isolate);
+
+    for (i = 0; i < MAX_LOGGER; i++) {
+        logger* lgr = s_logs[i];
+
+        if (!lgr)
+            break;
+
+        v8::Local<v8::Object> o = v8::Object::New(isolate->m_isolate);
+        o->Set(context, isolate->NewString("type", 4), isolate->NewString(lgr->m_type)).IsJust();
+        lgr->stats(isolate, o);
+        retVal->Set(context, i, o).IsJust();
+    }
+
+    if (i == 0) {
+        v8::Local<v8::Object> o = v8::Object::New(isolate->m_isolate);
+        o->Set(context, isolate->NewString("type", 4), isolate->NewString(s_std->m_type)).IsJust();
+        s_std->stats(isolate, o);
+        retVal->Set(context, 0, o).IsJust();
+    }
+
+    return 0;
+}
 }
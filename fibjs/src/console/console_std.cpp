@@ -72,25 +72,22 @@ void std_logger::out(exlib::string& txt, bool is_error)
 
 result_t std_logger::write(AsyncEvent* ac)
 {
-    item* p1;
-
-    while ((p1 = m_workinglogs.getHead()) != 0) {
+    for (size_t i = 0; i < m_working; i++) {
+        item& p1 = m_workinglogs[i];
         exlib::string txt;
 
-        if (p1->m_priority == console_base::C_NOTICE)
-            txt = logger::notice() + p1->m_msg + COLOR_RESET + "\n";
-        else if (p1->m_priority == console_base::C_WARN)
-            txt = logger::warn() + p1->m_msg + COLOR_RESET + "\n";
-        else if (p1->m_priority <= console_base::C_ERROR)
-            txt = logger::error() + p1->m_msg + COLOR_RESET + "\n";
-        else if (p1->m_priority == console_base::C_PRINT)
-            txt = p1->m_msg;
+        if (p1.m_priority == console_base::C_NOTICE)
+            txt = logger::notice() + p1.m_msg + COLOR_RESET + "\n";
+        else if (p1.m_priority == console_base::C_WARN)
+            txt = logger::warn() + p1.m_msg + COLOR_RESET + "\n";
+        else if (p1.m_priority <= console_base::C_ERROR)
+            txt = logger::error() + p1.m_msg + COLOR_RESET + "\n";
+        else if (p1.m_priority == console_base::C_PRINT)
+            txt = p1.m_msg;
         else
-            txt = p1->m_msg + "\n";
-
-        out(txt, p1->m_priority <= console_base::C_WARN);
+            txt = p1.m_msg + "\n";
 
-        delete p1;
+        out(txt, p1.m_priority <= console_base::C_WARN);
     }
     fflush(stdout);
 
@@ -15,13 +15,11 @@ namespace fibjs {
 
 result_t sys_logger::write(AsyncEvent* ac)
 {
-    item* p1;
+    for (size_t i = 0; i < m_working; i++) {
+        item& p1 = m_workinglogs[i];
 
-    while ((p1 = m_workinglogs.getHead()) != 0) {
-        if (p1->m_priority != console_base::C_PRINT)
-            ::syslog(p1->m_priority, "%s", p1->full(false).c_str());
-
-        delete p1;
+        if (p1.m_priority != console_base::C_PRINT)
+            ::syslog(p1.m_priority, "%s", p1.full(false).c_str());
     }
 
     return 0;
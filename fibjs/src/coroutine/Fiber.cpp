@@ -22,53 +22,70 @@ void JSFiber::FiberProcRunJavascript(void* p)
 {
     result_t hr = 0;
     Isolate* isolate = (Isolate*)p;
+    bool last;
 
     {
         Runtime rtForThread(isolate);
         v8::Locker locker(isolate->m_isolate);
         v8::Isolate::Scope isolate_scope(isolate->m_isolate);
 
-        v8::HandleScope handle_scope(isolate->m_isolate);
-        v8::Context::Scope context_scope(isolate->m_context.Get(isolate->m_isolate));
+        {
+            v8::HandleScope handle_scope(isolate->m_isolate);
+            v8::Context::Scope context_scope(isolate->m_context.Get(isolate->m_isolate));
+
+            isolate->m_idleFibers--;
+            while (1) {
+                if (!isolate->m_sem.trywait()) {
+                    isolate->m_idleFibers++;
+                    if (isolate->m_idleFibers > g_spareFibers) {
+                        isolate->m_idleFibers--;
+                        break;
+                    }
+
+                    {
+                        v8::Unlocker unlocker(isolate->m_isolate);
+                        isolate->m_sem.wait();
+                    }
 
-        isolate->m_idleFibers--;
-        while (1) {
-            if (!isolate->m_sem.trywait()) {
-                isolate->m_idleFibers++;
-                if (isolate->m_idleFibers > g_spareFibers) {
                     isolate->m_idleFibers--;
-                    break;
                 }
 
-                {
-                    v8::Unlocker unlocker(isolate->m_isolate);
-                    isolate->m_sem.wait();
+                AsyncEvent* ae = (AsyncEvent*)isolate->m_jobs.getHead();
+                if (ae == NULL) {
+                    // only a disposing isolate wakes a fiber without a job, pass it on and leave
+                    isolate->m_sem.post();
+                    break;
                 }
 
-                isolate->m_idleFibers--;
-            }
-
-            if (isolate->m_idleFibers == 0) {
-                isolate->m_currentFibers++;
-                isolate->m_idleFibers++;
+                if (isolate->m_idleFibers == 0) {
+                    isolate->m_currentFibers++;
+                    isolate->m_idleFibers++;
 
-                exlib::Service::CreateFiber(FiberProcRunJavascript, isolate, stack_size * 1024, "JSFiber");
-            }
+                    exlib::Service::CreateFiber(FiberProcRunJavascript, isolate, stack_size * 1024, "JSFiber");
+                }
 
-            {
-                v8::HandleScope handle_scope(isolate->m_isolate);
-                AsyncEvent* ae = (AsyncEvent*)isolate->m_jobs.getHead();
+                {
+                    v8::HandleScope handle_scope(isolate->m_isolate);
+                    hr = ae->js_invoke();
+                }
 
-                hr = ae->js_invoke();
+                isolate->Unref(hr);
             }
 
-            isolate->Unref(hr);
+            isolate->m_currentFibers--;
         }
 
-        isolate->m_currentFibers--;
+        last = isolate->m_disposing && isolate->m_currentFibers == 0;
+        if (last)
+            isolate->free_heap();
     }
 
     isolate->m_isolate->DiscardThreadSpecificMetadata();
+
+    if (last) {
+        isolate->m_isolate->Dispose();
+        isolate->m_isolate = NULL;
+    }
 }
 
 void JSFiber::set_caller(Fiber_base* caller)
@@ -165,6 +165,48 @@ result_t BlsKey_g2::verify(Buffer_base* data, Buffer_base* sign, v8::Local<v8::O
     return 0;
 }
 
+bool BlsKey_g2::verify_batch(std::vector<BlsKey_g2*>& keys, std::vector<Buffer_base*>& data,
+    std::vector<Buffer_base*>& sigs)
+{
+    std::vector<uint64_t> ctx_buf((blst_pairing_sizeof() + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    blst_pairing* ctx = (blst_pairing*)ctx_buf.data();
+
+    blst_pairing_init(ctx, true, DST_G2_POP, sizeof(DST_G2_POP) - 1);
+
+    for (size_t i = 0; i < keys.size(); i++) {
+        unsigned char k[96];
+        mbedtls_ecp_keypair* ecp = mbedtls_pk_ec(keys[i]->m_key);
+
+        Buffer* buf = Buffer::Cast(data[i]);
+        Buffer* sig = Buffer::Cast(sigs[i]);
+
+        if (sig->length() != 48)
+            return false;
+
+        blst_p2_affine pk;
+        mbedtls_mpi_write_binary(&ecp->Q.X, k, 96);
+        if (blst_p2_uncompress(&pk, k) != BLST_SUCCESS)
+            return false;
+
+        blst_p1_affine point;
+        if (blst_p1_uncompress(&point, sig->data()) != BLST_SUCCESS)
+            return false;
+
+        byte r[8];
+        mbedtls_ctr_drbg_random(&g_ssl.ctr_drbg, r, sizeof(r));
+        r[0] |= 1;
+
+        if (blst_pairing_mul_n_aggregate_pk_in_g2(ctx, &pk, &point, r, 64,
+                buf->data(), buf->length(), NULL, 0)
+            != BLST_SUCCESS)
+            return false;
+    }
+
+    blst_pairing_commit(ctx);
+
+    return blst_pairing_finalverify(ctx, NULL);
+}
+
 result_t BlsKey_g2::computeSecret(ECKey_base* publicKey, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
 {
     if (ac->isSync())
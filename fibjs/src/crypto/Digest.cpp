@@ -12,6 +12,7 @@
 #include "ifs/util.h"
 #include "Digest.h"
 #include "Buffer.h"
+#include "AsyncCall.h"
 #include "encoding.h"
 #include <string.h>
 #include "mbedtls/src/md_wrap.h"
@@ -75,6 +76,57 @@ result_t Digest::update(exlib::string data, exlib::string codec, obj_ptr<Digest_
     return 0;
 }
 
+result_t Digest::updateFromStream(Stream_base* stm, obj_ptr<Digest_base>& retVal, AsyncEvent* ac)
+{
+    class asyncUpdate : public AsyncState {
+    public:
+        asyncUpdate(Digest* pThis, Stream_base* stm, obj_ptr<Digest_base>& retVal, AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_pThis(pThis)
+            , m_stm(stm)
+            , m_retVal(retVal)
+        {
+            next(read);
+        }
+
+        ON_STATE(asyncUpdate, read)
+        {
+            m_buf.Release();
+            return m_stm->read(-1, m_buf, next(update));
+        }
+
+        ON_STATE(asyncUpdate, update)
+        {
+            if (n == CALL_RETURN_NULL) {
+                m_retVal = m_pThis;
+                return next();
+            }
+
+            if (m_pThis->m_iAlgo < 0)
+                return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+            Buffer* buf = Buffer::Cast(m_buf);
+            _md_update(&m_pThis->m_ctx, buf->data(), buf->length());
+
+            return next(read);
+        }
+
+    private:
+        obj_ptr<Digest> m_pThis;
+        obj_ptr<Stream_base> m_stm;
+        obj_ptr<Digest_base>& m_retVal;
+        obj_ptr<Buffer_base> m_buf;
+    };
+
+    if (m_iAlgo < 0)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new asyncUpdate(this, stm, retVal, ac))->post(0);
+}
+
 result_t Digest::digest(obj_ptr<Buffer_base>& retVal)
 {
     if (m_iAlgo < 0)
@@ -10,6 +10,8 @@
 #include "Digest.h"
 #include "Buffer.h"
 #include "md_api.h"
+#include "ssl.h"
+#include "File.h"
 
 namespace fibjs {
 
@@ -61,6 +63,170 @@ result_t hash_base::digest(int32_t algo, Buffer_base* data,
     return 0;
 }
 
+result_t hash_base::hashMany(int32_t algo, v8::Local<v8::Array> data, obj_ptr<NArray>& retVal)
+{
+    if (algo < MBEDTLS_MD_MD5 || algo >= MBEDTLS_MD_MAX)
+        return CHECK_ERROR(CALL_E_INVALIDARG);
+
+    Isolate* isolate = Isolate::current(data);
+    int32_t len = data->Length();
+    std::vector<obj_ptr<Buffer_base>> bufs(len);
+    std::vector<const unsigned char*> input(len);
+    std::vector<size_t> ilen(len);
+    result_t hr;
+    int32_t i;
+
+    for (i = 0; i < len; i++) {
+        hr = GetConfigValue(isolate, data, i, bufs[i]);
+        if (hr < 0)
+            return hr;
+
+        Buffer* buf = Buffer::Cast(bufs[i]);
+        input[i] = buf->data();
+        ilen[i] = buf->length();
+    }
+
+    int32_t size = _md_get_size((mbedtls_md_type_t)algo);
+    std::vector<unsigned char> output(size * len);
+
+    int ret = _md_many((mbedtls_md_type_t)algo, len, input.data(), ilen.data(), output.data());
+    if (ret != 0)
+        return CHECK_ERROR(_ssl::setError(ret));
+
+    obj_ptr<NArray> arr = new NArray();
+
+    arr->resize(len);
+    for (i = 0; i < len; i++)
+        arr->m_array[i] = new Buffer(output.data() + i * size, size);
+
+    retVal = arr;
+
+    return 0;
+}
+
+#define HASH_FILE_BUFF_SIZE (1024 * 1024)
+
+static result_t hash_file(exlib::string path, std::vector<mbedtls_md_type_t>& algos,
+    std::vector<obj_ptr<Buffer_base>>& retVal)
+{
+    std::vector<mbedtls_md_context_t> ctxs(algos.size());
+    int32_t fd;
+    result_t hr;
+    size_t i;
+
+    hr = file_open(path, "r", 0666, fd);
+    if (hr < 0)
+        return hr;
+
+#ifdef __linux__
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    for (i = 0; i < algos.size(); i++) {
+        mbedtls_md_init(&ctxs[i]);
+        _md_setup(&ctxs[i], algos[i], 0);
+        _md_starts(&ctxs[i]);
+    }
+
+    // the file is read in large blocks and fed to every digest in turn,
+    // so each byte is read only once and never reaches the javascript heap
+    std::vector<unsigned char> buf(HASH_FILE_BUFF_SIZE);
+    while (true) {
+        int32_t n = (int32_t)::_read(fd, buf.data(), HASH_FILE_BUFF_SIZE);
+        if (n < 0) {
+            hr = CHECK_ERROR(LastError());
+            break;
+        }
+        if (n == 0)
+            break;
+
+        for (i = 0; i < algos.size(); i++)
+            _md_update(&ctxs[i], buf.data(), n);
+    }
+
+    ::_close(fd);
+
+    if (hr >= 0) {
+        retVal.resize(algos.size());
+        for (i = 0; i < algos.size(); i++) {
+            obj_ptr<Buffer> out = new Buffer(NULL, mbedtls_md_get_size(ctxs[i].md_info));
+            _md_finish(&ctxs[i], out->data());
+            retVal[i] = out;
+        }
+    }
+
+    for (i = 0; i < algos.size(); i++)
+        mbedtls_md_free(&ctxs[i]);
+
+    return hr;
+}
+
+result_t hash_base::file(exlib::string path, int32_t algo, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    if (algo < MBEDTLS_MD_MD5 || algo >= MBEDTLS_MD_MAX)
+        return CHECK_ERROR(CALL_E_INVALIDARG);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    std::vector<mbedtls_md_type_t> algos(1, (mbedtls_md_type_t)algo);
+    std::vector<obj_ptr<Buffer_base>> bufs;
+
+    result_t hr = hash_file(path, algos, bufs);
+    if (hr < 0)
+        return hr;
+
+    retVal = bufs[0];
+
+    return 0;
+}
+
+result_t hash_base::fileMany(exlib::string path, v8::Local<v8::Array> algos, obj_ptr<NArray>& retVal, AsyncEvent* ac)
+{
+    if (ac->isSync()) {
+        Isolate* isolate = Isolate::current(algos);
+        int32_t len = algos->Length();
+        result_t hr;
+
+        ac->m_ctx.resize(len);
+        for (int32_t i = 0; i < len; i++) {
+            int32_t algo;
+
+            hr = GetConfigValue(isolate, algos, i, algo);
+            if (hr < 0)
+                return hr;
+
+            if (algo < MBEDTLS_MD_MD5 || algo >= MBEDTLS_MD_MAX)
+                return CHECK_ERROR(CALL_E_INVALIDARG);
+
+            ac->m_ctx[i] = algo;
+        }
+
+        return CHECK_ERROR(CALL_E_NOSYNC);
+    }
+
+    std::vector<mbedtls_md_type_t> _algos(ac->m_ctx.size());
+    std::vector<obj_ptr<Buffer_base>> bufs;
+    size_t i;
+
+    for (i = 0; i < _algos.size(); i++)
+        _algos[i] = (mbedtls_md_type_t)ac->m_ctx[i].intVal();
+
+    result_t hr = hash_file(path, _algos, bufs);
+    if (hr < 0)
+        return hr;
+
+    obj_ptr<NArray> arr = new NArray();
+
+    arr->resize(bufs.size());
+    for (i = 0; i < bufs.size(); i++)
+        arr->m_array[i] = bufs[i];
+
+    retVal = arr;
+
+    return 0;
+}
+
 result_t hash_base::hmac(int32_t algo, Buffer_base* key, Buffer_base* data,
     obj_ptr<Digest_base>& retVal)
 {
@@ -55,6 +55,14 @@ mbedtls_md_type_t _md_type_from_string(const char* md_name)
     return mbedtls_md_get_type(mi);
 }
 
+int32_t _md_get_size(mbedtls_md_type_t algo)
+{
+    if (algo > MBEDTLS_MD_SM3 && algo < MBEDTLS_MD_MAX)
+        return md_infos[algo - MBEDTLS_MD_SM3 - 1]->info.size;
+
+    return mbedtls_md_get_size(mbedtls_md_info_from_type(algo));
+}
+
 int _md_setup(mbedtls_md_context_t* ctx, mbedtls_md_type_t algo, int hmac)
 {
     if (algo > MBEDTLS_MD_SM3 && algo < MBEDTLS_MD_MAX) {
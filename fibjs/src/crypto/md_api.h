@@ -29,6 +29,7 @@ struct mbedtls_md_info_x {
 };
 
 mbedtls_md_type_t _md_type_from_string(const char* md_name);
+int32_t _md_get_size(mbedtls_md_type_t algo);
 int _md_setup(mbedtls_md_context_t* ctx, mbedtls_md_type_t algo, int hmac);
 int _md_starts(mbedtls_md_context_t* ctx);
 int _md_update(mbedtls_md_context_t* ctx, const unsigned char* input, size_t ilen);
@@ -36,5 +37,7 @@ int _md_finish(mbedtls_md_context_t* ctx, unsigned char* output);
 int _md_hmac_starts(mbedtls_md_context_t* ctx, const unsigned char* key, size_t keylen);
 int _md_hmac_finish(mbedtls_md_context_t* ctx, unsigned char* output);
 int _md_hmac_reset(mbedtls_md_context_t* ctx);
+int _md_many(mbedtls_md_type_t algo, size_t n, const unsigned char* const* input,
+    const size_t* ilen, unsigned char* output);
 
 }
@@ -0,0 +1,412 @@
+/*
+ * md_many.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lion
+ */
+
+#define MBEDTLS_ALLOW_PRIVATE_ACCESS
+
+#include "object.h"
+#include <string.h>
+#include <algorithm>
+#include <mbedtls/mbedtls/sha256.h>
+#include "md_api.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define MD_X86_FAST
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace fibjs {
+
+static const uint32_t s_sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t s_sha256_iv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static const uint32_t s_sha1_iv[5] = {
+    0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0
+};
+
+// the message split into the whole blocks read in place and the padded
+// tail, which takes one or two more blocks
+class md_message {
+public:
+    void init(const unsigned char* input, size_t ilen)
+    {
+        size_t rest = ilen & 63;
+
+        m_input = input;
+        m_full = ilen >> 6;
+
+        memset(m_tail, 0, sizeof(m_tail));
+        memcpy(m_tail, input + (m_full << 6), rest);
+        m_tail[rest] = 0x80;
+
+        m_blocks = m_full + (rest < 56 ? 1 : 2);
+
+        uint64_t bits = (uint64_t)ilen << 3;
+        unsigned char* p = m_tail + ((m_blocks - m_full) << 6) - 8;
+        for (int32_t i = 7; i >= 0; i--, bits >>= 8)
+            p[i] = (unsigned char)bits;
+    }
+
+    const unsigned char* block(size_t i) const
+    {
+        return i < m_full ? m_input + (i << 6) : m_tail + ((i - m_full) << 6);
+    }
+
+public:
+    const unsigned char* m_input;
+    size_t m_full;
+    size_t m_blocks;
+    unsigned char m_tail[128];
+};
+
+static void put_be32(unsigned char* output, const uint32_t* state, int32_t n)
+{
+    for (int32_t i = 0; i < n; i++) {
+        output[i * 4] = (unsigned char)(state[i] >> 24);
+        output[i * 4 + 1] = (unsigned char)(state[i] >> 16);
+        output[i * 4 + 2] = (unsigned char)(state[i] >> 8);
+        output[i * 4 + 3] = (unsigned char)state[i];
+    }
+}
+
+#ifdef MD_X86_FAST
+
+static bool cpu_has_sha_ni()
+{
+    static int32_t s_has = -1;
+
+    if (s_has < 0) {
+        unsigned int a, b, c, d;
+
+        s_has = __get_cpuid_count(7, 0, &a, &b, &c, &d) && (b & (1 << 29))
+            && __get_cpuid(1, &a, &b, &c, &d) && (c & (1 << 19));
+    }
+
+    return s_has == 1;
+}
+
+__attribute__((target("xsave"))) static bool cpu_has_avx2()
+{
+    static int32_t s_has = -1;
+
+    if (s_has < 0) {
+        unsigned int a, b, c, d;
+
+        // AVX2 also needs the OS to save the ymm registers
+        s_has = __get_cpuid(1, &a, &b, &c, &d) && (c & (1 << 27)) && (c & (1 << 28))
+            && ((_xgetbv(0) & 6) == 6)
+            && __get_cpuid_count(7, 0, &a, &b, &c, &d) && (b & (1 << 5));
+    }
+
+    return s_has == 1;
+}
+
+__attribute__((target("sha,sse4.1"))) static void sha256_ni(const md_message& msg, unsigned char* output)
+{
+    const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0, state1, tmp, abef, cdgh, t;
+    __m128i m[4];
+    uint32_t state[8];
+    int32_t i;
+
+    tmp = _mm_loadu_si128((const __m128i*)&s_sha256_iv[0]);
+    state1 = _mm_loadu_si128((const __m128i*)&s_sha256_iv[4]);
+
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for (size_t b = 0; b < msg.m_blocks; b++) {
+        const unsigned char* data = msg.block(b);
+
+        abef = state0;
+        cdgh = state1;
+
+        for (i = 0; i < 4; i++)
+            m[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + i * 16)), MASK);
+
+        for (i = 0; i < 16; i++) {
+            t = _mm_add_epi32(m[i & 3], _mm_loadu_si128((const __m128i*)&s_sha256_k[i * 4]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, t);
+
+            if (i < 12) {
+                tmp = _mm_add_epi32(_mm_sha256msg1_epu32(m[i & 3], m[(i + 1) & 3]),
+                    _mm_alignr_epi8(m[(i + 3) & 3], m[(i + 2) & 3], 4));
+                m[i & 3] = _mm_sha256msg2_epu32(tmp, m[(i + 3) & 3]);
+            }
+
+            t = _mm_shuffle_epi32(t, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, t);
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+    _mm_storeu_si128((__m128i*)&state[0], state0);
+    _mm_storeu_si128((__m128i*)&state[4], state1);
+
+    put_be32(output, state, 8);
+}
+
+__attribute__((target("sha,sse4.1"))) static void sha1_ni(const md_message& msg, unsigned char* output)
+{
+    const __m128i MASK = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    __m128i abcd, e0, e, e_next, abcd_save, e_save;
+    __m128i m[4];
+    uint32_t state[5];
+    int32_t i;
+
+    abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)s_sha1_iv), 0x1B);
+    e0 = _mm_set_epi32(s_sha1_iv[4], 0, 0, 0);
+
+    for (size_t b = 0; b < msg.m_blocks; b++) {
+        const unsigned char* data = msg.block(b);
+
+        abcd_save = abcd;
+        e_save = e0;
+
+        for (i = 0; i < 4; i++)
+            m[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + i * 16)), MASK);
+
+        e = e0;
+        for (i = 0; i < 20; i++) {
+            if (i == 0)
+                e = _mm_add_epi32(e, m[0]);
+            else
+                e = _mm_sha1nexte_epu32(e, m[i & 3]);
+
+            e_next = abcd;
+            switch (i / 5) {
+            case 0:
+                abcd = _mm_sha1rnds4_epu32(abcd, e, 0);
+                break;
+            case 1:
+                abcd = _mm_sha1rnds4_epu32(abcd, e, 1);
+                break;
+            case 2:
+                abcd = _mm_sha1rnds4_epu32(abcd, e, 2);
+                break;
+            default:
+                abcd = _mm_sha1rnds4_epu32(abcd, e, 3);
+                break;
+            }
+            e = e_next;
+
+            if (i < 16)
+                m[i & 3] = _mm_sha1msg2_epu32(
+                    _mm_xor_si128(_mm_sha1msg1_epu32(m[i & 3], m[(i + 1) & 3]), m[(i + 2) & 3]),
+                    m[(i + 3) & 3]);
+        }
+
+        e0 = _mm_sha1nexte_epu32(e, e_save);
+        abcd = _mm_add_epi32(abcd, abcd_save);
+    }
+
+    _mm_storeu_si128((__m128i*)state, _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = (uint32_t)_mm_extract_epi32(e0, 3);
+
+    put_be32(output, state, 5);
+}
+
+#define ROTR8(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+// eight messages of the same block count hashed side by side, one message
+// per 32-bit lane
+__attribute__((target("avx2"))) static void sha256_avx2_x8(const md_message** msg, unsigned char** output)
+{
+    __m256i s[8], v[8], w[16];
+    uint32_t state[8][8];
+    int32_t i, l;
+
+    for (i = 0; i < 8; i++)
+        s[i] = _mm256_set1_epi32(s_sha256_iv[i]);
+
+    for (size_t b = 0; b < msg[0]->m_blocks; b++) {
+        const unsigned char* data[8];
+
+        for (l = 0; l < 8; l++)
+            data[l] = msg[l]->block(b);
+
+        for (i = 0; i < 16; i++) {
+            uint32_t x[8];
+
+            for (l = 0; l < 8; l++) {
+                const unsigned char* p = data[l] + i * 4;
+                x[l] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+            }
+
+            w[i] = _mm256_loadu_si256((const __m256i*)x);
+        }
+
+        for (i = 0; i < 8; i++)
+            v[i] = s[i];
+
+        for (i = 0; i < 64; i++) {
+            __m256i wi;
+
+            if (i < 16)
+                wi = w[i];
+            else {
+                __m256i w15 = w[(i - 15) & 15];
+                __m256i w2 = w[(i - 2) & 15];
+                __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(ROTR8(w15, 7), ROTR8(w15, 18)), _mm256_srli_epi32(w15, 3));
+                __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(ROTR8(w2, 17), ROTR8(w2, 19)), _mm256_srli_epi32(w2, 10));
+
+                wi = _mm256_add_epi32(_mm256_add_epi32(w[i & 15], s0), _mm256_add_epi32(w[(i - 7) & 15], s1));
+                w[i & 15] = wi;
+            }
+
+            __m256i S1 = _mm256_xor_si256(_mm256_xor_si256(ROTR8(v[4], 6), ROTR8(v[4], 11)), ROTR8(v[4], 25));
+            __m256i ch = _mm256_xor_si256(_mm256_and_si256(v[4], v[5]), _mm256_andnot_si256(v[4], v[6]));
+            __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(v[7], S1),
+                _mm256_add_epi32(_mm256_add_epi32(ch, _mm256_set1_epi32(s_sha256_k[i])), wi));
+            __m256i S0 = _mm256_xor_si256(_mm256_xor_si256(ROTR8(v[0], 2), ROTR8(v[0], 13)), ROTR8(v[0], 22));
+            __m256i maj = _mm256_or_si256(_mm256_and_si256(v[0], v[1]), _mm256_and_si256(v[2], _mm256_or_si256(v[0], v[1])));
+            __m256i t2 = _mm256_add_epi32(S0, maj);
+
+            v[7] = v[6];
+            v[6] = v[5];
+            v[5] = v[4];
+            v[4] = _mm256_add_epi32(v[3], t1);
+            v[3] = v[2];
+            v[2] = v[1];
+            v[1] = v[0];
+            v[0] = _mm256_add_epi32(t1, t2);
+        }
+
+        for (i = 0; i < 8; i++)
+            s[i] = _mm256_add_epi32(s[i], v[i]);
+    }
+
+    for (i = 0; i < 8; i++)
+        _mm256_storeu_si256((__m256i*)state[i], s[i]);
+
+    for (l = 0; l < 8; l++) {
+        uint32_t st[8];
+
+        for (i = 0; i < 8; i++)
+            st[i] = state[i][l];
+        put_be32(output[l], st, 8);
+    }
+}
+
+#endif
+
+static bool md_many_fast(mbedtls_md_type_t algo, size_t n, const unsigned char* const* input,
+    const size_t* ilen, unsigned char* output)
+{
+#ifdef MD_X86_FAST
+    size_t i;
+
+    if (algo == MBEDTLS_MD_SHA256 || algo == MBEDTLS_MD_SHA1) {
+        if (cpu_has_sha_ni()) {
+            md_message msg;
+
+            for (i = 0; i < n; i++) {
+                msg.init(input[i], ilen[i]);
+                if (algo == MBEDTLS_MD_SHA256)
+                    sha256_ni(msg, output + i * 32);
+                else
+                    sha1_ni(msg, output + i * 20);
+            }
+
+            return true;
+        }
+
+        if (algo == MBEDTLS_MD_SHA256 && n >= 8 && cpu_has_avx2()) {
+            std::vector<md_message> msgs(n);
+            std::vector<size_t> order(n);
+            const md_message* lanes[8];
+            unsigned char* outs[8];
+            size_t j;
+
+            for (i = 0; i < n; i++) {
+                msgs[i].init(input[i], ilen[i]);
+                order[i] = i;
+            }
+
+            std::stable_sort(order.begin(), order.end(), [&msgs](size_t a, size_t b) {
+                return msgs[a].m_blocks < msgs[b].m_blocks;
+            });
+
+            // runs of eight messages with the same block count go through the
+            // lanes, the leftovers through mbedtls
+            i = 0;
+            while (i < n) {
+                j = i + 1;
+                while (j < n && msgs[order[j]].m_blocks == msgs[order[i]].m_blocks)
+                    j++;
+
+                for (; i + 8 <= j; i += 8) {
+                    for (size_t l = 0; l < 8; l++) {
+                        lanes[l] = &msgs[order[i + l]];
+                        outs[l] = output + order[i + l] * 32;
+                    }
+
+                    sha256_avx2_x8(lanes, outs);
+                }
+
+                for (; i < j; i++)
+                    mbedtls_sha256(input[order[i]], ilen[order[i]], output + order[i] * 32, 0);
+            }
+
+            return true;
+        }
+    }
+#endif
+
+    return false;
+}
+
+int _md_many(mbedtls_md_type_t algo, size_t n, const unsigned char* const* input,
+    const size_t* ilen, unsigned char* output)
+{
+    if (md_many_fast(algo, n, input, ilen, output))
+        return 0;
+
+    mbedtls_md_context_t ctx;
+    int ret;
+
+    mbedtls_md_init(&ctx);
+    ret = _md_setup(&ctx, algo, 0);
+    if (ret != 0)
+        return ret;
+
+    size_t size = ctx.md_info->size;
+    for (size_t i = 0; i < n && ret == 0; i++) {
+        ret = _md_starts(&ctx);
+        if (ret == 0)
+            ret = _md_update(&ctx, input[i], ilen[i]);
+        if (ret == 0)
+            ret = _md_finish(&ctx, output + i * size);
+    }
+
+    mbedtls_md_free(&ctx);
+
+    return ret;
+}
+
+}
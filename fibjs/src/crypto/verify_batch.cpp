@@ -0,0 +1,291 @@
+/*
+ * verify_batch.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "ifs/crypto.h"
+#include "ifs/os.h"
+#include "Buffer.h"
+#include "BlsKey.h"
+#include "AsyncCall.h"
+#include <algorithm>
+
+namespace fibjs {
+
+#define BATCH_MIN_ITEMS 16
+
+class VerifyBatch : public object_base {
+public:
+    class Item {
+    public:
+        Item()
+            : m_result(false)
+            , m_ready(false)
+        {
+        }
+
+    public:
+        result_t verify()
+        {
+            AsyncEvent ac;
+
+            ac.setAsync();
+            ac.m_ctx = m_ctx;
+
+            return m_key->verify(m_data, m_sign, v8::Local<v8::Object>(), m_result, &ac);
+        }
+
+    public:
+        obj_ptr<PKey_base> m_key;
+        obj_ptr<Buffer_base> m_data;
+        obj_ptr<Buffer_base> m_sign;
+        std::vector<Variant> m_ctx;
+        bool m_result;
+        bool m_ready;
+    };
+
+    class Job {
+    public:
+        Job()
+            : m_items(NULL)
+            , m_queue(NULL)
+            , m_begin(0)
+            , m_end(0)
+        {
+        }
+
+    public:
+        std::vector<Item>* m_items;
+        std::vector<size_t>* m_queue;
+        size_t m_begin;
+        size_t m_end;
+        exlib::Event m_ev;
+    };
+
+public:
+    result_t parse(v8::Local<v8::Array> items)
+    {
+        static const char* s_keys[] = {
+            "key", "data", "sign", "opts", NULL
+        };
+
+        Isolate* isolate = Isolate::current(items);
+        int32_t len = items->Length();
+        result_t hr;
+
+        m_items.resize(len);
+        for (int32_t i = 0; i < len; i++) {
+            Item& it = m_items[i];
+            v8::Local<v8::Object> o;
+
+            hr = GetConfigValue(isolate, items, i, o, true);
+            if (hr < 0)
+                return CHECK_ERROR(CALL_E_TYPEMISMATCH);
+
+            hr = CheckConfig(o, s_keys);
+            if (hr < 0)
+                return hr;
+
+            hr = GetConfigValue(isolate, o, "key", it.m_key);
+            if (hr < 0)
+                return CHECK_ERROR(Runtime::setError("crypto: key is required."));
+
+            hr = GetConfigValue(isolate, o, "data", it.m_data);
+            if (hr < 0)
+                return CHECK_ERROR(Runtime::setError("crypto: data is required."));
+
+            hr = GetConfigValue(isolate, o, "sign", it.m_sign);
+            if (hr < 0)
+                return CHECK_ERROR(Runtime::setError("crypto: sign is required."));
+
+            v8::Local<v8::Object> opts;
+            hr = GetConfigValue(isolate, o, "opts", opts);
+            if (hr == CALL_E_PARAMNOTOPTIONAL)
+                opts = v8::Object::New(isolate->m_isolate);
+            else if (hr < 0)
+                return hr;
+
+            // let the key check its options and keep them for the worker
+            AsyncEvent ac;
+            hr = it.m_key->verify(it.m_data, it.m_sign, opts, it.m_result, &ac);
+            if (hr == CALL_E_NOSYNC || hr == CALL_E_LONGSYNC)
+                it.m_ctx = ac.m_ctx;
+            else if (hr >= 0)
+                it.m_ready = true;
+            else
+                return hr;
+        }
+
+        return 0;
+    }
+
+    void verify()
+    {
+        std::vector<BlsKey_g1*> g1_keys;
+        std::vector<Buffer_base*> g1_data;
+        std::vector<Buffer_base*> g1_sigs;
+        std::vector<size_t> g1_items;
+        std::vector<BlsKey_g2*> g2_keys;
+        std::vector<Buffer_base*> g2_data;
+        std::vector<Buffer_base*> g2_sigs;
+        std::vector<size_t> g2_items;
+        std::vector<size_t> queue;
+        size_t i;
+
+        for (i = 0; i < m_items.size(); i++) {
+            Item& it = m_items[i];
+
+            if (it.m_ready)
+                continue;
+
+            BlsKey_g1* g1 = dynamic_cast<BlsKey_g1*>((PKey_base*)it.m_key);
+            if (g1) {
+                g1_keys.push_back(g1);
+                g1_data.push_back(it.m_data);
+                g1_sigs.push_back(it.m_sign);
+                g1_items.push_back(i);
+                continue;
+            }
+
+            BlsKey_g2* g2 = dynamic_cast<BlsKey_g2*>((PKey_base*)it.m_key);
+            if (g2) {
+                g2_keys.push_back(g2);
+                g2_data.push_back(it.m_data);
+                g2_sigs.push_back(it.m_sign);
+                g2_items.push_back(i);
+                continue;
+            }
+
+            queue.push_back(i);
+        }
+
+        // one multi-pairing check for the whole group, only when it fails
+        // do the signatures need to be checked one by one
+        if (g1_items.size() > 1 && BlsKey_g1::verify_batch(g1_keys, g1_data, g1_sigs))
+            set_result(g1_items);
+        else
+            queue.insert(queue.end(), g1_items.begin(), g1_items.end());
+
+        if (g2_items.size() > 1 && BlsKey_g2::verify_batch(g2_keys, g2_data, g2_sigs))
+            set_result(g2_items);
+        else
+            queue.insert(queue.end(), g2_items.begin(), g2_items.end());
+
+        verify_queue(queue);
+    }
+
+    void result(obj_ptr<NArray>& retVal)
+    {
+        obj_ptr<NArray> arr = new NArray();
+
+        arr->resize(m_items.size());
+        for (size_t i = 0; i < m_items.size(); i++)
+            arr->m_array[i] = m_items[i].m_result;
+
+        retVal = arr;
+    }
+
+private:
+    void set_result(std::vector<size_t>& items)
+    {
+        for (size_t i = 0; i < items.size(); i++)
+            m_items[items[i]].m_result = true;
+    }
+
+    void verify_queue(std::vector<size_t>& queue)
+    {
+        if (queue.empty())
+            return;
+
+        // keys cache curve tables on first use, so the items of one key
+        // must stay on the same worker
+        std::stable_sort(queue.begin(), queue.end(), [this](size_t a, size_t b) {
+            return (PKey_base*)m_items[a].m_key < (PKey_base*)m_items[b].m_key;
+        });
+
+        int32_t cpus = 0;
+        os_base::cpuNumbers(cpus);
+
+        size_t worker_count = cpus > 2 ? cpus - 2 : 1;
+        if (worker_count * BATCH_MIN_ITEMS > queue.size())
+            worker_count = queue.size() / BATCH_MIN_ITEMS;
+        if (worker_count < 1)
+            worker_count = 1;
+
+        std::vector<Job> jobs(worker_count);
+        size_t step = queue.size() / worker_count;
+        size_t pos = 0;
+        size_t i;
+
+        for (i = 0; i < worker_count; i++) {
+            size_t end = (i == worker_count - 1) ? queue.size() : pos + step;
+
+            if (end > queue.size())
+                end = queue.size();
+
+            while (end > 0 && end < queue.size()
+                && (PKey_base*)m_items[queue[end]].m_key == (PKey_base*)m_items[queue[end - 1]].m_key)
+                end++;
+
+            jobs[i].m_items = &m_items;
+            jobs[i].m_queue = &queue;
+            jobs[i].m_begin = pos;
+            jobs[i].m_end = end;
+
+            pos = end;
+
+            if (i > 0)
+                asyncCall(verify_job, &jobs[i], CALL_E_LONGSYNC);
+        }
+
+        verify_job(&jobs[0]);
+
+        for (i = 0; i < worker_count; i++)
+            jobs[i].m_ev.wait();
+    }
+
+    static result_t verify_job(Job* job)
+    {
+        for (size_t i = job->m_begin; i < job->m_end; i++) {
+            Item& it = (*job->m_items)[(*job->m_queue)[i]];
+
+            // a malformed signature fails its own item, not the whole batch
+            if (it.verify() < 0)
+                it.m_result = false;
+        }
+
+        job->m_ev.set();
+
+        return 0;
+    }
+
+private:
+    std::vector<Item> m_items;
+};
+
+result_t crypto_base::verifyBatch(v8::Local<v8::Array> items, obj_ptr<NArray>& retVal, AsyncEvent* ac)
+{
+    if (ac->isSync()) {
+        obj_ptr<VerifyBatch> batch = new VerifyBatch();
+
+        result_t hr = batch->parse(items);
+        if (hr < 0)
+            return hr;
+
+        ac->m_ctx.resize(1);
+        ac->m_ctx[0] = batch;
+
+        return CHECK_ERROR(CALL_E_LONGSYNC);
+    }
+
+    VerifyBatch* batch = (VerifyBatch*)ac->m_ctx[0].object();
+
+    batch->verify();
+    batch->result(retVal);
+
+    return 0;
+}
+}
@@ -0,0 +1,474 @@
+/*
+ * Pool.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "object.h"
+#include "Pool.h"
+#include "ifs/db.h"
+#include "Timer.h"
+
+namespace fibjs {
+
+#define DB_POOL_REAP_INTERVAL 1000
+
+static result_t get_opt(Isolate* isolate, v8::Local<v8::Object> opts, const char* key, int32_t& v)
+{
+    result_t hr = GetConfigValue(isolate, opts, key, v, true);
+    if (hr == CALL_E_PARAMNOTOPTIONAL)
+        return 0;
+    return hr;
+}
+
+result_t Pool_base::_new(exlib::string connString, v8::Local<v8::Object> opts,
+    obj_ptr<Pool_base>& retVal, v8::Local<v8::Object> This)
+{
+    Isolate* isolate = Isolate::current(opts);
+    int32_t min = 0;
+    int32_t max = 10;
+    int32_t timeout = 10000;
+    int32_t idle = 60000;
+    int32_t check = 30000;
+    result_t hr;
+
+    hr = get_opt(isolate, opts, "min", min);
+    if (hr < 0)
+        return hr;
+
+    hr = get_opt(isolate, opts, "max", max);
+    if (hr < 0)
+        return hr;
+
+    hr = get_opt(isolate, opts, "timeout", timeout);
+    if (hr < 0)
+        return hr;
+
+    hr = get_opt(isolate, opts, "idle", idle);
+    if (hr < 0)
+        return hr;
+
+    hr = get_opt(isolate, opts, "check", check);
+    if (hr < 0)
+        return hr;
+
+    if (max < 1 || min < 0 || min > max)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    obj_ptr<Pool> pool = new Pool(connString, max);
+
+    pool->m_min = min;
+    pool->m_timeout = timeout;
+    pool->m_idleTimeout = idle;
+    pool->m_check = check;
+
+    hr = pool->open(min);
+    if (hr < 0)
+        return hr;
+
+    retVal = pool;
+    return 0;
+}
+
+result_t Pool::open(int32_t min)
+{
+    date_t d;
+
+    d.now();
+    for (int32_t i = 0; i < min; i++) {
+        Conn c;
+        result_t hr = new_conn(c.conn);
+        if (hr < 0)
+            return hr;
+
+        c.d = d;
+
+        m_lock.lock();
+        m_idle.push_back(c);
+        m_lock.unlock();
+    }
+
+    return 0;
+}
+
+result_t Pool::new_conn(obj_ptr<DbConnection_base>& retVal)
+{
+    obj_ptr<object_base> o;
+    result_t hr;
+
+    m_lock.lock();
+    m_count++;
+    m_lock.unlock();
+
+    hr = db_base::ac_open(m_connString, o);
+    if (hr >= 0) {
+        retVal = DbConnection_base::getInstance(o);
+        if (!retVal)
+            hr = CHECK_ERROR(Runtime::setError("Pool: only sql database is supported."));
+    }
+
+    if (hr < 0) {
+        m_lock.lock();
+        m_count--;
+        m_errors++;
+        m_lock.unlock();
+    }
+
+    return hr;
+}
+
+bool Pool::ping(DbConnection_base* conn)
+{
+    obj_ptr<NArray> retVal;
+    return conn->ac_execute("SELECT 1", retVal) >= 0;
+}
+
+class DbPoolReaper : public Timer {
+public:
+    DbPoolReaper(Pool* pool)
+        : Timer(DB_POOL_REAP_INTERVAL)
+        , m_pool(pool)
+    {
+    }
+
+public:
+    virtual void on_timer()
+    {
+        if (m_pool->reap())
+            (new DbPoolReaper(m_pool))->sleep();
+    }
+
+private:
+    obj_ptr<Pool> m_pool;
+};
+
+bool Pool::reap()
+{
+    std::vector<Conn> drop;
+    size_t n = 0;
+    bool more;
+    date_t d;
+
+    d.now();
+
+    m_lock.lock();
+
+    // m_idle is used as a stack, the longest idle connections are at the front
+    while (n < m_idle.size() && (int32_t)(m_idle.size() - n) > m_min
+        && d.diff(m_idle[n].d) >= m_idleTimeout)
+        n++;
+
+    if (n > 0) {
+        drop.assign(m_idle.begin(), m_idle.begin() + n);
+        m_idle.erase(m_idle.begin(), m_idle.begin() + n);
+        m_count -= (int32_t)n;
+    }
+
+    more = !m_closed && (int32_t)m_idle.size() > m_min;
+    if (!more)
+        m_reaping = false;
+
+    m_lock.unlock();
+
+    for (size_t i = 0; i < drop.size(); i++)
+        drop[i].conn->ac_close();
+
+    return more;
+}
+
+bool Pool::take_conn(DbConnection_base* conn)
+{
+    bool found = false;
+
+    m_lock.lock();
+    for (size_t i = 0; i < m_active.size(); i++)
+        if (m_active[i] == conn) {
+            m_active.erase(m_active.begin() + i);
+            found = true;
+            break;
+        }
+    m_lock.unlock();
+
+    return found;
+}
+
+void Pool::put_conn(DbConnection_base* conn, bool error)
+{
+    bool broken = error && !ping(conn);
+    bool closed = false;
+    bool reap = false;
+
+    m_lock.lock();
+    if (broken) {
+        m_count--;
+        m_errors++;
+    } else if (m_closed) {
+        m_count--;
+        closed = true;
+    } else {
+        Conn c;
+
+        c.conn = conn;
+        c.d.now();
+        m_idle.push_back(c);
+
+        if (!m_reaping && m_idleTimeout > 0 && (int32_t)m_idle.size() > m_min) {
+            m_reaping = true;
+            reap = true;
+        }
+    }
+    m_lock.unlock();
+
+    if (closed)
+        conn->ac_close();
+
+    if (reap)
+        (new DbPoolReaper(this))->sleep();
+
+    m_sem.post();
+}
+
+result_t Pool::get_connString(exlib::string& retVal)
+{
+    retVal = m_connString;
+    return 0;
+}
+
+result_t Pool::get_size(int32_t& retVal)
+{
+    m_lock.lock();
+    retVal = m_count;
+    m_lock.unlock();
+
+    return 0;
+}
+
+result_t Pool::get_stats(v8::Local<v8::Object>& retVal)
+{
+    Isolate* isolate = holder();
+    v8::Local<v8::Context> context = isolate->context();
+    v8::Local<v8::Object> o = v8::Object::New(isolate->m_isolate);
+
+    m_lock.lock();
+    double size = m_count;
+    double idle = (double)m_idle.size();
+    double active = (double)m_active.size();
+    double waiting = m_waiting;
+    double acquires = (double)m_acquires;
+    double timeouts = (double)m_timeouts;
+    double errors = (double)m_errors;
+    double waitTime = m_waitTime;
+    double maxWaitTime = m_maxWaitTime;
+    m_lock.unlock();
+
+    o->Set(context, isolate->NewString("size"), v8::Number::New(isolate->m_isolate, size)).IsJust();
+    o->Set(context, isolate->NewString("idle"), v8::Number::New(isolate->m_isolate, idle)).IsJust();
+    o->Set(context, isolate->NewString("active"), v8::Number::New(isolate->m_isolate, active)).IsJust();
+    o->Set(context, isolate->NewString("waiting"), v8::Number::New(isolate->m_isolate, waiting)).IsJust();
+    o->Set(context, isolate->NewString("acquires"), v8::Number::New(isolate->m_isolate, acquires)).IsJust();
+    o->Set(context, isolate->NewString("timeouts"), v8::Number::New(isolate->m_isolate, timeouts)).IsJust();
+    o->Set(context, isolate->NewString("errors"), v8::Number::New(isolate->m_isolate, errors)).IsJust();
+    o->Set(context, isolate->NewString("waitTime"), v8::Number::New(isolate->m_isolate, waitTime)).IsJust();
+    o->Set(context, isolate->NewString("maxWaitTime"), v8::Number::New(isolate->m_isolate, maxWaitTime)).IsJust();
+
+    retVal = o;
+    return 0;
+}
+
+result_t Pool::check_closed()
+{
+    bool closed;
+
+    m_lock.lock();
+    closed = m_closed;
+    m_lock.unlock();
+
+    if (closed)
+        return CHECK_ERROR(Runtime::setError("Pool: pool is closed."));
+
+    return 0;
+}
+
+result_t Pool::acquire(obj_ptr<DbConnection_base>& retVal)
+{
+    result_t hr = check_closed();
+    if (hr < 0)
+        return hr;
+
+    if (!m_sem.trywait()) {
+        date_t d1, d2;
+        bool terminating;
+        bool ok;
+
+        d1.now();
+
+        m_lock.lock();
+        m_waiting++;
+        m_lock.unlock();
+
+        {
+            Isolate::LeaveJsScope _rt(holder());
+            ok = m_sem.wait(m_timeout);
+            terminating = _rt.is_terminating();
+        }
+
+        d2.now();
+        double w = d2.diff(d1);
+
+        m_lock.lock();
+        m_waiting--;
+        m_waitTime += w;
+        if (w > m_maxWaitTime)
+            m_maxWaitTime = w;
+        if (!ok && !terminating)
+            m_timeouts++;
+        m_lock.unlock();
+
+        if (terminating) {
+            if (ok)
+                m_sem.post();
+            return CALL_E_TIMEOUT;
+        }
+
+        if (!ok)
+            return CHECK_ERROR(Runtime::setError("Pool: timeout waiting for a connection."));
+    }
+
+    // the pool may have been closed while this fiber waited, close() posted its permit
+    hr = check_closed();
+    if (hr < 0)
+        return hr;
+
+    date_t d;
+
+    d.now();
+    while (true) {
+        Conn c;
+
+        m_lock.lock();
+        if (m_idle.empty()) {
+            m_lock.unlock();
+            break;
+        }
+        c = m_idle.back();
+        m_idle.pop_back();
+        m_lock.unlock();
+
+        if (m_check >= 0 && d.diff(c.d) >= m_check && !ping(c.conn)) {
+            m_lock.lock();
+            m_count--;
+            m_errors++;
+            m_lock.unlock();
+            continue;
+        }
+
+        retVal = c.conn;
+        break;
+    }
+
+    if (!retVal) {
+        hr = new_conn(retVal);
+        if (hr < 0) {
+            m_sem.post();
+            return hr;
+        }
+    }
+
+    m_lock.lock();
+    m_active.push_back(retVal);
+    m_acquires++;
+    m_lock.unlock();
+
+    return 0;
+}
+
+result_t Pool::release(DbConnection_base* conn, bool error)
+{
+    obj_ptr<DbConnection_base> _conn = conn;
+
+    if (!take_conn(conn))
+        return CHECK_ERROR(Runtime::setError("Pool: connection does not belong to this pool."));
+
+    put_conn(conn, error);
+    return 0;
+}
+
+result_t Pool::run(v8::Local<v8::Function> func, v8::Local<v8::Value>& retVal)
+{
+    obj_ptr<DbConnection_base> conn;
+    result_t hr;
+
+    hr = acquire(conn);
+    if (hr < 0)
+        return hr;
+
+    v8::Local<v8::Value> v = conn->wrap(holder());
+
+    TryCatch try_catch;
+    retVal = func->Call(func->GetCreationContextChecked(), wrap(), 1, &v).FromMaybe(v8::Local<v8::Value>());
+
+    // func may already have given the connection back by itself
+    if (take_conn(conn))
+        put_conn(conn, try_catch.HasCaught());
+
+    if (try_catch.HasCaught()) {
+        try_catch.ReThrow();
+        return CALL_E_JAVASCRIPT;
+    }
+
+    return 0;
+}
+
+result_t Pool::execute(exlib::string sql, OptArgs args, obj_ptr<NArray>& retVal)
+{
+    obj_ptr<DbConnection_base> conn;
+    result_t hr;
+
+    hr = acquire(conn);
+    if (hr < 0)
+        return hr;
+
+    hr = conn->ac_execute(sql, args, retVal);
+
+    if (take_conn(conn)) {
+        if (hr < 0) {
+            // keep the query error, the health check would replace it
+            exlib::string err = Runtime::errMessage();
+            put_conn(conn, true);
+            Runtime::setError(err);
+        } else
+            put_conn(conn, false);
+    }
+
+    return hr;
+}
+
+result_t Pool::close()
+{
+    std::vector<Conn> idle;
+    int32_t waiting;
+
+    m_lock.lock();
+    if (m_closed) {
+        m_lock.unlock();
+        return 0;
+    }
+
+    m_closed = true;
+
+    idle.swap(m_idle);
+    m_count -= (int32_t)idle.size();
+    waiting = m_waiting;
+    m_lock.unlock();
+
+    for (size_t i = 0; i < idle.size(); i++)
+        idle[i].conn->ac_close();
+
+    // every fiber blocked in acquire gets its own permit and sees the close
+    for (int32_t i = 0; i < waiting; i++)
+        m_sem.post();
+
+    return 0;
+}
+
+} /* namespace fibjs */
@@ -160,6 +160,60 @@ public:
         return execute(str, retVal, ac);
     }
 
+    result_t executeColumns(exlib::string sql, obj_ptr<NObject>& retVal, AsyncEvent* ac)
+    {
+        return CALL_E_INVALID_CALL;
+    }
+
+    result_t executeColumns(exlib::string sql, OptArgs args, obj_ptr<NObject>& retVal,
+        AsyncEvent* ac)
+    {
+        if (!m_conn)
+            return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+        if (ac->isSync()) {
+            exlib::string str;
+            result_t hr = format(sql, args, str);
+            if (hr < 0)
+                return hr;
+
+            ac->m_ctx.resize(1);
+            ac->m_ctx[0] = str;
+
+            return CHECK_ERROR(CALL_E_LONGSYNC);
+        }
+
+        exlib::string str = ac->m_ctx[0].string();
+        return executeColumns(str, retVal, ac);
+    }
+
+    result_t cursor(exlib::string sql, obj_ptr<DbCursor_base>& retVal, AsyncEvent* ac)
+    {
+        return CALL_E_INVALID_CALL;
+    }
+
+    result_t cursor(exlib::string sql, OptArgs args, obj_ptr<DbCursor_base>& retVal,
+        AsyncEvent* ac)
+    {
+        if (!m_conn)
+            return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+        if (ac->isSync()) {
+            exlib::string str;
+            result_t hr = format(sql, args, str);
+            if (hr < 0)
+                return hr;
+
+            ac->m_ctx.resize(1);
+            ac->m_ctx[0] = str;
+
+            return CHECK_ERROR(CALL_E_LONGSYNC);
+        }
+
+        exlib::string str = ac->m_ctx[0].string();
+        return cursor(str, retVal, ac);
+    }
+
     typedef result_t (*formater)(v8::Local<v8::Object> opts, exlib::string& retVal);
 
     result_t execute(formater fmt, v8::Local<v8::Object> opts,
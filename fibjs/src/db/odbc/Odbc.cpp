@@ -11,6 +11,7 @@
 #include "Buffer.h"
 #include "ifs/db.h"
 #include "DBResult.h"
+#include "DBColumns.h"
 #include "Url.h"
 #include "encoding_iconv.h"
 #include <stdio.h>
@@ -225,14 +226,166 @@ result_t odbc_connect(exlib::string connString, const char* driver, int32_t port
         u->m_pathname.length() > 0 ? u->m_pathname.c_str() + 1 : "", conn);
 }
 
-result_t odbc_execute(void* conn, exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent* ac, exlib::string codec)
+static SQLRETURN odbc_value(SQLHSTMT stmt, int32_t i, SQLLEN type, exlib::string& codec, Variant& v)
 {
-    if (!conn)
-        return CHECK_ERROR(CALL_E_INVALID_CALL);
+    SQLRETURN hr = 0;
+    SQLLEN len;
+
+    switch (type) {
+    case SQL_INTEGER:
+    case SQL_SMALLINT:
+    case SQL_TINYINT: {
+        int32_t value = 0;
+        hr = SQLGetData(stmt, i + 1, SQL_C_SLONG, &value, sizeof(value), &len);
+        if (len == SQL_NULL_DATA)
+            v.setNull();
+        else
+            v = value;
+        break;
+    }
+    case SQL_NUMERIC:
+    case SQL_DECIMAL:
+    case SQL_BIGINT:
+    case SQL_FLOAT:
+    case SQL_REAL:
+    case SQL_DOUBLE: {
+        double value;
+        hr = SQLGetData(stmt, i + 1, SQL_C_DOUBLE, &value, sizeof(value), &len);
+        if (len == SQL_NULL_DATA)
+            v.setNull();
+        else
+            v = value;
+        break;
+    }
+    case SQL_DATETIME:
+    case SQL_TIMESTAMP: {
+        TIMESTAMP_STRUCT value;
+        hr = SQLGetData(stmt, i + 1, SQL_C_TIMESTAMP, &value, sizeof(value), &len);
+        if (len == SQL_NULL_DATA)
+            v.setNull();
+        else {
+            date_t d;
+            d.create(value.year, value.month, value.day, value.hour, value.minute,
+                value.second, value.fraction / 1000000);
+            d.toUTC();
+            v = d;
+        }
+        break;
+    }
+    case SQL_BINARY:
+    case SQL_VARBINARY:
+    case SQL_LONGVARBINARY: {
+        exlib::string value;
+        hr = SQLGetData(stmt, i + 1, SQL_C_BINARY, value.data(), 0, &len);
+        if (hr < 0)
+            break;
+        if (len == SQL_NULL_DATA)
+            v.setNull();
+        else {
+            value.resize(len);
+            hr = SQLGetData(stmt, i + 1, SQL_C_BINARY, value.data(), len, &len);
+            if (hr >= 0)
+                v = new Buffer(value.c_str(), value.length());
+        }
+        break;
+    }
+    case SQL_CHAR:
+    case SQL_VARCHAR:
+    case SQL_LONGVARCHAR: {
+        exlib::string value;
+        hr = SQLGetData(stmt, i + 1, SQL_C_CHAR, value.data(), 1, &len);
+        if (hr < 0)
+            break;
+        if (len == SQL_NULL_DATA)
+            v.setNull();
+        else {
+            value.resize(len);
+            hr = SQLGetData(stmt, i + 1, SQL_C_CHAR, value.data(), len + 1, &len);
+            if (hr >= 0) {
+                if (codec == "utf8" || codec == "utf-8") {
+                    v = value;
+                } else {
+                    exlib::string value1;
+                    encoding_iconv(codec).decode(value, value1);
+                    v = value1;
+                }
+            }
+        }
+        break;
+    }
+    case SQL_WCHAR:
+    case SQL_WVARCHAR:
+    case SQL_WLONGVARCHAR:
+    case SQL_SS_VARIANT: {
+        exlib::wstring value;
+        hr = SQLGetData(stmt, i + 1, SQL_C_WCHAR, value.data(), 2, &len);
+        if (hr < 0)
+            break;
+        if (len == SQL_NULL_DATA)
+            v.setNull();
+        else {
+            value.resize(len / 2);
+            hr = SQLGetData(stmt, i + 1, SQL_C_WCHAR, value.data(), len + 2, &len);
+            if (hr >= 0)
+                v = utf16to8String(value);
+        }
+        break;
+    }
+    default: {
+        exlib::string value;
+        hr = SQLGetData(stmt, i + 1, SQL_C_BINARY, value.data(), 0, &len);
+        if (hr < 0)
+            break;
+        if (len == SQL_NULL_DATA)
+            v.setNull();
+        else {
+            value.resize(len);
+            hr = SQLGetData(stmt, i + 1, SQL_C_BINARY, value.data(), len, &len);
+            if (hr >= 0) {
+                if (codec == "utf8" || codec == "utf-8") {
+                    v = value;
+                } else {
+                    exlib::string value1;
+                    encoding_iconv(codec).decode(value, value1);
+                    v = value1;
+                }
+            }
+        }
+        break;
+    }
+    }
 
-    if (ac->isSync())
-        return CHECK_ERROR(CALL_E_LONGSYNC);
+    return hr;
+}
+
+static SQLRETURN odbc_fields(SQLHSTMT stmt, SQLSMALLINT columns, std::vector<SQLLEN>& types,
+    std::vector<exlib::string>& fields)
+{
+    SQLRETURN hr = 0;
+
+    types.resize(columns);
+    fields.resize(columns);
+    for (int32_t i = 0; i < columns; i++) {
+        char buf[SQL_MAX_COLUMN_NAME_LEN];
+        SQLSMALLINT buflen;
+
+        hr = SQLColAttributes(stmt, i + 1, SQL_DESC_NAME, buf, SQL_MAX_COLUMN_NAME_LEN, &buflen, NULL);
+        if (hr < 0)
+            break;
+
+        hr = SQLColAttributes(stmt, i + 1, SQL_DESC_TYPE, NULL, 0, NULL, &types[i]);
+        if (hr < 0)
+            break;
+
+        fields[i].assign(buf, buflen);
+    }
+
+    return hr;
+}
 
+template <typename T>
+static result_t odbc_run(void* conn, exlib::string& sql, std::vector<obj_ptr<T>>& results, exlib::string& codec)
+{
     SQLRETURN hr;
     SQLHSTMT stmt;
 
@@ -253,9 +406,9 @@ result_t odbc_execute(void* conn, exlib::string sql, obj_ptr<NArray>& retVal, As
             break;
 
         do {
-            obj_ptr<DBResult> res;
+            obj_ptr<T> res;
             std::vector<SQLLEN> types;
-            SQLLEN len;
+            std::vector<exlib::string> fields;
             SQLSMALLINT columns = 0;
             SQLLEN affected;
 
@@ -267,25 +420,14 @@ result_t odbc_execute(void* conn, exlib::string sql, obj_ptr<NArray>& retVal, As
             if (hr < 0)
                 break;
 
-            types.resize(columns);
-            res = new DBResult(columns, affected);
-            for (int32_t i = 0; i < columns; i++) {
-                char buf[SQL_MAX_COLUMN_NAME_LEN];
-                SQLSMALLINT buflen;
-
-                hr = SQLColAttributes(stmt, i + 1, SQL_DESC_NAME, buf, SQL_MAX_COLUMN_NAME_LEN, &buflen, NULL);
-                if (hr < 0)
-                    break;
-
-                hr = SQLColAttributes(stmt, i + 1, SQL_DESC_TYPE, NULL, 0, NULL, &types[i]);
-                if (hr < 0)
-                    break;
-
-                res->setField(i, exlib::string(buf, buflen));
-            }
+            hr = odbc_fields(stmt, columns, types, fields);
             if (hr < 0)
                 break;
 
+            res = new T(columns, affected);
+            for (int32_t i = 0; i < columns; i++)
+                res->setField(i, fields[i]);
+
             while (columns > 0) {
                 hr = SQLFetch(stmt);
                 if (hr < 0 || hr == SQL_NO_DATA)
@@ -296,129 +438,7 @@ result_t odbc_execute(void* conn, exlib::string sql, obj_ptr<NArray>& retVal, As
                 for (int32_t i = 0; i < columns; i++) {
                     Variant v;
 
-                    switch (types[i]) {
-                    case SQL_INTEGER:
-                    case SQL_SMALLINT:
-                    case SQL_TINYINT: {
-                        int32_t value = 0;
-                        hr = SQLGetData(stmt, i + 1, SQL_C_SLONG, &value, sizeof(value), &len);
-                        if (len == SQL_NULL_DATA)
-                            v.setNull();
-                        else
-                            v = value;
-                        break;
-                    }
-                    case SQL_NUMERIC:
-                    case SQL_DECIMAL:
-                    case SQL_BIGINT:
-                    case SQL_FLOAT:
-                    case SQL_REAL:
-                    case SQL_DOUBLE: {
-                        double value;
-                        hr = SQLGetData(stmt, i + 1, SQL_C_DOUBLE, &value, sizeof(value), &len);
-                        if (len == SQL_NULL_DATA)
-                            v.setNull();
-                        else
-                            v = value;
-                        break;
-                    }
-                    case SQL_DATETIME:
-                    case SQL_TIMESTAMP: {
-                        TIMESTAMP_STRUCT value;
-                        hr = SQLGetData(stmt, i + 1, SQL_C_TIMESTAMP, &value, sizeof(value), &len);
-                        if (len == SQL_NULL_DATA)
-                            v.setNull();
-                        else {
-                            date_t d;
-                            d.create(value.year, value.month, value.day, value.hour, value.minute,
-                                value.second, value.fraction / 1000000);
-                            d.toUTC();
-                            v = d;
-                        }
-                        break;
-                    }
-                    case SQL_BINARY:
-                    case SQL_VARBINARY:
-                    case SQL_LONGVARBINARY: {
-                        exlib::string value;
-                        hr = SQLGetData(stmt, i + 1, SQL_C_BINARY, value.data(), 0, &len);
-                        if (hr < 0)
-                            break;
-                        if (len == SQL_NULL_DATA)
-                            v.setNull();
-                        else {
-                            value.resize(len);
-                            hr = SQLGetData(stmt, i + 1, SQL_C_BINARY, value.data(), len, &len);
-                            if (hr >= 0)
-                                v = new Buffer(value.c_str(), value.length());
-                        }
-                        break;
-                    }
-                    case SQL_CHAR:
-                    case SQL_VARCHAR:
-                    case SQL_LONGVARCHAR: {
-                        exlib::string value;
-                        hr = SQLGetData(stmt, i + 1, SQL_C_CHAR, value.data(), 1, &len);
-                        if (hr < 0)
-                            break;
-                        if (len == SQL_NULL_DATA)
-                            v.setNull();
-                        else {
-                            value.resize(len);
-                            hr = SQLGetData(stmt, i + 1, SQL_C_CHAR, value.data(), len + 1, &len);
-                            if (hr >= 0) {
-                                if (codec == "utf8" || codec == "utf-8") {
-                                    v = value;
-                                } else {
-                                    exlib::string value1;
-                                    encoding_iconv(codec).decode(value, value1);
-                                    v = value1;
-                                }
-                            }
-                        }
-                        break;
-                    }
-                    case SQL_WCHAR:
-                    case SQL_WVARCHAR:
-                    case SQL_WLONGVARCHAR:
-                    case SQL_SS_VARIANT: {
-                        exlib::wstring value;
-                        hr = SQLGetData(stmt, i + 1, SQL_C_WCHAR, value.data(), 2, &len);
-                        if (hr < 0)
-                            break;
-                        if (len == SQL_NULL_DATA)
-                            v.setNull();
-                        else {
-                            value.resize(len / 2);
-                            hr = SQLGetData(stmt, i + 1, SQL_C_WCHAR, value.data(), len + 2, &len);
-                            if (hr >= 0)
-                                v = utf16to8String(value);
-                        }
-                        break;
-                    }
-                    default: {
-                        exlib::string value;
-                        hr = SQLGetData(stmt, i + 1, SQL_C_BINARY, value.data(), 0, &len);
-                        if (hr < 0)
-                            break;
-                        if (len == SQL_NULL_DATA)
-                            v.setNull();
-                        else {
-                            value.resize(len);
-                            hr = SQLGetData(stmt, i + 1, SQL_C_BINARY, value.data(), len, &len);
-                            if (hr >= 0) {
-                                if (codec == "utf8" || codec == "utf-8") {
-                                    v = value;
-                                } else {
-                                    exlib::string value1;
-                                    encoding_iconv(codec).decode(value, value1);
-                                    v = value1;
-                                }
-                            }
-                        }
-                        break;
-                    }
-                    }
+                    hr = odbc_value(stmt, i, types[i], codec, v);
                     if (hr < 0)
                         break;
 
@@ -433,15 +453,7 @@ result_t odbc_execute(void* conn, exlib::string sql, obj_ptr<NArray>& retVal, As
                 break;
 
             more = SQLMoreResults(stmt) == SQL_SUCCESS;
-
-            if (!more && retVal == NULL) {
-                retVal = res;
-            } else {
-                if (retVal == NULL)
-                    retVal = new NArray();
-
-                retVal->append(res);
-            }
+            results.push_back(res);
         } while (more);
     } while (0);
 
@@ -455,4 +467,223 @@ result_t odbc_execute(void* conn, exlib::string sql, obj_ptr<NArray>& retVal, As
     return hr;
 }
 
+result_t odbc_execute(void* conn, exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent* ac, exlib::string codec)
+{
+    if (!conn)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_LONGSYNC);
+
+    std::vector<obj_ptr<DBResult>> results;
+    result_t hr = odbc_run(conn, sql, results, codec);
+    if (hr < 0)
+        return hr;
+
+    if (results.size() == 1)
+        retVal = results[0];
+    else {
+        retVal = new NArray();
+        for (size_t i = 0; i < results.size(); i++)
+            retVal->append(results[i]);
+    }
+
+    return 0;
+}
+
+result_t odbc_execute_columns(void* conn, exlib::string sql, obj_ptr<NObject>& retVal, AsyncEvent* ac,
+    exlib::string codec)
+{
+    if (!conn)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_LONGSYNC);
+
+    std::vector<obj_ptr<DBColumns>> results;
+    result_t hr = odbc_run(conn, sql, results, codec);
+    if (hr < 0)
+        return hr;
+
+    retVal = results.back();
+
+    return 0;
+}
+
+// fetches the first result set on demand, the statement handle stays open
+// until every row has been read or the cursor is closed
+class OdbcCursor : public DbCursor_base {
+public:
+    OdbcCursor(DbConnection_base* db, void*& conn, SQLHSTMT stmt, exlib::string codec)
+        : m_db(db)
+        , m_conn(conn)
+        , m_stmt(stmt)
+        , m_codec(codec)
+    {
+    }
+
+    ~OdbcCursor()
+    {
+        free_stmt();
+    }
+
+public:
+    virtual bool enterTask(exlib::Task_base* current)
+    {
+        return m_db->enterTask(current);
+    }
+
+    virtual void enter()
+    {
+        m_db->enter();
+    }
+
+    virtual void leave(exlib::Task_base* current = NULL)
+    {
+        m_db->leave(current);
+    }
+
+public:
+    // DbCursor_base
+    virtual result_t next(int32_t count, obj_ptr<NArray>& retVal, AsyncEvent* ac);
+    virtual result_t close(AsyncEvent* ac);
+
+public:
+    void free_stmt()
+    {
+        if (m_stmt) {
+            if (m_conn)
+                SQLFreeStmt(m_stmt, SQL_DROP);
+            m_stmt = NULL;
+        }
+    }
+
+public:
+    std::vector<SQLLEN> m_types;
+    std::vector<exlib::string> m_fields;
+
+private:
+    obj_ptr<DbConnection_base> m_db;
+    void*& m_conn;
+    SQLHSTMT m_stmt;
+    exlib::string m_codec;
+};
+
+result_t odbc_cursor(DbConnection_base* db, void*& conn, exlib::string sql, obj_ptr<DbCursor_base>& retVal,
+    AsyncEvent* ac, exlib::string codec)
+{
+    if (!conn)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_LONGSYNC);
+
+    SQLRETURN hr;
+    SQLHSTMT stmt;
+    SQLSMALLINT columns = 0;
+
+    hr = SQLAllocStmt(conn, &stmt);
+    if (hr < 0)
+        return CHECK_ERROR(Runtime::setError(odbc_error(SQL_HANDLE_DBC, conn)));
+
+    obj_ptr<OdbcCursor> cur = new OdbcCursor(db, conn, stmt, codec);
+
+    if (codec == "utf8" || codec == "utf-8") {
+        hr = SQLExecDirect(stmt, (SQLCHAR*)sql.c_str(), (SQLINTEGER)sql.length());
+    } else {
+        exlib::wstring wsql(utf8to16String(sql));
+        hr = SQLExecDirectW(stmt, (SQLWCHAR*)wsql.c_str(), (SQLINTEGER)wsql.length());
+    }
+
+    if (hr >= 0)
+        hr = SQLNumResultCols(stmt, &columns);
+
+    if (hr >= 0)
+        hr = odbc_fields(stmt, columns, cur->m_types, cur->m_fields);
+
+    if (hr < 0)
+        return CHECK_ERROR(Runtime::setError(odbc_error(SQL_HANDLE_STMT, stmt)));
+
+    if (columns == 0)
+        cur->free_stmt();
+
+    retVal = cur;
+
+    return 0;
+}
+
+result_t OdbcCursor::next(int32_t count, obj_ptr<NArray>& retVal, AsyncEvent* ac)
+{
+    if (!m_conn) {
+        free_stmt();
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+    }
+
+    if (count <= 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_LONGSYNC);
+
+    int32_t columns = (int32_t)m_fields.size();
+    obj_ptr<DBResult> res = new DBResult(columns);
+    SQLRETURN hr = 0;
+    int32_t i;
+
+    for (i = 0; i < columns; i++)
+        res->setField(i, m_fields[i]);
+
+    while (m_stmt && count > 0) {
+        hr = SQLFetch(m_stmt);
+        if (hr < 0)
+            break;
+
+        if (hr == SQL_NO_DATA) {
+            hr = 0;
+            free_stmt();
+            break;
+        }
+
+        res->beginRow();
+
+        for (i = 0; i < columns; i++) {
+            Variant v;
+
+            hr = odbc_value(m_stmt, i, m_types[i], m_codec, v);
+            if (hr < 0)
+                break;
+
+            res->rowValue(i, v);
+        }
+        if (hr < 0)
+            break;
+
+        res->endRow();
+        count--;
+    }
+
+    if (hr < 0) {
+        result_t hr1 = CHECK_ERROR(Runtime::setError(odbc_error(SQL_HANDLE_STMT, m_stmt)));
+        free_stmt();
+        return hr1;
+    }
+
+    retVal = res;
+
+    return 0;
+}
+
+result_t OdbcCursor::close(AsyncEvent* ac)
+{
+    if (!m_stmt)
+        return 0;
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_LONGSYNC);
+
+    free_stmt();
+
+    return 0;
+}
+
 } /* namespace fibjs */
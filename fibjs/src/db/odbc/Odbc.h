@@ -25,6 +25,10 @@ result_t odbc_connect(exlib::string connString, const char* driver, int32_t port
 result_t odbc_disconnect(void* conn);
 result_t odbc_close(void*& conn, AsyncEvent* ac);
 result_t odbc_execute(void* conn, exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent* ac, exlib::string codec);
+result_t odbc_execute_columns(void* conn, exlib::string sql, obj_ptr<NObject>& retVal, AsyncEvent* ac,
+    exlib::string codec);
+result_t odbc_cursor(DbConnection_base* db, void*& conn, exlib::string sql, obj_ptr<DbCursor_base>& retVal,
+    AsyncEvent* ac, exlib::string codec);
 
 class Odbc_tmpl : public Odbc_base {
 public:
@@ -76,6 +80,16 @@ public:
     {
         return odbc_execute(m_conn, sql, retVal, ac, m_codec);
     }
+
+    virtual result_t executeColumns(exlib::string sql, obj_ptr<NObject>& retVal, AsyncEvent* ac)
+    {
+        return odbc_execute_columns(m_conn, sql, retVal, ac, m_codec);
+    }
+
+    virtual result_t cursor(exlib::string sql, obj_ptr<DbCursor_base>& retVal, AsyncEvent* ac)
+    {
+        return odbc_cursor(this, m_conn, sql, retVal, ac, m_codec);
+    }
 };
 
 } /* namespace fibjs */
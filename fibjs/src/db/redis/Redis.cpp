@@ -10,6 +10,7 @@
 #include "ifs/db.h"
 #include "Url.h"
 #include "Buffer.h"
+#include "GatherWriter.h"
 #include "RedisHash.h"
 #include "RedisList.h"
 #include "RedisSet.h"
@@ -65,11 +66,11 @@ result_t Redis::connect(const char* host, int32_t port, AsyncEvent* ac)
 }
 
 #define REDIS_MAX_LINE 1024
-result_t Redis::_command(exlib::string& req, Variant& retVal, AsyncEvent* ac)
+result_t Redis::_command(std::vector<obj_ptr<Buffer>>& req, Variant& retVal, AsyncEvent* ac)
 {
     class asyncCommand : public AsyncState {
     public:
-        asyncCommand(Redis* pThis, exlib::string& req, Variant& retVal, AsyncEvent* ac)
+        asyncCommand(Redis* pThis, std::vector<obj_ptr<Buffer>>& req, Variant& retVal, AsyncEvent* ac)
             : AsyncState(ac)
             , m_pThis(pThis)
             , m_req(req)
@@ -92,8 +93,7 @@ result_t Redis::_command(exlib::string& req, Variant& retVal, AsyncEvent* ac)
 
         ON_STATE(asyncCommand, send)
         {
-            m_buffer = new Buffer(m_req.c_str(), m_req.length());
-            return m_stmBuffered->write(m_buffer, next(read));
+            return stream_writev(m_stmBuffered, m_req, next(read));
         }
 
         ON_STATE(asyncCommand, read)
@@ -264,7 +264,7 @@ result_t Redis::_command(exlib::string& req, Variant& retVal, AsyncEvent* ac)
 
     protected:
         obj_ptr<Redis> m_pThis;
-        exlib::string m_req;
+        std::vector<obj_ptr<Buffer>> m_req;
         Variant& m_retVal;
         Variant m_val;
         obj_ptr<BufferedStream_base> m_stmBuffered;
@@ -9,12 +9,14 @@
 #include "SQLite.h"
 #include "ifs/db.h"
 #include "DBResult.h"
+#include "DBColumns.h"
 #include "Buffer.h"
 #include "ifs/coroutine.h"
 
 namespace fibjs {
 
 #define SQLITE_OPEN_FLAGS SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_SHAREDCACHE | SQLITE_OPEN_NOMUTEX
+#define SQLITE_STMT_CACHE 32
 
 result_t db_base::openSQLite(exlib::string connString,
     obj_ptr<SQLite_base>& retVal, AsyncEvent* ac)
@@ -63,10 +65,45 @@ result_t SQLite::open(const char* file)
 
 SQLite::~SQLite()
 {
+    clear_stmts();
+
     if (m_conn)
         asyncCall(sqlite3_close, (sqlite3*)m_conn);
 }
 
+sqlite3_stmt* SQLite::get_stmt(exlib::string& sql)
+{
+    std::list<std::pair<exlib::string, sqlite3_stmt*>>::iterator it;
+
+    for (it = m_stmts.begin(); it != m_stmts.end(); ++it)
+        if (it->first == sql) {
+            sqlite3_stmt* stmt = it->second;
+            m_stmts.erase(it);
+            return stmt;
+        }
+
+    return NULL;
+}
+
+void SQLite::put_stmt(exlib::string& sql, sqlite3_stmt* stmt)
+{
+    sqlite3_reset(stmt);
+    m_stmts.push_front(std::pair<exlib::string, sqlite3_stmt*>(sql, stmt));
+
+    if (m_stmts.size() > SQLITE_STMT_CACHE) {
+        sqlite3_finalize(m_stmts.back().second);
+        m_stmts.pop_back();
+    }
+}
+
+void SQLite::clear_stmts()
+{
+    while (!m_stmts.empty()) {
+        sqlite3_finalize(m_stmts.back().second);
+        m_stmts.pop_back();
+    }
+}
+
 result_t SQLite::get_type(exlib::string& retVal)
 {
     retVal = "SQLite";
@@ -81,7 +118,9 @@ result_t SQLite::close(AsyncEvent* ac)
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_LONGSYNC);
 
-    sqlite3_close((sqlite3*)m_conn);
+    // a cursor that is still open keeps the handle alive until it is finalized
+    clear_stmts();
+    sqlite3_close_v2((sqlite3*)m_conn);
     m_conn = NULL;
 
     return 0;
@@ -128,14 +167,116 @@ int32_t sqlite3_prepare_sleep(sqlite3* db, const char* zSql, int nByte,
     }
 }
 
-result_t SQLite::execute(exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent* ac)
+inline bool is_blob_type(const char* type)
 {
-    if (!m_conn)
-        return CHECK_ERROR(CALL_E_INVALID_CALL);
+    return type
+        && (!qstricmp(type, "blob", 4)
+            || !qstricmp(type, "tinyblob", 8)
+            || !qstricmp(type, "mediumblob", 10)
+            || !qstricmp(type, "longblob", 8)
+            || !qstricmp(type, "binary", 6)
+            || !qstricmp(type, "varbinary", 9));
+}
 
-    if (ac->isSync())
-        return CHECK_ERROR(CALL_E_LONGSYNC);
+inline bool is_date_type(const char* type)
+{
+    return type
+        && (!qstricmp(type, "datetime")
+            || !qstricmp(type, "timestamp")
+            || !qstricmp(type, "date")
+            || !qstricmp(type, "time"));
+}
+
+static void sqlite_value(sqlite3_stmt* stmt, int32_t i, Variant& v)
+{
+    switch (sqlite3_column_type(stmt, i)) {
+    case SQLITE_NULL:
+        v.setNull();
+        break;
+
+    case SQLITE_INTEGER:
+        v = (double)sqlite3_column_int64(stmt, i);
+        break;
+
+    case SQLITE_FLOAT:
+        v = sqlite3_column_double(stmt, i);
+        break;
+
+    case SQLITE_BLOB: {
+        const char* data = (const char*)sqlite3_column_blob(stmt, i);
+        int32_t size = sqlite3_column_bytes(stmt, i);
+
+        v = new Buffer(data, size);
+        break;
+    }
+
+    default:
+        const char* type = sqlite3_column_decltype(stmt, i);
+        if (is_blob_type(type)) {
+            const char* data = (const char*)sqlite3_column_blob(stmt, i);
+            int32_t size = sqlite3_column_bytes(stmt, i);
+
+            v = new Buffer(data, size);
+        } else if (is_date_type(type)) {
+            const char* data = (const char*)sqlite3_column_text(stmt, i);
+            int32_t size = sqlite3_column_bytes(stmt, i);
+
+            v.parseDate(data, size);
+        } else {
+            const char* data = (const char*)sqlite3_column_text(stmt, i);
+            int32_t size = sqlite3_column_bytes(stmt, i);
+
+            v = exlib::string(data, size);
+        }
+        break;
+    }
+}
 
+inline void sqlite_cell(sqlite3_stmt* stmt, int32_t i, DBResult* res)
+{
+    Variant v;
+
+    sqlite_value(stmt, i, v);
+    res->rowValue(i, v);
+}
+
+inline void sqlite_cell(sqlite3_stmt* stmt, int32_t i, DBColumns* res)
+{
+    switch (sqlite3_column_type(stmt, i)) {
+    case SQLITE_NULL:
+        res->rowNull(i);
+        return;
+
+    case SQLITE_INTEGER:
+        res->rowInt(i, sqlite3_column_int64(stmt, i));
+        return;
+
+    case SQLITE_FLOAT:
+        res->rowDouble(i, sqlite3_column_double(stmt, i));
+        return;
+
+    case SQLITE_TEXT: {
+        const char* type = sqlite3_column_decltype(stmt, i);
+        if (!is_blob_type(type) && !is_date_type(type)) {
+            const char* data = (const char*)sqlite3_column_text(stmt, i);
+            int32_t size = sqlite3_column_bytes(stmt, i);
+
+            res->rowString(i, data, size);
+            return;
+        }
+        break;
+    }
+    }
+
+    Variant v;
+
+    sqlite_value(stmt, i, v);
+    res->rowValue(i, v);
+}
+
+template <typename T>
+result_t SQLite::run(exlib::string& sql, std::vector<obj_ptr<T>>& results)
+{
     const char* pStr = sql.c_str();
     int32_t sLen = (int32_t)sql.length();
     const char* pStr1;
@@ -143,7 +284,9 @@ result_t SQLite::execute(exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent*
     do {
         sqlite3_stmt* stmt = 0;
 
-        if (sqlite3_prepare_sleep((sqlite3*)m_conn, pStr, sLen, &stmt, &pStr1, m_nCmdTimeout)) {
+        if (pStr == sql.c_str() && (stmt = get_stmt(sql)) != NULL)
+            pStr1 = pStr + sLen;
+        else if (sqlite3_prepare_sleep((sqlite3*)m_conn, pStr, sLen, &stmt, &pStr1, m_nCmdTimeout)) {
             result_t hr = CHECK_ERROR(Runtime::setError(sqlite3_errmsg((sqlite3*)m_conn)));
             if (stmt)
                 sqlite3_finalize(stmt);
@@ -155,12 +298,15 @@ result_t SQLite::execute(exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent*
 
         sLen -= (int32_t)(pStr1 - pStr);
 
+        // step before reading the columns, a cached statement is prepared
+        // again by its first step if the schema has changed since
+        int32_t r = sqlite3_step_sleep(stmt, m_nCmdTimeout);
         int32_t columns = sqlite3_column_count(stmt);
-        obj_ptr<DBResult> res;
+        obj_ptr<T> res;
 
         if (columns > 0) {
             int32_t i;
-            res = new DBResult(columns);
+            res = new T(columns);
 
             for (i = 0; i < columns; i++) {
                 exlib::string s = sqlite3_column_name(stmt, i);
@@ -168,67 +314,12 @@ result_t SQLite::execute(exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent*
             }
 
             while (true) {
-                int32_t r = sqlite3_step_sleep(stmt, m_nCmdTimeout);
                 if (r == SQLITE_ROW) {
                     res->beginRow();
-                    for (i = 0; i < columns; i++) {
-                        Variant v;
-
-                        switch (sqlite3_column_type(stmt, i)) {
-                        case SQLITE_NULL:
-                            v.setNull();
-                            break;
-
-                        case SQLITE_INTEGER:
-                            v = (double)sqlite3_column_int64(stmt, i);
-                            break;
-
-                        case SQLITE_FLOAT:
-                            v = sqlite3_column_double(stmt, i);
-                            break;
-
-                        case SQLITE_BLOB: {
-                            const char* data = (const char*)sqlite3_column_blob(stmt, i);
-                            int32_t size = sqlite3_column_bytes(stmt, i);
-
-                            v = new Buffer(data, size);
-                            break;
-                        }
-
-                        default:
-                            const char* type = sqlite3_column_decltype(stmt, i);
-                            if (type
-                                && (!qstricmp(type, "blob", 4)
-                                       || !qstricmp(type, "tinyblob", 8)
-                                       || !qstricmp(type, "mediumblob", 10)
-                                       || !qstricmp(type, "longblob", 8)
-                                       || !qstricmp(type, "binary", 6)
-                                       || !qstricmp(type, "varbinary", 9))) {
-                                const char* data = (const char*)sqlite3_column_blob(stmt, i);
-                                int32_t size = sqlite3_column_bytes(stmt, i);
-
-                                v = new Buffer(data, size);
-                            } else if (type
-                                && (!qstricmp(type, "datetime")
-                                       || !qstricmp(type, "timestamp")
-                                       || !qstricmp(type, "date")
-                                       || !qstricmp(type, "time"))) {
-                                const char* data = (const char*)sqlite3_column_text(stmt, i);
-                                int32_t size = sqlite3_column_bytes(stmt, i);
-
-                                v.parseDate(data, size);
-                            } else {
-                                const char* data = (const char*)sqlite3_column_text(stmt, i);
-                                int32_t size = sqlite3_column_bytes(stmt, i);
-
-                                v = exlib::string(data, size);
-                            }
-                            break;
-                        }
-
-                        res->rowValue(i, v);
-                    }
+                    for (i = 0; i < columns; i++)
+                        sqlite_cell(stmt, i, res);
                     res->endRow();
+                    r = sqlite3_step_sleep(stmt, m_nCmdTimeout);
                 } else if (r == SQLITE_DONE)
                     break;
                 else {
@@ -237,9 +328,8 @@ result_t SQLite::execute(exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent*
                 }
             }
         } else {
-            int32_t r = sqlite3_step_sleep(stmt, m_nCmdTimeout);
             if (r == SQLITE_DONE)
-                res = new DBResult(0, sqlite3_changes((sqlite3*)m_conn),
+                res = new T(0, sqlite3_changes((sqlite3*)m_conn),
                     sqlite3_last_insert_rowid((sqlite3*)m_conn));
             else {
                 sqlite3_finalize(stmt);
@@ -247,24 +337,194 @@ result_t SQLite::execute(exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent*
             }
         }
 
-        sqlite3_finalize(stmt);
-
         while (qisspace(*pStr1)) {
             pStr1++;
             sLen--;
         }
 
-        if (!*pStr1 && retVal == NULL) {
-            retVal = res;
-        } else {
-            if (retVal == NULL)
-                retVal = new NArray();
+        if (pStr == sql.c_str() && !*pStr1)
+            put_stmt(sql, stmt);
+        else
+            sqlite3_finalize(stmt);
+
+        results.push_back(res);
+        pStr = pStr1;
+    } while (*pStr1);
 
-            retVal->append(res);
+    return 0;
+}
 
-            pStr = pStr1;
+result_t SQLite::execute(exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent* ac)
+{
+    if (!m_conn)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_LONGSYNC);
+
+    std::vector<obj_ptr<DBResult>> results;
+    result_t hr = run(sql, results);
+    if (hr < 0)
+        return hr;
+
+    if (results.size() == 1)
+        retVal = results[0];
+    else {
+        retVal = new NArray();
+        for (size_t i = 0; i < results.size(); i++)
+            retVal->append(results[i]);
+    }
+
+    return 0;
+}
+
+result_t SQLite::executeColumns(exlib::string sql, obj_ptr<NObject>& retVal, AsyncEvent* ac)
+{
+    if (!m_conn)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_LONGSYNC);
+
+    std::vector<obj_ptr<DBColumns>> results;
+    result_t hr = run(sql, results);
+    if (hr < 0)
+        return hr;
+
+    retVal = results.back();
+
+    return 0;
+}
+
+result_t SQLite::cursor(exlib::string sql, obj_ptr<DbCursor_base>& retVal, AsyncEvent* ac)
+{
+    if (!m_conn)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_LONGSYNC);
+
+    sqlite3_stmt* stmt = 0;
+    const char* pStr1;
+
+    if (sqlite3_prepare_sleep((sqlite3*)m_conn, sql.c_str(), (int32_t)sql.length(),
+            &stmt, &pStr1, m_nCmdTimeout)) {
+        result_t hr = CHECK_ERROR(Runtime::setError(sqlite3_errmsg((sqlite3*)m_conn)));
+        if (stmt)
+            sqlite3_finalize(stmt);
+        return hr;
+    }
+
+    if (!stmt)
+        return CHECK_ERROR(Runtime::setError("SQLite: Query was empty"));
+
+    while (qisspace(*pStr1))
+        pStr1++;
+
+    if (*pStr1) {
+        sqlite3_finalize(stmt);
+        return CHECK_ERROR(Runtime::setError("SQLite: cursor only accepts a single statement"));
+    }
+
+    int32_t r = sqlite3_step_sleep(stmt, m_nCmdTimeout);
+    if (r != SQLITE_ROW && r != SQLITE_DONE) {
+        result_t hr = CHECK_ERROR(Runtime::setError(sqlite3_errmsg((sqlite3*)m_conn)));
+        sqlite3_finalize(stmt);
+        return hr;
+    }
+
+    retVal = new SQLiteCursor(this, stmt, r);
+
+    return 0;
+}
+
+SQLiteCursor::SQLiteCursor(SQLite* db, sqlite3_stmt* stmt, int32_t r)
+    : m_db(db)
+    , m_stmt(stmt)
+    , m_r(r)
+{
+    int32_t columns = sqlite3_column_count(stmt);
+
+    m_fields.resize(columns);
+    for (int32_t i = 0; i < columns; i++)
+        m_fields[i] = sqlite3_column_name(stmt, i);
+
+    if (m_r == SQLITE_DONE)
+        finalize();
+}
+
+SQLiteCursor::~SQLiteCursor()
+{
+    finalize();
+}
+
+void SQLiteCursor::finalize()
+{
+    if (m_stmt) {
+        sqlite3_finalize(m_stmt);
+        m_stmt = NULL;
+    }
+}
+
+result_t SQLiteCursor::next(int32_t count, obj_ptr<NArray>& retVal, AsyncEvent* ac)
+{
+    if (!m_db->m_conn) {
+        finalize();
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+    }
+
+    if (count <= 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_LONGSYNC);
+
+    int32_t columns = (int32_t)m_fields.size();
+    obj_ptr<DBResult> res = new DBResult(columns);
+    int32_t i;
+
+    for (i = 0; i < columns; i++)
+        res->setField(i, m_fields[i]);
+
+    while (m_stmt && count > 0) {
+        if (m_r == SQLITE_ROW) {
+            res->beginRow();
+            for (i = 0; i < columns; i++) {
+                Variant v;
+
+                sqlite_value(m_stmt, i, v);
+                res->rowValue(i, v);
+            }
+            res->endRow();
+            count--;
+
+            m_r = sqlite3_step_sleep(m_stmt, m_db->m_nCmdTimeout);
+        } else if (m_r == SQLITE_DONE)
+            finalize();
+        else {
+            result_t hr = CHECK_ERROR(Runtime::setError(sqlite3_errmsg((sqlite3*)m_db->m_conn)));
+            finalize();
+            return hr;
         }
-    } while (*pStr1);
+    }
+
+    if (m_r == SQLITE_DONE)
+        finalize();
+
+    retVal = res;
+
+    return 0;
+}
+
+result_t SQLiteCursor::close(AsyncEvent* ac)
+{
+    if (!m_stmt)
+        return 0;
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_LONGSYNC);
+
+    finalize();
 
     return 0;
 }
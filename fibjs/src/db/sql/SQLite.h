@@ -8,8 +8,10 @@
 #pragma once
 
 #include "ifs/SQLite.h"
+#include "ifs/DbCursor.h"
 #include <sqlite/sqlite3.h>
 #include "../db_tmpl.h"
+#include <list>
 
 namespace fibjs {
 
@@ -27,6 +29,8 @@ public:
     virtual result_t get_type(exlib::string& retVal);
     virtual result_t close(AsyncEvent* ac);
     virtual result_t execute(exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent* ac);
+    virtual result_t executeColumns(exlib::string sql, obj_ptr<NObject>& retVal, AsyncEvent* ac);
+    virtual result_t cursor(exlib::string sql, obj_ptr<DbCursor_base>& retVal, AsyncEvent* ac);
 
 public:
     // SQLite_base
@@ -39,9 +43,61 @@ public:
     result_t open(const char* file);
     int vec_init();
 
+private:
+    // runs every statement in sql and collects a result of type T for each
+    template <typename T>
+    result_t run(exlib::string& sql, std::vector<obj_ptr<T>>& results);
+
+    // prepared statements of recently executed single-statement sql, so a
+    // connection that runs the same sql again skips sqlite3_prepare
+    sqlite3_stmt* get_stmt(exlib::string& sql);
+    void put_stmt(exlib::string& sql, sqlite3_stmt* stmt);
+    void clear_stmts();
+
+    friend class SQLiteCursor;
+
 private:
     exlib::string m_file;
     int32_t m_nCmdTimeout;
+    std::list<std::pair<exlib::string, sqlite3_stmt*>> m_stmts;
+};
+
+// steps the statement on demand, each next reads at most count rows, so the
+// rows that have not been asked for stay in the database
+class SQLiteCursor : public DbCursor_base {
+public:
+    SQLiteCursor(SQLite* db, sqlite3_stmt* stmt, int32_t r);
+    ~SQLiteCursor();
+
+public:
+    virtual bool enterTask(exlib::Task_base* current)
+    {
+        return m_db->enterTask(current);
+    }
+
+    virtual void enter()
+    {
+        m_db->enter();
+    }
+
+    virtual void leave(exlib::Task_base* current = NULL)
+    {
+        m_db->leave(current);
+    }
+
+public:
+    // DbCursor_base
+    virtual result_t next(int32_t count, obj_ptr<NArray>& retVal, AsyncEvent* ac);
+    virtual result_t close(AsyncEvent* ac);
+
+private:
+    void finalize();
+
+private:
+    obj_ptr<SQLite> m_db;
+    sqlite3_stmt* m_stmt;
+    int32_t m_r;
+    std::vector<exlib::string> m_fields;
 };
 
 } /* namespace fibjs */
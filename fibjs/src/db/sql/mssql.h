@@ -40,6 +40,16 @@ public:
         return odbc_execute(m_conn, sql, retVal, ac, m_codec);
     }
 
+    virtual result_t executeColumns(exlib::string sql, obj_ptr<NObject>& retVal, AsyncEvent* ac)
+    {
+        return odbc_execute_columns(m_conn, sql, retVal, ac, m_codec);
+    }
+
+    virtual result_t cursor(exlib::string sql, obj_ptr<DbCursor_base>& retVal, AsyncEvent* ac)
+    {
+        return odbc_cursor(this, m_conn, sql, retVal, ac, m_codec);
+    }
+
     virtual result_t begin(exlib::string point, AsyncEvent* ac)
     {
         if (!m_conn)
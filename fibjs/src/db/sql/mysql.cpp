@@ -11,10 +11,205 @@
 #include "Buffer.h"
 #include "ifs/db.h"
 #include "DBResult.h"
+#include "DBColumns.h"
 #include "Url.h"
+#include <deque>
 
 namespace fibjs {
 
+// rows of a cursor query are handed from the fiber reading the protocol to
+// the fiber calling next, the reading fiber stops once two batches are queued
+class mysql_stream : public obj_base {
+public:
+    mysql_stream(mysql* db, exlib::string sql)
+        : m_db(db)
+        , m_sql(sql)
+        , m_batch(1000)
+        , m_done(false)
+        , m_closed(false)
+        , m_hr(0)
+    {
+    }
+
+public:
+    void push(DBResult* res)
+    {
+        m_lock.lock();
+        if (!m_closed)
+            m_rows.insert(m_rows.end(), res->m_array.begin(), res->m_array.end());
+        res->m_array.clear();
+
+        while (m_rows.size() >= m_batch) {
+            bool full = m_rows.size() >= m_batch * 2;
+
+            if (full)
+                m_writable.reset();
+            m_lock.unlock();
+
+            m_readable.set();
+            if (!full)
+                return;
+
+            m_writable.wait();
+            m_lock.lock();
+        }
+        m_lock.unlock();
+    }
+
+    void finish(result_t hr)
+    {
+        m_lock.lock();
+        m_done = true;
+        m_hr = hr;
+        if (hr == CALL_E_EXCEPTION)
+            m_error = Runtime::errMessage();
+        m_lock.unlock();
+
+        m_readable.set();
+        m_finished.set();
+    }
+
+    result_t wait(size_t count)
+    {
+        while (!m_done && m_rows.size() < count) {
+            m_readable.reset();
+            m_lock.unlock();
+
+            m_writable.set();
+            m_readable.wait();
+            m_lock.lock();
+        }
+
+        if (m_rows.empty() && m_hr < 0) {
+            if (m_hr == CALL_E_EXCEPTION)
+                return CHECK_ERROR(Runtime::setError(m_error));
+            return CHECK_ERROR(m_hr);
+        }
+
+        return 0;
+    }
+
+    result_t open()
+    {
+        m_lock.lock();
+        result_t hr = wait(1);
+        m_lock.unlock();
+
+        return hr;
+    }
+
+    result_t read(int32_t count, obj_ptr<NArray>& retVal)
+    {
+        obj_ptr<DBResult> res = new DBResult(0);
+
+        m_lock.lock();
+        m_batch = count;
+
+        result_t hr = wait(count);
+        if (hr >= 0)
+            while (count-- > 0 && !m_rows.empty()) {
+                res->append(m_rows.front());
+                m_rows.pop_front();
+            }
+        m_lock.unlock();
+
+        m_writable.set();
+
+        if (hr < 0)
+            return hr;
+
+        retVal = res;
+        return 0;
+    }
+
+    void close(bool wait)
+    {
+        m_lock.lock();
+        m_closed = true;
+        m_rows.clear();
+        m_lock.unlock();
+
+        m_writable.set();
+        if (wait)
+            m_finished.wait();
+    }
+
+public:
+    obj_ptr<mysql> m_db;
+    exlib::string m_sql;
+
+private:
+    exlib::spinlock m_lock;
+    std::deque<Variant> m_rows;
+    exlib::Event m_readable;
+    exlib::Event m_writable;
+    exlib::Event m_finished;
+    size_t m_batch;
+    bool m_done;
+    bool m_closed;
+    result_t m_hr;
+    exlib::string m_error;
+};
+
+class mysql_cursor : public DbCursor_base {
+public:
+    mysql_cursor(mysql_stream* stream)
+        : m_db(stream->m_db)
+        , m_stream(stream)
+    {
+    }
+
+    ~mysql_cursor()
+    {
+        m_stream->close(false);
+    }
+
+public:
+    virtual bool enterTask(exlib::Task_base* current)
+    {
+        return m_db->enterTask(current);
+    }
+
+    virtual void enter()
+    {
+        m_db->enter();
+    }
+
+    virtual void leave(exlib::Task_base* current = NULL)
+    {
+        m_db->leave(current);
+    }
+
+public:
+    // DbCursor_base
+    virtual result_t next(int32_t count, obj_ptr<NArray>& retVal, AsyncEvent* ac)
+    {
+        if (count <= 0)
+            return CHECK_ERROR(CALL_E_OUTRANGE);
+
+        if (ac->isSync())
+            return CHECK_ERROR(CALL_E_LONGSYNC);
+
+        return m_stream->read(count, retVal);
+    }
+
+    virtual result_t close(AsyncEvent* ac)
+    {
+        if (ac->isSync())
+            return CHECK_ERROR(CALL_E_LONGSYNC);
+
+        m_stream->close(true);
+        return 0;
+    }
+
+private:
+    obj_ptr<mysql> m_db;
+    obj_ptr<mysql_stream> m_stream;
+};
+
+static exlib::fiber_local<mysql_stream*> s_stream;
+static exlib::fiber_local<bool> s_columns;
+
 void* API_getSocket()
 {
     return socket::create();
@@ -55,6 +250,12 @@ int32_t API_sendSocket(void* sock, const char* buffer, int32_t cbBuffer)
 
 void* API_createResult(int32_t columns)
 {
+    if (s_columns) {
+        DBColumns* res = new DBColumns(columns);
+        res->Ref();
+        return res;
+    }
+
     DBResult* res = new DBResult(columns);
     res->Ref();
     return res;
@@ -64,12 +265,17 @@ void API_resultSetField(void* result, int32_t ifield, UMTypeInfo* ti, void* name
     size_t cbName)
 {
     exlib::string s((char*)name, cbName);
-    ((DBResult*)result)->setField(ifield, s);
+
+    if (s_columns)
+        ((DBColumns*)result)->setField(ifield, s);
+    else
+        ((DBResult*)result)->setField(ifield, s);
 }
 
 void API_resultRowBegin(void* result)
 {
-    ((DBResult*)result)->beginRow();
+    if (!s_columns)
+        ((DBResult*)result)->beginRow();
 }
 
 int32_t API_resultRowValue(void* result, int32_t icolumn, UMTypeInfo* ti, void* value,
@@ -92,6 +298,11 @@ int32_t API_resultRowValue(void* result, int32_t icolumn, UMTypeInfo* ti, void*
         case MFTYPE_LONG:
         case MFTYPE_INT24:
         case MFTYPE_LONGLONG:
+            // integer columns stay integers in a columnar result
+            if (s_columns) {
+                v.parseInt((const char*)value, (int32_t)cbValue);
+                break;
+            }
         case MFTYPE_FLOAT:
         case MFTYPE_DOUBLE:
         case MFTYPE_DECIMAL:
@@ -114,6 +325,11 @@ int32_t API_resultRowValue(void* result, int32_t icolumn, UMTypeInfo* ti, void*
             }
 
         default:
+            if (s_columns) {
+                ((DBColumns*)result)->rowString(icolumn, (const char*)value, cbValue);
+                return true;
+            }
+
             v = exlib::string((const char*)value, cbValue);
             break;
         }
@@ -121,23 +337,44 @@ int32_t API_resultRowValue(void* result, int32_t icolumn, UMTypeInfo* ti, void*
         v.setNull();
     }
 
-    ((DBResult*)result)->rowValue(icolumn, v);
+    if (s_columns)
+        ((DBColumns*)result)->rowValue(icolumn, v);
+    else
+        ((DBResult*)result)->rowValue(icolumn, v);
     return true;
 }
 
 void API_resultRowEnd(void* result)
 {
+    if (s_columns) {
+        ((DBColumns*)result)->endRow();
+        return;
+    }
+
     ((DBResult*)result)->endRow();
+
+    mysql_stream* stream = s_stream;
+    if (stream)
+        stream->push((DBResult*)result);
 }
 
 void API_destroyResult(void* result)
 {
-    ((DBResult*)result)->Unref();
+    if (s_columns)
+        ((DBColumns*)result)->Unref();
+    else
+        ((DBResult*)result)->Unref();
 }
 
 void* API_resultOK(UINT64 affected, UINT64 insertId, int32_t serverStatus,
     const char* message, size_t len)
 {
+    if (s_columns) {
+        DBColumns* res = new DBColumns(0, affected, insertId);
+        res->Ref();
+        return res;
+    }
+
     DBResult* res = new DBResult(0, affected, insertId);
     res->Ref();
     return res;
@@ -228,6 +465,10 @@ result_t mysql::close(AsyncEvent* ac)
     if (!m_conn)
         return 0;
 
+    result_t hr = check_stream();
+    if (hr < 0)
+        return hr;
+
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_LONGSYNC);
 
@@ -245,6 +486,10 @@ result_t mysql::execute(exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent*
     if (!m_conn)
         return CHECK_ERROR(CALL_E_INVALID_CALL);
 
+    result_t hr = check_stream();
+    if (hr < 0)
+        return hr;
+
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_LONGSYNC);
 
@@ -274,6 +519,98 @@ result_t mysql::execute(exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent*
     return 0;
 }
 
+result_t mysql::executeColumns(exlib::string sql, obj_ptr<NObject>& retVal, AsyncEvent* ac)
+{
+    if (!m_conn)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    result_t hr = check_stream();
+    if (hr < 0)
+        return hr;
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_LONGSYNC);
+
+    s_columns = true;
+    DBColumns* res = (DBColumns*)UMConnection_Query(m_conn, sql.c_str(), sql.length());
+    while (res && UMConnection_HasMoreResult(m_conn)) {
+        DBColumns* res1 = (DBColumns*)UMConnection_NextResultSet(m_conn);
+
+        res->Unref();
+        res = res1;
+    }
+    s_columns = false;
+
+    if (!res)
+        return CHECK_ERROR(error());
+
+    retVal = res;
+    res->Unref();
+
+    return 0;
+}
+
+static result_t cursor_query(mysql_stream* stream)
+{
+    mysql* db = stream->m_db;
+    UMConnection conn = db->m_conn;
+    result_t hr = 0;
+
+    s_stream = stream;
+    DBResult* res = (DBResult*)UMConnection_Query(conn, stream->m_sql.c_str(), stream->m_sql.length());
+    s_stream = NULL;
+
+    if (!res)
+        hr = db->error();
+    else {
+        res->Unref();
+
+        // only the first result set is streamed, the others are read and dropped
+        while (UMConnection_HasMoreResult(conn)) {
+            res = (DBResult*)UMConnection_NextResultSet(conn);
+            if (!res) {
+                hr = db->error();
+                break;
+            }
+
+            res->Unref();
+        }
+    }
+
+    db->m_streaming = 0;
+    stream->finish(hr);
+    stream->Unref();
+
+    return 0;
+}
+
+result_t mysql::cursor(exlib::string sql, obj_ptr<DbCursor_base>& retVal, AsyncEvent* ac)
+{
+    if (!m_conn)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    result_t hr = check_stream();
+    if (hr < 0)
+        return hr;
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_LONGSYNC);
+
+    obj_ptr<mysql_stream> stream = new mysql_stream(this, sql);
+
+    m_streaming = 1;
+    stream->Ref();
+    asyncCall(cursor_query, (mysql_stream*)stream, CALL_E_LONGSYNC);
+
+    // wait for the first batch, so a failed query is reported here
+    hr = stream->open();
+    if (hr < 0)
+        return hr;
+
+    retVal = new mysql_cursor(stream);
+    return 0;
+}
+
 result_t mysql::get_rxBufferSize(int32_t& retVal)
 {
     if (!m_conn)
@@ -17,6 +17,11 @@ namespace fibjs {
 
 class mysql : public db_tmpl<MySQL_base, mysql> {
 public:
+    mysql()
+        : m_streaming(0)
+    {
+    }
+
     virtual ~mysql();
 
 public:
@@ -24,6 +29,8 @@ public:
     virtual result_t get_type(exlib::string& retVal);
     virtual result_t close(AsyncEvent* ac);
     virtual result_t execute(exlib::string sql, obj_ptr<NArray>& retVal, AsyncEvent* ac);
+    virtual result_t executeColumns(exlib::string sql, obj_ptr<NObject>& retVal, AsyncEvent* ac);
+    virtual result_t cursor(exlib::string sql, obj_ptr<DbCursor_base>& retVal, AsyncEvent* ac);
 
 public:
     // MySQL_base
@@ -103,7 +110,7 @@ public:
         return _data_type;
     }
 
-private:
+public:
     inline result_t error()
     {
         const char* errorMessage = NULL;
@@ -115,6 +122,17 @@ private:
             return Runtime::setError(errorMessage);
         return Runtime::errNumber();
     }
+
+    result_t check_stream()
+    {
+        if (m_streaming)
+            return CHECK_ERROR(Runtime::setError("MySQL: connection is busy with an unfinished cursor."));
+        return 0;
+    }
+
+public:
+    // set while a cursor is still reading its result from the connection
+    exlib::atomic m_streaming;
 };
 
 } /* namespace fibjs */
@@ -29,7 +29,8 @@ static void hexEncode(const char* data, size_t sz, bool upper, exlib::string& re
     retVal.resize(sz * 2);
     char* _retVal = retVal.data();
 
-    for (i = 0; i < sz; i++) {
+    i = hex_encode_block((const unsigned char*)data, sz, upper, _retVal);
+    for (; i < sz; i++) {
         unsigned char ch = (unsigned char)data[i];
 
         _retVal[i * 2] = HexChar[ch >> 4];
@@ -49,18 +50,22 @@ result_t hex_base::encode(Buffer_base* data, exlib::string& retVal)
     return 0;
 }
 
-static void hexDecode(const char* _data, int32_t len, exlib::string& retVal)
+// decodes into out, which holds at least len / 2 bytes, and returns the decoded size
+static size_t hexDecode(const char* _data, size_t len, char* _strBuf)
 {
-    int32_t pos;
+    size_t pos;
     const char* end = _data + len;
-    exlib::string strBuf;
     unsigned char ch1, ch2;
 
-    strBuf.resize(len / 2);
-    char* _strBuf = strBuf.data();
+    // the block decoder takes the leading run of valid blocks in one go, the
+    // scalar loop then finishes the input whatever follows
+    pos = hex_decode_block(_data, len, (unsigned char*)_strBuf) / 2;
+    _data += pos * 2;
+
+    while (_data < end - 1) {
+        if (!(ch1 = (unsigned char)*_data++))
+            break;
 
-    pos = 0;
-    while ((_data < end - 1) && (ch1 = (unsigned char)*_data++)) {
         if (qisxdigit(ch1))
             ch1 = qhex(ch1);
         else
@@ -80,20 +85,34 @@ static void hexDecode(const char* _data, int32_t len, exlib::string& retVal)
         _strBuf[pos++] = (ch1 << 4) + ch2;
     }
 
-    strBuf.resize(pos);
-    retVal = strBuf;
+    return pos;
 }
 
-static void hexDecode(const char* _data, int32_t len, obj_ptr<Buffer_base>& retVal)
+static void hexDecode(const char* _data, size_t len, exlib::string& retVal)
 {
-    exlib::string strBuf;
-    hexDecode(_data, len, strBuf);
-    retVal = new Buffer(strBuf.c_str(), strBuf.length());
+    retVal.resize(len / 2);
+    retVal.resize(hexDecode(_data, len, retVal.data()));
+}
+
+// decoded data goes straight into the backing store of the result, a shorter
+// result is a view of the same store
+typedef size_t (*buffer_decoder)(const char* data, size_t len, char* out);
+
+static void bufferDecode(buffer_decoder decoder, const char* data, size_t len, size_t bound,
+    obj_ptr<Buffer_base>& retVal)
+{
+    obj_ptr<Buffer> buf = new Buffer(NULL, bound);
+    size_t n = decoder(data, len, (char*)buf->data());
+
+    if (n == bound)
+        retVal = buf;
+    else
+        retVal = new Buffer(buf, 0, n);
 }
 
 result_t hex_base::decode(exlib::string data, obj_ptr<Buffer_base>& retVal)
 {
-    hexDecode(data.c_str(), (int32_t)data.length(), retVal);
+    bufferDecode(hexDecode, data.c_str(), data.length(), data.length() / 2, retVal);
     return 0;
 }
 
@@ -134,20 +153,33 @@ static void baseEncode(const char* pEncodingTable, size_t dwBits,
     retVal.resize(len);
 }
 
-static void baseDecode(const char* pdecodeTable, size_t dwBits,
-    const char* _baseString, size_t len, exlib::string& retVal)
+typedef size_t (*block_decoder)(const char* data, size_t len, unsigned char* out);
+
+// decodes into out, which holds at least len * dwBits / 8 bytes, and returns the decoded size
+static size_t baseDecode(const char* pdecodeTable, size_t dwBits,
+    const char* _baseString, size_t len, char* _retVal, block_decoder block = NULL)
 {
     size_t nWritten = 0;
     const char* end = _baseString + len;
 
-    retVal.resize(len * dwBits / 8);
-    char* _retVal = retVal.data();
+    // the block decoder takes the leading run of valid blocks in one go and stops
+    // at the first block holding a character it does not take, the scalar loop
+    // then finishes the input whatever follows
+    if (block) {
+        size_t n = block(_baseString, len, (unsigned char*)_retVal);
+
+        _baseString += n;
+        nWritten = n * dwBits / 8;
+    }
 
     size_t dwCurr = 0;
     size_t nBits = 0;
     unsigned char ch;
 
-    while ((_baseString < end) && (ch = (unsigned char)*_baseString++)) {
+    while (_baseString < end) {
+        if (!(ch = (unsigned char)*_baseString++))
+            break;
+
         int32_t nCh = (ch > 0x20 && ch < 0x80) ? pdecodeTable[ch - 0x20] : -1;
 
         if (nCh != -1) {
@@ -162,15 +194,14 @@ static void baseDecode(const char* pdecodeTable, size_t dwBits,
         }
     }
 
-    retVal.resize(nWritten);
+    return nWritten;
 }
 
 static void baseDecode(const char* pdecodeTable, size_t dwBits,
-    const char* _baseString, size_t len, obj_ptr<Buffer_base>& retVal)
+    const char* _baseString, size_t len, exlib::string& retVal, block_decoder block = NULL)
 {
-    exlib::string strBuf;
-    baseDecode(pdecodeTable, dwBits, _baseString, len, strBuf);
-    retVal = new Buffer(strBuf.c_str(), strBuf.length());
+    retVal.resize(len * dwBits / 8);
+    retVal.resize(baseDecode(pdecodeTable, dwBits, _baseString, len, retVal.data(), block));
 }
 
 static void base32Encode(const char* data, size_t sz, bool upper, bool padding, exlib::string& retVal)
@@ -186,7 +217,7 @@ result_t base32_base::encode(Buffer_base* data, exlib::string& retVal)
     return 0;
 }
 
-static void base32Decode(const char* data, size_t sz, exlib::string& retVal)
+static size_t base32Decode(const char* data, size_t sz, char* out)
 {
     static const char decodeTable[] = {
         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 2x  !"#$%&'()*+,-./   */
@@ -197,30 +228,36 @@ static void base32Decode(const char* data, size_t sz, exlib::string& retVal)
         15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1 /* 7X pqrstuvwxyz{\}~DEL */
     };
 
-    baseDecode(decodeTable, 5, data, sz, retVal);
+    return baseDecode(decodeTable, 5, data, sz, out);
 }
 
-static void base32Decode(const char* data, size_t sz, obj_ptr<Buffer_base>& retVal)
+static void base32Decode(const char* data, size_t sz, exlib::string& retVal)
 {
-    exlib::string strBuf;
-    base32Decode(data, sz, strBuf);
-    retVal = new Buffer(strBuf.c_str(), strBuf.length());
+    retVal.resize(sz * 5 / 8);
+    retVal.resize(base32Decode(data, sz, retVal.data()));
 }
 
 result_t base32_base::decode(exlib::string data, obj_ptr<Buffer_base>& retVal)
 {
-    base32Decode(data.c_str(), data.length(), retVal);
+    bufferDecode(base32Decode, data.c_str(), data.length(), data.length() * 5 / 8, retVal);
     return 0;
 }
 
 static void base64Encode(const char* data, size_t sz, bool url, bool padding, exlib::string& retVal)
 {
-    if (url)
-        baseEncode("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_",
-            6, data, sz, retVal, padding);
-    else
-        baseEncode("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
-            6, data, sz, retVal, padding);
+    const char* pEncodingTable = url ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+                                     : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    exlib::string tail;
+    size_t n, len;
+
+    retVal.resize((sz + 2) / 3 * 4);
+
+    n = base64_encode_block((const unsigned char*)data, sz, url, retVal.data());
+    len = n / 3 * 4;
+
+    baseEncode(pEncodingTable, 6, data + n, sz - n, tail, padding);
+    memcpy(retVal.data() + len, tail.c_str(), tail.length());
+    retVal.resize(len + tail.length());
 }
 
 void base64Encode(const char* data, size_t sz, bool url, exlib::string& retVal)
@@ -228,7 +265,7 @@ void base64Encode(const char* data, size_t sz, bool url, exlib::string& retVal)
     base64Encode(data, sz, url, !url, retVal);
 }
 
-void base64Decode(const char* data, size_t sz, exlib::string& retVal)
+static size_t base64Decode(const char* data, size_t sz, char* out)
 {
     static const char decodeTable[] = {
         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, 62, -1, 63, /* 2x  !"#$%&'()*+,-./   */
@@ -239,14 +276,13 @@ void base64Decode(const char* data, size_t sz, exlib::string& retVal)
         41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1 /* 7X pqrstuvwxyz{\}~DEL */
     };
 
-    baseDecode(decodeTable, 6, data, sz, retVal);
+    return baseDecode(decodeTable, 6, data, sz, out, base64_decode_block);
 }
 
-static void base64Decode(const char* data, size_t sz, obj_ptr<Buffer_base>& retVal)
+void base64Decode(const char* data, size_t sz, exlib::string& retVal)
 {
-    exlib::string strBuf;
-    base64Decode(data, sz, strBuf);
-    retVal = new Buffer(strBuf.c_str(), strBuf.length());
+    retVal.resize(sz * 6 / 8);
+    retVal.resize(base64Decode(data, sz, retVal.data()));
 }
 
 result_t base64_base::encode(Buffer_base* data, bool url, exlib::string& retVal)
@@ -258,16 +294,7 @@ result_t base64_base::encode(Buffer_base* data, bool url, exlib::string& retVal)
 
 result_t base64_base::decode(exlib::string data, obj_ptr<Buffer_base>& retVal)
 {
-    static const char decodeTable[] = {
-        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, 62, -1, 63, /* 2x  !"#$%&'()*+,-./   */
-        52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1, /* 3x 0123456789:;<=>?   */
-        -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, /* 4x @ABCDEFGHIJKLMNO   */
-        15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, 63, /* 5X PQRSTUVWXYZ[\]^_   */
-        -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, /* 6x `abcdefghijklmno   */
-        41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1 /* 7X pqrstuvwxyz{\}~DEL */
-    };
-
-    baseDecode(decodeTable, 6, data.c_str(), data.length(), retVal);
+    bufferDecode(base64Decode, data.c_str(), data.length(), data.length() * 6 / 8, retVal);
     return 0;
 }
 
@@ -422,6 +449,26 @@ result_t commonDecode(exlib::string codec, exlib::string data, exlib::string& re
     return 0;
 }
 
+result_t commonDecode(exlib::string codec, exlib::string data, obj_ptr<Buffer_base>& retVal)
+{
+    if (codec == "hex")
+        bufferDecode(hexDecode, data.c_str(), data.length(), data.length() / 2, retVal);
+    else if (codec == "base32")
+        bufferDecode(base32Decode, data.c_str(), data.length(), data.length() * 5 / 8, retVal);
+    else if ((codec == "base64") || (codec == "base64url"))
+        bufferDecode(base64Decode, data.c_str(), data.length(), data.length() * 6 / 8, retVal);
+    else {
+        exlib::string strBuf;
+        result_t hr = commonDecode(codec, data, strBuf);
+        if (hr < 0)
+            return hr;
+
+        retVal = new Buffer(strBuf.c_str(), strBuf.length());
+    }
+
+    return 0;
+}
+
 inline bool is_native_codec(exlib::string codec)
 {
     return (codec == "hex")
@@ -623,13 +670,13 @@ result_t multibase_base::decode(exlib::string data, obj_ptr<Buffer_base>& retVal
     char type = p[0];
 
     if (type == 'f' || type == 'F') {
-        hexDecode(p + 1, (int32_t)sz - 1, retVal);
+        bufferDecode(hexDecode, p + 1, sz - 1, (sz - 1) / 2, retVal);
         return 0;
     } else if (type == 'b' || type == 'B' || type == 'c' || type == 'C') {
-        base32Decode(p + 1, (int32_t)sz - 1, retVal);
+        bufferDecode(base32Decode, p + 1, sz - 1, (sz - 1) * 5 / 8, retVal);
         return 0;
     } else if (type == 'm' || type == 'M' || type == 'u' || type == 'U') {
-        base64Decode(p + 1, (int32_t)sz - 1, retVal);
+        bufferDecode(base64Decode, p + 1, sz - 1, (sz - 1) * 6 / 8, retVal);
         return 0;
     } else if (type == 'z') {
         return base58Decode(p + 1, (int32_t)sz - 1, retVal);
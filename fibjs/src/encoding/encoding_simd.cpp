@@ -0,0 +1,522 @@
+/*
+ * encoding_simd.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "encoding.h"
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define ENCODING_X86_FAST
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define ENCODING_NEON_FAST
+#include <arm_neon.h>
+#endif
+
+namespace fibjs {
+
+static const char s_hex_lower[] = "0123456789abcdef";
+static const char s_hex_upper[] = "0123456789ABCDEF";
+static const char s_base64_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char s_base64_url_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+#ifdef ENCODING_X86_FAST
+
+static bool cpu_has_ssse3()
+{
+    static int32_t s_has = -1;
+
+    if (s_has < 0) {
+        unsigned int a, b, c, d;
+        s_has = __get_cpuid(1, &a, &b, &c, &d) && (c & (1 << 9));
+    }
+
+    return s_has == 1;
+}
+
+__attribute__((target("xsave"))) static bool cpu_has_avx2()
+{
+    static int32_t s_has = -1;
+
+    if (s_has < 0) {
+        unsigned int a, b, c, d;
+
+        // AVX2 also needs the OS to save the ymm registers
+        s_has = __get_cpuid(1, &a, &b, &c, &d) && (c & (1 << 27)) && (c & (1 << 28))
+            && ((_xgetbv(0) & 6) == 6)
+            && __get_cpuid_count(7, 0, &a, &b, &c, &d) && (b & (1 << 5));
+    }
+
+    return s_has == 1;
+}
+
+// hex
+
+__attribute__((target("ssse3"))) static size_t hex_encode_ssse3(const unsigned char* data, size_t sz,
+    const char* table, char* out)
+{
+    const __m128i lut = _mm_loadu_si128((const __m128i*)table);
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    size_t i;
+
+    for (i = 0; i + 16 <= sz; i += 16) {
+        __m128i in = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(in, 4), mask));
+        __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(in, mask));
+
+        _mm_storeu_si128((__m128i*)(out + i * 2), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i*)(out + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2"))) static size_t hex_encode_avx2(const unsigned char* data, size_t sz,
+    const char* table, char* out)
+{
+    const __m256i lut = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)table));
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+    size_t i;
+
+    for (i = 0; i + 32 <= sz; i += 32) {
+        __m256i in = _mm256_loadu_si256((const __m256i*)(data + i));
+        __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(in, 4), mask));
+        __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(in, mask));
+        __m256i a = _mm256_unpacklo_epi8(hi, lo);
+        __m256i b = _mm256_unpackhi_epi8(hi, lo);
+
+        _mm256_storeu_si256((__m256i*)(out + i * 2), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i*)(out + i * 2 + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+
+    return i;
+}
+
+__attribute__((target("ssse3"))) static inline __m128i lt_u8(__m128i x, int n)
+{
+    return _mm_cmpeq_epi8(_mm_min_epu8(x, _mm_set1_epi8((char)(n - 1))), x);
+}
+
+__attribute__((target("ssse3"))) static inline __m128i hex_nibbles_ssse3(__m128i c, __m128i& valid)
+{
+    __m128i d = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    __m128i dm = lt_u8(d, 10);
+    __m128i a = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i am = lt_u8(a, 6);
+
+    valid = _mm_and_si128(valid, _mm_or_si128(dm, am));
+
+    return _mm_or_si128(_mm_and_si128(dm, d),
+        _mm_and_si128(am, _mm_add_epi8(a, _mm_set1_epi8(10))));
+}
+
+__attribute__((target("ssse3"))) static size_t hex_decode_ssse3(const char* data, size_t len, unsigned char* out)
+{
+    const __m128i weight = _mm_set1_epi16(0x0110);
+    size_t i;
+
+    for (i = 0; i + 32 <= len; i += 32) {
+        __m128i valid = _mm_set1_epi8(-1);
+        __m128i n0 = hex_nibbles_ssse3(_mm_loadu_si128((const __m128i*)(data + i)), valid);
+        __m128i n1 = hex_nibbles_ssse3(_mm_loadu_si128((const __m128i*)(data + i + 16)), valid);
+
+        if (_mm_movemask_epi8(valid) != 0xffff)
+            break;
+
+        __m128i r = _mm_packus_epi16(_mm_maddubs_epi16(n0, weight), _mm_maddubs_epi16(n1, weight));
+        _mm_storeu_si128((__m128i*)(out + i / 2), r);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2"))) static inline __m256i lt_u8_avx2(__m256i x, int n)
+{
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(x, _mm256_set1_epi8((char)(n - 1))), x);
+}
+
+__attribute__((target("avx2"))) static inline __m256i hex_nibbles_avx2(__m256i c, __m256i& valid)
+{
+    __m256i d = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+    __m256i dm = lt_u8_avx2(d, 10);
+    __m256i a = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    __m256i am = lt_u8_avx2(a, 6);
+
+    valid = _mm256_and_si256(valid, _mm256_or_si256(dm, am));
+
+    return _mm256_or_si256(_mm256_and_si256(dm, d),
+        _mm256_and_si256(am, _mm256_add_epi8(a, _mm256_set1_epi8(10))));
+}
+
+__attribute__((target("avx2"))) static size_t hex_decode_avx2(const char* data, size_t len, unsigned char* out)
+{
+    const __m256i weight = _mm256_set1_epi16(0x0110);
+    size_t i;
+
+    for (i = 0; i + 64 <= len; i += 64) {
+        __m256i valid = _mm256_set1_epi8(-1);
+        __m256i n0 = hex_nibbles_avx2(_mm256_loadu_si256((const __m256i*)(data + i)), valid);
+        __m256i n1 = hex_nibbles_avx2(_mm256_loadu_si256((const __m256i*)(data + i + 32)), valid);
+
+        if (_mm256_movemask_epi8(valid) != -1)
+            break;
+
+        __m256i r = _mm256_packus_epi16(_mm256_maddubs_epi16(n0, weight), _mm256_maddubs_epi16(n1, weight));
+        _mm256_storeu_si256((__m256i*)(out + i / 2), _mm256_permute4x64_epi64(r, 0xd8));
+    }
+
+    return i;
+}
+
+// base64
+
+__attribute__((target("ssse3"))) static inline __m128i base64_encode_lane(__m128i in, __m128i shift_lut)
+{
+    // spread 3 bytes into 4 bytes of 6 bits each
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+    __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    __m128i idx = _mm_or_si128(t0, t1);
+
+    // map each 6 bits index to the offset of its character range
+    __m128i r = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+    r = _mm_or_si128(r, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), idx), _mm_set1_epi8(13)));
+
+    return _mm_add_epi8(_mm_shuffle_epi8(shift_lut, r), idx);
+}
+
+__attribute__((target("ssse3"))) static inline __m128i base64_shift_lut(bool url)
+{
+    return _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, url ? '-' - 62 : '+' - 62, url ? '_' - 63 : '/' - 63,
+        'A', 0, 0);
+}
+
+__attribute__((target("ssse3"))) static size_t base64_encode_ssse3(const unsigned char* data, size_t sz,
+    bool url, char* out)
+{
+    const __m128i shift_lut = base64_shift_lut(url);
+    size_t i;
+
+    // each step reads 16 bytes and uses 12 of them
+    for (i = 0; i + 16 <= sz; i += 12) {
+        __m128i in = _mm_loadu_si128((const __m128i*)(data + i));
+        _mm_storeu_si128((__m128i*)(out + i / 3 * 4), base64_encode_lane(in, shift_lut));
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2"))) static size_t base64_encode_avx2(const unsigned char* data, size_t sz,
+    bool url, char* out)
+{
+    const __m128i shift_lut = base64_shift_lut(url);
+    const __m256i lut = _mm256_broadcastsi128_si256(shift_lut);
+    const __m256i shuf = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    size_t i;
+
+    for (i = 0; i + 28 <= sz; i += 24) {
+        __m256i in = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(data + i))),
+            _mm_loadu_si128((const __m128i*)(data + i + 12)), 1);
+
+        in = _mm256_shuffle_epi8(in, shuf);
+
+        __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+        __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+        __m256i idx = _mm256_or_si256(t0, t1);
+
+        __m256i r = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+        r = _mm256_or_si256(r, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), idx), _mm256_set1_epi8(13)));
+
+        _mm256_storeu_si256((__m256i*)(out + i / 3 * 4), _mm256_add_epi8(_mm256_shuffle_epi8(lut, r), idx));
+    }
+
+    return i;
+}
+
+// both alphabets are accepted, as the scalar decoder does
+__attribute__((target("ssse3"))) static inline __m128i base64_values_ssse3(__m128i c, __m128i& valid)
+{
+    __m128i u = _mm_sub_epi8(c, _mm_set1_epi8('A'));
+    __m128i mu = lt_u8(u, 26);
+    __m128i l = _mm_sub_epi8(c, _mm_set1_epi8('a'));
+    __m128i ml = lt_u8(l, 26);
+    __m128i d = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    __m128i md = lt_u8(d, 10);
+    __m128i m62 = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('+')), _mm_cmpeq_epi8(c, _mm_set1_epi8('-')));
+    __m128i m63 = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('/')), _mm_cmpeq_epi8(c, _mm_set1_epi8('_')));
+
+    valid = _mm_and_si128(valid, _mm_or_si128(_mm_or_si128(mu, ml), _mm_or_si128(md, _mm_or_si128(m62, m63))));
+
+    __m128i r = _mm_and_si128(mu, u);
+    r = _mm_or_si128(r, _mm_and_si128(ml, _mm_add_epi8(l, _mm_set1_epi8(26))));
+    r = _mm_or_si128(r, _mm_and_si128(md, _mm_add_epi8(d, _mm_set1_epi8(52))));
+    r = _mm_or_si128(r, _mm_and_si128(m62, _mm_set1_epi8(62)));
+    return _mm_or_si128(r, _mm_and_si128(m63, _mm_set1_epi8(63)));
+}
+
+__attribute__((target("ssse3"))) static inline __m128i base64_pack_ssse3(__m128i v)
+{
+    // 4 x 6 bits -> 24 bits in each dword, then gather the 3 bytes big endian
+    v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+    v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(v, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+__attribute__((target("ssse3"))) static size_t base64_decode_ssse3(const char* data, size_t len, unsigned char* out)
+{
+    size_t i;
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        __m128i valid = _mm_set1_epi8(-1);
+        __m128i v = base64_values_ssse3(_mm_loadu_si128((const __m128i*)(data + i)), valid);
+
+        if (_mm_movemask_epi8(valid) != 0xffff)
+            break;
+
+        __m128i r = base64_pack_ssse3(v);
+        uint32_t t = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(r, 8));
+
+        _mm_storel_epi64((__m128i*)(out + i / 4 * 3), r);
+        memcpy(out + i / 4 * 3 + 8, &t, 4);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2"))) static size_t base64_decode_avx2(const char* data, size_t len, unsigned char* out)
+{
+    const __m256i gather = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+    size_t i;
+
+    for (i = 0; i + 32 <= len; i += 32) {
+        __m256i c = _mm256_loadu_si256((const __m256i*)(data + i));
+        __m256i u = _mm256_sub_epi8(c, _mm256_set1_epi8('A'));
+        __m256i mu = lt_u8_avx2(u, 26);
+        __m256i l = _mm256_sub_epi8(c, _mm256_set1_epi8('a'));
+        __m256i ml = lt_u8_avx2(l, 26);
+        __m256i d = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+        __m256i md = lt_u8_avx2(d, 10);
+        __m256i m62 = _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('+')), _mm256_cmpeq_epi8(c, _mm256_set1_epi8('-')));
+        __m256i m63 = _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('/')), _mm256_cmpeq_epi8(c, _mm256_set1_epi8('_')));
+        __m256i valid = _mm256_or_si256(_mm256_or_si256(mu, ml), _mm256_or_si256(md, _mm256_or_si256(m62, m63)));
+
+        if (_mm256_movemask_epi8(valid) != -1)
+            break;
+
+        __m256i v = _mm256_and_si256(mu, u);
+        v = _mm256_or_si256(v, _mm256_and_si256(ml, _mm256_add_epi8(l, _mm256_set1_epi8(26))));
+        v = _mm256_or_si256(v, _mm256_and_si256(md, _mm256_add_epi8(d, _mm256_set1_epi8(52))));
+        v = _mm256_or_si256(v, _mm256_and_si256(m62, _mm256_set1_epi8(62)));
+        v = _mm256_or_si256(v, _mm256_and_si256(m63, _mm256_set1_epi8(63)));
+
+        v = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+        v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00011000));
+        v = _mm256_shuffle_epi8(v, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                       2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        v = _mm256_permutevar8x32_epi32(v, gather);
+
+        _mm_storeu_si128((__m128i*)(out + i / 4 * 3), _mm256_castsi256_si128(v));
+        _mm_storel_epi64((__m128i*)(out + i / 4 * 3 + 16), _mm256_extracti128_si256(v, 1));
+    }
+
+    return i;
+}
+
+#endif
+
+#ifdef ENCODING_NEON_FAST
+
+static size_t hex_encode_neon(const unsigned char* data, size_t sz, const char* table, char* out)
+{
+    const uint8x16_t lut = vld1q_u8((const uint8_t*)table);
+    const uint8x16_t mask = vdupq_n_u8(0x0f);
+    size_t i;
+
+    for (i = 0; i + 16 <= sz; i += 16) {
+        uint8x16_t in = vld1q_u8(data + i);
+        uint8x16x2_t r;
+
+        r.val[0] = vqtbl1q_u8(lut, vshrq_n_u8(in, 4));
+        r.val[1] = vqtbl1q_u8(lut, vandq_u8(in, mask));
+        vst2q_u8((uint8_t*)out + i * 2, r);
+    }
+
+    return i;
+}
+
+static inline uint8x16_t hex_nibbles_neon(uint8x16_t c, uint8x16_t& valid)
+{
+    uint8x16_t d = vsubq_u8(c, vdupq_n_u8('0'));
+    uint8x16_t dm = vcltq_u8(d, vdupq_n_u8(10));
+    uint8x16_t a = vsubq_u8(vorrq_u8(c, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    uint8x16_t am = vcltq_u8(a, vdupq_n_u8(6));
+
+    valid = vandq_u8(valid, vorrq_u8(dm, am));
+
+    return vbslq_u8(dm, d, vaddq_u8(a, vdupq_n_u8(10)));
+}
+
+static size_t hex_decode_neon(const char* data, size_t len, unsigned char* out)
+{
+    size_t i;
+
+    for (i = 0; i + 32 <= len; i += 32) {
+        uint8x16x2_t in = vld2q_u8((const uint8_t*)data + i);
+        uint8x16_t valid = vdupq_n_u8(0xff);
+        uint8x16_t hi = hex_nibbles_neon(in.val[0], valid);
+        uint8x16_t lo = hex_nibbles_neon(in.val[1], valid);
+
+        if (vminvq_u8(valid) != 0xff)
+            break;
+
+        vst1q_u8(out + i / 2, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+    }
+
+    return i;
+}
+
+static size_t base64_encode_neon(const unsigned char* data, size_t sz, bool url, char* out)
+{
+    const uint8x16x4_t lut = vld1q_u8_x4((const uint8_t*)(url ? s_base64_url_table : s_base64_table));
+    const uint8x16_t mask = vdupq_n_u8(0x3f);
+    size_t i;
+
+    for (i = 0; i + 48 <= sz; i += 48) {
+        uint8x16x3_t in = vld3q_u8(data + i);
+        uint8x16x4_t r;
+
+        r.val[0] = vqtbl4q_u8(lut, vshrq_n_u8(in.val[0], 2));
+        r.val[1] = vqtbl4q_u8(lut, vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask));
+        r.val[2] = vqtbl4q_u8(lut, vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask));
+        r.val[3] = vqtbl4q_u8(lut, vandq_u8(in.val[2], mask));
+
+        vst4q_u8((uint8_t*)out + i / 3 * 4, r);
+    }
+
+    return i;
+}
+
+static inline uint8x16_t base64_values_neon(uint8x16_t c, uint8x16_t& valid)
+{
+    uint8x16_t u = vsubq_u8(c, vdupq_n_u8('A'));
+    uint8x16_t mu = vcltq_u8(u, vdupq_n_u8(26));
+    uint8x16_t l = vsubq_u8(c, vdupq_n_u8('a'));
+    uint8x16_t ml = vcltq_u8(l, vdupq_n_u8(26));
+    uint8x16_t d = vsubq_u8(c, vdupq_n_u8('0'));
+    uint8x16_t md = vcltq_u8(d, vdupq_n_u8(10));
+    uint8x16_t m62 = vorrq_u8(vceqq_u8(c, vdupq_n_u8('+')), vceqq_u8(c, vdupq_n_u8('-')));
+    uint8x16_t m63 = vorrq_u8(vceqq_u8(c, vdupq_n_u8('/')), vceqq_u8(c, vdupq_n_u8('_')));
+
+    valid = vandq_u8(valid, vorrq_u8(vorrq_u8(mu, ml), vorrq_u8(md, vorrq_u8(m62, m63))));
+
+    uint8x16_t r = vandq_u8(mu, u);
+    r = vorrq_u8(r, vandq_u8(ml, vaddq_u8(l, vdupq_n_u8(26))));
+    r = vorrq_u8(r, vandq_u8(md, vaddq_u8(d, vdupq_n_u8(52))));
+    r = vorrq_u8(r, vandq_u8(m62, vdupq_n_u8(62)));
+    return vorrq_u8(r, vandq_u8(m63, vdupq_n_u8(63)));
+}
+
+static size_t base64_decode_neon(const char* data, size_t len, unsigned char* out)
+{
+    size_t i;
+
+    for (i = 0; i + 64 <= len; i += 64) {
+        uint8x16x4_t in = vld4q_u8((const uint8_t*)data + i);
+        uint8x16_t valid = vdupq_n_u8(0xff);
+        uint8x16_t a = base64_values_neon(in.val[0], valid);
+        uint8x16_t b = base64_values_neon(in.val[1], valid);
+        uint8x16_t c = base64_values_neon(in.val[2], valid);
+        uint8x16_t d = base64_values_neon(in.val[3], valid);
+
+        if (vminvq_u8(valid) != 0xff)
+            break;
+
+        uint8x16x3_t r;
+
+        r.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+        r.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+        r.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+
+        vst3q_u8(out + i / 4 * 3, r);
+    }
+
+    return i;
+}
+
+#endif
+
+size_t hex_encode_block(const unsigned char* data, size_t sz, bool upper, char* out)
+{
+    const char* table = upper ? s_hex_upper : s_hex_lower;
+    size_t n = 0;
+
+#ifdef ENCODING_X86_FAST
+    if (cpu_has_avx2())
+        n = hex_encode_avx2(data, sz, table, out);
+    if (cpu_has_ssse3())
+        n += hex_encode_ssse3(data + n, sz - n, table, out + n * 2);
+#elif defined(ENCODING_NEON_FAST)
+    n = hex_encode_neon(data, sz, table, out);
+#endif
+
+    return n;
+}
+
+size_t hex_decode_block(const char* data, size_t len, unsigned char* out)
+{
+    size_t n = 0;
+
+#ifdef ENCODING_X86_FAST
+    if (cpu_has_avx2())
+        n = hex_decode_avx2(data, len, out);
+    if (cpu_has_ssse3())
+        n += hex_decode_ssse3(data + n, len - n, out + n / 2);
+#elif defined(ENCODING_NEON_FAST)
+    n = hex_decode_neon(data, len, out);
+#endif
+
+    return n;
+}
+
+size_t base64_encode_block(const unsigned char* data, size_t sz, bool url, char* out)
+{
+    size_t n = 0;
+
+#ifdef ENCODING_X86_FAST
+    if (cpu_has_avx2())
+        n = base64_encode_avx2(data, sz, url, out);
+    if (cpu_has_ssse3())
+        n += base64_encode_ssse3(data + n, sz - n, url, out + n / 3 * 4);
+#elif defined(ENCODING_NEON_FAST)
+    n = base64_encode_neon(data, sz, url, out);
+#endif
+
+    return n;
+}
+
+size_t base64_decode_block(const char* data, size_t len, unsigned char* out)
+{
+    size_t n = 0;
+
+#ifdef ENCODING_X86_FAST
+    if (cpu_has_avx2())
+        n = base64_decode_avx2(data, len, out);
+    if (cpu_has_ssse3())
+        n += base64_decode_ssse3(data + n, len - n, out + n / 4 * 3);
+#elif defined(ENCODING_NEON_FAST)
+    n = base64_decode_neon(data, len, out);
+#endif
+
+    return n;
+}
+
+}
@@ -16,6 +16,11 @@
 #include "File.h"
 #include "Buffer.h"
 
+#ifdef Linux
+#include "Socket.h"
+#include "options.h"
+#endif
+
 #ifdef _WIN32
 #define pclose _pclose
 #endif
@@ -173,9 +178,121 @@ result_t File::copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal,
     if (m_fd == -1)
         return CHECK_ERROR(CALL_E_INVALID_CALL);
 
+#ifdef Linux
+    // regular files go through the kernel, everything else is pumped in user space
+    struct stat64 st;
+    if (fstat64(m_fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        File* file = dynamic_cast<File*>(stm);
+        if (file && file->m_fd != -1) {
+            if (ac->isSync())
+                return CHECK_ERROR(CALL_E_LONGSYNC);
+
+            return copy_range(file->m_fd, bytes, retVal);
+        }
+
+        Socket* sock = dynamic_cast<Socket*>(stm);
+        if (sock && !g_tcpdump)
+            return sock->sendfile(m_fd, -1, bytes, retVal, ac);
+    }
+#endif
+
     return io_base::copyStream(this, stm, bytes, retVal, ac);
 }
 
+#ifdef Linux
+result_t File::copy_range(int32_t fd, int64_t bytes, int64_t& retVal)
+{
+    retVal = 0;
+
+    while (bytes != 0) {
+        size_t len = (bytes < 0 || bytes > 0x40000000) ? 0x40000000 : (size_t)bytes;
+
+        ssize_t n = ::copy_file_range(m_fd, NULL, fd, NULL, len, 0);
+        if (n < 0) {
+            int32_t nError = errno;
+            if (retVal == 0 && (nError == ENOSYS || nError == EXDEV || nError == EINVAL
+                                   || nError == EBADF || nError == EOPNOTSUPP))
+                break;
+
+            return CHECK_ERROR(-nError);
+        }
+
+        if (n == 0)
+            return 0;
+
+        retVal += n;
+        if (bytes > 0)
+            bytes -= n;
+    }
+
+    // copy_file_range is not available for this pair, fall back to read/write
+    std::vector<char> buf;
+    buf.resize(STREAM_BUFF_SIZE);
+
+    while (bytes != 0) {
+        size_t len = (bytes < 0 || bytes > STREAM_BUFF_SIZE) ? STREAM_BUFF_SIZE : (size_t)bytes;
+
+        ssize_t n = ::_read(m_fd, buf.data(), len);
+        if (n < 0)
+            return CHECK_ERROR(LastError());
+        if (n == 0)
+            break;
+
+        char* p = buf.data();
+        ssize_t sz = n;
+        while (sz) {
+            ssize_t w = ::_write(fd, p, sz);
+            if (w < 0)
+                return CHECK_ERROR(LastError());
+
+            sz -= w;
+            p += w;
+        }
+
+        retVal += n;
+        if (bytes > 0)
+            bytes -= n;
+    }
+
+    return 0;
+}
+#endif
+
+#ifndef _WIN32
+result_t File::pread(int64_t pos, int32_t bytes, obj_ptr<Buffer_base>& retVal)
+{
+    if (m_fd == -1)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (bytes <= 0)
+        return CALL_RETURN_NULL;
+
+    obj_ptr<Buffer> buf = new Buffer(NULL, bytes);
+    char* p = (char*)buf->data();
+    int32_t sz = 0;
+
+    while (sz < bytes) {
+        ssize_t n = ::pread(m_fd, p + sz, bytes - sz, pos + sz);
+        if (n < 0)
+            return CHECK_ERROR(LastError());
+        if (n == 0)
+            break;
+
+        sz += (int32_t)n;
+    }
+
+    if (sz == 0)
+        return CALL_RETURN_NULL;
+
+    if (sz < bytes)
+        retVal = new Buffer(buf, 0, sz);
+    else
+        retVal = buf;
+
+    return 0;
+}
+#endif
+
 result_t File::open(exlib::string fname, exlib::string flags)
 {
     close();
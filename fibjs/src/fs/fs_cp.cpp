@@ -0,0 +1,235 @@
+/*
+ * fs_cp.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "ifs/fs.h"
+#include "DirWalker.h"
+
+namespace fibjs {
+
+#define CP_BATCH_MIN_FILES 16
+
+// reflink first, libuv falls back to copy_file_range/sendfile in the kernel
+static result_t copy_one(exlib::string from, exlib::string to, bool force)
+{
+    AutoReq req;
+    return uv_fs_copyfile(NULL, &req, from.c_str(), to.c_str(),
+        (force ? 0 : UV_FS_COPYFILE_EXCL) | UV_FS_COPYFILE_FICLONE, NULL);
+}
+
+static result_t make_dir(exlib::string path, int32_t mode)
+{
+    AutoReq req;
+    int32_t ret = uv_fs_mkdir(NULL, &req, path.c_str(), mode, NULL);
+    if (ret == UV_EEXIST)
+        return 0;
+
+    return ret;
+}
+
+static result_t copy_link(exlib::string from, exlib::string to, bool isDir)
+{
+    exlib::string target;
+
+    {
+        AutoReq req;
+        int32_t ret = uv_fs_readlink(NULL, &req, from.c_str(), NULL);
+        if (ret < 0)
+            return ret;
+
+        target = (const char*)req.ptr;
+    }
+
+    AutoReq req;
+    int32_t ret = uv_fs_symlink(NULL, &req, target.c_str(), to.c_str(), isDir ? UV_FS_SYMLINK_DIR : 0, NULL);
+    if (ret == UV_EEXIST)
+        return 0;
+
+    return ret;
+}
+
+class CopyBatch {
+public:
+    class Job {
+    public:
+        Job()
+            : m_batch(NULL)
+            , m_begin(0)
+            , m_end(0)
+        {
+        }
+
+    public:
+        CopyBatch* m_batch;
+        size_t m_begin;
+        size_t m_end;
+        exlib::Event m_ev;
+    };
+
+public:
+    CopyBatch(exlib::string from, exlib::string to, bool force)
+        : m_from(from)
+        , m_to(to)
+        , m_force(force)
+    {
+    }
+
+public:
+    void add(exlib::string rel)
+    {
+        m_files.push_back(rel);
+    }
+
+    result_t run()
+    {
+        if (m_files.empty())
+            return 0;
+
+        int32_t cpus = 0;
+        os_base::cpuNumbers(cpus);
+
+        size_t worker_count = cpus > 2 ? cpus - 2 : 1;
+        if (worker_count > WALK_MAX_WORKERS)
+            worker_count = WALK_MAX_WORKERS;
+        if (worker_count * CP_BATCH_MIN_FILES > m_files.size())
+            worker_count = m_files.size() / CP_BATCH_MIN_FILES;
+        if (worker_count < 1)
+            worker_count = 1;
+
+        std::vector<Job> jobs(worker_count);
+        size_t step = m_files.size() / worker_count;
+        size_t i;
+
+        for (i = 0; i < worker_count; i++) {
+            jobs[i].m_batch = this;
+            jobs[i].m_begin = i * step;
+            jobs[i].m_end = (i == worker_count - 1) ? m_files.size() : (i + 1) * step;
+
+            if (i > 0)
+                asyncCall(copy_job, &jobs[i], CALL_E_LONGSYNC);
+        }
+
+        copy_job(&jobs[0]);
+
+        for (i = 1; i < worker_count; i++)
+            jobs[i].m_ev.wait();
+
+        return (result_t)m_hr.value();
+    }
+
+private:
+    static result_t copy_job(Job* job)
+    {
+        CopyBatch* batch = job->m_batch;
+
+        for (size_t i = job->m_begin; i < job->m_end && batch->m_hr.value() == 0; i++) {
+            exlib::string& rel = batch->m_files[i];
+
+            result_t hr = copy_one(batch->m_from + PATH_SLASH + rel, batch->m_to + PATH_SLASH + rel, batch->m_force);
+            if (hr < 0)
+                batch->m_hr.CompareAndSwap(0, hr);
+        }
+
+        job->m_ev.set();
+
+        return 0;
+    }
+
+private:
+    exlib::string m_from;
+    exlib::string m_to;
+    bool m_force;
+    std::vector<exlib::string> m_files;
+    exlib::atomic m_hr;
+};
+
+result_t fs_base::cp(exlib::string from, exlib::string to, v8::Local<v8::Object> opts, AsyncEvent* ac)
+{
+    if (ac->isSync()) {
+        Isolate* isolate = Isolate::current(opts);
+        result_t hr;
+
+        ac->m_ctx.resize(2);
+
+        bool recursive = false;
+        hr = GetConfigValue(isolate, opts, "recursive", recursive, true);
+        if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+            return hr;
+        ac->m_ctx[0] = recursive;
+
+        bool force = true;
+        hr = GetConfigValue(isolate, opts, "force", force, true);
+        if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+            return hr;
+        ac->m_ctx[1] = force;
+
+        return CHECK_ERROR(CALL_E_LONGSYNC);
+    }
+
+    bool recursive = ac->m_ctx[0].boolVal();
+    bool force = ac->m_ctx[1].boolVal();
+    int32_t mode;
+
+    os_normalize(from, from, true);
+    os_normalize(to, to, true);
+
+    {
+        AutoReq req;
+        int32_t ret = uv_fs_stat(NULL, &req, from.c_str(), NULL);
+        if (ret < 0)
+            return ret;
+
+        if ((req.statbuf.st_mode & S_IFMT) != S_IFDIR)
+            return copy_one(from, to, force);
+
+        mode = (int32_t)(req.statbuf.st_mode & 0777);
+    }
+
+    if (!recursive)
+        return Runtime::setError("fs: Recursive option is required to copy a directory");
+
+    result_t hr = make_dir(to, mode);
+    if (hr < 0)
+        return hr;
+
+    obj_ptr<DirWalker> walker = new DirWalker(true, true);
+    hr = walker->walk(from);
+    if (hr < 0)
+        return hr;
+
+    obj_ptr<NArray> list;
+    walker->result(list);
+
+    // breadth first order puts every directory before its content
+    CopyBatch batch(from, to, force);
+    for (size_t i = 0; i < list->m_array.size(); i++) {
+        Stat* st = (Stat*)list->m_array[i].object();
+        bool isDir, isLink;
+
+        st->isDirectory(isDir);
+        st->isSymbolicLink(isLink);
+
+        if (isLink) {
+            AutoReq req;
+            exlib::string src = from + PATH_SLASH + st->name;
+
+            isDir = uv_fs_stat(NULL, &req, src.c_str(), NULL) >= 0 && (req.statbuf.st_mode & S_IFMT) == S_IFDIR;
+            hr = copy_link(src, to + PATH_SLASH + st->name, isDir);
+        } else if (isDir)
+            hr = make_dir(to + PATH_SLASH + st->name, (int32_t)(st->m_mode & 0777));
+        else {
+            batch.add(st->name);
+            hr = 0;
+        }
+
+        if (hr < 0)
+            return hr;
+    }
+
+    return batch.run();
+}
+}
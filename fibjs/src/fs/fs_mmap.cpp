@@ -0,0 +1,245 @@
+/*
+ * fs_mmap.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "ifs/fs.h"
+#include "path.h"
+#include "Buffer.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fibjs {
+
+enum {
+    MMAP_NORMAL = 0,
+    MMAP_SEQUENTIAL,
+    MMAP_RANDOM,
+    MMAP_WILLNEED
+};
+
+// the mapping starts at an aligned file offset, the distance from the
+// aligned start to the data travels in deleter_data
+static void unmap_store(void* data, size_t length, void* deleter_data)
+{
+    intptr_t delta = (intptr_t)deleter_data;
+
+#ifdef _WIN32
+    UnmapViewOfFile((char*)data - delta);
+#else
+    ::munmap((char*)data - delta, length + delta);
+#endif
+}
+
+#ifdef _WIN32
+
+static result_t map_file(exlib::string fname, int64_t offset, int64_t length, int32_t advice,
+    void*& data, int64_t& size, intptr_t& delta)
+{
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+
+    if (advice == MMAP_SEQUENTIAL)
+        flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    else if (advice == MMAP_RANDOM)
+        flags |= FILE_FLAG_RANDOM_ACCESS;
+
+    HANDLE file = CreateFileW(UTF8_W(fname), GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_EXISTING, flags, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return CHECK_ERROR(LastError());
+
+    LARGE_INTEGER fsize;
+    if (!GetFileSizeEx(file, &fsize)) {
+        result_t hr = LastError();
+        CloseHandle(file);
+        return CHECK_ERROR(hr);
+    }
+
+    if (offset > fsize.QuadPart) {
+        CloseHandle(file);
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+    }
+
+    size = fsize.QuadPart - offset;
+    if (length >= 0 && length < size)
+        size = length;
+
+    if (size > INT32_MAX) {
+        CloseHandle(file);
+        return CHECK_ERROR(CALL_E_OVERFLOW);
+    }
+
+    if (size == 0) {
+        CloseHandle(file);
+        data = NULL;
+        return 0;
+    }
+
+    HANDLE map = CreateFileMappingW(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (map == NULL) {
+        result_t hr = LastError();
+        CloseHandle(file);
+        return CHECK_ERROR(hr);
+    }
+
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    delta = (intptr_t)(offset % si.dwAllocationGranularity);
+    offset -= delta;
+
+    void* p = MapViewOfFile(map, FILE_MAP_COPY, (DWORD)(offset >> 32), (DWORD)offset,
+        (SIZE_T)(size + delta));
+    result_t hr = p ? 0 : LastError();
+
+    CloseHandle(map);
+    CloseHandle(file);
+
+    if (p == NULL)
+        return CHECK_ERROR(hr);
+
+    data = (char*)p + delta;
+    return 0;
+}
+
+#else
+
+static result_t map_file(exlib::string fname, int64_t offset, int64_t length, int32_t advice,
+    void*& data, int64_t& size, intptr_t& delta)
+{
+    int32_t fd = ::open(fname.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return CHECK_ERROR(LastError());
+
+    struct stat st;
+    if (::fstat(fd, &st) < 0) {
+        result_t hr = LastError();
+        ::close(fd);
+        return CHECK_ERROR(hr);
+    }
+
+    if (offset > st.st_size) {
+        ::close(fd);
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+    }
+
+    size = st.st_size - offset;
+    if (length >= 0 && length < size)
+        size = length;
+
+    if (size > INT32_MAX) {
+        ::close(fd);
+        return CHECK_ERROR(CALL_E_OVERFLOW);
+    }
+
+    if (size == 0) {
+        ::close(fd);
+        data = NULL;
+        return 0;
+    }
+
+    delta = (intptr_t)(offset % sysconf(_SC_PAGESIZE));
+    offset -= delta;
+
+    // private mapping, pages written from js are copied and never reach the file
+    void* p = ::mmap(NULL, (size_t)(size + delta), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, offset);
+    result_t hr = p != MAP_FAILED ? 0 : LastError();
+
+    ::close(fd);
+
+    if (p == MAP_FAILED)
+        return CHECK_ERROR(hr);
+
+    static const int32_t s_advice[] = {
+        MADV_NORMAL,
+        MADV_SEQUENTIAL,
+        MADV_RANDOM,
+        MADV_WILLNEED
+    };
+
+    if (advice != MMAP_NORMAL)
+        ::madvise(p, (size_t)(size + delta), s_advice[advice]);
+
+    data = (char*)p + delta;
+    return 0;
+}
+
+#endif
+
+result_t fs_base::mmap(exlib::string fname, v8::Local<v8::Object> opts,
+    obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    if (ac->isSync()) {
+        Isolate* isolate = Isolate::current(opts);
+        result_t hr;
+
+        if (!isolate->m_enable_FileSystem)
+            return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+        ac->m_ctx.resize(3);
+
+        int64_t offset = 0;
+        hr = GetConfigValue(isolate, opts, "offset", offset, true);
+        if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+            return hr;
+        if (offset < 0)
+            return Runtime::setError("fs: Offset is out of bounds");
+        ac->m_ctx[0] = offset;
+
+        int64_t length = -1;
+        hr = GetConfigValue(isolate, opts, "length", length, true);
+        if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+            return hr;
+        ac->m_ctx[1] = length;
+
+        exlib::string advice = "normal";
+        hr = GetConfigValue(isolate, opts, "advice", advice, true);
+        if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+            return hr;
+
+        if (advice == "normal")
+            ac->m_ctx[2] = MMAP_NORMAL;
+        else if (advice == "sequential")
+            ac->m_ctx[2] = MMAP_SEQUENTIAL;
+        else if (advice == "random")
+            ac->m_ctx[2] = MMAP_RANDOM;
+        else if (advice == "willneed")
+            ac->m_ctx[2] = MMAP_WILLNEED;
+        else
+            return Runtime::setError("fs: Unknown advice '" + advice + "'");
+
+        return CHECK_ERROR(CALL_E_NOSYNC);
+    }
+
+    exlib::string safe_name;
+    path_base::normalize(fname, safe_name);
+
+    void* data;
+    int64_t size;
+    intptr_t delta = 0;
+    result_t hr = map_file(safe_name, ac->m_ctx[0].longVal(), ac->m_ctx[1].longVal(),
+        ac->m_ctx[2].intVal(), data, size, delta);
+    if (hr < 0)
+        return hr;
+
+    if (data == NULL) {
+        retVal = new Buffer();
+        return 0;
+    }
+
+    std::shared_ptr<v8::BackingStore> store = v8::ArrayBuffer::NewBackingStore(data, (size_t)size,
+        unmap_store, (void*)delta);
+    retVal = new Buffer(store, 0, (size_t)size);
+
+    return 0;
+}
+
+}
@@ -0,0 +1,41 @@
+/*
+ * fs_readdir.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "ifs/fs.h"
+#include "DirWalker.h"
+
+namespace fibjs {
+
+result_t fs_base::readdir(exlib::string path, v8::Local<v8::Object> opts, obj_ptr<NArray>& retVal, AsyncEvent* ac)
+{
+    if (ac->isSync()) {
+        obj_ptr<DirWalker> walker = new DirWalker();
+
+        result_t hr = walker->parse(opts);
+        if (hr < 0)
+            return hr;
+
+        ac->m_ctx.resize(1);
+        ac->m_ctx[0] = walker;
+
+        return CHECK_ERROR(CALL_E_LONGSYNC);
+    }
+
+    DirWalker* walker = (DirWalker*)ac->m_ctx[0].object();
+
+    os_normalize(path, path, true);
+
+    result_t hr = walker->walk(path);
+    if (hr < 0)
+        return hr;
+
+    walker->result(retVal);
+
+    return 0;
+}
+}
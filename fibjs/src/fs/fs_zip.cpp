@@ -320,15 +320,14 @@ result_t fs_base::openFile(exlib::string fname, exlib::string flags,
     result_t hr = resolve_zip_file(safe_name, zi, ac);
     if (hr >= 0) {
         obj_ptr<Buffer_base> data;
-        exlib::string strData;
         date_t _d;
 
         zi->get_data(data);
-        if (data)
-            data->toString(strData);
+        if (!data)
+            data = new Buffer();
 
         zi->get_date(_d);
-        retVal = new MemoryStream::CloneStream(strData, _d);
+        retVal = new MemoryStream::BufferStream(data, _d);
         return 0;
     }
 
@@ -2,6 +2,7 @@
 #include "Buffer.h"
 #include "SandBox.h"
 #include "encoding.h"
+#include "options.h"
 
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 
@@ -172,13 +173,7 @@ result_t Buffer_base::from(v8::Local<v8::Uint8Array> datas, int32_t byteOffset,
 
 result_t Buffer_base::from(exlib::string str, exlib::string codec, obj_ptr<Buffer_base>& retVal)
 {
-    exlib::string strBuf;
-    result_t hr = commonDecode(codec, str, strBuf);
-    if (hr < 0)
-        return hr;
-
-    retVal = new Buffer(strBuf.c_str(), strBuf.length());
-    return 0;
+    return commonDecode(codec, str, retVal);
 }
 
 result_t Buffer_base::concat(v8::Local<v8::Array> buflist, int32_t cutLength, obj_ptr<Buffer_base>& retVal)
@@ -241,12 +236,16 @@ v8::Local<v8::Value> Buffer::load_module()
     context->SetEmbedderData(kBufferClassIndex, _buffer);
     context->SetEmbedderData(kBufferPrototype, js_buffer_proto);
 
-    js_buffer_proto->Set(context, isolate->NewString("compare"), isolate->NewFunction("compare", proto_compare)).IsJust();
-    js_buffer_proto->Set(context, isolate->NewString("equals"), isolate->NewFunction("equals", proto_equals)).IsJust();
-    js_buffer_proto->Set(context, isolate->NewString("indexOf"), isolate->NewFunction("indexOf", proto_indexOf)).IsJust();
+    // buf.compare and buf.equals in buffer.js both end up here, optimized code
+    // calls straight into class_compare_fast when both sides are typed arrays
+    static const v8::CFunction s_compare_cfunc = v8::CFunction::Make(class_compare_fast);
 
     v8::Local<v8::Object> js_buffer_class = _buffer.As<v8::Object>();
-    js_buffer_class->Set(context, isolate->NewString("compare"), isolate->NewFunction("compare", s_static_compare)).IsJust();
+    js_buffer_class->Set(context, isolate->NewString("compare"), isolate->NewFunction("compare", s_static_compare, &s_compare_cfunc)).IsJust();
+
+    // buf.indexOf in buffer.js, a byte value or a bad offset takes the regular callback
+    static const v8::CFunction s_indexOf_cfunc = v8::CFunction::Make(class_indexOf_fast);
+    js_buffer_class->Set(context, isolate->NewString("native_indexOf"), isolate->NewFunction("indexOf", class_indexOf, &s_indexOf_cfunc)).IsJust();
 
     // js_buffer_proto->Set(context, isolate->NewString("copy"), isolate->NewFunction("copy", proto_copy)).IsJust();
     js_buffer_proto->Set(context, isolate->NewString("write"), isolate->NewFunction("write", proto_write)).IsJust();
@@ -259,6 +258,38 @@ v8::Local<v8::Value> Buffer::load_module()
     return _buffer;
 }
 
+bool Buffer::store::pool_alloc(size_t _length, Isolate* isolate)
+{
+    size_t pool_size = g_buffer_pool_size;
+
+    if (_length == 0 || _length >= pool_size / 2)
+        return false;
+
+    // a slab belongs to one isolate, so a buffer never shares its backing store with
+    // another isolate. io threads have no current isolate and pass the owner of the
+    // request instead, a buffer whose owner is unknown is not pooled
+    if (!isolate)
+        isolate = Isolate::current();
+    if (!isolate)
+        return false;
+
+    isolate->m_buffer_slab_lock.lock();
+
+    if (!isolate->m_buffer_slab || isolate->m_buffer_slab_used + _length > pool_size) {
+        isolate->m_buffer_slab = NewBackingStore(pool_size);
+        isolate->m_buffer_slab_used = 0;
+    }
+
+    m_store = isolate->m_buffer_slab;
+    m_offset = isolate->m_buffer_slab_used;
+
+    isolate->m_buffer_slab_used = (isolate->m_buffer_slab_used + _length + 7) & ~(size_t)7;
+
+    isolate->m_buffer_slab_lock.unlock();
+
+    return true;
+}
+
 v8::Local<v8::Object> Buffer::wrap(Isolate* isolate, v8::Local<v8::Object> This)
 {
     if (!hasJSHandle()) {
@@ -336,53 +367,79 @@ result_t GetArgumentValue(Isolate* isolate, v8::Local<v8::Value> v, obj_ptr<Buff
         return;                                               \
     }
 
-void Buffer::proto_compare(const v8::FunctionCallbackInfo<v8::Value>& args)
+int32_t Buffer::class_compare_fast(v8::Local<v8::Object> receiver, const v8::FastApiTypedArray<uint8_t>& buf1,
+    const v8::FastApiTypedArray<uint8_t>& buf2, v8::FastApiCallbackOptions& options)
 {
-    int32_t vr;
+    FastArrayData<uint8_t> data1(buf1);
+    FastArrayData<uint8_t> data2(buf2);
+    int32_t len1 = (int32_t)data1.m_length;
+    int32_t len2 = (int32_t)data2.m_length;
 
-    BUFFER_INSTANCE();
-    METHOD_ENTER();
+    int32_t retVal = memcmp(data1.m_data, data2.m_data, MIN(len1, len2));
+    if (retVal)
+        return retVal;
 
-    METHOD_OVER(1, 1);
+    return len1 - len2;
+}
 
-    ARG(obj_ptr<Buffer>, 0);
+int32_t Buffer::class_indexOf_fast(v8::Local<v8::Object> receiver, const v8::FastApiTypedArray<uint8_t>& buf,
+    const v8::FastApiTypedArray<uint8_t>& v, int32_t offset, v8::FastApiCallbackOptions& options)
+{
+    FastArrayData<uint8_t> data(buf);
+    FastArrayData<uint8_t> find(v);
 
-    hr = pInst->compare(v0, vr);
+    result_t hr = validOffset((int32_t)data.m_length, offset);
+    if (hr < 0) {
+        FAST_METHOD_FALLBACK(hr);
+        return -1;
+    }
 
-    METHOD_RETURN();
+    const uint8_t* p = exlib::qmemmem(data.m_data + offset, data.m_length - offset,
+        find.m_data, find.m_length);
+
+    return p ? (int32_t)(p - data.m_data) : -1;
 }
 
-void Buffer::proto_copy(const v8::FunctionCallbackInfo<v8::Value>& args)
+void Buffer::class_indexOf(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     int32_t vr;
 
-    BUFFER_INSTANCE();
     METHOD_ENTER();
 
-    METHOD_OVER(4, 1);
+    METHOD_OVER(3, 2);
 
     ARG(obj_ptr<Buffer>, 0);
-    OPT_ARG(int32_t, 1, 0);
+    ARG(int32_t, 1);
     OPT_ARG(int32_t, 2, 0);
-    OPT_ARG(int32_t, 3, -1);
 
-    hr = pInst->copy(v0, v1, v2, v3, vr);
+    hr = v0->indexOf(v1, v2, vr);
+
+    METHOD_OVER(3, 2);
+
+    ARG(obj_ptr<Buffer>, 0);
+    ARG(obj_ptr<Buffer>, 1);
+    OPT_ARG(int32_t, 2, 0);
+
+    hr = v0->indexOf(v1, v2, vr);
 
     METHOD_RETURN();
 }
 
-void Buffer::proto_equals(const v8::FunctionCallbackInfo<v8::Value>& args)
+void Buffer::proto_copy(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
-    bool vr;
+    int32_t vr;
 
     BUFFER_INSTANCE();
     METHOD_ENTER();
 
-    METHOD_OVER(1, 1);
+    METHOD_OVER(4, 1);
 
     ARG(obj_ptr<Buffer>, 0);
+    OPT_ARG(int32_t, 1, 0);
+    OPT_ARG(int32_t, 2, 0);
+    OPT_ARG(int32_t, 3, -1);
 
-    hr = pInst->equals(v0, vr);
+    hr = pInst->copy(v0, v1, v2, v3, vr);
 
     METHOD_RETURN();
 }
@@ -437,37 +494,6 @@ void Buffer::proto_fill(const v8::FunctionCallbackInfo<v8::Value>& args)
     METHOD_RETURN();
 }
 
-void Buffer::proto_indexOf(const v8::FunctionCallbackInfo<v8::Value>& args)
-{
-    int32_t vr;
-
-    BUFFER_INSTANCE();
-    METHOD_ENTER();
-
-    METHOD_OVER(2, 1);
-
-    ARG(int32_t, 0);
-    OPT_ARG(int32_t, 1, 0);
-
-    hr = pInst->indexOf(v0, v1, vr);
-
-    METHOD_OVER(2, 1);
-
-    ARG(obj_ptr<Buffer>, 0);
-    OPT_ARG(int32_t, 1, 0);
-
-    hr = pInst->indexOf(v0, v1, vr);
-
-    METHOD_OVER(2, 1);
-
-    ARG(exlib::string, 0);
-    OPT_ARG(int32_t, 1, 0);
-
-    hr = pInst->indexOf(v0, v1, vr);
-
-    METHOD_RETURN();
-}
-
 void Buffer::proto_write(const v8::FunctionCallbackInfo<v8::Value>& args)
 {
     if (!args.This()->IsUint8Array()) {
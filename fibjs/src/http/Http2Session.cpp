@@ -0,0 +1,1455 @@
+/*
+ * Http2Session.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "object.h"
+#include "Http2Session.h"
+#include "HttpHandler.h"
+#include "HttpRequest.h"
+#include "HttpResponse.h"
+#include "BufferedStream.h"
+#include "Buffer.h"
+
+namespace fibjs {
+
+#define H2_DATA 0x0
+#define H2_HEADERS 0x1
+#define H2_PRIORITY 0x2
+#define H2_RST_STREAM 0x3
+#define H2_SETTINGS 0x4
+#define H2_PUSH_PROMISE 0x5
+#define H2_PING 0x6
+#define H2_GOAWAY 0x7
+#define H2_WINDOW_UPDATE 0x8
+#define H2_CONTINUATION 0x9
+
+#define H2_FLAG_ACK 0x1
+#define H2_FLAG_END_STREAM 0x1
+#define H2_FLAG_END_HEADERS 0x4
+#define H2_FLAG_PADDED 0x8
+#define H2_FLAG_PRIORITY 0x20
+
+#define H2_NO_ERROR 0x0
+#define H2_PROTOCOL_ERROR 0x1
+#define H2_FLOW_CONTROL_ERROR 0x3
+#define H2_STREAM_CLOSED 0x5
+#define H2_FRAME_SIZE_ERROR 0x6
+#define H2_REFUSED_STREAM 0x7
+#define H2_CANCEL 0x8
+#define H2_COMPRESSION_ERROR 0x9
+#define H2_ENHANCE_YOUR_CALM 0xb
+
+// the peer sent GOAWAY, stop reading without answering
+#define H2_GOING_AWAY -1
+
+#define H2_DEFAULT_WINDOW 65535
+#define H2_DEFAULT_FRAME 16384
+#define H2_MAX_STREAMS 100
+#define H2_READ_SIZE 65536
+#define H2_MAX_WINDOW 0x7fffffff
+#define H2_MAX_ID 0x7fffffff
+
+static inline uint32_t get_u32(const char* p)
+{
+    const uint8_t* s = (const uint8_t*)p;
+    return ((uint32_t)s[0] << 24) | ((uint32_t)s[1] << 16) | ((uint32_t)s[2] << 8) | s[3];
+}
+
+static inline void put_u32(char* p, uint32_t v)
+{
+    p[0] = (char)(v >> 24);
+    p[1] = (char)(v >> 16);
+    p[2] = (char)(v >> 8);
+    p[3] = (char)v;
+}
+
+static void put_frame(exlib::string& out, uint8_t type, uint8_t flags, int32_t id,
+    const char* data, size_t len)
+{
+    char head[9];
+
+    head[0] = (char)(len >> 16);
+    head[1] = (char)(len >> 8);
+    head[2] = (char)len;
+    head[3] = (char)type;
+    head[4] = (char)flags;
+    put_u32(head + 5, id & 0x7fffffff);
+
+    out.append(head, 9);
+    if (len)
+        out.append(data, len);
+}
+
+// connection specific fields have no place in http/2, content-length is set from the body
+static void encode_headers(HttpCollection* headers, bool request, exlib::string& block)
+{
+    headers->each([&block, request](const exlib::string& name, const exlib::string& value) {
+        exlib::string key(name);
+        char* p = key.data();
+
+        for (size_t i = 0; i < key.length(); i++)
+            p[i] = qtolower(p[i]);
+
+        if (key == "connection" || key == "keep-alive" || key == "proxy-connection"
+            || key == "transfer-encoding" || key == "upgrade" || key == "content-length")
+            return;
+
+        // a request carries its host as :authority
+        if (request && key == "host")
+            return;
+
+        HPackEncoder::encode(key, value, block);
+    });
+}
+
+class Http2Session::asyncSession : public AsyncState {
+public:
+    asyncSession(Http2Session* pThis, AsyncEvent* ac)
+        : AsyncState(ac)
+        , m_pThis(pThis)
+    {
+    }
+
+    virtual Isolate* isolate()
+    {
+        return m_pThis->m_isolate;
+    }
+
+protected:
+    obj_ptr<Http2Session> m_pThis;
+};
+
+class Http2Session::asyncRead : public asyncSession {
+public:
+    asyncRead(Http2Session* pThis, int32_t size, AsyncEvent* ac)
+        : asyncSession(pThis, ac)
+        , m_preface(size)
+    {
+        // the client sent its preface in start(), the server answers with frames only
+        next(pThis->m_client ? head : preface);
+    }
+
+    ON_STATE(asyncRead, preface)
+    {
+        return m_pThis->m_stmBuffered->read(m_preface, m_buf, next(settings));
+    }
+
+    ON_STATE(asyncRead, settings)
+    {
+        if (n == CALL_RETURN_NULL)
+            return next(end);
+
+        exlib::string data;
+        m_buf->toString(data);
+
+        if (data != exlib::string(H2_PREFACE + sizeof(H2_PREFACE) - 1 - m_preface, m_preface))
+            return CHECK_ERROR(CALL_E_INVALID_DATA);
+
+        char settings[6];
+
+        settings[0] = 0;
+        settings[1] = 0x3;
+        put_u32(settings + 2, H2_MAX_STREAMS);
+        m_pThis->frame(H2_SETTINGS, 0, 0, settings, sizeof(settings));
+
+        return next(head);
+    }
+
+    ON_STATE(asyncRead, head)
+    {
+        return m_pThis->m_stmBuffered->read(9, m_buf, next(header));
+    }
+
+    ON_STATE(asyncRead, header)
+    {
+        if (n == CALL_RETURN_NULL)
+            return next(end);
+
+        exlib::string head;
+        m_buf->toString(head);
+        if (head.length() < 9)
+            return next(end);
+
+        const uint8_t* p = (const uint8_t*)head.c_str();
+
+        m_len = ((int32_t)p[0] << 16) | ((int32_t)p[1] << 8) | p[2];
+        m_type = p[3];
+        m_flags = p[4];
+        m_id = get_u32(head.c_str() + 5) & 0x7fffffff;
+
+        if (m_len > H2_DEFAULT_FRAME) {
+            m_pThis->goaway(H2_FRAME_SIZE_ERROR);
+            return next(end);
+        }
+
+        if (m_pThis->m_headerId && (m_type != H2_CONTINUATION || m_id != m_pThis->m_headerId)) {
+            m_pThis->goaway(H2_PROTOCOL_ERROR);
+            return next(end);
+        }
+
+        m_buf.Release();
+        if (m_len == 0)
+            return next(frame);
+
+        return m_pThis->m_stmBuffered->read(m_len, m_buf, next(frame));
+    }
+
+    ON_STATE(asyncRead, frame)
+    {
+        exlib::string data;
+
+        if (m_len > 0) {
+            if (n == CALL_RETURN_NULL)
+                return next(end);
+
+            m_buf->toString(data);
+            if ((int32_t)data.length() < m_len)
+                return next(end);
+        }
+
+        int32_t code = m_pThis->on_frame(m_type, m_flags, m_id, data);
+        if (code == H2_GOING_AWAY)
+            return next(end);
+
+        if (code != H2_NO_ERROR) {
+            m_pThis->goaway(code);
+            return next(end);
+        }
+
+        return next(head);
+    }
+
+    ON_STATE(asyncRead, end)
+    {
+        Http2Session* s = m_pThis;
+
+        s->m_lock.lock();
+        s->m_closed = true;
+        s->m_lock.unlock();
+
+        if (s->m_client)
+            s->fail_all(0, "HttpClient: http/2 connection closed.");
+        s->wake();
+
+        s->m_lock.lock();
+        if (s->m_active == 0 && !s->m_writing) {
+            s->m_lock.unlock();
+            return next(exit);
+        }
+
+        next(exit);
+        s->m_closer = this;
+        s->m_lock.unlock();
+
+        return CALL_E_PENDDING;
+    }
+
+    ON_STATE(asyncRead, exit)
+    {
+        // the server connection is closed by HttpHandler, a client session owns its connection
+        if (m_pThis->m_client)
+            return m_pThis->m_stm->close(next());
+
+        return next();
+    }
+
+    virtual int32_t error(int32_t v)
+    {
+        if (at(end) || at(exit))
+            return v;
+
+        if (at(settings))
+            m_pThis->goaway(H2_PROTOCOL_ERROR);
+
+        next(end);
+        return 0;
+    }
+
+private:
+    int32_t m_preface;
+    obj_ptr<Buffer_base> m_buf;
+    int32_t m_len;
+    uint8_t m_type;
+    uint8_t m_flags;
+    int32_t m_id;
+};
+
+class Http2Session::asyncWrite : public asyncSession {
+public:
+    asyncWrite(Http2Session* pThis)
+        : asyncSession(pThis, NULL)
+    {
+        next(write);
+    }
+
+    ON_STATE(asyncWrite, write)
+    {
+        exlib::string data;
+
+        m_pThis->m_lock.lock();
+        data.swap(m_pThis->m_out);
+        if (data.empty())
+            m_pThis->m_writing = false;
+        bool shutdown = m_pThis->m_shutdown;
+        m_pThis->m_lock.unlock();
+
+        if (data.empty()) {
+            m_pThis->check_close();
+
+            // GOAWAY is out, the reader sees the connection go and ends the session
+            if (shutdown)
+                return m_pThis->m_stm->close(next());
+
+            return next();
+        }
+
+        m_buf = new Buffer(data.c_str(), data.length());
+        return m_pThis->m_stm->write(m_buf, next(write));
+    }
+
+    virtual int32_t error(int32_t v)
+    {
+        m_pThis->m_lock.lock();
+        m_pThis->m_out.clear();
+        m_pThis->m_closed = true;
+        m_pThis->m_writing = false;
+        m_pThis->m_lock.unlock();
+
+        m_pThis->wake();
+        m_pThis->check_close();
+
+        return v;
+    }
+
+private:
+    obj_ptr<Buffer_base> m_buf;
+};
+
+class Http2Session::asyncSend : public asyncSession {
+public:
+    asyncSend(Http2Session* pThis, int32_t id, Stream* stm, SeekableStream_base* body, int64_t len,
+        AsyncEvent* ac)
+        : asyncSession(pThis, ac)
+        , m_id(id)
+        , m_stream(stm)
+        , m_body(body)
+        , m_len(len)
+        , m_sent(0)
+        , m_pos(0)
+    {
+        next(read);
+    }
+
+    ON_STATE(asyncSend, read)
+    {
+        int64_t sz = m_len - m_sent;
+        if (sz > H2_READ_SIZE)
+            sz = H2_READ_SIZE;
+
+        return m_body->read((int32_t)sz, m_buf, next(data));
+    }
+
+    ON_STATE(asyncSend, data)
+    {
+        if (n == CALL_RETURN_NULL) {
+            exlib::string frames;
+
+            put_frame(frames, H2_DATA, H2_FLAG_END_STREAM, m_id, NULL, 0);
+
+            m_pThis->m_lock.lock();
+            m_stream->m_local = true;
+            m_pThis->flush(frames);
+
+            return next();
+        }
+
+        m_buf->toString(m_chunk);
+        m_buf.Release();
+        m_pos = 0;
+
+        return next(window);
+    }
+
+    ON_STATE(asyncSend, window)
+    {
+        Http2Session* s = m_pThis;
+
+        s->m_lock.lock();
+
+        if (s->m_closed || m_stream->m_reset) {
+            s->m_lock.unlock();
+            return next();
+        }
+
+        int64_t avail = m_stream->m_window;
+        if (avail > s->m_window)
+            avail = s->m_window;
+        if (avail > s->m_maxFrame)
+            avail = s->m_maxFrame;
+
+        if (avail <= 0) {
+            next(window);
+            s->m_waiters.push_back(this);
+            s->m_lock.unlock();
+
+            return CALL_E_PENDDING;
+        }
+
+        int64_t sz = (int64_t)m_chunk.length() - m_pos;
+        if (sz > avail)
+            sz = avail;
+
+        m_stream->m_window -= sz;
+        s->m_window -= sz;
+
+        m_sent += sz;
+        bool last = m_sent >= m_len;
+        if (last)
+            m_stream->m_local = true;
+
+        exlib::string frames;
+        put_frame(frames, H2_DATA, last ? H2_FLAG_END_STREAM : 0, m_id,
+            m_chunk.c_str() + m_pos, (size_t)sz);
+        m_pos += (size_t)sz;
+
+        s->flush(frames);
+
+        if (last)
+            return next();
+
+        if (m_pos < m_chunk.length())
+            return next(window);
+
+        return next(read);
+    }
+
+private:
+    int32_t m_id;
+    obj_ptr<Stream> m_stream;
+    obj_ptr<SeekableStream_base> m_body;
+    obj_ptr<Buffer_base> m_buf;
+    exlib::string m_chunk;
+    int64_t m_len;
+    int64_t m_sent;
+    size_t m_pos;
+};
+
+class Http2Session::asyncRequest : public asyncSession {
+public:
+    asyncRequest(Http2Session* pThis, HttpRequest_base* req, exlib::string scheme,
+        exlib::string authority, SeekableStream_base* response_body,
+        obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
+        : asyncSession(pThis, ac)
+        , m_retVal(retVal)
+        , m_id(0)
+    {
+        exlib::string method;
+        exlib::string path;
+        exlib::string query;
+        obj_ptr<HttpCollection_base> headers;
+
+        req->get_method(method);
+        req->get_address(path);
+        req->get_queryString(query);
+        if (!query.empty()) {
+            path.append(1, '?');
+            path.append(query);
+        }
+
+        HPackEncoder::encode(":method", method, m_block);
+        HPackEncoder::encode(":scheme", scheme, m_block);
+        HPackEncoder::encode(":authority", authority, m_block);
+        HPackEncoder::encode(":path", path, m_block);
+
+        req->get_headers(headers);
+        encode_headers((HttpCollection*)(HttpCollection_base*)headers, true, m_block);
+
+        req->get_length(m_len);
+        if (m_len > 0) {
+            char buf[32];
+
+            snprintf(buf, sizeof(buf), "%lld", (long long)m_len);
+            HPackEncoder::encode("content-length", buf, m_block);
+
+            req->get_body(m_body);
+            m_body->rewind();
+        } else
+            m_len = 0;
+
+        m_rep = new HttpResponse();
+        m_rep->set_protocol("HTTP/2.0");
+        m_rep->set_maxHeadersCount(pThis->m_maxHeadersCount);
+        m_rep->set_maxHeaderSize(pThis->m_maxHeaderSize);
+        m_rep->set_maxBodySize(pThis->m_maxBodySize);
+        if (response_body)
+            m_rep->set_body(response_body);
+
+        next(open);
+    }
+
+    ON_STATE(asyncRequest, open)
+    {
+        Http2Session* s = m_pThis;
+
+        s->m_lock.lock();
+        if (s->m_closed || s->m_goaway || s->m_nextId > H2_MAX_ID - 2) {
+            s->m_goaway = true;
+            s->m_lock.unlock();
+            return CHECK_ERROR(Runtime::setError("HttpClient: http/2 connection closed."));
+        }
+
+        if (s->m_active >= s->m_maxStreams) {
+            next(open);
+            s->m_waiters.push_back(this);
+            s->m_lock.unlock();
+
+            return CALL_E_PENDDING;
+        }
+
+        bool last = m_len == 0;
+
+        m_id = s->m_nextId;
+        s->m_nextId += 2;
+
+        m_stream = new Stream(s->m_initWindow);
+        m_stream->m_rep = m_rep;
+        m_stream->m_local = last;
+        s->m_streams[m_id] = m_stream;
+        s->m_active++;
+
+        // stream ids must reach the peer in order, so the headers are queued under the same lock
+        s->headers(m_id, m_block, last);
+
+        if (last)
+            return next(wait);
+
+        return (new asyncSend(s, m_id, m_stream, m_body, m_len, next(wait)))->post(0);
+    }
+
+    ON_STATE(asyncRequest, wait)
+    {
+        Http2Session* s = m_pThis;
+
+        s->m_lock.lock();
+        if (!m_stream->m_remote) {
+            next(done);
+            m_stream->m_ac = this;
+            s->m_lock.unlock();
+
+            return CALL_E_PENDDING;
+        }
+        s->m_lock.unlock();
+
+        return next(done);
+    }
+
+    ON_STATE(asyncRequest, done)
+    {
+        if (!m_stream->m_error.empty())
+            return CHECK_ERROR(Runtime::setError(m_stream->m_error));
+
+        obj_ptr<SeekableStream_base> body;
+
+        m_rep->get_body(body);
+        if (body)
+            body->rewind();
+
+        m_retVal = m_rep;
+        return next();
+    }
+
+    virtual int32_t error(int32_t v)
+    {
+        // the request body could not be read, the stream goes away with it
+        if (m_stream)
+            m_pThis->finish(m_id, m_stream, "", false);
+
+        return v;
+    }
+
+private:
+    obj_ptr<HttpResponse> m_rep;
+    obj_ptr<HttpResponse_base>& m_retVal;
+    exlib::string m_block;
+    obj_ptr<SeekableStream_base> m_body;
+    int64_t m_len;
+    int32_t m_id;
+    obj_ptr<Stream> m_stream;
+};
+
+Http2Session::Http2Session(HttpHandler* hdlr, Stream_base* stm, BufferedStream_base* stmBuffered,
+    Isolate* isolate)
+    : m_hdlr(hdlr)
+    , m_stm(stm)
+    , m_stmBuffered(stmBuffered)
+    , m_isolate(isolate)
+    , m_client(false)
+    , m_maxHeadersCount(hdlr->m_maxHeadersCount)
+    , m_maxHeaderSize(hdlr->m_maxHeaderSize)
+    , m_maxBodySize(hdlr->m_maxBodySize)
+    , m_headerId(0)
+    , m_headerEnd(false)
+    , m_lastId(0)
+    , m_window(H2_DEFAULT_WINDOW)
+    , m_initWindow(H2_DEFAULT_WINDOW)
+    , m_maxFrame(H2_DEFAULT_FRAME)
+    , m_active(0)
+    , m_buffered(0)
+    , m_closed(false)
+    , m_nextId(1)
+    , m_maxStreams(H2_MAX_STREAMS)
+    , m_goaway(false)
+    , m_shutdown(false)
+    , m_writing(false)
+    , m_closer(NULL)
+{
+}
+
+Http2Session::Http2Session(Stream_base* stm, int32_t maxHeadersCount, int32_t maxHeaderSize,
+    int32_t maxBodySize, Isolate* isolate)
+    : m_stm(stm)
+    , m_isolate(isolate)
+    , m_client(true)
+    , m_maxHeadersCount(maxHeadersCount)
+    , m_maxHeaderSize(maxHeaderSize)
+    , m_maxBodySize(maxBodySize)
+    , m_headerId(0)
+    , m_headerEnd(false)
+    , m_lastId(0)
+    , m_window(H2_DEFAULT_WINDOW)
+    , m_initWindow(H2_DEFAULT_WINDOW)
+    , m_maxFrame(H2_DEFAULT_FRAME)
+    , m_active(0)
+    , m_buffered(0)
+    , m_closed(false)
+    , m_nextId(1)
+    , m_maxStreams(H2_MAX_STREAMS)
+    , m_goaway(false)
+    , m_shutdown(false)
+    , m_writing(false)
+    , m_closer(NULL)
+{
+    m_stmBuffered = new BufferedStream(stm);
+    m_idle.now();
+}
+
+result_t Http2Session::run(int32_t preface, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new asyncRead(this, preface, ac))->post(0);
+}
+
+result_t Http2Session::send(int32_t id, HttpResponse_base* rep, bool headOnly, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    HttpResponse* r = (HttpResponse*)rep;
+    exlib::string block;
+    int64_t len;
+
+    r->flushCookies();
+    r->get_length(len);
+
+    HPackEncoder::encode_status(r->m_statusCode, block);
+    encode_headers(r->m_message->m_headers, false, block);
+
+    if (len >= 0) {
+        char buf[32];
+
+        snprintf(buf, sizeof(buf), "%lld", (long long)len);
+        HPackEncoder::encode("content-length", buf, block);
+    } else
+        len = 0;
+
+    bool last = headOnly || len == 0;
+    obj_ptr<Stream> stm;
+
+    m_lock.lock();
+    std::map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+    if (it == m_streams.end()) {
+        m_lock.unlock();
+        return 0;
+    }
+
+    stm = it->second;
+    stm->m_local = last;
+    headers(id, block, last);
+
+    if (last)
+        return 0;
+
+    obj_ptr<SeekableStream_base> body;
+
+    r->get_body(body);
+    body->rewind();
+
+    return (new asyncSend(this, id, stm, body, len, ac))->post(0);
+}
+
+void Http2Session::stream_end(int32_t id)
+{
+    m_lock.lock();
+    std::map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+    if (it != m_streams.end()) {
+        release(it->second);
+        m_streams.erase(it);
+    }
+    m_active--;
+    m_lock.unlock();
+
+    check_close();
+}
+
+// called with m_lock held, the request body of stm no longer counts against the connection
+void Http2Session::release(Stream* stm)
+{
+    m_buffered -= stm->m_size;
+    stm->m_size = 0;
+}
+
+int32_t Http2Session::on_frame(uint8_t type, uint8_t flags, int32_t id, exlib::string& data)
+{
+    obj_ptr<Stream> stm;
+
+    switch (type) {
+    case H2_DATA:
+        return on_data(id, flags, data);
+    case H2_HEADERS:
+        return on_headers(id, flags, data);
+    case H2_CONTINUATION:
+        m_headerBlock.append(data);
+        if ((int32_t)m_headerBlock.length() > m_maxHeaderSize * 4 + H2_DEFAULT_FRAME)
+            return H2_ENHANCE_YOUR_CALM;
+        if (flags & H2_FLAG_END_HEADERS)
+            return headers_done();
+        return H2_NO_ERROR;
+    case H2_PRIORITY:
+        if (id == 0)
+            return H2_PROTOCOL_ERROR;
+        if (data.length() != 5)
+            return H2_FRAME_SIZE_ERROR;
+        return H2_NO_ERROR;
+    case H2_RST_STREAM:
+        if (id == 0)
+            return H2_PROTOCOL_ERROR;
+        if (data.length() != 4)
+            return H2_FRAME_SIZE_ERROR;
+
+        m_lock.lock();
+        {
+            std::map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+            if (it != m_streams.end()) {
+                stm = it->second;
+                stm->m_reset = true;
+                if (!m_client && !stm->m_remote) {
+                    release(stm);
+                    m_streams.erase(it);
+                }
+            }
+        }
+        m_lock.unlock();
+
+        if (m_client && stm)
+            finish(id, stm, "HttpClient: http/2 stream was reset by the server.", true);
+
+        wake();
+        return H2_NO_ERROR;
+    case H2_SETTINGS:
+        if (id != 0)
+            return H2_PROTOCOL_ERROR;
+        return on_settings(flags, data);
+    case H2_PUSH_PROMISE:
+        return H2_PROTOCOL_ERROR;
+    case H2_PING:
+        if (id != 0)
+            return H2_PROTOCOL_ERROR;
+        if (data.length() != 8)
+            return H2_FRAME_SIZE_ERROR;
+        if (!(flags & H2_FLAG_ACK))
+            frame(H2_PING, H2_FLAG_ACK, 0, data.c_str(), data.length());
+        return H2_NO_ERROR;
+    case H2_GOAWAY:
+        if (m_client)
+            return on_goaway(data);
+        return H2_GOING_AWAY;
+    case H2_WINDOW_UPDATE: {
+        if (data.length() != 4)
+            return H2_FRAME_SIZE_ERROR;
+
+        int32_t inc = get_u32(data.c_str()) & 0x7fffffff;
+        if (inc == 0)
+            return H2_PROTOCOL_ERROR;
+
+        bool overflow = false;
+
+        m_lock.lock();
+        if (id == 0) {
+            m_window += inc;
+            if (m_window > H2_MAX_WINDOW) {
+                m_lock.unlock();
+                return H2_FLOW_CONTROL_ERROR;
+            }
+        } else {
+            std::map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+            if (it != m_streams.end()) {
+                stm = it->second;
+
+                stm->m_window += inc;
+                if (stm->m_window > H2_MAX_WINDOW) {
+                    // a stream error, only this stream goes away
+                    overflow = true;
+                    stm->m_reset = true;
+                    if (!m_client && !stm->m_remote) {
+                        release(stm);
+                        m_streams.erase(it);
+                    }
+                }
+            }
+        }
+        m_lock.unlock();
+
+        if (overflow) {
+            rst_stream(id, H2_FLOW_CONTROL_ERROR);
+            if (m_client)
+                finish(id, stm, "HttpClient: http/2 flow control error.", true);
+        }
+
+        wake();
+        return H2_NO_ERROR;
+    }
+    }
+
+    // unknown frame types must be ignored
+    return H2_NO_ERROR;
+}
+
+int32_t Http2Session::on_settings(uint8_t flags, exlib::string& data)
+{
+    if (flags & H2_FLAG_ACK)
+        return data.length() ? H2_FRAME_SIZE_ERROR : H2_NO_ERROR;
+
+    if (data.length() % 6)
+        return H2_FRAME_SIZE_ERROR;
+
+    const char* p = data.c_str();
+
+    m_lock.lock();
+    for (size_t i = 0; i < data.length(); i += 6) {
+        int32_t key = ((uint8_t)p[i] << 8) | (uint8_t)p[i + 1];
+        uint32_t value = get_u32(p + i + 2);
+
+        if (key == 0x3) {
+            // the streams a client may open at once, capped by our own limit
+            m_maxStreams = value < H2_MAX_STREAMS ? (int32_t)value : H2_MAX_STREAMS;
+        } else if (key == 0x4) {
+            if (value > H2_MAX_WINDOW) {
+                m_lock.unlock();
+                return H2_FLOW_CONTROL_ERROR;
+            }
+
+            int64_t delta = (int64_t)value - m_initWindow;
+            std::map<int32_t, obj_ptr<Stream>>::iterator it;
+
+            for (it = m_streams.begin(); it != m_streams.end(); ++it) {
+                it->second->m_window += delta;
+                if (it->second->m_window > H2_MAX_WINDOW) {
+                    m_lock.unlock();
+                    return H2_FLOW_CONTROL_ERROR;
+                }
+            }
+            m_initWindow = (int32_t)value;
+        } else if (key == 0x5) {
+            if (value < H2_DEFAULT_FRAME || value > 0xffffff) {
+                m_lock.unlock();
+                return H2_PROTOCOL_ERROR;
+            }
+
+            m_maxFrame = (int32_t)value;
+        }
+    }
+    m_lock.unlock();
+
+    frame(H2_SETTINGS, H2_FLAG_ACK, 0, NULL, 0);
+    wake();
+
+    return H2_NO_ERROR;
+}
+
+int32_t Http2Session::on_headers(int32_t id, uint8_t flags, exlib::string& data)
+{
+    if (id == 0 || !(id & 1))
+        return H2_PROTOCOL_ERROR;
+
+    size_t pos = 0;
+    size_t pad = 0;
+
+    if (flags & H2_FLAG_PADDED) {
+        if (data.length() < 1)
+            return H2_FRAME_SIZE_ERROR;
+        pad = (uint8_t)data[0];
+        pos = 1;
+    }
+
+    if (flags & H2_FLAG_PRIORITY)
+        pos += 5;
+
+    if (pos + pad > data.length())
+        return H2_PROTOCOL_ERROR;
+
+    m_headerBlock.assign(data.c_str() + pos, data.length() - pos - pad);
+    m_headerId = id;
+    m_headerEnd = (flags & H2_FLAG_END_STREAM) != 0;
+
+    if (flags & H2_FLAG_END_HEADERS)
+        return headers_done();
+
+    return H2_NO_ERROR;
+}
+
+int32_t Http2Session::headers_done()
+{
+    std::vector<hpack_field> fields;
+    int32_t id = m_headerId;
+    bool end = m_headerEnd;
+    result_t hr;
+
+    m_headerId = 0;
+
+    hr = m_decoder.decode(m_headerBlock.c_str(), m_headerBlock.length(), fields,
+        m_maxHeaderSize + 32 * (m_maxHeadersCount + 4));
+    m_headerBlock.clear();
+
+    if (hr == CALL_E_OVERFLOW || (int32_t)fields.size() > m_maxHeadersCount + 4)
+        return H2_ENHANCE_YOUR_CALM;
+    if (hr < 0)
+        return H2_COMPRESSION_ERROR;
+
+    if (m_client)
+        return on_response(id, end, fields);
+
+    obj_ptr<Stream> stm;
+
+    m_lock.lock();
+    std::map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+    if (it != m_streams.end())
+        stm = it->second;
+    size_t count = m_streams.size();
+    m_lock.unlock();
+
+    if (stm) {
+        // trailers, the fields are dropped
+        if (stm->m_remote || !end)
+            return H2_PROTOCOL_ERROR;
+
+        dispatch(id, stm);
+        return H2_NO_ERROR;
+    }
+
+    if (id <= m_lastId)
+        return H2_PROTOCOL_ERROR;
+    m_lastId = id;
+
+    if (count >= H2_MAX_STREAMS) {
+        rst_stream(id, H2_REFUSED_STREAM);
+        return H2_NO_ERROR;
+    }
+
+    obj_ptr<HttpRequest> req = new HttpRequest();
+    exlib::string method;
+    exlib::string path;
+    exlib::string authority;
+    exlib::string cookie;
+    bool host = false;
+
+    req->set_protocol("HTTP/2.0");
+    req->set_maxHeadersCount(m_maxHeadersCount);
+    req->set_maxBodySize(m_maxBodySize);
+
+    for (size_t i = 0; i < fields.size(); i++) {
+        hpack_field& f = fields[i];
+
+        if (f.first[0] == ':') {
+            if (f.first == ":method")
+                method = f.second;
+            else if (f.first == ":path")
+                path = f.second;
+            else if (f.first == ":authority")
+                authority = f.second;
+            else if (f.first != ":scheme") {
+                rst_stream(id, H2_PROTOCOL_ERROR);
+                return H2_NO_ERROR;
+            }
+        } else if (f.first == "cookie") {
+            if (!cookie.empty())
+                cookie.append("; ", 2);
+            cookie.append(f.second);
+        } else {
+            if (f.first == "host")
+                host = true;
+            req->addHeader(f.first, f.second);
+        }
+    }
+
+    if (method.empty() || path.empty()) {
+        rst_stream(id, H2_PROTOCOL_ERROR);
+        return H2_NO_ERROR;
+    }
+
+    if (!host && !authority.empty())
+        req->addHeader("host", authority);
+    if (!cookie.empty())
+        req->addHeader("cookie", cookie);
+
+    req->set_method(method);
+
+    size_t q = path.find('?');
+    if (q != exlib::string::npos) {
+        req->set_address(path.substr(0, q));
+        req->set_queryString(path.substr(q + 1));
+    } else
+        req->set_address(path);
+
+    stm = new Stream(m_initWindow);
+    stm->m_req = req;
+
+    m_lock.lock();
+    m_streams[id] = stm;
+    m_lock.unlock();
+
+    if (end)
+        dispatch(id, stm);
+
+    return H2_NO_ERROR;
+}
+
+int32_t Http2Session::on_data(int32_t id, uint8_t flags, exlib::string& data)
+{
+    if (id == 0)
+        return H2_PROTOCOL_ERROR;
+
+    size_t pos = 0;
+    size_t pad = 0;
+
+    if (flags & H2_FLAG_PADDED) {
+        if (data.length() < 1)
+            return H2_FRAME_SIZE_ERROR;
+        pad = (uint8_t)data[0];
+        pos = 1;
+    }
+
+    if (pos + pad > data.length())
+        return H2_PROTOCOL_ERROR;
+
+    obj_ptr<Stream> stm;
+    int32_t code = H2_NO_ERROR;
+    size_t sz = data.length() - pos - pad;
+
+    m_lock.lock();
+    std::map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+    if (it != m_streams.end())
+        stm = it->second;
+
+    if (!stm || stm->m_remote)
+        code = H2_STREAM_CLOSED;
+    else if (m_client && !stm->m_response)
+        code = H2_PROTOCOL_ERROR;
+    else if (sz && m_maxBodySize >= 0) {
+        // the request bodies held by a connection are capped at what a single http/1 request
+        // may buffer. a stream that would go past it is refused, the peer may retry it later
+        int64_t max = (int64_t)m_maxBodySize * 1024 * 1024;
+
+        if (stm->m_size + (int64_t)sz > max)
+            code = H2_CANCEL;
+        else if (!m_client && m_buffered + (int64_t)sz > max)
+            code = H2_REFUSED_STREAM;
+
+        if (code != H2_NO_ERROR && !m_client) {
+            release(stm);
+            m_streams.erase(it);
+        }
+    }
+
+    if (code == H2_NO_ERROR) {
+        stm->m_size += sz;
+        m_buffered += sz;
+    }
+    m_lock.unlock();
+
+    // the whole frame counts against the connection window, padding included. its payload is
+    // either dropped or held within the cap above, so the window can be given back right away
+    if (data.length())
+        window_update(0, (int32_t)data.length());
+
+    if (code != H2_NO_ERROR) {
+        rst_stream(id, code);
+
+        if (m_client && code != H2_STREAM_CLOSED)
+            finish(id, stm, code == H2_CANCEL ? "HttpMessage: body is too huge." : "HttpClient: invalid http/2 response.", true);
+
+        return H2_NO_ERROR;
+    }
+
+    if (sz) {
+        obj_ptr<SeekableStream_base> body;
+        obj_ptr<Buffer_base> buf = new Buffer(data.c_str() + pos, sz);
+
+        if (m_client)
+            stm->m_rep->get_body(body);
+        else
+            stm->m_req->get_body(body);
+        body->write(buf, NULL);
+    }
+
+    if (flags & H2_FLAG_END_STREAM) {
+        if (m_client)
+            finish(id, stm, "", false);
+        else
+            dispatch(id, stm);
+    } else if (data.length())
+        window_update(id, (int32_t)data.length());
+
+    return H2_NO_ERROR;
+}
+
+void Http2Session::dispatch(int32_t id, Stream* stm)
+{
+    obj_ptr<SeekableStream_base> body;
+
+    stm->m_remote = true;
+
+    stm->m_req->get_body(body);
+    if (body)
+        body->rewind();
+
+    m_lock.lock();
+    m_active++;
+    m_lock.unlock();
+
+    m_hdlr->invoke_h2(this, id, stm->m_req);
+}
+
+int32_t Http2Session::on_response(int32_t id, bool end, std::vector<hpack_field>& fields)
+{
+    obj_ptr<Stream> stm;
+    int32_t nextId;
+
+    m_lock.lock();
+    std::map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+    if (it != m_streams.end())
+        stm = it->second;
+    nextId = m_nextId;
+    m_lock.unlock();
+
+    // a stream that is already over, the block was decoded only to keep the table in step
+    if (!stm)
+        return id < nextId ? H2_NO_ERROR : H2_PROTOCOL_ERROR;
+
+    if (stm->m_response) {
+        // trailers, the fields are dropped
+        if (!end)
+            return H2_PROTOCOL_ERROR;
+
+        finish(id, stm, "", false);
+        return H2_NO_ERROR;
+    }
+
+    int32_t status = 0;
+
+    for (size_t i = 0; i < fields.size(); i++) {
+        hpack_field& f = fields[i];
+
+        if (f.first[0] == ':') {
+            if (f.first != ":status") {
+                status = 0;
+                break;
+            }
+
+            status = atoi(f.second.c_str());
+        }
+    }
+
+    if (status < 100 || status > 999 || (status < 200 && end)) {
+        rst_stream(id, H2_PROTOCOL_ERROR);
+        finish(id, stm, "HttpClient: invalid http/2 response.", true);
+        return H2_NO_ERROR;
+    }
+
+    // an informational response, the final one follows on the same stream
+    if (status < 200)
+        return H2_NO_ERROR;
+
+    stm->m_rep->set_statusCode(status);
+    for (size_t i = 0; i < fields.size(); i++)
+        if (fields[i].first[0] != ':')
+            stm->m_rep->addHeader(fields[i].first, fields[i].second);
+    stm->m_response = true;
+
+    if (end)
+        finish(id, stm, "", false);
+
+    return H2_NO_ERROR;
+}
+
+int32_t Http2Session::on_goaway(exlib::string& data)
+{
+    if (data.length() < 8)
+        return H2_FRAME_SIZE_ERROR;
+
+    int32_t lastId = get_u32(data.c_str()) & 0x7fffffff;
+    bool done;
+
+    m_lock.lock();
+    m_goaway = true;
+    m_lock.unlock();
+
+    // the streams the server never looked at fail at once, the others run to the end
+    fail_all(lastId, "HttpClient: http/2 connection is going away.");
+
+    m_lock.lock();
+    done = m_active == 0;
+    m_lock.unlock();
+
+    return done ? H2_GOING_AWAY : H2_NO_ERROR;
+}
+
+// client: the stream is over, the request waiting for it picks up the response or the error.
+// reset tells that the peer already knows the stream is gone
+void Http2Session::finish(int32_t id, Stream* stm, exlib::string error, bool reset)
+{
+    AsyncEvent* ac;
+    bool rst;
+    bool close;
+
+    m_lock.lock();
+    std::map<int32_t, obj_ptr<Stream>>::iterator it = m_streams.find(id);
+    if (it == m_streams.end() || it->second != stm) {
+        m_lock.unlock();
+        return;
+    }
+
+    m_streams.erase(it);
+    m_active--;
+    if (m_active == 0)
+        m_idle.now();
+
+    // the response is complete before the request body, the rest of the body is not needed
+    rst = !reset && !stm->m_local;
+
+    stm->m_remote = true;
+    stm->m_reset = true;
+    stm->m_error = error;
+
+    ac = stm->m_ac;
+    stm->m_ac = NULL;
+
+    close = m_goaway && m_active == 0;
+    m_lock.unlock();
+
+    if (rst)
+        rst_stream(id, H2_CANCEL);
+
+    if (ac)
+        ac->apost(0);
+
+    wake();
+
+    if (close)
+        shutdown();
+}
+
+void Http2Session::fail_all(int32_t lastId, exlib::string error)
+{
+    std::vector<std::pair<int32_t, obj_ptr<Stream>>> streams;
+    std::map<int32_t, obj_ptr<Stream>>::iterator it;
+
+    m_lock.lock();
+    for (it = m_streams.upper_bound(lastId); it != m_streams.end(); ++it)
+        streams.push_back(*it);
+    m_lock.unlock();
+
+    for (size_t i = 0; i < streams.size(); i++)
+        finish(streams[i].first, streams[i].second, error, true);
+}
+
+void Http2Session::start()
+{
+    exlib::string frames(H2_PREFACE, sizeof(H2_PREFACE) - 1);
+    char settings[6];
+
+    // no server push, responses only come on the streams we open
+    settings[0] = 0;
+    settings[1] = 0x2;
+    put_u32(settings + 2, 0);
+    put_frame(frames, H2_SETTINGS, 0, 0, settings, sizeof(settings));
+
+    m_lock.lock();
+    flush(frames);
+
+    (new asyncRead(this, 0, NULL))->apost(0);
+}
+
+result_t Http2Session::request(HttpRequest_base* req, exlib::string scheme, exlib::string authority,
+    SeekableStream_base* response_body, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new asyncRequest(this, req, scheme, authority, response_body, retVal, ac))->post(0);
+}
+
+bool Http2Session::available()
+{
+    bool r;
+
+    m_lock.lock();
+    r = !m_closed && !m_goaway;
+    m_lock.unlock();
+
+    return r;
+}
+
+bool Http2Session::expired(date_t& d, int32_t timeout)
+{
+    bool r;
+
+    m_lock.lock();
+    r = m_active == 0 && d.diff(m_idle) >= (double)timeout;
+    m_lock.unlock();
+
+    return r;
+}
+
+void Http2Session::shutdown()
+{
+    exlib::string frames;
+    char buf[8];
+
+    m_lock.lock();
+    m_goaway = true;
+    if (m_shutdown || m_closed || m_active > 0) {
+        m_lock.unlock();
+        return;
+    }
+
+    m_shutdown = true;
+
+    // a client never accepts streams from the server, so the last stream id is 0
+    put_u32(buf, 0);
+    put_u32(buf + 4, H2_NO_ERROR);
+    put_frame(frames, H2_GOAWAY, 0, 0, buf, sizeof(buf));
+    flush(frames);
+}
+
+// called with m_lock held, releases it
+void Http2Session::headers(int32_t id, exlib::string& block, bool last)
+{
+    exlib::string frames;
+    size_t maxFrame = m_maxFrame;
+    size_t pos = 0;
+
+    do {
+        size_t sz = block.length() - pos;
+        if (sz > maxFrame)
+            sz = maxFrame;
+
+        uint8_t flags = pos + sz == block.length() ? H2_FLAG_END_HEADERS : 0;
+        if (pos == 0) {
+            if (last)
+                flags |= H2_FLAG_END_STREAM;
+            put_frame(frames, H2_HEADERS, flags, id, block.c_str(), sz);
+        } else
+            put_frame(frames, H2_CONTINUATION, flags, id, block.c_str() + pos, sz);
+
+        pos += sz;
+    } while (pos < block.length());
+
+    flush(frames);
+}
+
+void Http2Session::frame(uint8_t type, uint8_t flags, int32_t id, const char* data, size_t len)
+{
+    exlib::string frames;
+
+    put_frame(frames, type, flags, id, data, len);
+
+    m_lock.lock();
+    flush(frames);
+}
+
+void Http2Session::window_update(int32_t id, int32_t inc)
+{
+    char buf[4];
+
+    put_u32(buf, inc);
+    frame(H2_WINDOW_UPDATE, 0, id, buf, sizeof(buf));
+}
+
+void Http2Session::rst_stream(int32_t id, int32_t code)
+{
+    char buf[4];
+
+    put_u32(buf, code);
+    frame(H2_RST_STREAM, 0, id, buf, sizeof(buf));
+}
+
+void Http2Session::goaway(int32_t code)
+{
+    char buf[8];
+
+    put_u32(buf, m_lastId);
+    put_u32(buf + 4, code);
+    frame(H2_GOAWAY, 0, 0, buf, sizeof(buf));
+}
+
+// called with m_lock held, releases it
+void Http2Session::flush(exlib::string& frames)
+{
+    bool start = false;
+
+    m_out.append(frames);
+    if (!m_writing) {
+        m_writing = true;
+        start = true;
+    }
+
+    m_lock.unlock();
+
+    if (start)
+        (new asyncWrite(this))->apost(0);
+}
+
+void Http2Session::wake()
+{
+    std::list<AsyncEvent*> waiters;
+
+    m_lock.lock();
+    waiters.swap(m_waiters);
+    m_lock.unlock();
+
+    while (!waiters.empty()) {
+        waiters.front()->apost(0);
+        waiters.pop_front();
+    }
+}
+
+void Http2Session::check_close()
+{
+    AsyncEvent* ac = NULL;
+
+    m_lock.lock();
+    if (m_closer && m_active == 0 && !m_writing) {
+        ac = m_closer;
+        m_closer = NULL;
+    }
+    m_lock.unlock();
+
+    if (ac)
+        ac->apost(0);
+}
+
+} /* namespace fibjs */
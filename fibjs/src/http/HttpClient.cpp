@@ -11,6 +11,7 @@
 #include "HttpRequest.h"
 #include "SslSocket.h"
 #include "BufferedStream.h"
+#include "Timer.h"
 #include "inetAddr.h"
 #include "ifs/net.h"
 #include "ifs/zlib.h"
@@ -21,6 +22,8 @@
 
 namespace fibjs {
 
+static const char* s_alpn[] = { "h2", "http/1.1", NULL };
+
 result_t HttpClient_base::_new(obj_ptr<HttpClient_base>& retVal, v8::Local<v8::Object> This)
 {
     retVal = new HttpClient();
@@ -81,6 +84,20 @@ result_t HttpClient::set_enableEncoding(bool newVal)
     return 0;
 }
 
+result_t HttpClient::get_enableHttp2(bool& retVal)
+{
+    retVal = m_enableHttp2;
+    return 0;
+}
+
+result_t HttpClient::set_enableHttp2(bool newVal)
+{
+    m_enableHttp2 = newVal;
+    clean_conn();
+
+    return 0;
+}
+
 result_t HttpClient::get_maxHeadersCount(int32_t& retVal)
 {
     retVal = m_maxHeadersCount;
@@ -159,6 +176,352 @@ result_t HttpClient::set_poolTimeout(int32_t newVal)
     return 0;
 }
 
+result_t HttpClient::get_poolMaxActive(int32_t& retVal)
+{
+    retVal = m_poolMaxActive;
+    return 0;
+}
+
+result_t HttpClient::set_poolMaxActive(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    std::vector<obj_ptr<Waiter>> waiters;
+
+    m_poolLock.lock();
+    m_poolMaxActive = newVal;
+    for (auto& it : m_pool)
+        wake_conn(it.second, waiters);
+    m_poolLock.unlock();
+
+    for (size_t i = 0; i < waiters.size(); i++)
+        waiters[i]->m_ac->apost(0);
+
+    return 0;
+}
+
+result_t HttpClient::get_poolStats(v8::Local<v8::Object>& retVal)
+{
+    Isolate* isolate = holder();
+    v8::Local<v8::Context> context = isolate->context();
+    v8::Local<v8::Object> o = v8::Object::New(isolate->m_isolate);
+    int32_t origins, idle = 0, active = 0, waiting = 0;
+    int64_t hits, misses, evictions;
+
+    m_poolLock.lock();
+    origins = (int32_t)m_pool.size();
+    for (auto& it : m_pool) {
+        idle += (int32_t)it.second.m_idle.size();
+        active += it.second.m_active;
+        waiting += (int32_t)it.second.m_waiters.size();
+    }
+    hits = m_hits;
+    misses = m_misses;
+    evictions = m_evictions;
+    m_poolLock.unlock();
+
+    o->Set(context, isolate->NewString("hits"), v8::Number::New(isolate->m_isolate, (double)hits)).IsJust();
+    o->Set(context, isolate->NewString("misses"), v8::Number::New(isolate->m_isolate, (double)misses)).IsJust();
+    o->Set(context, isolate->NewString("evictions"), v8::Number::New(isolate->m_isolate, (double)evictions)).IsJust();
+    o->Set(context, isolate->NewString("origins"), v8::Number::New(isolate->m_isolate, origins)).IsJust();
+    o->Set(context, isolate->NewString("idle"), v8::Number::New(isolate->m_isolate, idle)).IsJust();
+    o->Set(context, isolate->NewString("active"), v8::Number::New(isolate->m_isolate, active)).IsJust();
+    o->Set(context, isolate->NewString("waiting"), v8::Number::New(isolate->m_isolate, waiting)).IsJust();
+
+    retVal = o;
+    return 0;
+}
+
+#define POOL_REAP_INTERVAL 1000
+
+class PoolReaper : public Timer {
+public:
+    PoolReaper(HttpClient* hc)
+        : Timer(POOL_REAP_INTERVAL)
+        , m_hc(hc)
+    {
+    }
+
+public:
+    virtual void on_timer()
+    {
+        if (m_hc->reap_conn())
+            (new PoolReaper(m_hc))->sleep();
+    }
+
+private:
+    obj_ptr<HttpClient> m_hc;
+};
+
+void HttpClient::expire_conn(Origin& o, date_t& d, std::vector<obj_ptr<Conn>>& drop_conns)
+{
+    size_t n = 0;
+
+    while (n < o.m_idle.size() && d.diff(o.m_idle[n]->d) >= (double)m_poolTimeout)
+        n++;
+
+    if (n > 0) {
+        drop_conns.insert(drop_conns.end(), o.m_idle.begin(), o.m_idle.begin() + n);
+        o.m_idle.erase(o.m_idle.begin(), o.m_idle.begin() + n);
+        m_evictions += n;
+    }
+}
+
+// hands free slots to the waiters in arrival order, a slot goes straight to the
+// front waiter so a request arriving meanwhile can not take it first
+void HttpClient::wake_conn(Origin& o, std::vector<obj_ptr<Waiter>>& waiters)
+{
+    while (!o.m_waiters.empty() && (m_poolMaxActive <= 0 || o.m_active < m_poolMaxActive)) {
+        obj_ptr<Waiter> w = o.m_waiters.front();
+        o.m_waiters.pop_front();
+
+        o.m_active++;
+        if (!o.m_idle.empty()) {
+            w->m_conn = o.m_idle.back()->conn;
+            o.m_idle.pop_back();
+            m_hits++;
+        } else
+            m_misses++;
+
+        // still under the lock, so the timer can not be finishing at the same time
+        w->m_granted = true;
+        w->clear();
+
+        waiters.push_back(w);
+    }
+}
+
+void HttpClient::timeout_conn(Waiter* w)
+{
+    bool found = false;
+
+    m_poolLock.lock();
+    auto it = m_pool.find(w->m_url);
+    if (it != m_pool.end()) {
+        std::list<obj_ptr<Waiter>>& ws = it->second.m_waiters;
+
+        for (auto it1 = ws.begin(); it1 != ws.end(); it1++)
+            if (*it1 == w) {
+                ws.erase(it1);
+                found = true;
+                break;
+            }
+    }
+    m_poolLock.unlock();
+
+    if (found)
+        w->m_ac->apost(0);
+}
+
+result_t HttpClient::get_conn(exlib::string url, obj_ptr<Stream_base>& _conn, obj_ptr<Waiter>& waiter,
+    AsyncEvent* ac)
+{
+    std::vector<obj_ptr<Conn>> drop_conns;
+    date_t d;
+
+    if (waiter) {
+        obj_ptr<Waiter> w = waiter;
+
+        waiter.Release();
+        if (!w->m_granted)
+            return CHECK_ERROR(Runtime::setError("HttpClient: timeout waiting for a connection slot."));
+
+        _conn = w->m_conn;
+        return 0;
+    }
+
+    d.now();
+
+    m_poolLock.lock();
+    Origin& o = m_pool[url];
+
+    // queue behind earlier waiters as well, they get the slots first
+    if (m_poolMaxActive > 0 && (o.m_active >= m_poolMaxActive || !o.m_waiters.empty())) {
+        waiter = new Waiter(this, url, ac, m_timeout);
+        o.m_waiters.push_back(waiter);
+
+        // armed under the lock, a handover can not clear the timer before it is running
+        waiter->sleep();
+        m_poolLock.unlock();
+
+        return CALL_E_PENDDING;
+    }
+
+    expire_conn(o, d, drop_conns);
+    o.m_active++;
+
+    if (!o.m_idle.empty()) {
+        _conn = o.m_idle.back()->conn;
+        o.m_idle.pop_back();
+        m_hits++;
+    } else
+        m_misses++;
+    m_poolLock.unlock();
+
+    return 0;
+}
+
+void HttpClient::save_conn(exlib::string url, Stream_base* _conn)
+{
+    obj_ptr<Conn> conn = new Conn();
+    std::vector<obj_ptr<Conn>> drop_conns;
+    std::vector<obj_ptr<Waiter>> waiters;
+    bool reap = false;
+
+    conn->d.now();
+    conn->conn = _conn;
+
+    m_poolLock.lock();
+    Origin& o = m_pool[url];
+
+    o.m_active--;
+    o.m_idle.push_back(conn);
+    wake_conn(o, waiters);
+
+    if ((int32_t)o.m_idle.size() > m_poolSize) {
+        size_t n = o.m_idle.size() - (m_poolSize > 0 ? m_poolSize : 0);
+
+        drop_conns.assign(o.m_idle.begin(), o.m_idle.begin() + n);
+        o.m_idle.erase(o.m_idle.begin(), o.m_idle.begin() + n);
+        m_evictions += n;
+    }
+
+    if (!m_reaping && !o.m_idle.empty()) {
+        m_reaping = true;
+        reap = true;
+    }
+    m_poolLock.unlock();
+
+    for (size_t i = 0; i < waiters.size(); i++)
+        waiters[i]->m_ac->apost(0);
+
+    if (reap)
+        (new PoolReaper(this))->sleep();
+}
+
+void HttpClient::release_conn(exlib::string url)
+{
+    std::vector<obj_ptr<Waiter>> waiters;
+
+    m_poolLock.lock();
+    Origin& o = m_pool[url];
+
+    o.m_active--;
+    wake_conn(o, waiters);
+    m_poolLock.unlock();
+
+    for (size_t i = 0; i < waiters.size(); i++)
+        waiters[i]->m_ac->apost(0);
+}
+
+void HttpClient::clean_conn()
+{
+    std::vector<obj_ptr<Conn>> drop_conns;
+    std::vector<obj_ptr<Http2Session>> drop_sessions;
+
+    m_poolLock.lock();
+    for (auto& it : m_pool) {
+        drop_conns.insert(drop_conns.end(), it.second.m_idle.begin(), it.second.m_idle.end());
+        it.second.m_idle.clear();
+
+        if (it.second.m_h2) {
+            drop_sessions.push_back(it.second.m_h2);
+            it.second.m_h2.Release();
+        }
+    }
+    m_poolLock.unlock();
+
+    // streams still running on a session finish before it goes away
+    for (size_t i = 0; i < drop_sessions.size(); i++)
+        drop_sessions[i]->shutdown();
+}
+
+bool HttpClient::reap_conn()
+{
+    std::vector<obj_ptr<Conn>> drop_conns;
+    std::vector<obj_ptr<Http2Session>> drop_sessions;
+    bool idle = false;
+    date_t d;
+
+    d.now();
+
+    m_poolLock.lock();
+    auto it = m_pool.begin();
+    while (it != m_pool.end()) {
+        Origin& o = it->second;
+
+        expire_conn(o, d, drop_conns);
+        if (!o.m_idle.empty())
+            idle = true;
+
+        if (o.m_h2) {
+            if (!o.m_h2->available() || o.m_h2->expired(d, m_poolTimeout)) {
+                drop_sessions.push_back(o.m_h2);
+                o.m_h2.Release();
+                m_evictions++;
+            } else
+                idle = true;
+        }
+
+        if (o.m_idle.empty() && o.m_active == 0 && o.m_waiters.empty() && !o.m_h2)
+            it = m_pool.erase(it);
+        else
+            it++;
+    }
+
+    m_reaping = idle;
+    m_poolLock.unlock();
+
+    for (size_t i = 0; i < drop_sessions.size(); i++)
+        drop_sessions[i]->shutdown();
+
+    return idle;
+}
+
+void HttpClient::get_session(exlib::string url, obj_ptr<Http2Session>& retVal)
+{
+    m_poolLock.lock();
+    auto it = m_pool.find(url);
+    if (it != m_pool.end() && it->second.m_h2) {
+        Origin& o = it->second;
+
+        if (o.m_h2->available()) {
+            retVal = o.m_h2;
+            m_hits++;
+        } else
+            o.m_h2.Release();
+    }
+    m_poolLock.unlock();
+}
+
+bool HttpClient::put_session(exlib::string url, Http2Session* session)
+{
+    bool reap = false;
+
+    m_poolLock.lock();
+    Origin& o = m_pool[url];
+
+    // two requests raced to connect, the first session stays in the pool
+    if (o.m_h2 && o.m_h2->available()) {
+        m_poolLock.unlock();
+        return false;
+    }
+
+    o.m_h2 = session;
+
+    if (!m_reaping) {
+        m_reaping = true;
+        reap = true;
+    }
+    m_poolLock.unlock();
+
+    if (reap)
+        (new PoolReaper(this))->sleep();
+
+    return true;
+}
+
 result_t HttpClient::get_http_proxy(exlib::string& retVal)
 {
     retVal = m_http_proxy;
@@ -186,11 +549,7 @@ result_t HttpClient::set_http_proxy(exlib::string newVal)
         m_http_proxy = newVal;
     }
 
-    date_t d;
-
-    d.now();
-    d.add(m_poolTimeout, date_t::_MICROSECOND);
-    clean_coon(d);
+    clean_conn();
 
     return 0;
 }
@@ -222,11 +581,7 @@ result_t HttpClient::set_https_proxy(exlib::string newVal)
         m_https_proxy = newVal;
     }
 
-    date_t d;
-
-    d.now();
-    d.add(m_poolTimeout, date_t::_MICROSECOND);
-    clean_coon(d);
+    clean_conn();
 
     return 0;
 }
@@ -422,14 +777,21 @@ result_t HttpClient::setClientCert(X509Cert_base* crt, PKey_base* key)
 
 result_t HttpClient::request(Stream_base* conn, HttpRequest_base* req, SeekableStream_base* response_body,
     obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
+{
+    return request(conn, NULL, req, response_body, retVal, ac);
+}
+
+result_t HttpClient::request(Stream_base* conn, Http2Session* session, HttpRequest_base* req,
+    SeekableStream_base* response_body, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
 {
     class asyncRequest : public AsyncState {
     public:
-        asyncRequest(HttpClient* hc, Stream_base* conn, HttpRequest_base* req, SeekableStream_base* response_body,
-            obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
+        asyncRequest(HttpClient* hc, Stream_base* conn, Http2Session* session, HttpRequest_base* req,
+            SeekableStream_base* response_body, obj_ptr<HttpResponse_base>& retVal, AsyncEvent* ac)
             : AsyncState(ac)
             , m_hc(hc)
             , m_conn(conn)
+            , m_session(session)
             , m_req(req)
             , m_response_body(response_body)
             , m_retVal(retVal)
@@ -443,6 +805,14 @@ result_t HttpClient::request(Stream_base* conn, HttpRequest_base* req, SeekableS
 
         ON_STATE(asyncRequest, send)
         {
+            if (m_session) {
+                exlib::string host;
+
+                m_req->firstHeader("Host", host);
+                return m_session->request(m_req, "https", host, m_response_body, m_retVal,
+                    next(m_hc->m_enableEncoding ? unzip : close));
+            }
+
             return m_req->sendTo(m_conn, next(recv));
         }
 
@@ -498,6 +868,7 @@ result_t HttpClient::request(Stream_base* conn, HttpRequest_base* req, SeekableS
     private:
         obj_ptr<HttpClient> m_hc;
         Stream_base* m_conn;
+        obj_ptr<Http2Session> m_session;
         HttpRequest_base* m_req;
         obj_ptr<BufferedStream> m_bs;
         obj_ptr<MemoryStream> m_unzip;
@@ -510,7 +881,7 @@ result_t HttpClient::request(Stream_base* conn, HttpRequest_base* req, SeekableS
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    return (new asyncRequest(this, conn, req, response_body, retVal, ac))->post(0);
+    return (new asyncRequest(this, conn, session, req, response_body, retVal, ac))->post(0);
 }
 
 result_t HttpClient::request(Stream_base* conn, HttpRequest_base* req,
@@ -536,6 +907,11 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
             , m_opts(opts)
             , m_retVal(retVal)
             , m_hc(hc)
+            , m_owner(Isolate::current())
+            , m_reuse(false)
+            , m_acquired(false)
+            , m_shared(false)
+            , m_fresh(false)
         {
             m_u->toString(m_url);
             if (m_response_body)
@@ -543,6 +919,12 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
             next(prepare);
         }
 
+        ~asyncRequest()
+        {
+            release_conn();
+            release_session();
+        }
+
         ON_STATE(asyncRequest, prepare)
         {
             bool _domain = false;
@@ -624,14 +1006,52 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
             else
                 m_sslhost.clear();
 
+            bool socks = m_http_proxy.c_str()[0] == 's';
+            m_poolKey = (m_http_proxy.empty() || socks || m_ssl) ? m_connUrl : m_http_proxy;
+
+            release_session();
+            m_h2 = m_ssl && m_hc->m_enableHttp2;
+            m_fresh = false;
+
+            return next(acquire);
+        }
+
+        ON_STATE(asyncRequest, acquire)
+        {
+            m_conn.Release();
+
+            // a live h2 session to the origin carries the request without taking a pool slot
+            if (m_h2 && !m_fresh) {
+                m_hc->get_session(m_poolKey, m_session);
+                if (m_session) {
+                    m_shared = true;
+                    m_reuse = true;
+                    return next(connected);
+                }
+            }
+
+            next(acquire);
+            result_t hr = m_hc->get_conn(m_poolKey, m_conn, m_waiter, this);
+            if (hr == CALL_E_PENDDING || hr < 0)
+                return hr;
+
+            m_acquired = true;
             m_reuse = false;
-            if (m_hc->get_conn(m_connUrl, m_conn)) {
+            if (m_conn) {
                 m_reuse = true;
                 return next(connected);
             }
 
+            return next(connect);
+        }
+
+        ON_STATE(asyncRequest, connect)
+        {
             if (m_http_proxy.empty()) {
-                if (m_ssl)
+                if (m_ssl && m_h2)
+                    return net_base::connect("tcp://" + m_connUrl.substr(6), m_hc->m_timeout,
+                        m_conn, next(ssl_handshake));
+                else if (m_ssl)
                     return ssl_base::connect(m_connUrl, m_hc->m_sslVerification,
                         m_hc->m_crt, m_hc->m_key, m_hc->m_timeout, m_conn, next(connected));
                 else
@@ -652,11 +1072,6 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
                         m_reqConn->addHeader("User-Agent", a);
                 }
 
-                if (m_hc->get_conn(m_http_proxy, m_conn)) {
-                    m_reuse = true;
-                    return next(m_ssl ? ssl_connect : connected);
-                }
-
                 obj_ptr<Url> u = new Url();
                 exlib::string connUrl;
                 const char* def_port;
@@ -810,6 +1225,9 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
             if (m_hc->m_sslVerification >= 0)
                 ss->set_verification(m_hc->m_sslVerification);
 
+            if (m_h2)
+                ss->set_alpn(s_alpn);
+
             obj_ptr<Stream_base> conn = m_conn;
             m_conn = ss;
 
@@ -828,6 +1246,20 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
 
         ON_STATE(asyncRequest, connected)
         {
+            if (m_h2 && !m_session && ((SslSocket*)(Stream_base*)m_conn)->alpn() == "h2") {
+                m_session = new Http2Session(m_conn, m_hc->m_maxHeadersCount, m_hc->m_maxHeaderSize,
+                    m_hc->m_maxBodySize, m_owner);
+                m_session->start();
+
+                // the session owns the connection now, the pool slot goes back to HTTP/1 requests
+                m_shared = m_hc->put_session(m_poolKey, m_session);
+                release_conn();
+                m_conn.Release();
+            }
+
+            if (m_session)
+                return m_hc->request(NULL, m_session, m_req, m_response_body, m_retVal, next(requested));
+
             if (!m_ssl)
                 ((Socket_base*)(Stream_base*)m_conn)->set_timeout(m_hc->m_timeout);
 
@@ -844,22 +1276,28 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
                 m_hc->update_cookies(m_url, cookies);
             }
 
+            if (m_session) {
+                release_session();
+                return next(closed);
+            }
+
             bool upgrade;
             m_retVal->get_upgrade(upgrade);
-            if (upgrade)
+            if (upgrade) {
+                release_conn();
                 return next(closed);
+            }
 
             bool keepalive;
             m_retVal->get_keepAlive(keepalive);
             if (keepalive) {
-                if (m_http_proxy.empty() || m_http_proxy.c_str()[0] == 's' || !m_sslhost.empty())
-                    m_hc->save_conn(m_connUrl, m_conn);
-                else
-                    m_hc->save_conn(m_http_proxy, m_conn);
+                m_acquired = false;
+                m_hc->save_conn(m_poolKey, m_conn);
 
                 return next(closed);
             }
 
+            release_conn();
             return m_conn->close(next(closed));
         }
 
@@ -897,15 +1335,44 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
 
         virtual int32_t error(int32_t v)
         {
-            if (m_reuse && (at(ssl_connect) || at(connected))) {
+            if (m_reuse && at(connected)) {
                 m_reuse = false;
-                next(prepare);
+
+                // the pooled session went away under us, dial a new connection for this request
+                if (m_session) {
+                    release_session();
+                    m_fresh = true;
+                    next(acquire);
+                    return 0;
+                }
+
+                next(connect);
                 return 0;
             }
 
             return v;
         }
 
+    private:
+        void release_conn()
+        {
+            if (m_acquired) {
+                m_acquired = false;
+                m_hc->release_conn(m_poolKey);
+            }
+        }
+
+        void release_session()
+        {
+            if (m_session) {
+                // a session that lost the race into the pool serves only this request
+                if (!m_shared)
+                    m_session->shutdown();
+                m_session.Release();
+            }
+            m_shared = false;
+        }
+
     private:
         exlib::string m_method;
         obj_ptr<Url> m_u;
@@ -923,10 +1390,18 @@ result_t HttpClient::request(exlib::string method, obj_ptr<Url>& u, SeekableStre
         obj_ptr<HttpRequest> m_req;
         obj_ptr<HttpRequest> m_reqConn;
         exlib::string m_connUrl;
+        exlib::string m_poolKey;
         obj_ptr<HttpClient> m_hc;
+        obj_ptr<HttpClient::Waiter> m_waiter;
+        obj_ptr<Http2Session> m_session;
         obj_ptr<Buffer_base> m_buffer;
+        Isolate* m_owner;
         int32_t m_temp;
         bool m_reuse;
+        bool m_acquired;
+        bool m_h2;
+        bool m_shared;
+        bool m_fresh;
     };
 
     if (ac->isSync())
@@ -23,6 +23,11 @@ size_t HttpCollection::size()
         sz += _pair.first.length() + _pair.second.length() + 4;
     }
 
+    for (i = 0; i < m_rawCount; i++) {
+        raw& _raw = m_raw[i];
+        sz += _raw.szName + _raw.szValue + 4;
+    }
+
     return sz;
 }
 
@@ -55,9 +60,39 @@ size_t HttpCollection::getData(char* buf, size_t sz)
         cp(buf, sz, pos, "\r\n", 2);
     }
 
+    for (i = 0; i < m_rawCount; i++) {
+        raw& _raw = m_raw[i];
+
+        cp(buf, sz, pos, m_arena.c_str() + _raw.name, _raw.szName);
+        cp(buf, sz, pos, ": ", 2);
+        cp(buf, sz, pos, m_arena.c_str() + _raw.value, _raw.szValue);
+        cp(buf, sz, pos, "\r\n", 2);
+    }
+
     return pos;
 }
 
+void HttpCollection::materialize()
+{
+    size_t i;
+
+    if (!m_rawCount)
+        return;
+
+    if (m_map.size() < m_count + m_rawCount)
+        m_map.resize(m_count + m_rawCount);
+
+    for (i = 0; i < m_rawCount; i++) {
+        raw& _raw = m_raw[i];
+        pair& _pair = m_map[m_count++];
+
+        _pair.first.assign(m_arena.c_str() + _raw.name, _raw.szName);
+        _pair.second.assign(m_arena.c_str() + _raw.value, _raw.szValue);
+    }
+
+    m_rawCount = 0;
+}
+
 result_t HttpCollection::clear()
 {
     size_t i;
@@ -69,6 +104,8 @@ result_t HttpCollection::clear()
     }
 
     m_count = 0;
+    m_rawCount = 0;
+    m_arena.clear();
 
     return 0;
 }
@@ -196,6 +233,12 @@ result_t HttpCollection::has(exlib::string name, bool& retVal)
     retVal = false;
     for (i = 0; i < m_count; i++)
         if (!qstricmp(m_map[i].first.c_str(), name.c_str())) {
+            retVal = true;
+            return 0;
+        }
+
+    for (i = 0; i < m_rawCount; i++)
+        if (is_raw(m_raw[i], name)) {
             retVal = true;
             break;
         }
@@ -216,6 +259,15 @@ result_t HttpCollection::first(exlib::string name, Variant& retVal)
         }
     }
 
+    for (i = 0; i < m_rawCount; i++) {
+        raw& _raw = m_raw[i];
+
+        if (is_raw(_raw, name)) {
+            retVal = raw_value(_raw);
+            return 0;
+        }
+    }
+
     return CALL_RETURN_NULL;
 }
 
@@ -326,6 +378,8 @@ result_t HttpCollection::set(exlib::string name, v8::Local<v8::Array> values)
 
 result_t HttpCollection::remove(exlib::string name)
 {
+    materialize();
+
     size_t i;
     int32_t p = 0;
 
@@ -352,6 +406,8 @@ result_t HttpCollection::_delete(exlib::string name)
 
 result_t HttpCollection::sort()
 {
+    materialize();
+
     if (m_count)
         std::sort(m_map.begin(), m_map.begin() + m_count, [](pair& a, pair& b) {
             return a.first < b.first;
@@ -362,6 +418,8 @@ result_t HttpCollection::sort()
 
 result_t HttpCollection::keys(obj_ptr<NArray>& retVal)
 {
+    materialize();
+
     obj_ptr<NArray> _keys = new NArray();
     size_t i;
 
@@ -375,6 +433,8 @@ result_t HttpCollection::keys(obj_ptr<NArray>& retVal)
 
 result_t HttpCollection::values(obj_ptr<NArray>& retVal)
 {
+    materialize();
+
     obj_ptr<NArray> _keys = new NArray();
     size_t i;
 
@@ -394,24 +454,34 @@ result_t HttpCollection::_named_getter(exlib::string property, Variant& retVal)
     Isolate* isolate = holder();
     v8::Local<v8::Context> context = isolate->context();
 
+    auto found = [&](const exlib::string& value) {
+        if (n == 0) {
+            v = value;
+            n = 1;
+        } else {
+            if (n == 1) {
+                a = v8::Array::New(isolate->m_isolate);
+                a->Set(context, 0, v).IsJust();
+                v = a;
+            }
+
+            Variant t = value;
+            a->Set(context, n++, t).IsJust();
+        }
+    };
+
     for (i = 0; i < m_count; i++) {
         pair& _pair = m_map[i];
 
-        if (!qstricmp(_pair.first.c_str(), property.c_str())) {
-            if (n == 0) {
-                v = _pair.second;
-                n = 1;
-            } else {
-                if (n == 1) {
-                    a = v8::Array::New(isolate->m_isolate);
-                    a->Set(context, 0, v).IsJust();
-                    v = a;
-                }
-
-                Variant t = _pair.second;
-                a->Set(context, n++, t).IsJust();
-            }
-        }
+        if (!qstricmp(_pair.first.c_str(), property.c_str()))
+            found(_pair.second);
+    }
+
+    for (i = 0; i < m_rawCount; i++) {
+        raw& _raw = m_raw[i];
+
+        if (is_raw(_raw, property))
+            found(raw_value(_raw));
     }
 
     if (n > 0) {
@@ -424,6 +494,8 @@ result_t HttpCollection::_named_getter(exlib::string property, Variant& retVal)
 
 result_t HttpCollection::_named_enumerator(v8::Local<v8::Array>& retVal)
 {
+    materialize();
+
     size_t i;
     int32_t n;
     std::set<exlib::string> name_set;
@@ -448,7 +520,7 @@ result_t HttpCollection::_named_setter(exlib::string property, Variant newVal)
 result_t HttpCollection::_named_deleter(exlib::string property,
     v8::Local<v8::Boolean>& retVal)
 {
-    size_t n = m_count;
+    size_t n = m_count + m_rawCount;
     remove(property);
     return n > m_count;
 }
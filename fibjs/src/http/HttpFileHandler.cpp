@@ -16,10 +16,17 @@
 #include "Url.h"
 #include "Buffer.h"
 #include "MemoryStream.h"
+#include "File.h"
+#include "parse.h"
 #include <inttypes.h>
 
 namespace fibjs {
 
+#define MULTIRANGE_MAX_PARTS 16
+#define MISSING_CACHE_SIZE 4096
+#define MISSING_CACHE_TIME 5000
+#define MULTIRANGE_MAX_SIZE (4 * 1024 * 1024)
+
 struct MimeType {
     const char* ext;
     const char* type;
@@ -1173,11 +1180,78 @@ result_t HttpFileHandler::set_mimes(v8::Local<v8::Object> mimes)
     return 0;
 }
 
+int32_t HttpFileHandler::get_missing(const exlib::string& path, const exlib::string& etag)
+{
+    int32_t missing = 0;
+    date_t now;
+
+    now.now();
+
+    m_missingLock.lock();
+    std::unordered_map<exlib::string, Missing>::iterator it = m_missing.find(path);
+    if (it != m_missing.end()) {
+        // a changed file or an old entry is probed again, siblings may have been deployed since
+        if (it->second.m_etag == etag && now.diff(it->second.m_d) < MISSING_CACHE_TIME)
+            missing = it->second.m_missing;
+        else
+            m_missing.erase(it);
+    }
+    m_missingLock.unlock();
+
+    return missing;
+}
+
+void HttpFileHandler::set_missing(const exlib::string& path, const exlib::string& etag, int32_t missing)
+{
+    m_missingLock.lock();
+    if (m_missing.size() >= MISSING_CACHE_SIZE)
+        m_missing.clear();
+
+    Missing& m = m_missing[path];
+    m.m_etag = etag;
+    m.m_d.now();
+    m.m_missing = missing;
+    m_missingLock.unlock();
+}
+
 static int32_t mt_cmp(const void* p, const void* q)
 {
     return qstricmp(*(const char**)p, *(const char**)q);
 }
 
+static bool accept_encoding(exlib::string& hdr, const char* enc)
+{
+    _parser p(hdr);
+    int32_t len = (int32_t)qstrlen(enc);
+
+    while (!p.end()) {
+        exlib::string name;
+
+        p.skipSpace();
+        p.getWord(name, ',', ';');
+
+        bool match = (int32_t)name.length() == len && !qstricmp(name.c_str(), enc, len);
+
+        while (p.want(';')) {
+            exlib::string param;
+
+            p.skipSpace();
+            p.getWord(param, ',', ';');
+
+            if (!qstricmp(param.c_str(), "q=", 2) && atof(param.c_str() + 2) <= 0)
+                match = false;
+        }
+
+        if (match)
+            return true;
+
+        p.skipUntil(',');
+        p.skip();
+    }
+
+    return false;
+}
+
 result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
     AsyncEvent* ac)
 {
@@ -1190,7 +1264,11 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
             , m_req(req)
             , m_autoIndex(autoIndex)
             , m_index(false)
+            , m_br(false)
+            , m_gz(false)
+            , m_missing(0)
             , m_dirPos(0)
+            , m_rangePos(0)
         {
             req->get_response(m_rep);
             m_req->get_value(m_value);
@@ -1353,24 +1431,64 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
                 m_rep->addHeader("Accept-Ranges", "bytes");
             }
 
+            // the body of a file depends on Accept-Encoding even when this request gets the plain one
+            m_rep->addHeader("Vary", "Accept-Encoding");
+
+            // serve precompressed siblings, filename.ext.br or filename.ext.gz, when the client accepts them
+            exlib::string hdr;
+            if (m_req->firstHeader("Accept-Encoding", hdr) != CALL_RETURN_NULL) {
+                m_br = accept_encoding(hdr, "br");
+                m_gz = accept_encoding(hdr, "gzip");
+            }
+
             return m_file->stat(m_stat, next(stat));
         }
 
         ON_STATE(asyncInvoke, stat)
         {
-            date_t d;
-            exlib::string str;
+            double sz;
+
+            m_stat->get_mtime(m_mtime);
+            m_stat->get_size(sz);
+
+            // validators come from the stat of the open file, nothing is stat'ed twice
+            char etag[64];
+            snprintf(etag, sizeof(etag), "\"%" PRIx64 "-%" PRIx64 "\"", (int64_t)m_mtime.date(), (int64_t)sz);
+            m_etag = etag;
+
+            if (m_br || m_gz) {
+                m_missing = m_pThis->get_missing(m_path, m_etag);
+                if (m_missing & MISSING_BR)
+                    m_br = false;
+                if (m_missing & MISSING_GZ)
+                    m_gz = false;
+            }
+
+            // the encoding is chosen first, the conditionals below then see the tag that is sent
+            if (m_br || m_gz)
+                return next(precompressed);
 
-            m_stat->get_mtime(d);
+            return next(validate);
+        }
+
+        ON_STATE(asyncInvoke, validate)
+        {
+            exlib::string str;
 
             exlib::string lastModified;
-            if (m_req->firstHeader("If-Modified-Since", lastModified)
+            if (m_req->firstHeader("If-None-Match", str) != CALL_RETURN_NULL) {
+                if (str == "*" || qstrstr(str.c_str(), m_etag.c_str())) {
+                    m_rep->addHeader("ETag", m_etag);
+                    m_rep->set_statusCode(304);
+                    return next(CALL_RETURN_NULL);
+                }
+            } else if (m_req->firstHeader("If-Modified-Since", lastModified)
                 != CALL_RETURN_NULL) {
                 date_t d1;
                 double diff;
 
                 d1.parse(lastModified);
-                diff = d.diff(d1);
+                diff = m_mtime.diff(d1);
 
                 if (diff > -1000 && diff < 1000) {
                     m_rep->set_statusCode(304);
@@ -1378,12 +1496,22 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
                 }
             }
 
-            d.toGMTString(lastModified);
+            m_mtime.toGMTString(lastModified);
 
             m_rep->addHeader("Last-Modified", lastModified);
+            m_rep->addHeader("ETag", m_etag);
+            if (!m_encoding.empty())
+                m_rep->addHeader("Content-Encoding", m_encoding);
 
             exlib::string range;
             if (m_req->firstHeader("Range", range) != CALL_RETURN_NULL) {
+                // a stale If-Range means the client wants the whole new file
+                if (m_req->firstHeader("If-Range", str) != CALL_RETURN_NULL
+                    && str != m_etag && str != lastModified) {
+                    m_rep->set_body(m_file);
+                    return next(CALL_RETURN_NULL);
+                }
+
                 if (qstricmp(range.c_str(), "bytes=", 6)) {
                     m_rep->set_statusCode(416);
 
@@ -1392,18 +1520,46 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
 
                 range = range.substr(6);
 
-                obj_ptr<RangeStream_base> stm;
-                if (RangeStream_base::_new(m_file, range, stm) != 0) {
+                int64_t fsz;
+                m_file->size(fsz);
+
+                m_ranges.clear();
+                if (RangeStream::parse(range, fsz, m_ranges) < 0) {
                     m_rep->set_statusCode(416);
 
                     return next(CALL_RETURN_NULL);
                 }
 
-                int64_t fsz, bpos, epos;
+                if (m_ranges.size() > 1) {
+                    int64_t total = 0;
 
-                m_file->size(fsz);
-                stm->get_begin(bpos);
-                stm->get_end(epos);
+                    for (size_t i = 0; i < m_ranges.size(); i++)
+                        total += m_ranges[i].second - m_ranges[i].first;
+
+                    // too many or too large parts are not worth assembling, send the file
+                    if (m_ranges.size() > MULTIRANGE_MAX_PARTS || total > MULTIRANGE_MAX_SIZE) {
+                        m_rep->set_body(m_file);
+                        return next(CALL_RETURN_NULL);
+                    }
+
+                    char boundary[32];
+                    snprintf(boundary, sizeof(boundary), "%08x%08x", rand(), rand());
+                    m_boundary = boundary;
+
+                    if (m_rep->firstHeader("Content-Type", m_type) == CALL_RETURN_NULL)
+                        m_type = s_defType.type;
+                    m_rep->setHeader("Content-Type", "multipart/byteranges; boundary=" + m_boundary);
+
+                    m_rep->set_statusCode(206);
+
+                    m_body = new MemoryStream();
+                    m_rangePos = 0;
+
+                    return next(range_part);
+                }
+
+                int64_t bpos = m_ranges[0].first;
+                int64_t epos = m_ranges[0].second;
 
                 m_rep->set_statusCode(206);
 
@@ -1411,6 +1567,7 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
                 snprintf(s, sizeof(s), "bytes %" PRId64 "-%" PRId64 "/%" PRId64 "", bpos, epos - 1, fsz);
                 m_rep->addHeader("Content-Range", s);
 
+                obj_ptr<RangeStream_base> stm = new RangeStream(m_file, bpos, epos);
                 m_rep->set_body(stm);
 
                 return next(CALL_RETURN_NULL);
@@ -1421,8 +1578,108 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
             return next(CALL_RETURN_NULL);
         }
 
+        ON_STATE(asyncInvoke, range_part)
+        {
+            obj_ptr<Buffer_base> buf;
+
+            if (m_rangePos == m_ranges.size()) {
+                exlib::string s = "\r\n--" + m_boundary + "--\r\n";
+                buf = new Buffer(s.c_str(), s.length());
+                m_body->cc_write(buf);
+
+                m_body->rewind();
+                m_rep->set_body(m_body);
+
+                return next(CALL_RETURN_NULL);
+            }
+
+            int64_t fsz;
+            int64_t bpos = m_ranges[m_rangePos].first;
+            int64_t epos = m_ranges[m_rangePos].second;
+
+            m_file->size(fsz);
+
+            char s[256];
+            snprintf(s, sizeof(s), "bytes %" PRId64 "-%" PRId64 "/%" PRId64 "", bpos, epos - 1, fsz);
+
+            exlib::string head = "\r\n--" + m_boundary + "\r\nContent-Type: " + m_type
+                + "\r\nContent-Range: " + s + "\r\n\r\n";
+            buf = new Buffer(head.c_str(), head.length());
+            m_body->cc_write(buf);
+
+            m_buf.Release();
+            if (epos == bpos)
+                return next(range_data);
+
+#ifndef _WIN32
+            // positional reads leave the offset of the shared file alone, as RangeStream does
+            File* f = dynamic_cast<File*>((SeekableStream_base*)m_file);
+            if (f) {
+                result_t hr = f->pread(bpos, (int32_t)(epos - bpos), m_buf);
+                if (hr < 0)
+                    return hr;
+
+                return next(range_data);
+            }
+#endif
+
+            m_file->seek(bpos, fs_base::C_SEEK_SET);
+            return m_file->read((int32_t)(epos - bpos), m_buf, next(range_data));
+        }
+
+        ON_STATE(asyncInvoke, range_data)
+        {
+            if (m_buf)
+                m_body->cc_write(m_buf);
+
+            m_rangePos++;
+            return next(range_part);
+        }
+
+        ON_STATE(asyncInvoke, precompressed)
+        {
+            if (m_br) {
+                m_br = false;
+                m_encoding = "br";
+                return fs_base::openFile(m_path + ".br", "r", m_zfile, next(zip_open));
+            }
+
+            if (m_gz) {
+                m_gz = false;
+                m_encoding = "gzip";
+                return fs_base::openFile(m_path + ".gz", "r", m_zfile, next(zip_open));
+            }
+
+            m_pThis->set_missing(m_path, m_etag, m_missing);
+
+            m_encoding.clear();
+            return next(validate);
+        }
+
+        ON_STATE(asyncInvoke, zip_open)
+        {
+            if (m_missing)
+                m_pThis->set_missing(m_path, m_etag, m_missing);
+
+            // each encoding is its own representation and gets its own tag
+            m_etag = m_etag.substr(0, m_etag.length() - 1) + "-" + m_encoding + "\"";
+
+            obj_ptr<SeekableStream_base> file = m_file;
+            m_file = m_zfile;
+
+            return file->close(next(validate));
+        }
+
         virtual int32_t error(int32_t v)
         {
+            if (at(precompressed)) {
+                m_missing |= m_encoding == "br" ? MISSING_BR : MISSING_GZ;
+                return next(precompressed);
+            }
+
+            if (at(zip_open))
+                return next(validate);
+
             if (at(start)) {
                 if (m_index) {
                     m_index = false;
@@ -1441,14 +1698,27 @@ result_t HttpFileHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
         obj_ptr<HttpRequest_base> m_req;
         obj_ptr<HttpResponse_base> m_rep;
         obj_ptr<SeekableStream_base> m_file;
+        obj_ptr<SeekableStream_base> m_zfile;
+        obj_ptr<SeekableStream_base> m_body;
+        obj_ptr<Buffer_base> m_buf;
         obj_ptr<Stat_base> m_stat;
         exlib::string m_value;
         exlib::string m_url;
         exlib::string m_path;
+        exlib::string m_encoding;
+        exlib::string m_etag;
+        date_t m_mtime;
+        exlib::string m_boundary;
+        exlib::string m_type;
         bool m_autoIndex;
         bool m_index;
+        bool m_br;
+        bool m_gz;
+        int32_t m_missing;
         obj_ptr<NArray> m_dir;
         int32_t m_dirPos;
+        std::vector<std::pair<int64_t, int64_t>> m_ranges;
+        size_t m_rangePos;
     };
 
     if (ac->isSync())
@@ -16,9 +16,16 @@
 #include "version.h"
 #include "ifs/zlib.h"
 #include "ifs/console.h"
+#include "ZlibStream.h"
+#include "Http2Session.h"
+#include "SslSocket.h"
+#include <mbedtls/mbedtls/sha1.h>
 
 namespace fibjs {
 
+#define ENCODING_CACHE_ITEM (1024 * 1024)
+#define PIPELINE_DEPTH 16
+
 static const char* s_zipTypes[] = {
     "application/3gpdash-qoe-report+xml",
     "application/3gpp-ims+xml",
@@ -604,183 +611,507 @@ HttpHandler::HttpHandler()
     , m_maxHeaderSize(8192)
     , m_maxBodySize(64)
     , m_enableEncoding(false)
+    , m_streamForm(false)
+    , m_cacheSize(0)
+    , m_cacheUsed(0)
 {
     m_serverName = "fibjs/";
     m_serverName.append(fibjs_version);
 }
 
-result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
-    AsyncEvent* ac)
+// a pipelined request is only handled ahead of the responses before it when its head
+// and body have already arrived, a chunked body is never taken as complete
+static bool request_buffered(BufferedStream* bs)
 {
-    class asyncInvoke : public AsyncState {
+    const char* p = bs->m_data ? bs->m_data + bs->m_pos : NULL;
+    int32_t n = bs->m_len - bs->m_pos;
+    int32_t head = -1;
+    int32_t i;
+
+    if (!p || n < 4 || bs->m_strbuf.size() > 0)
+        return false;
+
+    for (i = 0; i + 3 < n; i++)
+        if (p[i] == '\r' && p[i + 1] == '\n' && p[i + 2] == '\r' && p[i + 3] == '\n') {
+            head = i + 4;
+            break;
+        }
+
+    if (head < 0)
+        return false;
+
+    int64_t length = 0;
+
+    for (i = 0; i < head;) {
+        const char* line = p + i;
+        int32_t len = 0;
+
+        while (i + len < head && line[len] != '\r')
+            len++;
+        i += len + 2;
+
+        if (len > 18 && !qstricmp(line, "transfer-encoding:", 18))
+            return false;
+
+        if (len > 15 && !qstricmp(line, "content-length:", 15))
+            length = atoll(exlib::string(line + 15, len - 15).c_str());
+    }
+
+    return length <= n - head;
+}
+
+class HttpHandler::asyncInvoke : public AsyncState {
+public:
+    // writes queued http/1.1 responses in order while the connection goes on
+    // reading and handling the requests pipelined behind them
+    class asyncPipe : public AsyncState {
     public:
-        asyncInvoke(HttpHandler* pThis, Stream_base* stm, AsyncEvent* ac)
-            : AsyncState(ac)
+        asyncPipe(asyncInvoke* pThis)
+            : AsyncState(NULL)
             , m_pThis(pThis)
-            , m_stm(stm)
-            , m_options(false)
+            , m_stm(pThis->m_stm)
+            , m_isolate(pThis->isolate())
+            , m_headOnly(false)
         {
-            m_stmBuffered = new BufferedStream(stm);
-            m_stmBuffered->set_EOL("\r\n");
+            next(send);
+        }
 
-            m_req = new HttpRequest();
-            m_req->get_response(m_rep);
+        ON_STATE(asyncPipe, send)
+        {
+            asyncInvoke* inv = m_pThis;
+            AsyncEvent* drain = NULL;
+            bool done = false;
+
+            inv->m_sendLock.lock();
+            if (inv->m_sendQueue.empty()) {
+                inv->m_sending = false;
+                drain = inv->m_drain;
+                inv->m_drain = NULL;
+                done = true;
+            } else {
+                m_rep = inv->m_sendQueue.front().first;
+                m_headOnly = inv->m_sendQueue.front().second;
+                inv->m_sendQueue.pop_front();
+            }
+            inv->m_sendLock.unlock();
 
-            m_req->set_maxHeadersCount(pThis->m_maxHeadersCount);
-            m_req->set_maxBodySize(pThis->m_maxBodySize);
+            // inv may be gone as soon as m_sending is cleared
+            if (done) {
+                if (drain)
+                    drain->apost(0);
+                return next();
+            }
 
-            next(read);
+            if (m_headOnly)
+                return m_rep->sendHeader(m_stm, next(close));
+
+            return m_rep->sendTo(m_stm, next(close));
         }
 
-        ON_STATE(asyncInvoke, read)
+        ON_STATE(asyncPipe, close)
         {
-            bool bKeepAlive = false;
+            obj_ptr<SeekableStream_base> body;
+
+            m_rep->get_body(body);
+            m_rep.Release();
+
+            if (!body)
+                return next(send);
 
-            m_rep->get_keepAlive(bKeepAlive);
+            return body->close(next(send));
+        }
 
-            if (!bKeepAlive)
-                return next(CALL_RETURN_NULL);
+        virtual int32_t error(int32_t v)
+        {
+            asyncInvoke* inv = m_pThis;
+            AsyncEvent* drain;
 
-            m_options = false;
+            inv->m_sendLock.lock();
+            inv->m_sendError = v;
+            inv->m_sendQueue.clear();
+            inv->m_sending = false;
+            drain = inv->m_drain;
+            inv->m_drain = NULL;
+            inv->m_sendLock.unlock();
 
-            m_zip.Release();
-            m_body.Release();
+            if (drain)
+                drain->apost(0);
 
-            m_req->clear();
-            return m_req->readFrom(m_stmBuffered, next(invoke));
+            return v;
         }
 
-        ON_STATE(asyncInvoke, invoke)
+        virtual Isolate* isolate()
         {
-            if (n == CALL_RETURN_NULL)
-                return next(CALL_RETURN_NULL);
+            return m_isolate;
+        }
 
-            exlib::string str;
+    private:
+        asyncInvoke* m_pThis;
+        obj_ptr<Stream_base> m_stm;
+        Isolate* m_isolate;
+        obj_ptr<HttpResponse_base> m_rep;
+        bool m_headOnly;
+    };
 
-            m_req->get_protocol(str);
-            m_rep->set_protocol(str);
+public:
+    asyncInvoke(HttpHandler* pThis, Stream_base* stm, bool h2, AsyncEvent* ac)
+        : AsyncState(ac)
+        , m_pThis(pThis)
+        , m_stm(stm)
+        , m_streamId(0)
+        , m_preface(sizeof(H2_PREFACE) - 1)
+        , m_sending(false)
+        , m_keepAlive(true)
+        , m_sendError(0)
+        , m_drain(NULL)
+        , m_options(false)
+    {
+        m_stmBuffered = new BufferedStream(stm);
+        m_stmBuffered->set_EOL("\r\n");
+
+        new_request();
+
+        next(h2 ? session : read);
+    }
 
-            bool bKeepAlive;
+    // one request of an http/2 connection, the response goes back through the session
+    asyncInvoke(HttpHandler* pThis, Http2Session* session, int32_t streamId, HttpRequest_base* req)
+        : AsyncState(NULL)
+        , m_pThis(pThis)
+        , m_session(session)
+        , m_streamId(streamId)
+        , m_preface(0)
+        , m_req(req)
+        , m_sending(false)
+        , m_keepAlive(false)
+        , m_sendError(0)
+        , m_drain(NULL)
+        , m_options(false)
+    {
+        m_req->get_response(m_rep);
+        next(invoke);
+    }
 
-            m_req->get_keepAlive(bKeepAlive);
-            m_rep->set_keepAlive(bKeepAlive);
+    ~asyncInvoke()
+    {
+        if (m_streamId)
+            m_session->stream_end(m_streamId);
+    }
 
-            m_d.now();
+    virtual Isolate* isolate()
+    {
+        if (m_streamId)
+            return m_session->isolate();
+        return AsyncState::isolate();
+    }
+
+    ON_STATE(asyncInvoke, read)
+    {
+        if (m_session)
+            return next(CALL_RETURN_NULL);
 
-            if (m_pThis->m_crossDomain) {
-                m_req->get_address(str);
+        if (!m_keepAlive || m_sendError < 0)
+            return next(drain);
 
-                exlib::string origin;
+        m_options = false;
 
-                if (m_req->firstHeader("origin", origin) != CALL_RETURN_NULL) {
-                    m_rep->setHeader("Access-Control-Allow-Credentials", "true");
-                    m_rep->setHeader("Access-Control-Allow-Origin", origin);
+        m_zip.Release();
+        m_body.Release();
+        m_data.Release();
+        m_zipData.Release();
 
-                    m_req->get_method(str);
+        return m_req->readFrom(m_stmBuffered, next(invoke));
+    }
 
-                    if (!qstricmp(str.c_str(), "options")) {
-                        m_options = true;
+    ON_STATE(asyncInvoke, invoke)
+    {
+        if (n == CALL_RETURN_NULL)
+            return next(drain);
 
-                        m_rep->setHeader("Access-Control-Allow-Methods", "*");
-                        m_rep->setHeader("Access-Control-Allow-Headers",
-                            m_pThis->m_allowHeaders);
-                        m_rep->setHeader("Access-Control-Max-Age", "1728000");
+        exlib::string str;
 
-                        return next(send);
-                    }
-                }
-            }
+        m_req->get_protocol(str);
+        m_rep->set_protocol(str);
+
+        if (!m_session && str == "HTTP/2.0") {
+            exlib::string method;
+            exlib::string address;
+
+            // h2c with prior knowledge, the request line was the first half of the preface
+            m_req->get_method(method);
+            m_req->get_address(address);
+            if (method == "PRI" && address == "*") {
+                m_preface = sizeof(H2_PREFACE) - sizeof(H2_PREFACE_HEAD);
 
-            return mq_base::invoke(m_pThis->m_hdlr, m_req, next(send));
+                next(session);
+                return wait_send() ? CALL_E_PENDDING : 0;
+            }
         }
 
-        ON_STATE(asyncInvoke, send)
-        {
-            int32_t s;
-            bool t = false;
-            date_t d;
-            exlib::string str;
-
-            if (m_rep->firstHeader("Server", str) == CALL_RETURN_NULL)
-                m_rep->addHeader("Server", m_pThis->m_serverName);
-
-            d.now();
-
-            m_rep->get_statusCode(s);
-            if (s == 200 && !m_options) {
-                m_rep->hasHeader("Last-Modified", t);
-                if (!t && (m_rep->firstHeader("Cache-Control", str) == CALL_RETURN_NULL)) {
-                    m_rep->addHeader("Cache-Control", "no-cache, no-store");
-                    m_rep->addHeader("Expires", "-1");
+        bool bKeepAlive;
+
+        m_req->get_keepAlive(bKeepAlive);
+        m_rep->set_keepAlive(bKeepAlive);
+
+        m_d.now();
+
+        if (m_pThis->m_crossDomain) {
+            m_req->get_address(str);
+
+            exlib::string origin;
+
+            if (m_req->firstHeader("origin", origin) != CALL_RETURN_NULL) {
+                m_rep->setHeader("Access-Control-Allow-Credentials", "true");
+                m_rep->setHeader("Access-Control-Allow-Origin", origin);
+
+                m_req->get_method(str);
+
+                if (!qstricmp(str.c_str(), "options")) {
+                    m_options = true;
+
+                    m_rep->setHeader("Access-Control-Allow-Methods", "*");
+                    m_rep->setHeader("Access-Control-Allow-Headers",
+                        m_pThis->m_allowHeaders);
+                    m_rep->setHeader("Access-Control-Max-Age", "1728000");
+
+                    return next(send);
                 }
             }
+        }
+
+        bool upgrade;
 
-            m_req->get_method(str);
-            bool headOnly = !qstricmp(str.c_str(), "head");
+        m_req->get_upgrade(upgrade);
+        if (upgrade) {
+            next(dispatch);
+            return wait_send() ? CALL_E_PENDDING : 0;
+        }
+
+        return mq_base::invoke(m_pThis->m_hdlr, m_req, next(send));
+    }
+
+    ON_STATE(asyncInvoke, dispatch)
+    {
+        if (m_sendError < 0)
+            return next(drain);
+
+        return mq_base::invoke(m_pThis->m_hdlr, m_req, next(send));
+    }
+
+    ON_STATE(asyncInvoke, session)
+    {
+        if (m_sendError < 0)
+            return next(drain);
 
-            if (headOnly) {
-                m_rep->set_keepAlive(false);
-                return m_rep->sendHeader(m_stm, next(end));
+        m_session = new Http2Session(m_pThis, m_stm, m_stmBuffered, isolate());
+        return m_session->run(m_preface, next());
+    }
+
+    ON_STATE(asyncInvoke, send)
+    {
+        int32_t s;
+        bool t = false;
+        date_t d;
+        exlib::string str;
+
+        if (m_rep->firstHeader("Server", str) == CALL_RETURN_NULL)
+            m_rep->addHeader("Server", m_pThis->m_serverName);
+
+        d.now();
+
+        m_rep->get_statusCode(s);
+        if (s == 200 && !m_options) {
+            m_rep->hasHeader("Last-Modified", t);
+            if (!t && (m_rep->firstHeader("Cache-Control", str) == CALL_RETURN_NULL)) {
+                m_rep->addHeader("Cache-Control", "no-cache, no-store");
+                m_rep->addHeader("Expires", "-1");
             }
+        }
+
+        m_req->get_method(str);
+        bool headOnly = !qstricmp(str.c_str(), "head");
 
-            int64_t len;
+        if (headOnly) {
+            m_rep->set_keepAlive(false);
+            return send_response(true, next(end));
+        }
 
-            m_rep->get_length(len);
+        int64_t len;
 
-            if (m_pThis->m_enableEncoding && len > 128 && len < 1024 * 1024 * 64) {
-                exlib::string hdr;
+        m_rep->get_length(len);
 
-                if (m_req->firstHeader("Accept-Encoding", hdr) != CALL_RETURN_NULL) {
-                    int32_t type = 0;
+        if (m_pThis->m_enableEncoding && len > 0 && len < 1024 * 1024 * 64) {
+            exlib::string hdr;
 
-                    if (qstristr(hdr.c_str(), "gzip"))
-                        type = 1;
-                    else if (qstristr(hdr.c_str(), "deflate"))
-                        type = 2;
+            if (m_req->firstHeader("Accept-Encoding", hdr) != CALL_RETURN_NULL) {
+                HttpHandler::EncodingOptions opts;
 
-                    if (type != 0) {
-                        if (m_rep->firstHeader("Content-Type", hdr) != CALL_RETURN_NULL) {
-                            const char* pKey = hdr.c_str();
-                            if (qstricmp(hdr.c_str(), "text/", 5)
-                                && !bsearch(&pKey, &s_zipTypes, ARRAYSIZE(s_zipTypes),
-                                    sizeof(pKey), mt_cmp))
-                                type = 0;
-                        } else
-                            type = 0;
-                    }
+                m_type = 0;
+                if (qstristr(hdr.c_str(), "gzip"))
+                    m_type = 1;
+                else if (qstristr(hdr.c_str(), "deflate"))
+                    m_type = 2;
 
-                    if (type != 0) {
-                        if (m_rep->firstHeader("Content-Encoding", hdr) != CALL_RETURN_NULL)
-                            type = 0;
-                    }
+                if (m_type != 0) {
+                    if (m_rep->firstHeader("Content-Type", hdr) == CALL_RETURN_NULL
+                        || !m_pThis->encodingOptions(hdr, opts)
+                        || len <= opts.m_minSize)
+                        m_type = 0;
+                }
+
+                if (m_type != 0) {
+                    if (m_rep->firstHeader("Content-Encoding", hdr) != CALL_RETURN_NULL)
+                        m_type = 0;
+                }
+
+                if (m_type != 0) {
+                    m_level = opts.m_level;
 
-                    if (type != 0) {
-                        m_rep->addHeader("Content-Encoding", type == 1 ? "gzip" : "deflate");
+                    m_rep->get_body(m_body);
+                    m_body->rewind();
 
-                        m_rep->get_body(m_body);
-                        m_body->rewind();
+                    if (m_pThis->m_cacheSize > 0 && len <= ENCODING_CACHE_ITEM) {
+                        char buf[16];
 
-                        m_zip = new MemoryStream();
+                        snprintf(buf, sizeof(buf), "%d:%d:", m_type, m_level);
+                        m_key = buf;
 
-                        if (type == 1)
-                            return zlib_base::gzipTo(m_body, m_zip, next(zip));
-                        else
-                            return zlib_base::deflateTo(m_body, m_zip, -1, next(zip));
+                        m_etag = m_rep->firstHeader("ETag", hdr) != CALL_RETURN_NULL;
+                        if (m_etag) {
+                            exlib::string value;
+
+                            m_req->get_value(value);
+                            m_key.append("E:" + value + "\n" + hdr);
+
+                            exlib::string data;
+                            if (m_pThis->getCache(m_key, data))
+                                return send_zip(data);
+                        }
+
+                        return m_body->readAll(m_data, next(hash));
                     }
+
+                    m_rep->addHeader("Content-Encoding", m_type == 1 ? "gzip" : "deflate");
+                    m_zip = new MemoryStream();
+
+                    obj_ptr<ZlibStream> zs;
+                    if (m_type == 1)
+                        zs = new gz(m_zip, m_level);
+                    else
+                        zs = new def(m_zip, m_level);
+
+                    return zs->process(m_body, next(zip));
                 }
             }
+        }
 
-            return m_rep->sendTo(m_stm, next(end));
+        return send_response(false, next(end));
+    }
+
+    ON_STATE(asyncInvoke, zip)
+    {
+        m_rep->set_body(m_zip);
+        return send_response(false, next(end));
+    }
+
+    ON_STATE(asyncInvoke, hash)
+    {
+        if (n == CALL_RETURN_NULL) {
+            m_body->rewind();
+            return send_response(false, next(end));
         }
 
-        ON_STATE(asyncInvoke, zip)
-        {
-            m_rep->set_body(m_zip);
-            return m_rep->sendTo(m_stm, next(end));
+        if (!m_etag) {
+            Buffer* buf = Buffer::Cast(m_data);
+            unsigned char output[20];
+
+            mbedtls_sha1((const unsigned char*)buf->data(), buf->length(), output);
+            m_key.append((const char*)output, sizeof(output));
+
+            exlib::string data;
+            if (m_pThis->getCache(m_key, data))
+                return send_zip(data);
         }
 
-        ON_STATE(asyncInvoke, end)
-        {
+        obj_ptr<ZlibStream> zs;
+        if (m_type == 1)
+            zs = new gz(NULL, m_level);
+        else
+            zs = new def(NULL, m_level);
+
+        return zs->process(m_data, m_zipData, next(cache));
+    }
+
+    ON_STATE(asyncInvoke, cache)
+    {
+        Buffer* buf = Buffer::Cast(m_zipData);
+        exlib::string data((const char*)buf->data(), buf->length());
+
+        m_pThis->putCache(m_key, data);
+        return send_zip(data);
+    }
+
+    result_t send_response(bool headOnly, AsyncEvent* ac)
+    {
+        if (m_session)
+            return m_session->send(m_streamId, m_rep, headOnly, ac);
+
+        bool start;
+
+        m_sendLock.lock();
+        m_sendQueue.push_back(std::pair<obj_ptr<HttpResponse_base>, bool>(m_rep, headOnly));
+        start = !m_sending;
+        m_sending = true;
+        m_sendLock.unlock();
+
+        if (start)
+            (new asyncPipe(this))->apost(0);
+
+        return 0;
+    }
+
+    // parks the state machine until the queued responses are written. an upgrade
+    // handler takes the stream over and writes to it directly, and a full queue
+    // stops reading more requests
+    bool wait_send()
+    {
+        bool sending;
+
+        m_sendLock.lock();
+        sending = m_sending;
+        if (sending)
+            m_drain = this;
+        m_sendLock.unlock();
+
+        return sending;
+    }
+
+    void new_request()
+    {
+        obj_ptr<HttpRequest> req = new HttpRequest();
+        req->m_message->m_streamForm = m_pThis->m_streamForm;
+
+        m_req = req;
+        m_req->get_response(m_rep);
+
+        m_req->set_maxHeadersCount(m_pThis->m_maxHeadersCount);
+        m_req->set_maxBodySize(m_pThis->m_maxBodySize);
+    }
+
+    result_t send_zip(exlib::string& data)
+    {
+        date_t d;
+
+        d.now();
+        m_rep->addHeader("Content-Encoding", m_type == 1 ? "gzip" : "deflate");
+        m_rep->set_body(new MemoryStream::CloneStream(data, d));
+
+        return send_response(false, next(end));
+    }
+
+    ON_STATE(asyncInvoke, end)
+    {
+        if (m_session) {
             if (!m_body)
                 m_rep->get_body(m_body);
 
@@ -790,44 +1121,119 @@ result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
             return m_body->close(next(read));
         }
 
-        virtual int32_t error(int32_t v)
-        {
-            if (at(invoke)) {
-                exlib::string err = getResultMessage(v);
+        // the queued response owns its body until asyncPipe has written it,
+        // only a body that was replaced by its compressed copy is closed here
+        obj_ptr<SeekableStream_base> body;
 
-                m_req->set_lastError(err);
-                errorLog("HttpHandler: " + err);
+        m_rep->get_body(body);
+        m_rep->get_keepAlive(m_keepAlive);
+        new_request();
 
-                m_rep->set_statusCode(500);
-                return 0;
-            }
+        if (!m_body || m_body == body)
+            return next(pipe);
+
+        return m_body->close(next(pipe));
+    }
+
+    ON_STATE(asyncInvoke, pipe)
+    {
+        size_t depth;
+
+        m_sendLock.lock();
+        depth = m_sendQueue.size();
+        m_sendLock.unlock();
+
+        // a client that pipelines without reading the responses stalls here once the
+        // queue is full, the next request waits for the queued responses to go out
+        next(read);
+        if (depth < PIPELINE_DEPTH && request_buffered((BufferedStream*)(BufferedStream_base*)m_stmBuffered))
+            return 0;
 
-            if (at(read)) {
-                if (v == CALL_E_CLOSED)
-                    return next(CALL_RETURN_NULL);
+        return wait_send() ? CALL_E_PENDDING : 0;
+    }
+
+    ON_STATE(asyncInvoke, drain)
+    {
+        m_sendLock.lock();
+        if (!m_sending) {
+            m_sendLock.unlock();
+            return next(CALL_RETURN_NULL);
+        }
+
+        next(drained);
+        m_drain = this;
+        m_sendLock.unlock();
+
+        return CALL_E_PENDDING;
+    }
 
-                m_rep->set_keepAlive(false);
-                m_rep->set_statusCode(400);
-                next(send);
-                m_d.now();
+    ON_STATE(asyncInvoke, drained)
+    {
+        return next(CALL_RETURN_NULL);
+    }
+
+    virtual int32_t error(int32_t v)
+    {
+        if (at(invoke) || at(dispatch)) {
+            exlib::string err = getResultMessage(v);
+
+            m_req->set_lastError(err);
+            errorLog("HttpHandler: " + err);
+
+            m_rep->set_statusCode(500);
+            return 0;
+        }
+
+        if (at(read)) {
+            if (v == CALL_E_CLOSED) {
+                next(drain);
                 return 0;
             }
 
-            return next(CALL_RETURN_NULL);
+            m_rep->set_keepAlive(false);
+            m_rep->set_statusCode(400);
+            next(send);
+            m_d.now();
+            return 0;
         }
 
-    private:
-        obj_ptr<HttpHandler> m_pThis;
-        obj_ptr<Stream_base> m_stm;
-        obj_ptr<BufferedStream_base> m_stmBuffered;
-        obj_ptr<HttpRequest_base> m_req;
-        obj_ptr<HttpResponse_base> m_rep;
-        obj_ptr<MemoryStream> m_zip;
-        obj_ptr<SeekableStream_base> m_body;
-        date_t m_d;
-        bool m_options;
-    };
+        if (at(drain) || at(drained))
+            return next(CALL_RETURN_NULL);
+
+        next(drain);
+        return 0;
+    }
+
+private:
+    obj_ptr<HttpHandler> m_pThis;
+    obj_ptr<Stream_base> m_stm;
+    obj_ptr<BufferedStream_base> m_stmBuffered;
+    obj_ptr<Http2Session> m_session;
+    int32_t m_streamId;
+    int32_t m_preface;
+    exlib::spinlock m_sendLock;
+    std::list<std::pair<obj_ptr<HttpResponse_base>, bool>> m_sendQueue;
+    bool m_sending;
+    bool m_keepAlive;
+    result_t m_sendError;
+    AsyncEvent* m_drain;
+    obj_ptr<HttpRequest_base> m_req;
+    obj_ptr<HttpResponse_base> m_rep;
+    obj_ptr<MemoryStream> m_zip;
+    obj_ptr<SeekableStream_base> m_body;
+    obj_ptr<Buffer_base> m_data;
+    obj_ptr<Buffer_base> m_zipData;
+    exlib::string m_key;
+    int32_t m_type;
+    int32_t m_level;
+    bool m_etag;
+    date_t m_d;
+    bool m_options;
+};
 
+result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
+    AsyncEvent* ac)
+{
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
@@ -841,7 +1247,17 @@ result_t HttpHandler::invoke(object_base* v, obj_ptr<Handler_base>& retVal,
     if (stm == NULL)
         return CHECK_ERROR(CALL_E_BADVARTYPE);
 
-    return (new asyncInvoke(this, stm, ac))->post(0);
+    bool h2 = false;
+    SslSocket_base* ss = SslSocket_base::getInstance(stm);
+    if (ss)
+        h2 = ((SslSocket*)ss)->alpn() == "h2";
+
+    return (new asyncInvoke(this, stm, h2, ac))->post(0);
+}
+
+void HttpHandler::invoke_h2(Http2Session* session, int32_t streamId, HttpRequest_base* req)
+{
+    (new asyncInvoke(this, session, streamId, req))->apost(0);
 }
 
 result_t HttpHandler::enableCrossOrigin(exlib::string allowHeaders)
@@ -851,6 +1267,140 @@ result_t HttpHandler::enableCrossOrigin(exlib::string allowHeaders)
     return 0;
 }
 
+static exlib::string mime_key(exlib::string type)
+{
+    const char* c_str = type.c_str();
+    size_t len = 0;
+
+    while (c_str[len] && c_str[len] != ';' && !qisspace(c_str[len]))
+        len++;
+
+    exlib::string key(c_str, len);
+    char* p = key.data();
+
+    for (size_t i = 0; i < len; i++)
+        p[i] = qtolower(p[i]);
+
+    return key;
+}
+
+result_t HttpHandler::setEncodingOptions(exlib::string type, v8::Local<v8::Object> opts)
+{
+    Isolate* isolate = holder();
+    exlib::string key = mime_key(type);
+    result_t hr;
+
+    if (key.empty())
+        return CHECK_ERROR(Runtime::setError("HttpHandler: invalid content type."));
+
+    EncodingOptions eo;
+    std::map<exlib::string, EncodingOptions>::iterator it = m_encodingOptions.find(key);
+    if (it != m_encodingOptions.end())
+        eo = it->second;
+
+    hr = GetConfigValue(isolate, opts, "minSize", eo.m_minSize);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+    if (eo.m_minSize < 0)
+        return CHECK_ERROR(Runtime::setError("HttpHandler: minSize must not be negative."));
+
+    hr = GetConfigValue(isolate, opts, "level", eo.m_level);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+    if (eo.m_level < zlib_base::C_DEFAULT_COMPRESSION || eo.m_level > zlib_base::C_BEST_COMPRESSION)
+        return CHECK_ERROR(Runtime::setError("HttpHandler: level must be between -1 and 9."));
+
+    m_encodingOptions[key] = eo;
+    return 0;
+}
+
+bool HttpHandler::encodingOptions(exlib::string type, EncodingOptions& retVal)
+{
+    exlib::string key = mime_key(type);
+    std::map<exlib::string, EncodingOptions>::iterator it = m_encodingOptions.find(key);
+
+    if (it == m_encodingOptions.end()) {
+        const char* p = qstrchr(key.c_str(), '/');
+        if (p) {
+            exlib::string group(key.c_str(), p - key.c_str() + 1);
+
+            group.append(1, '*');
+            it = m_encodingOptions.find(group);
+        }
+    }
+
+    if (it != m_encodingOptions.end()) {
+        retVal = it->second;
+        return retVal.m_level != 0;
+    }
+
+    const char* pKey = key.c_str();
+    if (qstrcmp(pKey, "text/", 5)
+        && !bsearch(&pKey, &s_zipTypes, ARRAYSIZE(s_zipTypes), sizeof(pKey), mt_cmp))
+        return false;
+
+    retVal = EncodingOptions();
+    return true;
+}
+
+bool HttpHandler::getCache(const exlib::string& key, exlib::string& retVal)
+{
+    bool found = false;
+
+    m_cacheLock.lock();
+
+    std::unordered_map<exlib::string, cache_list::iterator>::iterator it = m_cacheMap.find(key);
+    if (it != m_cacheMap.end()) {
+        m_cacheList.splice(m_cacheList.begin(), m_cacheList, it->second);
+        retVal = it->second->second;
+        found = true;
+    }
+
+    m_cacheLock.unlock();
+
+    return found;
+}
+
+void HttpHandler::putCache(const exlib::string& key, const exlib::string& data)
+{
+    m_cacheLock.lock();
+
+    if (m_cacheMap.find(key) == m_cacheMap.end()) {
+        m_cacheList.push_front(std::pair<exlib::string, exlib::string>(key, data));
+        m_cacheMap[key] = m_cacheList.begin();
+        m_cacheUsed += key.length() + data.length();
+
+        trimCache();
+    }
+
+    m_cacheLock.unlock();
+}
+
+void HttpHandler::trimCache()
+{
+    while (m_cacheUsed > (size_t)m_cacheSize && !m_cacheList.empty()) {
+        std::pair<exlib::string, exlib::string>& item = m_cacheList.back();
+
+        m_cacheUsed -= item.first.length() + item.second.length();
+        m_cacheMap.erase(item.first);
+        m_cacheList.pop_back();
+    }
+}
+
+void HttpHandler::copy_settings(HttpHandler* from)
+{
+    m_crossDomain = from->m_crossDomain;
+    m_allowHeaders = from->m_allowHeaders;
+    m_maxHeadersCount = from->m_maxHeadersCount;
+    m_maxHeaderSize = from->m_maxHeaderSize;
+    m_maxBodySize = from->m_maxBodySize;
+    m_enableEncoding = from->m_enableEncoding;
+    m_streamForm = from->m_streamForm;
+    m_serverName = from->m_serverName;
+    m_encodingOptions = from->m_encodingOptions;
+    m_cacheSize = from->m_cacheSize;
+}
+
 result_t HttpHandler::get_maxHeadersCount(int32_t& retVal)
 {
     retVal = m_maxHeadersCount;
@@ -905,6 +1455,37 @@ result_t HttpHandler::set_enableEncoding(bool newVal)
     return 0;
 }
 
+result_t HttpHandler::get_streamForm(bool& retVal)
+{
+    retVal = m_streamForm;
+    return 0;
+}
+
+result_t HttpHandler::set_streamForm(bool newVal)
+{
+    m_streamForm = newVal;
+    return 0;
+}
+
+result_t HttpHandler::get_encodingCacheSize(int32_t& retVal)
+{
+    retVal = m_cacheSize;
+    return 0;
+}
+
+result_t HttpHandler::set_encodingCacheSize(int32_t newVal)
+{
+    if (newVal < 0)
+        return CHECK_ERROR(CALL_E_OUTRANGE);
+
+    m_cacheLock.lock();
+    m_cacheSize = newVal;
+    trimCache();
+    m_cacheLock.unlock();
+
+    return 0;
+}
+
 result_t HttpHandler::get_serverName(exlib::string& retVal)
 {
     retVal = m_serverName;
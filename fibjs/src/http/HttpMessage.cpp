@@ -9,6 +9,9 @@
 #include "HttpMessage.h"
 #include "parse.h"
 #include "Buffer.h"
+#include "BufferedStream.h"
+#include "GatherWriter.h"
+#include "HttpUploadCollection.h"
 #include <string.h>
 
 namespace fibjs {
@@ -46,7 +49,6 @@ public:
     {
         size_t sz = m_strCommand.length();
         size_t sz1;
-        exlib::string m_strBuf;
         char* pBuf;
 
         if (m_buffer != NULL) {
@@ -58,25 +60,28 @@ public:
                 return CHECK_ERROR(Runtime::setError("HttpMessage: body is not complete."));
         }
 
+        // the head is rendered straight into the buffer that goes to the wire
         sz1 = m_pThis->size();
-        m_strBuf = m_strCommand;
-        m_strBuf.resize(sz + sz1 + 2 + m_body_length);
+        m_datas.push_back(new Buffer(NULL, sz + 2 + sz1));
 
-        pBuf = m_strBuf.data() + sz;
+        pBuf = (char*)m_datas[0]->data();
+        memcpy(pBuf, m_strCommand.c_str(), sz);
+        pBuf += sz;
         *pBuf++ = '\r';
         *pBuf++ = '\n';
 
-        pBuf += m_pThis->getData(pBuf, sz1);
+        m_pThis->getData(pBuf, sz1);
 
         if (m_body_length > 0)
-            memcpy(pBuf, m_body_buf->data(), m_body_length);
+            m_datas.push_back(m_body_buf);
 
-        m_buffer = new Buffer(m_strBuf.c_str(), m_strBuf.length());
-        return m_stm->write(m_buffer, next(body));
+        return stream_writev(m_stm, m_datas, next(body));
     }
 
     ON_STATE(asyncSendTo, body)
     {
+        m_datas.clear();
+
         if (m_headerOnly || m_contentLength == 0 || m_body_length > 0)
             return next();
 
@@ -95,6 +100,7 @@ public:
     HttpMessage* m_pThis;
     obj_ptr<Stream_base> m_stm;
     obj_ptr<Buffer_base> m_buffer;
+    std::vector<obj_ptr<Buffer>> m_datas;
     int64_t m_contentLength;
     int64_t m_copySize;
     size_t m_body_length = 0;
@@ -185,32 +191,75 @@ result_t HttpMessage::sendHeader(Stream_base* stm, exlib::string& strCommand,
     return (new asyncSendTo(this, stm, strCommand, ac, true))->post(0);
 }
 
-result_t HttpMessage::readFrom(Stream_base* stm, AsyncEvent* ac)
+result_t HttpMessage::readHead(BufferedStream_base* stm, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    exlib::string& head = m_headers->arena();
+
+    m_headers->materialize();
+    head.clear();
+
+    stm->get_stream(m_socket);
+    m_stm = stm;
+
+    // leave room for the start line, content-length and transfer-encoding, which are not counted as headers
+    return ((BufferedStream*)stm)->readHead(m_maxHeaderSize, m_maxHeadersCount + 4, head, ac);
+}
+
+int32_t HttpMessage::headLine(int32_t pos, int32_t& sz)
+{
+    exlib::string& head = m_headers->arena();
+    const char* buf = head.c_str();
+    int32_t len = (int32_t)head.length();
+    const char* eol;
+
+    if (pos >= len) {
+        sz = 0;
+        return len;
+    }
+
+    eol = (const char*)memchr(buf + pos, '\n', len - pos);
+    sz = eol ? (int32_t)(eol - buf) - pos : len - pos;
+    if (sz > 0 && buf[pos + sz - 1] == '\r')
+        sz--;
+
+    return eol ? (int32_t)(eol - buf) + 1 : len;
+}
+
+result_t HttpMessage::readFrom(BufferedStream_base* stm, int32_t pos, AsyncEvent* ac)
 {
     class asyncReadFrom : public AsyncState {
     public:
-        asyncReadFrom(HttpMessage* pThis, BufferedStream_base* stm,
+        asyncReadFrom(HttpMessage* pThis, BufferedStream_base* stm, int32_t pos,
             AsyncEvent* ac)
             : AsyncState(ac)
             , m_pThis(pThis)
             , m_stm(stm)
+            , m_pos(pos)
             , m_contentLength(-1)
             , m_bChunked(false)
             , m_headCount(0)
         {
-            next(begin);
-        }
-
-        ON_STATE(asyncReadFrom, begin)
-        {
-            return m_stm->readLine(m_pThis->m_maxHeaderSize, m_strLine, next(header));
+            next(header);
         }
 
         ON_STATE(asyncReadFrom, header)
         {
-            if (m_strLine.length() > 0) {
-                if (!qstricmp(m_strLine.c_str(), "content-length:", 15)) {
-                    m_contentLength = atoi(m_strLine.c_str() + 15);
+            const char* buf = m_pThis->m_headers->arena().c_str();
+            int32_t pos = m_pos;
+            int32_t sz;
+
+            while (true) {
+                int32_t line = pos;
+
+                pos = m_pThis->headLine(line, sz);
+                if (sz == 0)
+                    break;
+
+                if (sz >= 15 && !qstricmp(buf + line, "content-length:", 15)) {
+                    m_contentLength = atoi(buf + line + 15);
 
                     if ((m_contentLength < 0)
                         || (m_pThis->m_maxBodySize >= 0
@@ -218,24 +267,22 @@ result_t HttpMessage::readFrom(Stream_base* stm, AsyncEvent* ac)
                         return CHECK_ERROR(Runtime::setError("HttpMessage: body is too huge."));
 
                     if (m_pThis->m_bNoBody) {
-                        result_t hr = m_pThis->addHeader(m_strLine);
+                        result_t hr = m_pThis->addHeader(line, sz);
                         if (hr < 0)
                             return hr;
 
                         m_headCount++;
                     }
-                } else if (!qstricmp(m_strLine.c_str(),
-                               "transfer-encoding:", 18)) {
-                    _parser p(m_strLine.c_str() + 18,
-                        (int32_t)m_strLine.length() - 18);
+                } else if (sz >= 18 && !qstricmp(buf + line, "transfer-encoding:", 18)) {
+                    _parser p(buf + line + 18, sz - 18);
 
                     p.skipSpace();
-                    if (qstricmp(p.now(), "chunked"))
+                    if (p.left() != 7 || qstricmp(p.now(), "chunked", 7))
                         return CHECK_ERROR(Runtime::setError("HttpMessage: unknown transfer-encoding."));
 
                     m_bChunked = true;
                 } else {
-                    result_t hr = m_pThis->addHeader(m_strLine);
+                    result_t hr = m_pThis->addHeader(line, sz);
                     if (hr < 0)
                         return hr;
 
@@ -244,8 +291,6 @@ result_t HttpMessage::readFrom(Stream_base* stm, AsyncEvent* ac)
 
                 if (m_headCount > m_pThis->m_maxHeadersCount)
                     return CHECK_ERROR(Runtime::setError("HttpMessage: too many headers."));
-
-                return m_stm->readLine(m_pThis->m_maxHeaderSize, m_strLine, this);
             }
 
             if (m_bChunked) {
@@ -256,13 +301,19 @@ result_t HttpMessage::readFrom(Stream_base* stm, AsyncEvent* ac)
                     return CHECK_ERROR(CALL_E_INVALID_DATA);
                 m_contentLength = 0;
 
-                m_pThis->get_body(m_body);
+                result_t hr = open_body();
+                if (hr < 0)
+                    return hr;
+
                 return next(chunk_head);
             }
 
             if (!m_pThis->m_bNoBody && (m_contentLength > 0 || (m_pThis->m_bResponse && !m_pThis->m_keepAlive && m_contentLength == -1))) {
-                m_pThis->get_body(m_body);
-                return m_stm->copyTo(m_body, m_contentLength, m_copySize, next(body));
+                result_t hr = open_body();
+                if (hr < 0)
+                    return hr;
+
+                return m_stm->copyTo(m_sink, m_contentLength, m_copySize, next(body));
             }
 
             return next();
@@ -273,7 +324,15 @@ result_t HttpMessage::readFrom(Stream_base* stm, AsyncEvent* ac)
             if (!m_pThis->m_bNoBody && m_contentLength > 0 && m_contentLength != m_copySize)
                 return CHECK_ERROR(Runtime::setError("HttpMessage: body is not complete."));
 
+            return next(body_end);
+        }
+
+        ON_STATE(asyncReadFrom, body_end)
+        {
             m_body->rewind();
+            if (m_sink != m_body)
+                return m_sink->close(next());
+
             return next();
         }
 
@@ -302,7 +361,7 @@ result_t HttpMessage::readFrom(Stream_base* stm, AsyncEvent* ac)
                 if (m_pThis->m_maxBodySize >= 0
                     && sz + m_contentLength > (int64_t)m_pThis->m_maxBodySize * 1024 * 1024)
                     return CHECK_ERROR(Runtime::setError("HttpMessage: body is too huge."));
-                return m_stm->copyTo(m_body, sz, m_copySize, next(chunk_body_end));
+                return m_stm->copyTo(m_sink, sz, m_copySize, next(chunk_body_end));
             }
 
             return m_stm->readLine(m_pThis->m_maxHeaderSize, m_strLine, next(chunk_end));
@@ -316,15 +375,41 @@ result_t HttpMessage::readFrom(Stream_base* stm, AsyncEvent* ac)
 
         ON_STATE(asyncReadFrom, chunk_end)
         {
-            m_body->rewind();
-            return next();
+            return next(body_end);
+        }
+
+    private:
+        // with m_streamForm set, multipart/form-data requests are parsed while the body
+        // arrives instead of being kept in memory, the parts end up in m_form
+        result_t open_body()
+        {
+            m_pThis->get_body(m_body);
+            m_sink = m_body;
+
+            if (m_pThis->m_streamForm && !m_pThis->m_bResponse) {
+                exlib::string strType;
+
+                if (m_pThis->firstHeader("Content-Type", strType) != CALL_RETURN_NULL
+                    && !qstricmp(strType.c_str(), "multipart/form-data;", 20)) {
+                    obj_ptr<HttpUploadCollection> col = new HttpUploadCollection();
+                    result_t hr = col->parser(strType.c_str(), m_sink);
+                    if (hr < 0)
+                        return hr;
+
+                    m_pThis->m_form = col;
+                }
+            }
+
+            return 0;
         }
 
     public:
         HttpMessage* m_pThis;
         obj_ptr<BufferedStream_base> m_stm;
         obj_ptr<SeekableStream_base> m_body;
+        obj_ptr<Stream_base> m_sink;
         exlib::string m_strLine;
+        int32_t m_pos;
         int64_t m_contentLength;
         bool m_bChunked;
         int32_t m_headCount;
@@ -334,41 +419,40 @@ result_t HttpMessage::readFrom(Stream_base* stm, AsyncEvent* ac)
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    obj_ptr<BufferedStream_base> _stm = BufferedStream_base::getInstance(stm);
-    if (!_stm)
-        return CHECK_ERROR(Runtime::setError("HttpMessage: only accept BufferedStream object."));
-
-    _stm->get_stream(m_socket);
-    m_stm = _stm;
-
-    return (new asyncReadFrom(this, _stm, ac))->post(0);
+    return (new asyncReadFrom(this, stm, pos, ac))->post(0);
 }
 
-void HttpMessage::addHeader(const char* name, int32_t szName, const char* value,
-    int32_t szValue)
+result_t HttpMessage::addHeader(int32_t pos, int32_t sz)
 {
-    if (szName == 10 && !qstricmp(name, "connection", szName)) {
-        if (qstristr(value, "upgrade")) {
+    exlib::string& head = m_headers->arena();
+    const char* buf = head.c_str() + pos;
+    const char* colon = (const char*)memchr(buf, ':', sz);
+    int32_t szName = colon ? (int32_t)(colon - buf) : 0;
+    int32_t value, szValue;
+    int32_t i;
+
+    for (i = 0; i < szName; i++)
+        if (qisspace(buf[i]))
+            break;
+
+    if (szName == 0 || i < szName)
+        return CHECK_ERROR(Runtime::setError("HttpMessage: bad header: " + exlib::string(buf, sz)));
+
+    value = szName + 1;
+    while (value < sz && qisspace(buf[value]))
+        value++;
+    szValue = sz - value;
+
+    if (szName == 10 && !qstricmp(buf, "connection", szName)) {
+        exlib::string v(buf + value, szValue);
+
+        if (qstristr(v.c_str(), "upgrade")) {
             m_upgrade = true;
             m_keepAlive = true;
         } else
-            m_keepAlive = !!qstristr(value, "keep-alive");
+            m_keepAlive = !!qstristr(v.c_str(), "keep-alive");
     } else
-        m_headers->add(name, szName, value, szValue);
-}
-
-result_t HttpMessage::addHeader(exlib::string& strLine)
-{
-    int32_t p2;
-    _parser p(strLine);
-
-    p.skipWord(':');
-    p2 = p.pos;
-    if (0 == p2 || !p.want(':'))
-        return CHECK_ERROR(Runtime::setError("HttpMessage: bad header: " + strLine));
-
-    p.skipSpace();
-    addHeader(p.string, p2, p.now(), p.left());
+        m_headers->add_raw(pos, szName, pos + value, szValue);
 
     return 0;
 }
@@ -623,6 +707,7 @@ result_t HttpMessage::clear()
     m_encoding.clear();
 
     m_headers->clear();
+    m_form.Release();
 
     m_stm.Release();
     m_socket.Release();
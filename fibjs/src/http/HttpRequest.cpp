@@ -302,7 +302,7 @@ result_t HttpRequest::readFrom(Stream_base* stm, AsyncEvent* ac)
 
         ON_STATE(asyncReadFrom, begin)
         {
-            return m_stm->readLine(m_pThis->m_message->m_maxHeaderSize, m_strLine, next(command));
+            return m_pThis->m_message->readHead(m_stm, next(command));
         }
 
         ON_STATE(asyncReadFrom, command)
@@ -310,7 +310,9 @@ result_t HttpRequest::readFrom(Stream_base* stm, AsyncEvent* ac)
             if (n == CALL_RETURN_NULL)
                 return CHECK_ERROR(CALL_E_CLOSED);
 
-            _parser p(m_strLine);
+            int32_t sz;
+            int32_t pos = m_pThis->m_message->headLine(0, sz);
+            _parser p(m_pThis->m_message->m_headers->arena().c_str(), sz);
             result_t hr;
 
             if (!p.getWord(m_pThis->m_method))
@@ -338,17 +340,16 @@ result_t HttpRequest::readFrom(Stream_base* stm, AsyncEvent* ac)
             if (p.end())
                 return CHECK_ERROR(Runtime::setError("HttpRequest: bad protocol version."));
 
-            hr = m_pThis->set_protocol(p.now());
+            hr = m_pThis->set_protocol(exlib::string(p.now(), p.left()));
             if (hr < 0)
                 return hr;
 
-            return m_pThis->m_message->readFrom(m_stm, next());
+            return m_pThis->m_message->readFrom(m_stm, pos, next());
         }
 
     public:
         obj_ptr<HttpRequest> m_pThis;
         obj_ptr<BufferedStream_base> m_stm;
-        exlib::string m_strLine;
     };
 
     if (ac->isSync())
@@ -429,6 +430,9 @@ result_t HttpRequest::get_cookies(obj_ptr<HttpCollection_base>& retVal)
 
 result_t HttpRequest::get_form(obj_ptr<HttpCollection_base>& retVal)
 {
+    if (m_form == NULL && m_message->m_form)
+        m_form = m_message->m_form;
+
     if (m_form == NULL) {
         int64_t len = 0;
 
@@ -450,21 +454,26 @@ result_t HttpRequest::get_form(obj_ptr<HttpCollection_base>& retVal)
 
             obj_ptr<Buffer_base> buf;
             obj_ptr<SeekableStream_base> _body;
+            result_t hr;
 
             get_body(_body);
-            _body->rewind();
-            result_t hr = _body->cc_read((int32_t)len, buf);
-            if (hr < 0)
-                return hr;
-
-            exlib::string strForm;
-            buf->toString(strForm);
 
             if (bUpload) {
                 obj_ptr<HttpUploadCollection> col = new HttpUploadCollection();
-                col->parse(strForm, strType.c_str());
+                hr = col->parse(_body, strType.c_str());
+                if (hr < 0)
+                    return hr;
+
                 m_form = col;
             } else {
+                _body->rewind();
+                hr = _body->cc_read((int32_t)len, buf);
+                if (hr < 0)
+                    return hr;
+
+                exlib::string strForm;
+                buf->toString(strForm);
+
                 obj_ptr<HttpCollection> c = new HttpCollection();
                 c->parse(strForm);
                 m_form = c;
@@ -315,11 +315,8 @@ result_t http_base::get_STATUS_CODES(v8::Local<v8::Object>& retVal)
     return 0;
 }
 
-result_t HttpResponse::sendTo(Stream_base* stm, AsyncEvent* ac)
+void HttpResponse::flushCookies()
 {
-    if (ac->isSync())
-        return CHECK_ERROR(CALL_E_NOSYNC);
-
     if (m_cookies) {
         int32_t len, i;
 
@@ -341,6 +338,14 @@ result_t HttpResponse::sendTo(Stream_base* stm, AsyncEvent* ac)
 
         m_cookies.Release();
     }
+}
+
+result_t HttpResponse::sendTo(Stream_base* stm, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    flushCookies();
 
     exlib::string strCommand;
     exlib::string statusMessage;
@@ -390,7 +395,7 @@ result_t HttpResponse::readFrom(Stream_base* stm, AsyncEvent* ac)
 
         ON_STATE(asyncReadFrom, begin)
         {
-            return m_stm->readLine(m_pThis->m_message->m_maxHeaderSize, m_strLine, next(command));
+            return m_pThis->m_message->readHead(m_stm, next(command));
         }
 
         ON_STATE(asyncReadFrom, command)
@@ -399,29 +404,30 @@ result_t HttpResponse::readFrom(Stream_base* stm, AsyncEvent* ac)
                 return CHECK_ERROR(CALL_E_CLOSED);
 
             result_t hr;
-            const char* c_str = m_strLine.c_str();
-            int32_t len = (int32_t)m_strLine.length();
+            int32_t len;
+            int32_t pos = m_pThis->m_message->headLine(0, len);
+            const char* c_str = m_pThis->m_message->m_headers->arena().c_str();
 
             if (len < 12 || c_str[8] != ' '
                 || !qisdigit(c_str[9]) || !qisdigit(c_str[10]) || !qisdigit(c_str[11])
-                || qisdigit(c_str[12]))
-                return CHECK_ERROR(Runtime::setError("HttpResponse: bad protocol: " + m_strLine));
+                || (len > 12 && qisdigit(c_str[12])))
+                return CHECK_ERROR(Runtime::setError("HttpResponse: bad protocol: " + exlib::string(c_str, len)));
+
+            int32_t msg = (len > 12 && c_str[12] == ' ') ? 13 : 12;
 
             m_pThis->set_statusCode((c_str[9] - '0') * 100 + (c_str[10] - '0') * 10 + (c_str[11] - '0'));
-            m_pThis->set_statusMessage(c_str[12] == ' ' ? c_str + 13 : c_str + 12);
+            m_pThis->set_statusMessage(exlib::string(c_str + msg, len - msg));
 
-            m_strLine.resize(8);
-            hr = m_pThis->set_protocol(m_strLine);
+            hr = m_pThis->set_protocol(exlib::string(c_str, 8));
             if (hr < 0)
                 return hr;
 
-            return m_pThis->m_message->readFrom(m_stm, next());
+            return m_pThis->m_message->readFrom(m_stm, pos, next());
         }
 
     public:
         obj_ptr<HttpResponse> m_pThis;
         obj_ptr<BufferedStream_base> m_stm;
-        exlib::string m_strLine;
     };
 
     if (ac->isSync())
@@ -559,27 +565,7 @@ result_t HttpResponse::sendHeader(Stream_base* stm, AsyncEvent* ac)
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    if (m_cookies) {
-        int32_t len, i;
-
-        len = m_cookies->length();
-
-        for (i = 0; i < len; i++) {
-            Variant v;
-            obj_ptr<object_base> cookie;
-            exlib::string str;
-
-            m_cookies->_indexed_getter(i, v);
-            cookie = v.object();
-
-            if (cookie) {
-                cookie->toString(str);
-                addHeader("Set-Cookie", str);
-            }
-        }
-
-        m_cookies.Release();
-    }
+    flushCookies();
 
     int32_t pos = shortcut[m_statusCode / 100 - 1] + m_statusCode % 100;
     exlib::string strCommand;
@@ -43,16 +43,52 @@ result_t HttpServer_base::_new(exlib::string addr, Handler_base* hdlr,
     return _new(addr, 0, hdlr, retVal, This);
 }
 
-result_t HttpServer::create(exlib::string addr, int32_t port, Handler_base* hdlr)
+result_t HttpServer_base::_new(v8::Local<v8::Object> opts, Handler_base* hdlr,
+    obj_ptr<HttpServer_base>& retVal, v8::Local<v8::Object> This)
 {
     result_t hr;
-    obj_ptr<TcpServer> _server;
-    obj_ptr<HttpHandler_base> _handler;
 
-    hr = HttpHandler_base::_new(hdlr, _handler);
+    obj_ptr<HttpServer> svr = new HttpServer();
+    svr->wrap(This);
+
+    hr = svr->create(opts, hdlr);
+    if (hr < 0)
+        return hr;
+
+    retVal = svr;
+    return 0;
+}
+
+result_t HttpServer_base::_new(v8::Local<v8::Object> opts, obj_ptr<HttpServer_base>& retVal,
+    v8::Local<v8::Object> This)
+{
+    result_t hr;
+
+    obj_ptr<HttpServer> svr = new HttpServer();
+    svr->wrap(This);
+
+    hr = svr->create_workers(opts);
     if (hr < 0)
         return hr;
 
+    retVal = svr;
+    return 0;
+}
+
+result_t HttpServer::init(Handler_base* hdlr, obj_ptr<TcpServer>& retVal)
+{
+    result_t hr;
+    obj_ptr<TcpServer> _server;
+    obj_ptr<HttpHandler_base> _handler;
+
+    // in worker mode the handler only carries the settings, each worker gets a copy of them
+    if (hdlr) {
+        hr = HttpHandler_base::_new(hdlr, _handler);
+        if (hr < 0)
+            return hr;
+    } else
+        _handler = new HttpHandler();
+
     _server = new TcpServer();
 
     SetPrivate("handler", _handler->wrap());
@@ -61,7 +97,38 @@ result_t HttpServer::create(exlib::string addr, int32_t port, Handler_base* hdlr
     SetPrivate("server", _server->wrap());
     m_server = _server;
 
-    return _server->create(addr, port, _handler);
+    retVal = _server;
+    return 0;
+}
+
+result_t HttpServer::create(exlib::string addr, int32_t port, Handler_base* hdlr)
+{
+    obj_ptr<TcpServer> _server;
+    result_t hr = init(hdlr, _server);
+    if (hr < 0)
+        return hr;
+
+    return _server->create(addr, port, m_hdlr);
+}
+
+result_t HttpServer::create(v8::Local<v8::Object> opts, Handler_base* hdlr)
+{
+    obj_ptr<TcpServer> _server;
+    result_t hr = init(hdlr, _server);
+    if (hr < 0)
+        return hr;
+
+    return _server->create(opts, m_hdlr);
+}
+
+result_t HttpServer::create_workers(v8::Local<v8::Object> opts)
+{
+    obj_ptr<TcpServer> _server;
+    result_t hr = init(NULL, _server);
+    if (hr < 0)
+        return hr;
+
+    return _server->create_workers(opts, (HttpHandler*)(HttpHandler_base*)m_hdlr);
 }
 
 result_t HttpServer::start()
@@ -74,6 +141,11 @@ result_t HttpServer::stop(AsyncEvent* ac)
     return m_server->stop(ac);
 }
 
+result_t HttpServer::reload(AsyncEvent* ac)
+{
+    return m_server->reload(ac);
+}
+
 result_t HttpServer::get_socket(obj_ptr<Socket_base>& retVal)
 {
     return m_server->get_socket(retVal);
@@ -86,14 +158,27 @@ result_t HttpServer::get_handler(obj_ptr<Handler_base>& retVal)
 
 result_t HttpServer::set_handler(Handler_base* newVal)
 {
+    if (((TcpServer*)(TcpServer_base*)m_server)->is_worker())
+        return CHECK_ERROR(Runtime::setError("HttpServer: worker mode loads the handler from the worker module."));
+
     return m_hdlr->set_handler(newVal);
 }
 
+result_t HttpServer::get_stats(v8::Local<v8::Object>& retVal)
+{
+    return m_server->get_stats(retVal);
+}
+
 result_t HttpServer::enableCrossOrigin(exlib::string allowHeaders)
 {
     return m_hdlr->enableCrossOrigin(allowHeaders);
 }
 
+result_t HttpServer::setEncodingOptions(exlib::string type, v8::Local<v8::Object> opts)
+{
+    return m_hdlr->setEncodingOptions(type, opts);
+}
+
 result_t HttpServer::get_maxHeadersCount(int32_t& retVal)
 {
     return m_hdlr->get_maxHeadersCount(retVal);
@@ -134,6 +219,26 @@ result_t HttpServer::set_enableEncoding(bool newVal)
     return m_hdlr->set_enableEncoding(newVal);
 }
 
+result_t HttpServer::get_streamForm(bool& retVal)
+{
+    return m_hdlr->get_streamForm(retVal);
+}
+
+result_t HttpServer::set_streamForm(bool newVal)
+{
+    return m_hdlr->set_streamForm(newVal);
+}
+
+result_t HttpServer::get_encodingCacheSize(int32_t& retVal)
+{
+    return m_hdlr->get_encodingCacheSize(retVal);
+}
+
+result_t HttpServer::set_encodingCacheSize(int32_t newVal)
+{
+    return m_hdlr->set_encodingCacheSize(newVal);
+}
+
 result_t HttpServer::get_serverName(exlib::string& retVal)
 {
     return m_hdlr->get_serverName(retVal);
@@ -9,86 +9,325 @@
 #include "HttpUploadCollection.h"
 #include "HttpUploadData.h"
 #include "MemoryStream.h"
+#include "Buffer.h"
+#include "File.h"
+#include "ifs/os.h"
+#include <uv/include/uv.h>
 #include <string.h>
 
 namespace fibjs {
 
-void HttpUploadCollection::parse(exlib::string& str, const char* boundary)
+#define UPLOAD_HEADER_SIZE 8192
+#define UPLOAD_SPILL_SIZE (1024 * 1024)
+#define UPLOAD_FIELDS_SIZE (8 * 1024 * 1024)
+
+static result_t open_spill_file(obj_ptr<File>& retVal)
 {
-    const char* pstr = str.c_str();
-    size_t nSize = str.length();
-    exlib::string strName;
-    exlib::string strFileName;
-    exlib::string strContentType;
-    exlib::string strContentTransferEncoding;
-    const char *p, *p1, *p2, *szQueryString;
-    const char* pstrSplit;
-    size_t uiSplitSize;
-    char ch;
-
-    boundary += 20;
-    while (*boundary && *boundary == ' ')
-        boundary++;
+    static exlib::atomic s_seq;
+    exlib::string path;
+    result_t hr;
+
+    hr = os_base::tmpdir(path);
+    if (hr < 0)
+        return hr;
+
+    char name[64];
+    snprintf(name, sizeof(name), "%cfibjs-upload-%d-%lld", PATH_SLASH,
+        (int32_t)uv_os_getpid(), (long long)s_seq.inc());
+    path.append(name);
+
+#ifdef _WIN32
+    int32_t fd = _wopen(UTF8_W(path), _O_BINARY | _O_CREAT | _O_EXCL | _O_RDWR | _O_TEMPORARY,
+        _S_IREAD | _S_IWRITE);
+    if (fd < 0)
+        return CHECK_ERROR(LastError());
+#else
+    int32_t fd = ::open(path.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0600);
+    if (fd < 0)
+        return CHECK_ERROR(LastError());
+    ::unlink(path.c_str());
+#endif
+
+    retVal = new File(fd);
+    return 0;
+}
+
+class multipart_parser {
+public:
+    multipart_parser(HttpUploadCollection* col, const char* boundary)
+        : m_col(col)
+        , m_state(0)
+        , m_pos(0)
+        , m_spilled(false)
+        , m_fieldsSize(0)
+    {
+        size_t i, n;
+
+        m_delimiter.assign("\r\n--", 4);
+        m_delimiter.append(boundary);
+        n = m_delimiter.length();
+
+        for (i = 0; i < 256; i++)
+            m_skip[i] = n;
+        for (i = 0; i < n - 1; i++)
+            m_skip[(unsigned char)m_delimiter[i]] = n - 1 - i;
+
+        // the first boundary is not preceded by CRLF
+        m_buffer.assign("\r\n", 2);
+    }
+
+public:
+    result_t feed(const char* data, size_t sz)
+    {
+        result_t hr;
+
+        if (m_state == _done)
+            return 0;
+
+        m_buffer.append(data, sz);
+
+        while (true) {
+            const char* pstr = m_buffer.c_str();
+            size_t len = m_buffer.length();
+
+            if (m_state == _preamble || m_state == _body) {
+                const char* p = find(pstr + m_pos, pstr + len);
+
+                if (p == NULL) {
+                    size_t keep = m_delimiter.length() - 1;
+
+                    if (len > m_pos + keep) {
+                        if (m_state == _body) {
+                            hr = on_data(pstr + m_pos, len - m_pos - keep);
+                            if (hr < 0)
+                                return hr;
+                        }
+                        m_pos = len - keep;
+                    }
+                    break;
+                }
+
+                if (m_state == _body) {
+                    hr = on_data(pstr + m_pos, p - pstr - m_pos);
+                    if (hr < 0)
+                        return hr;
+
+                    hr = on_part_end();
+                    if (hr < 0)
+                        return hr;
+                }
+
+                m_pos = p - pstr + m_delimiter.length();
+                m_state = _boundary;
+            } else if (m_state == _boundary) {
+                if (len < m_pos + 2)
+                    break;
+
+                if (pstr[m_pos] == '-' && pstr[m_pos + 1] == '-') {
+                    m_state = _done;
+                    break;
+                }
+
+                if (pstr[m_pos] != '\r')
+                    return fail();
+                m_pos++;
+                if (pstr[m_pos] == '\n')
+                    m_pos++;
+
+                m_state = _header;
+            } else if (m_state == _header) {
+                const char* p = pstr + m_pos;
+                const char* p1;
+
+                if (len < m_pos + 2)
+                    break;
+
+                if (p[0] == '\r' && p[1] == '\n')
+                    p1 = p;
+                else {
+                    p1 = (const char*)exlib::qmemmem((const uint8_t*)p, len - m_pos,
+                        (const uint8_t*)"\r\n\r\n", 4);
+                    if (p1 == NULL) {
+                        if (len - m_pos > UPLOAD_HEADER_SIZE)
+                            return fail();
+                        break;
+                    }
+
+                    p1 += 2;
+                }
+
+                if (!on_headers(p, p1))
+                    return fail();
+
+                // leave the last CRLF in place, an empty body is followed by the delimiter directly
+                m_pos = p1 - pstr;
+                m_state = _body_start;
+            } else if (m_state == _body_start) {
+                size_t n = m_delimiter.length();
+
+                if (len < m_pos + n)
+                    break;
+
+                if (memcmp(pstr + m_pos, m_delimiter.c_str(), n))
+                    m_pos += 2;
+                m_state = _body;
+            } else
+                break;
+        }
+
+        if (m_pos > 0) {
+            m_buffer = m_buffer.substr(m_pos);
+            m_pos = 0;
+        }
+
+        return 0;
+    }
+
+private:
+    const char* find(const char* p, const char* end)
+    {
+        const char* d = m_delimiter.c_str();
+        size_t n = m_delimiter.length();
+
+        while ((size_t)(end - p) >= n) {
+            unsigned char ch = (unsigned char)p[n - 1];
 
-    if (qstricmp(boundary, "boundary=", 9))
-        return;
+            if (ch == (unsigned char)d[n - 1] && !memcmp(p, d, n - 1))
+                return p;
+            p += m_skip[ch];
+        }
 
-    boundary += 9;
-    uiSplitSize = qstrlen(boundary);
+        return NULL;
+    }
 
-    pstrSplit = szQueryString = pstr;
+    result_t fail()
+    {
+        m_state = _done;
+        return CHECK_ERROR(Runtime::setError("HttpUploadCollection: bad multipart data."));
+    }
 
-    if (nSize < uiSplitSize + 2 || szQueryString[0] != '-'
-        || szQueryString[1] != '-'
-        || qstrcmp(szQueryString + 2, boundary, uiSplitSize))
-        return;
+public:
+    // called once the whole body has been fed, a part that is still open means the body was cut short
+    result_t finish()
+    {
+        if (m_state == _done)
+            return 0;
 
-    uiSplitSize += 2;
-    szQueryString += uiSplitSize;
-    nSize -= uiSplitSize;
+        if (m_state == _preamble)
+            return fail();
 
-    while (nSize) {
-        strFileName.clear();
-        strContentType.clear();
-        strContentTransferEncoding.clear();
+        if (m_state == _boundary || m_state == _header) {
+            const char* p = m_buffer.c_str() + m_pos;
+            size_t len = m_buffer.length() - m_pos;
 
-        while (nSize > 0) {
-            ch = *szQueryString++;
-            nSize--;
-            if (ch != '\r')
-                return;
-            if (nSize > 0 && *szQueryString == '\n') {
-                nSize--;
-                szQueryString++;
+            // the closing "--" is often left out, a bare boundary line still ends the form
+            if (len == 0 || (len == 2 && p[0] == '\r' && p[1] == '\n')) {
+                m_state = _done;
+                return 0;
             }
+        }
+
+        return fail();
+    }
+
+    bool pending()
+    {
+        return !m_jobs.empty();
+    }
+
+    // writes the queued file part data to disk
+    result_t spill()
+    {
+        result_t hr = 0;
+        size_t i;
 
-            p = szQueryString;
-            while (nSize > 0 && *p != '\r') {
-                nSize--;
-                p++;
+        for (i = 0; i < m_jobs.size(); i++) {
+            spill_job& job = m_jobs[i];
+
+            if (job.m_part != m_spillPart) {
+                hr = open_spill_file(m_spillFile);
+                if (hr < 0)
+                    break;
+                m_spillPart = job.m_part;
             }
 
-            if (nSize == 0)
+            hr = m_spillFile->Write(job.m_data);
+            if (hr < 0)
                 break;
 
-            p1 = szQueryString;
-            szQueryString = p;
+            if (job.m_last) {
+                m_spillFile->rewind();
+                job.m_part->m_body = m_spillFile;
 
-            if (p != p1) {
-                if (p1 + 20 < p && !qstricmp(p1, "Content-Disposition:", 20)) {
-                    p1 += 20;
-                    while (p1 < p && *p1 == ' ')
-                        p1++;
-                    if (p1 + 10 >= p || qstricmp(p1, "form-data;", 10))
-                        return;
+                m_spillFile.Release();
+                m_spillPart.Release();
+            }
+        }
 
-                    p1 += 10;
-                    while (p1 < p && *p1 == ' ')
-                        p1++;
-                    if (p1 + 5 >= p || qstricmp(p1, "name=", 5))
-                        return;
+        m_jobs.clear();
+        return hr;
+    }
+
+private:
+    bool on_headers(const char* p1, const char* end)
+    {
+        const char *p, *p2;
+        char ch;
+
+        m_name.clear();
+        m_fileName.clear();
+        m_contentType.clear();
+        m_contentTransferEncoding.clear();
+        m_data.clear();
+        m_part.Release();
+        m_spilled = false;
+
+        while (p1 < end) {
+            p = (const char*)memchr(p1, '\r', end - p1);
+            if (p == NULL)
+                p = end;
+
+            if (p1 + 20 < p && !qstricmp(p1, "Content-Disposition:", 20)) {
+                p1 += 20;
+                while (p1 < p && *p1 == ' ')
+                    p1++;
+                if (p1 + 10 >= p || qstricmp(p1, "form-data;", 10))
+                    return false;
+
+                p1 += 10;
+                while (p1 < p && *p1 == ' ')
+                    p1++;
+                if (p1 + 5 >= p || qstricmp(p1, "name=", 5))
+                    return false;
+
+                p1 += 5;
+
+                while (p1 < p && *p1 == ' ')
+                    p1++;
+
+                ch = ';';
+                if (*p1 == '\"') {
+                    p1++;
+                    ch = '\"';
+                }
+
+                p2 = p1;
+                while (p1 < p && *p1 != ch)
+                    p1++;
+
+                m_name.assign(p2, (size_t)(p1 - p2));
+
+                if (p1 < p && *p1 == '\"')
+                    p1++;
+
+                if (p1 < p && *p1 == ';')
+                    p1++;
 
-                    p1 += 5;
+                while (p1 < p && *p1 == ' ')
+                    p1++;
+
+                if (p1 + 9 < p && !qstricmp(p1, "filename=", 9)) {
+                    p1 += 9;
 
                     while (p1 < p && *p1 == ' ')
                         p1++;
@@ -100,112 +339,231 @@ void HttpUploadCollection::parse(exlib::string& str, const char* boundary)
                     }
 
                     p2 = p1;
-                    while (p1 < p && *p1 != ch)
+                    while (p1 < p && *p1 != ch) {
+                        if (*p1 == '/' || *p1 == '\\')
+                            p2 = p1 + 1;
                         p1++;
+                    }
 
-                    strName.assign(p2, (size_t)(p1 - p2));
+                    m_fileName.assign(p2, (size_t)(p1 - p2));
+                }
+            } else if (p1 + 13 < p && !qstricmp(p1, "Content-Type:", 13)) {
+                p1 += 13;
+                while (p1 < p && *p1 == ' ')
+                    p1++;
+                m_contentType.assign(p1, (size_t)(p - p1));
+            } else if (p1 + 26 < p && !qstricmp(p1, "Content-Transfer-Encoding:", 26)) {
+                p1 += 26;
+                while (p1 < p && *p1 == ' ')
+                    p1++;
+                m_contentTransferEncoding.assign(p1, (size_t)(p - p1));
+            }
 
-                    if (p1 < p && *p1 == '\"')
-                        p1++;
+            p1 = p;
+            if (p1 < end && *p1 == '\r')
+                p1++;
+            if (p1 < end && *p1 == '\n')
+                p1++;
+        }
 
-                    if (p1 < p && *p1 == ';')
-                        p1++;
+        return true;
+    }
 
-                    while (p1 < p && *p1 == ' ')
-                        p1++;
+    void queue(bool last)
+    {
+        if (!m_part)
+            m_part = new HttpUploadData();
 
-                    if (p1 + 9 < p && !qstricmp(p1, "filename=", 9)) {
-                        p1 += 9;
+        m_jobs.resize(m_jobs.size() + 1);
 
-                        while (p1 < p && *p1 == ' ')
-                            p1++;
+        spill_job& job = m_jobs.back();
+        job.m_part = m_part;
+        job.m_data = m_data;
+        job.m_last = last;
 
-                        ch = ';';
-                        if (*p1 == '\"') {
-                            p1++;
-                            ch = '\"';
-                        }
+        m_data.clear();
+        m_spilled = !last;
+    }
 
-                        p2 = p1;
-                        while (p1 < p && *p1 != ch) {
-                            if (*p1 == '/' || *p1 == '\\')
-                                p2 = p1 + 1;
-                            p1++;
-                        }
+    result_t on_data(const char* p, size_t sz)
+    {
+        if (m_name.empty() || sz == 0)
+            return 0;
 
-                        strFileName.assign(p2, (size_t)(p1 - p2));
-                    }
-                } else if (p1 + 13 < p && !qstricmp(p1, "Content-Type:", 13)) {
-                    p1 += 13;
-                    while (p1 < p && *p1 == ' ')
-                        p1++;
-                    strContentType.assign(p1, (size_t)(p - p1));
-                } else if (p1 + 26 < p && !qstricmp(p1, "Content-Transfer-Encoding:", 26)) {
-                    p1 += 26;
-                    while (p1 < p && *p1 == ' ')
-                        p1++;
-                    strContentTransferEncoding.assign(p1, (size_t)(p - p1));
-                }
-            } else {
-                ch = *szQueryString++;
-                nSize--;
-                if (ch != '\r')
-                    return;
-                if (nSize > 0 && *szQueryString == '\n') {
-                    nSize--;
-                    szQueryString++;
-                }
-                break;
+        // text fields stay in memory, so all of them together are kept under UPLOAD_FIELDS_SIZE
+        if (m_fileName.empty()) {
+            m_fieldsSize += sz;
+            if (m_fieldsSize > UPLOAD_FIELDS_SIZE) {
+                m_state = _done;
+                return CHECK_ERROR(Runtime::setError("HttpUploadCollection: form fields are too huge."));
             }
         }
 
-        p = szQueryString;
-        p1 = p + nSize;
-        while (p1 > p && (p = (char*)memchr(p, '-', p1 - p))
-            && p1 > p + uiSplitSize && memcmp(p, pstrSplit, uiSplitSize))
-            p++;
-
-        if (!p || p1 <= p + uiSplitSize)
-            break;
+        m_data.append(p, sz);
+        if (!m_fileName.empty() && m_data.length() >= UPLOAD_SPILL_SIZE)
+            queue(false);
 
-        nSize = (size_t)(p1 - p - uiSplitSize);
-        p1 = szQueryString;
-        szQueryString = p + uiSplitSize;
+        return 0;
+    }
 
-        if (p > p1) {
-            p--;
-            ch = *p;
-            if (ch != '\n')
-                return;
+    result_t on_part_end()
+    {
+        if (m_name.empty())
+            return 0;
 
-            if (p > p1 && *(p - 1) == '\r')
-                p--;
-        }
+        Variant varTemp;
 
-        if (!strName.empty()) {
-            size_t uiSize = (size_t)(p - p1);
-            exlib::string strTemp;
-            Variant varTemp;
+        if (m_fileName.empty())
+            varTemp = m_data;
+        else {
+            if (!m_part)
+                m_part = new HttpUploadData();
 
-            strTemp.assign(p1, uiSize);
+            m_part->m_name = m_fileName;
+            m_part->m_type = m_contentType;
+            m_part->m_encoding = m_contentTransferEncoding;
 
-            if (strFileName.empty())
-                varTemp = strTemp;
+            // once a part has started spilling, the rest of it follows it to the same file
+            if (m_spilled)
+                queue(true);
             else {
-                obj_ptr<HttpUploadData> objTemp = new HttpUploadData();
                 date_t tm;
-
-                objTemp->m_name = strFileName;
-                objTemp->m_type = strContentType;
-                objTemp->m_encoding = strContentTransferEncoding;
-                objTemp->m_body = new MemoryStream::CloneStream(strTemp, tm);
-
-                varTemp = objTemp;
+                m_part->m_body = new MemoryStream::CloneStream(m_data, tm);
             }
 
-            add(strName, varTemp);
+            varTemp = m_part;
+            m_part.Release();
         }
+
+        m_data.clear();
+        return m_col->add(m_name, varTemp);
+    }
+
+private:
+    enum {
+        _preamble = 0,
+        _boundary,
+        _header,
+        _body_start,
+        _body,
+        _done
+    };
+
+    HttpUploadCollection* m_col;
+    exlib::string m_delimiter;
+    size_t m_skip[256];
+
+    int32_t m_state;
+    exlib::string m_buffer;
+    size_t m_pos;
+
+    exlib::string m_name;
+    exlib::string m_fileName;
+    exlib::string m_contentType;
+    exlib::string m_contentTransferEncoding;
+    exlib::string m_data;
+    obj_ptr<HttpUploadData> m_part;
+    bool m_spilled;
+    size_t m_fieldsSize;
+
+    class spill_job {
+    public:
+        obj_ptr<HttpUploadData> m_part;
+        exlib::string m_data;
+        bool m_last;
+    };
+
+    std::vector<spill_job> m_jobs;
+    obj_ptr<HttpUploadData> m_spillPart;
+    obj_ptr<File> m_spillFile;
+};
+
+// receives the body of a multipart/form-data message and turns it into parts as it arrives,
+// file parts that grow past UPLOAD_SPILL_SIZE are written out the way File::write does
+class multipart_stream : public Stream_base {
+public:
+    multipart_stream(HttpUploadCollection* col, const char* boundary)
+        : m_parser(col, boundary)
+    {
+    }
+
+public:
+    // Stream_base
+    virtual result_t get_fd(int32_t& retVal)
+    {
+        return CALL_E_INVALID_CALL;
+    }
+
+    virtual result_t read(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+    {
+        return CALL_E_INVALID_CALL;
+    }
+
+    virtual result_t write(Buffer_base* data, AsyncEvent* ac)
+    {
+        if (ac->isSync())
+            return CHECK_ERROR(CALL_E_NOSYNC);
+
+        obj_ptr<Buffer> buf = Buffer::Cast(data);
+        result_t hr = m_parser.feed((const char*)buf->data(), buf->length());
+        if (hr < 0)
+            return hr;
+
+        if (!m_parser.pending())
+            return 0;
+
+        return m_parser.spill();
+    }
+
+    virtual result_t flush(AsyncEvent* ac)
+    {
+        return 0;
+    }
+
+    virtual result_t close(AsyncEvent* ac)
+    {
+        return m_parser.finish();
+    }
+
+    virtual result_t copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal, AsyncEvent* ac)
+    {
+        return CALL_E_INVALID_CALL;
     }
+
+private:
+    multipart_parser m_parser;
+};
+
+result_t HttpUploadCollection::parser(const char* type, obj_ptr<Stream_base>& retVal)
+{
+    const char* boundary = type + 20;
+
+    while (*boundary && *boundary == ' ')
+        boundary++;
+
+    if (qstricmp(boundary, "boundary=", 9) || !boundary[9])
+        return CHECK_ERROR(Runtime::setError("HttpUploadCollection: boundary is missing."));
+
+    retVal = new multipart_stream(this, boundary + 9);
+    return 0;
+}
+
+result_t HttpUploadCollection::parse(SeekableStream_base* body, const char* type)
+{
+    obj_ptr<Stream_base> stm;
+    int64_t sz;
+    result_t hr;
+
+    hr = parser(type, stm);
+    if (hr < 0)
+        return hr;
+
+    body->rewind();
+    hr = body->cc_copyTo(stm, -1, sz);
+    if (hr < 0)
+        return hr;
+
+    return stm->cc_close();
 }
 
 result_t HttpUploadCollection::clear()
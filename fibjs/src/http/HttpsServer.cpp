@@ -7,10 +7,13 @@
 
 #include "object.h"
 #include "HttpsServer.h"
+#include "SslServer.h"
 #include "ifs/http.h"
 
 namespace fibjs {
 
+static const char* s_alpn[] = { "h2", "http/1.1", NULL };
+
 result_t HttpsServer_base::_new(v8::Local<v8::Array> certs, int32_t port,
     Handler_base* hdlr, obj_ptr<HttpsServer_base>& retVal,
     v8::Local<v8::Object> This)
@@ -57,6 +60,59 @@ result_t HttpsServer_base::_new(X509Cert_base* crt, PKey_base* key, exlib::strin
     return 0;
 }
 
+result_t HttpsServer_base::_new(v8::Local<v8::Array> certs, v8::Local<v8::Object> opts,
+    Handler_base* hdlr, obj_ptr<HttpsServer_base>& retVal,
+    v8::Local<v8::Object> This)
+{
+    obj_ptr<HttpsServer> svr = new HttpsServer();
+    svr->wrap(This);
+
+    result_t hr = svr->create(certs, opts, hdlr);
+    if (hr < 0)
+        return hr;
+
+    retVal = svr;
+
+    return 0;
+}
+
+result_t HttpsServer_base::_new(X509Cert_base* crt, PKey_base* key, v8::Local<v8::Object> opts,
+    Handler_base* hdlr, obj_ptr<HttpsServer_base>& retVal,
+    v8::Local<v8::Object> This)
+{
+    obj_ptr<HttpsServer> svr = new HttpsServer();
+    svr->wrap(This);
+
+    result_t hr = svr->create(crt, key, opts, hdlr);
+    if (hr < 0)
+        return hr;
+
+    retVal = svr;
+
+    return 0;
+}
+
+static result_t get_h2(v8::Local<v8::Object> opts, bool& retVal)
+{
+    result_t hr = GetConfigValue(Isolate::current(opts), opts, "h2", retVal);
+    if (hr == CALL_E_PARAMNOTOPTIONAL)
+        return 0;
+    return hr;
+}
+
+void HttpsServer::init(HttpHandler_base* handler, SslServer_base* server, bool h2)
+{
+    SetPrivate("handler", handler->wrap());
+    m_hdlr = handler;
+
+    // http/2 is only offered when the server asks for it, otherwise the handshake carries no ALPN
+    if (h2)
+        ((SslServer*)server)->set_alpn(s_alpn);
+
+    SetPrivate("server", server->wrap());
+    m_server = server;
+}
+
 result_t HttpsServer::create(X509Cert_base* crt, PKey_base* key, exlib::string addr, int32_t port,
     Handler_base* hdlr)
 {
@@ -72,12 +128,7 @@ result_t HttpsServer::create(X509Cert_base* crt, PKey_base* key, exlib::string a
     if (hr < 0)
         return hr;
 
-    SetPrivate("handler", _handler->wrap());
-    m_hdlr = _handler;
-
-    SetPrivate("server", _server->wrap());
-    m_server = _server;
-
+    init(_handler, _server, false);
     return 0;
 }
 
@@ -96,12 +147,55 @@ result_t HttpsServer::create(v8::Local<v8::Array> certs, exlib::string addr, int
     if (hr < 0)
         return hr;
 
-    SetPrivate("handler", _handler->wrap());
-    m_hdlr = _handler;
+    init(_handler, _server, false);
+    return 0;
+}
+
+result_t HttpsServer::create(X509Cert_base* crt, PKey_base* key, v8::Local<v8::Object> opts,
+    Handler_base* hdlr)
+{
+    result_t hr;
+    obj_ptr<SslServer_base> _server;
+    obj_ptr<HttpHandler_base> _handler;
+    bool h2 = false;
+
+    hr = get_h2(opts, h2);
+    if (hr < 0)
+        return hr;
+
+    hr = HttpHandler_base::_new(hdlr, _handler);
+    if (hr < 0)
+        return hr;
+
+    hr = SslServer_base::_new(crt, key, opts, _handler, _server);
+    if (hr < 0)
+        return hr;
+
+    init(_handler, _server, h2);
+    return 0;
+}
+
+result_t HttpsServer::create(v8::Local<v8::Array> certs, v8::Local<v8::Object> opts,
+    Handler_base* hdlr)
+{
+    result_t hr;
+    obj_ptr<SslServer_base> _server;
+    obj_ptr<HttpHandler_base> _handler;
+    bool h2 = false;
+
+    hr = get_h2(opts, h2);
+    if (hr < 0)
+        return hr;
+
+    hr = HttpHandler_base::_new(hdlr, _handler);
+    if (hr < 0)
+        return hr;
 
-    SetPrivate("server", _server->wrap());
-    m_server = _server;
+    hr = SslServer_base::_new(certs, opts, _handler, _server);
+    if (hr < 0)
+        return hr;
 
+    init(_handler, _server, h2);
     return 0;
 }
 
@@ -115,6 +209,11 @@ result_t HttpsServer::stop(AsyncEvent* ac)
     return m_server->stop(ac);
 }
 
+result_t HttpsServer::reload(AsyncEvent* ac)
+{
+    return m_server->reload(ac);
+}
+
 result_t HttpsServer::get_socket(obj_ptr<Socket_base>& retVal)
 {
     return m_server->get_socket(retVal);
@@ -130,11 +229,21 @@ result_t HttpsServer::set_handler(Handler_base* newVal)
     return m_hdlr->set_handler(newVal);
 }
 
+result_t HttpsServer::get_stats(v8::Local<v8::Object>& retVal)
+{
+    return m_server->get_stats(retVal);
+}
+
 result_t HttpsServer::enableCrossOrigin(exlib::string allowHeaders)
 {
     return m_hdlr->enableCrossOrigin(allowHeaders);
 }
 
+result_t HttpsServer::setEncodingOptions(exlib::string type, v8::Local<v8::Object> opts)
+{
+    return m_hdlr->setEncodingOptions(type, opts);
+}
+
 result_t HttpsServer::get_maxHeadersCount(int32_t& retVal)
 {
     return m_hdlr->get_maxHeadersCount(retVal);
@@ -175,6 +284,26 @@ result_t HttpsServer::set_enableEncoding(bool newVal)
     return m_hdlr->set_enableEncoding(newVal);
 }
 
+result_t HttpsServer::get_streamForm(bool& retVal)
+{
+    return m_hdlr->get_streamForm(retVal);
+}
+
+result_t HttpsServer::set_streamForm(bool newVal)
+{
+    return m_hdlr->set_streamForm(newVal);
+}
+
+result_t HttpsServer::get_encodingCacheSize(int32_t& retVal)
+{
+    return m_hdlr->get_encodingCacheSize(retVal);
+}
+
+result_t HttpsServer::set_encodingCacheSize(int32_t newVal)
+{
+    return m_hdlr->set_encodingCacheSize(newVal);
+}
+
 result_t HttpsServer::get_serverName(exlib::string& retVal)
 {
     return m_hdlr->get_serverName(retVal);
@@ -0,0 +1,459 @@
+/*
+ * hpack.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "hpack.h"
+#include <string.h>
+
+namespace fibjs {
+
+// RFC 7541 Appendix A
+static const char* s_static_table[][2] = {
+    { ":authority", "" },
+    { ":method", "GET" },
+    { ":method", "POST" },
+    { ":path", "/" },
+    { ":path", "/index.html" },
+    { ":scheme", "http" },
+    { ":scheme", "https" },
+    { ":status", "200" },
+    { ":status", "204" },
+    { ":status", "206" },
+    { ":status", "304" },
+    { ":status", "400" },
+    { ":status", "404" },
+    { ":status", "500" },
+    { "accept-charset", "" },
+    { "accept-encoding", "gzip, deflate" },
+    { "accept-language", "" },
+    { "accept-ranges", "" },
+    { "accept", "" },
+    { "access-control-allow-origin", "" },
+    { "age", "" },
+    { "allow", "" },
+    { "authorization", "" },
+    { "cache-control", "" },
+    { "content-disposition", "" },
+    { "content-encoding", "" },
+    { "content-language", "" },
+    { "content-length", "" },
+    { "content-location", "" },
+    { "content-range", "" },
+    { "content-type", "" },
+    { "cookie", "" },
+    { "date", "" },
+    { "etag", "" },
+    { "expect", "" },
+    { "expires", "" },
+    { "from", "" },
+    { "host", "" },
+    { "if-match", "" },
+    { "if-modified-since", "" },
+    { "if-none-match", "" },
+    { "if-range", "" },
+    { "if-unmodified-since", "" },
+    { "last-modified", "" },
+    { "link", "" },
+    { "location", "" },
+    { "max-forwards", "" },
+    { "proxy-authenticate", "" },
+    { "proxy-authorization", "" },
+    { "range", "" },
+    { "referer", "" },
+    { "refresh", "" },
+    { "retry-after", "" },
+    { "server", "" },
+    { "set-cookie", "" },
+    { "strict-transport-security", "" },
+    { "transfer-encoding", "" },
+    { "user-agent", "" },
+    { "vary", "" },
+    { "via", "" },
+    { "www-authenticate", "" }
+};
+
+#define STATIC_TABLE_SIZE (sizeof(s_static_table) / sizeof(s_static_table[0]))
+
+// RFC 7541 Appendix B
+static const uint32_t s_huffman_codes[256] = {
+    0x00001ff8, 0x007fffd8, 0x0fffffe2, 0x0fffffe3, 0x0fffffe4, 0x0fffffe5, 0x0fffffe6, 0x0fffffe7,
+    0x0fffffe8, 0x00ffffea, 0x3ffffffc, 0x0fffffe9, 0x0fffffea, 0x3ffffffd, 0x0fffffeb, 0x0fffffec,
+    0x0fffffed, 0x0fffffee, 0x0fffffef, 0x0ffffff0, 0x0ffffff1, 0x0ffffff2, 0x3ffffffe, 0x0ffffff3,
+    0x0ffffff4, 0x0ffffff5, 0x0ffffff6, 0x0ffffff7, 0x0ffffff8, 0x0ffffff9, 0x0ffffffa, 0x0ffffffb,
+    0x00000014, 0x000003f8, 0x000003f9, 0x00000ffa, 0x00001ff9, 0x00000015, 0x000000f8, 0x000007fa,
+    0x000003fa, 0x000003fb, 0x000000f9, 0x000007fb, 0x000000fa, 0x00000016, 0x00000017, 0x00000018,
+    0x00000000, 0x00000001, 0x00000002, 0x00000019, 0x0000001a, 0x0000001b, 0x0000001c, 0x0000001d,
+    0x0000001e, 0x0000001f, 0x0000005c, 0x000000fb, 0x00007ffc, 0x00000020, 0x00000ffb, 0x000003fc,
+    0x00001ffa, 0x00000021, 0x0000005d, 0x0000005e, 0x0000005f, 0x00000060, 0x00000061, 0x00000062,
+    0x00000063, 0x00000064, 0x00000065, 0x00000066, 0x00000067, 0x00000068, 0x00000069, 0x0000006a,
+    0x0000006b, 0x0000006c, 0x0000006d, 0x0000006e, 0x0000006f, 0x00000070, 0x00000071, 0x00000072,
+    0x000000fc, 0x00000073, 0x000000fd, 0x00001ffb, 0x0007fff0, 0x00001ffc, 0x00003ffc, 0x00000022,
+    0x00007ffd, 0x00000003, 0x00000023, 0x00000004, 0x00000024, 0x00000005, 0x00000025, 0x00000026,
+    0x00000027, 0x00000006, 0x00000074, 0x00000075, 0x00000028, 0x00000029, 0x0000002a, 0x00000007,
+    0x0000002b, 0x00000076, 0x0000002c, 0x00000008, 0x00000009, 0x0000002d, 0x00000077, 0x00000078,
+    0x00000079, 0x0000007a, 0x0000007b, 0x00007ffe, 0x000007fc, 0x00003ffd, 0x00001ffd, 0x0ffffffc,
+    0x000fffe6, 0x003fffd2, 0x000fffe7, 0x000fffe8, 0x003fffd3, 0x003fffd4, 0x003fffd5, 0x007fffd9,
+    0x003fffd6, 0x007fffda, 0x007fffdb, 0x007fffdc, 0x007fffdd, 0x007fffde, 0x00ffffeb, 0x007fffdf,
+    0x00ffffec, 0x00ffffed, 0x003fffd7, 0x007fffe0, 0x00ffffee, 0x007fffe1, 0x007fffe2, 0x007fffe3,
+    0x007fffe4, 0x001fffdc, 0x003fffd8, 0x007fffe5, 0x003fffd9, 0x007fffe6, 0x007fffe7, 0x00ffffef,
+    0x003fffda, 0x001fffdd, 0x000fffe9, 0x003fffdb, 0x003fffdc, 0x007fffe8, 0x007fffe9, 0x001fffde,
+    0x007fffea, 0x003fffdd, 0x003fffde, 0x00fffff0, 0x001fffdf, 0x003fffdf, 0x007fffeb, 0x007fffec,
+    0x001fffe0, 0x001fffe1, 0x003fffe0, 0x001fffe2, 0x007fffed, 0x003fffe1, 0x007fffee, 0x007fffef,
+    0x000fffea, 0x003fffe2, 0x003fffe3, 0x003fffe4, 0x007ffff0, 0x003fffe5, 0x003fffe6, 0x007ffff1,
+    0x03ffffe0, 0x03ffffe1, 0x000fffeb, 0x0007fff1, 0x003fffe7, 0x007ffff2, 0x003fffe8, 0x01ffffec,
+    0x03ffffe2, 0x03ffffe3, 0x03ffffe4, 0x07ffffde, 0x07ffffdf, 0x03ffffe5, 0x00fffff1, 0x01ffffed,
+    0x0007fff2, 0x001fffe3, 0x03ffffe6, 0x07ffffe0, 0x07ffffe1, 0x03ffffe7, 0x07ffffe2, 0x00fffff2,
+    0x001fffe4, 0x001fffe5, 0x03ffffe8, 0x03ffffe9, 0x0ffffffd, 0x07ffffe3, 0x07ffffe4, 0x07ffffe5,
+    0x000fffec, 0x00fffff3, 0x000fffed, 0x001fffe6, 0x003fffe9, 0x001fffe7, 0x001fffe8, 0x007ffff3,
+    0x003fffea, 0x003fffeb, 0x01ffffee, 0x01ffffef, 0x00fffff4, 0x00fffff5, 0x03ffffea, 0x007ffff4,
+    0x03ffffeb, 0x07ffffe6, 0x03ffffec, 0x03ffffed, 0x07ffffe7, 0x07ffffe8, 0x07ffffe9, 0x07ffffea,
+    0x07ffffeb, 0x0ffffffe, 0x07ffffec, 0x07ffffed, 0x07ffffee, 0x07ffffef, 0x07fffff0, 0x03ffffee,
+};
+
+static const uint8_t s_huffman_lens[256] = {
+    13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28,
+    28, 28, 28, 28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+    6, 10, 10, 12, 13, 6, 8, 11, 10, 10, 8, 11, 8, 6, 6, 6,
+    5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 7, 8, 15, 6, 12, 10,
+    13, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 8, 13, 19, 13, 14, 6,
+    15, 5, 6, 5, 6, 5, 6, 6, 6, 5, 7, 7, 6, 6, 6, 5,
+    6, 7, 6, 5, 5, 6, 7, 7, 7, 7, 7, 15, 11, 14, 13, 28,
+    20, 22, 20, 20, 22, 22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23,
+    24, 24, 22, 23, 24, 23, 23, 23, 23, 21, 22, 23, 22, 23, 23, 24,
+    22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22, 24, 21, 22, 23, 23,
+    21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22, 22, 23,
+    26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25,
+    19, 21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27,
+    20, 24, 20, 21, 22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23,
+    26, 27, 26, 26, 27, 27, 27, 27, 27, 28, 27, 27, 27, 27, 27, 26,
+};
+
+class huffman_tree {
+public:
+    class node {
+    public:
+        node()
+            : children(NULL)
+            , sym(0)
+            , len(0)
+        {
+        }
+
+        ~node()
+        {
+            delete[] children;
+        }
+
+    public:
+        node* children;
+        uint8_t sym;
+        uint8_t len;
+    };
+
+public:
+    huffman_tree()
+    {
+        m_root.children = new node[256];
+
+        for (int32_t i = 0; i < 256; i++)
+            add((uint8_t)i, s_huffman_codes[i], s_huffman_lens[i]);
+    }
+
+    // decoding walks the code 8 bits at a time, internal nodes own a
+    // 256-slot child table and a leaf fills every slot its prefix covers
+    void add(uint8_t sym, uint32_t code, uint8_t len)
+    {
+        node* cur = &m_root;
+
+        while (len > 8) {
+            len -= 8;
+            node& n = cur->children[(uint8_t)(code >> len)];
+            if (!n.children)
+                n.children = new node[256];
+            cur = &n;
+        }
+
+        int32_t shift = 8 - len;
+        int32_t start = (uint8_t)(code << shift);
+        int32_t end = start + (1 << shift);
+
+        for (int32_t i = start; i < end; i++) {
+            cur->children[i].sym = sym;
+            cur->children[i].len = len;
+        }
+    }
+
+    result_t decode(const uint8_t* data, size_t len, exlib::string& retVal)
+    {
+        const node* n = &m_root;
+        uint64_t cur = 0;
+        int32_t cbits = 0;
+        int32_t sbits = 0;
+
+        retVal.clear();
+
+        for (size_t i = 0; i < len; i++) {
+            cur = (cur << 8) | data[i];
+            cbits += 8;
+            sbits += 8;
+
+            while (cbits >= 8) {
+                n = &n->children[(uint8_t)(cur >> (cbits - 8))];
+                if (n->children)
+                    cbits -= 8;
+                else if (n->len == 0)
+                    return CALL_E_INVALID_DATA;
+                else {
+                    retVal.append(1, (char)n->sym);
+                    cbits -= n->len;
+                    n = &m_root;
+                    sbits = cbits;
+                }
+            }
+        }
+
+        while (cbits > 0) {
+            const node* c = &n->children[(uint8_t)(cur << (8 - cbits))];
+            if (c->children || c->len == 0 || c->len > cbits)
+                break;
+
+            retVal.append(1, (char)c->sym);
+            cbits -= c->len;
+            n = &m_root;
+            sbits = cbits;
+        }
+
+        // at most 7 bits of EOS prefix may pad the last octet
+        if (sbits > 7)
+            return CALL_E_INVALID_DATA;
+
+        uint64_t mask = (1ull << cbits) - 1;
+        if ((cur & mask) != mask)
+            return CALL_E_INVALID_DATA;
+
+        return 0;
+    }
+
+private:
+    node m_root;
+};
+
+static huffman_tree s_huffman;
+
+static bool get_int(const uint8_t*& p, const uint8_t* end, int32_t prefix, uint64_t& retVal)
+{
+    uint64_t mask = (1 << prefix) - 1;
+    int32_t shift = 0;
+
+    if (p >= end)
+        return false;
+
+    retVal = *p++ & mask;
+    if (retVal < mask)
+        return true;
+
+    while (p < end) {
+        uint8_t b = *p++;
+
+        retVal += (uint64_t)(b & 0x7f) << shift;
+        if (!(b & 0x80))
+            return true;
+
+        shift += 7;
+        if (shift > 28)
+            return false;
+    }
+
+    return false;
+}
+
+static result_t get_string(const uint8_t*& p, const uint8_t* end, exlib::string& retVal)
+{
+    uint64_t len;
+
+    if (p >= end)
+        return CALL_E_INVALID_DATA;
+
+    bool huffman = (*p & 0x80) != 0;
+    if (!get_int(p, end, 7, len) || len > (uint64_t)(end - p))
+        return CALL_E_INVALID_DATA;
+
+    const uint8_t* s = p;
+    p += len;
+
+    if (huffman)
+        return s_huffman.decode(s, (size_t)len, retVal);
+
+    retVal.assign((const char*)s, (size_t)len);
+    return 0;
+}
+
+bool HPackDecoder::get(size_t index, hpack_field& field)
+{
+    if (index == 0)
+        return false;
+
+    if (index <= STATIC_TABLE_SIZE) {
+        field.first = s_static_table[index - 1][0];
+        field.second = s_static_table[index - 1][1];
+        return true;
+    }
+
+    index -= STATIC_TABLE_SIZE + 1;
+    if (index >= m_table.size())
+        return false;
+
+    field = m_table[index];
+    return true;
+}
+
+void HPackDecoder::evict(size_t maxSize)
+{
+    while (m_size > maxSize && !m_table.empty()) {
+        hpack_field& f = m_table.back();
+
+        m_size -= f.first.length() + f.second.length() + 32;
+        m_table.pop_back();
+    }
+}
+
+void HPackDecoder::add(hpack_field& field)
+{
+    size_t sz = field.first.length() + field.second.length() + 32;
+
+    if (sz > m_maxSize) {
+        evict(0);
+        return;
+    }
+
+    evict(m_maxSize - sz);
+    m_table.push_front(field);
+    m_size += sz;
+}
+
+result_t HPackDecoder::decode(const char* data, size_t len, std::vector<hpack_field>& fields,
+    size_t maxListSize)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    const uint8_t* end = p + len;
+    size_t listSize = 0;
+    bool first = true;
+    result_t hr;
+
+    while (p < end) {
+        uint8_t b = *p;
+        hpack_field field;
+        uint64_t index;
+
+        if (b & 0x80) {
+            // indexed header field
+            if (!get_int(p, end, 7, index) || !get((size_t)index, field))
+                return CALL_E_INVALID_DATA;
+        } else if ((b & 0xe0) == 0x20) {
+            // dynamic table size update, only allowed at the beginning of a block
+            if (!first || !get_int(p, end, 5, index) || index > m_limit)
+                return CALL_E_INVALID_DATA;
+
+            m_maxSize = (size_t)index;
+            evict(m_maxSize);
+            continue;
+        } else {
+            // literal, with incremental indexing (01), without indexing (0000) or never indexed (0001)
+            bool indexing = (b & 0xc0) == 0x40;
+
+            if (!get_int(p, end, indexing ? 6 : 4, index))
+                return CALL_E_INVALID_DATA;
+
+            if (index) {
+                if (!get((size_t)index, field))
+                    return CALL_E_INVALID_DATA;
+            } else {
+                hr = get_string(p, end, field.first);
+                if (hr < 0)
+                    return hr;
+            }
+
+            hr = get_string(p, end, field.second);
+            if (hr < 0)
+                return hr;
+
+            if (indexing)
+                add(field);
+        }
+
+        first = false;
+
+        listSize += field.first.length() + field.second.length() + 32;
+        if (listSize > maxListSize)
+            return CALL_E_OVERFLOW;
+
+        fields.push_back(field);
+    }
+
+    return 0;
+}
+
+static void put_int(exlib::string& out, uint8_t flags, int32_t prefix, uint64_t v)
+{
+    uint64_t mask = (1 << prefix) - 1;
+
+    if (v < mask) {
+        out.append(1, (char)(flags | v));
+        return;
+    }
+
+    out.append(1, (char)(flags | mask));
+    v -= mask;
+
+    while (v >= 0x80) {
+        out.append(1, (char)(0x80 | (v & 0x7f)));
+        v >>= 7;
+    }
+
+    out.append(1, (char)v);
+}
+
+static void put_string(exlib::string& out, const exlib::string& s)
+{
+    put_int(out, 0, 7, s.length());
+    out.append(s);
+}
+
+void HPackEncoder::encode(const exlib::string& name, const exlib::string& value, exlib::string& out)
+{
+    size_t i;
+
+    for (i = 0; i < STATIC_TABLE_SIZE; i++)
+        if (!strcmp(s_static_table[i][0], name.c_str()))
+            break;
+
+    if (i < STATIC_TABLE_SIZE)
+        put_int(out, 0, 4, i + 1);
+    else {
+        out.append(1, 0);
+        put_string(out, name);
+    }
+
+    put_string(out, value);
+}
+
+void HPackEncoder::encode_status(int32_t status, exlib::string& out)
+{
+    char buf[16];
+
+    // :status 200, 204, 206, 304, 400, 404 and 500 have their own static entries
+    for (size_t i = 7; i < 14; i++)
+        if (atoi(s_static_table[i][1]) == status) {
+            put_int(out, 0x80, 7, i + 1);
+            return;
+        }
+
+    snprintf(buf, sizeof(buf), "%d", status);
+    put_int(out, 0, 4, 8);
+    put_string(out, buf);
+}
+
+} /* namespace fibjs */
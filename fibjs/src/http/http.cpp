@@ -91,6 +91,16 @@ result_t http_base::set_enableEncoding(bool newVal)
     return get_httpClient()->set_enableEncoding(newVal);
 }
 
+result_t http_base::get_enableHttp2(bool& retVal)
+{
+    return get_httpClient()->get_enableHttp2(retVal);
+}
+
+result_t http_base::set_enableHttp2(bool newVal)
+{
+    return get_httpClient()->set_enableHttp2(newVal);
+}
+
 result_t http_base::get_maxHeadersCount(int32_t& retVal)
 {
     return get_httpClient()->get_maxHeadersCount(retVal);
@@ -151,6 +161,21 @@ result_t http_base::set_poolTimeout(int32_t newVal)
     return get_httpClient()->set_poolTimeout(newVal);
 }
 
+result_t http_base::get_poolMaxActive(int32_t& retVal)
+{
+    return get_httpClient()->get_poolMaxActive(retVal);
+}
+
+result_t http_base::set_poolMaxActive(int32_t newVal)
+{
+    return get_httpClient()->set_poolMaxActive(newVal);
+}
+
+result_t http_base::get_poolStats(v8::Local<v8::Object>& retVal)
+{
+    return get_httpClient()->get_poolStats(retVal);
+}
+
 result_t http_base::get_http_proxy(exlib::string& retVal)
 {
     return get_httpClient()->get_http_proxy(retVal);
@@ -19,6 +19,12 @@
 #include <exlib/include/thread.h>
 #include "options.h"
 #include <sys/wait.h>
+#include <sys/uio.h>
+#include <limits.h>
+
+#ifdef Linux
+#include <sys/sendfile.h>
+#endif
 
 namespace fibjs {
 
@@ -422,6 +428,7 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
             , m_family(family)
             , m_bRead(bRead)
             , m_timer(timer)
+            , m_isolate(Isolate::current())
         {
         }
 
@@ -472,7 +479,7 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
             } while (m_bRead && m_pos < (int32_t)m_buf.length());
 
             m_buf.resize(m_pos);
-            m_retVal = new Buffer(m_buf.c_str(), m_buf.length());
+            m_retVal = new Buffer(m_buf.c_str(), m_buf.length(), m_isolate);
             if (g_tcpdump)
                 outLog(console_base::C_NOTICE, clean_string(m_buf));
 
@@ -502,6 +509,7 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
         bool m_bRead;
         exlib::string m_buf;
         obj_ptr<Timer_base> m_timer;
+        Isolate* m_isolate;
     };
 
     if (m_fd == INVALID_SOCKET) {
@@ -517,37 +525,73 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
 }
 
 result_t AsyncIO::write(Buffer_base* data, AsyncEvent* ac)
+{
+    std::vector<obj_ptr<Buffer>> datas;
+
+    datas.push_back(Buffer::Cast(data));
+    return writev(datas, ac);
+}
+
+result_t AsyncIO::writev(std::vector<obj_ptr<Buffer>>& datas, AsyncEvent* ac)
 {
     class asyncSend : public AsyncSockProc {
     public:
-        asyncSend(intptr_t& sockfd, Buffer_base* data, AsyncEvent* ac, int32_t family, exlib::Locker& locker, void*& opt)
+        asyncSend(intptr_t& sockfd, std::vector<obj_ptr<Buffer>>& datas, AsyncEvent* ac, int32_t family, exlib::Locker& locker, void*& opt)
             : AsyncSockProc(sockfd, EV_WRITE, ac, locker, opt)
+            , m_datas(datas)
+            , m_pos(0)
             , m_family(family)
         {
-            m_data = Buffer::Cast(data);
-            m_p = (const char*)m_data->data();
-            m_sz = m_data->length();
+            for (size_t i = 0; i < m_datas.size(); i++) {
+                struct iovec iov;
 
-            if (g_tcpdump)
-                outLog(console_base::C_WARN, clean_string(m_p, m_sz));
+                iov.iov_base = m_datas[i]->data();
+                iov.iov_len = m_datas[i]->length();
+                if (!iov.iov_len)
+                    continue;
+
+                m_iov.push_back(iov);
+
+                if (g_tcpdump)
+                    outLog(console_base::C_WARN, clean_string((const char*)iov.iov_base, iov.iov_len));
+            }
         }
 
         virtual result_t process()
         {
-            while (m_sz) {
-                int32_t n;
-
-                if (m_family)
-                    n = (int32_t)::send(m_sockfd, m_p, m_sz, MSG_NOSIGNAL);
-                else
-                    n = (int32_t)::write(m_sockfd, m_p, m_sz);
+            while (m_pos < m_iov.size()) {
+                struct iovec* iov = &m_iov[m_pos];
+                int32_t cnt = (int32_t)(m_iov.size() - m_pos);
+                ssize_t n;
+
+                if (cnt > IOV_MAX)
+                    cnt = IOV_MAX;
+
+                if (m_family) {
+                    struct msghdr msg;
+
+                    memset(&msg, 0, sizeof(msg));
+                    msg.msg_iov = iov;
+                    msg.msg_iovlen = cnt;
+                    n = ::sendmsg(m_sockfd, &msg, MSG_NOSIGNAL);
+                } else
+                    n = ::writev(m_sockfd, iov, cnt);
                 if (n == SOCKET_ERROR) {
                     int32_t nError = errno;
                     return CHECK_ERROR((nError == EWOULDBLOCK) ? CALL_E_PENDDING : -nError);
                 }
 
-                m_sz -= n;
-                m_p += n;
+                while (n > 0) {
+                    if ((size_t)n >= iov->iov_len) {
+                        n -= iov->iov_len;
+                        iov++;
+                        m_pos++;
+                    } else {
+                        iov->iov_base = (char*)iov->iov_base + n;
+                        iov->iov_len -= n;
+                        n = 0;
+                    }
+                }
             }
 
             return 0;
@@ -564,9 +608,9 @@ result_t AsyncIO::write(Buffer_base* data, AsyncEvent* ac)
         }
 
     public:
-        obj_ptr<Buffer> m_data;
-        const char* m_p;
-        int32_t m_sz;
+        std::vector<obj_ptr<Buffer>> m_datas;
+        std::vector<struct iovec> m_iov;
+        size_t m_pos;
         int32_t m_family;
     };
 
@@ -576,9 +620,74 @@ result_t AsyncIO::write(Buffer_base* data, AsyncEvent* ac)
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    return (new asyncSend(m_fd, data, ac, m_family, m_lockSend, m_SendOpt))->request();
+    return (new asyncSend(m_fd, datas, ac, m_family, m_lockSend, m_SendOpt))->request();
 }
 
+#ifdef Linux
+result_t AsyncIO::sendfile(int32_t fd, int64_t pos, int64_t bytes, int64_t& retVal, AsyncEvent* ac)
+{
+    class asyncSendFile : public AsyncSockProc {
+    public:
+        asyncSendFile(intptr_t& sockfd, int32_t fd, int64_t pos, int64_t bytes, int64_t& retVal,
+            AsyncEvent* ac, exlib::Locker& locker, void*& opt)
+            : AsyncSockProc(sockfd, EV_WRITE, ac, locker, opt)
+            , m_fd(fd)
+            , m_pos(pos)
+            , m_bytes(bytes)
+            , m_retVal(retVal)
+        {
+            m_retVal = 0;
+        }
+
+        virtual result_t process()
+        {
+            while (m_bytes != 0) {
+                size_t len = (m_bytes < 0 || m_bytes > 0x40000000) ? 0x40000000 : (size_t)m_bytes;
+
+                ssize_t n = ::sendfile(m_sockfd, m_fd, m_pos < 0 ? NULL : &m_pos, len);
+                if (n == SOCKET_ERROR) {
+                    int32_t nError = errno;
+                    return CHECK_ERROR((nError == EWOULDBLOCK) ? CALL_E_PENDDING : -nError);
+                }
+
+                if (n == 0)
+                    break;
+
+                m_retVal += n;
+                if (m_bytes > 0)
+                    m_bytes -= n;
+            }
+
+            return 0;
+        }
+
+        virtual void after_unwatch()
+        {
+            result_t hr = process();
+
+            if (hr == CALL_E_PENDDING)
+                post();
+            else
+                ready(hr);
+        }
+
+    public:
+        int32_t m_fd;
+        off_t m_pos;
+        int64_t m_bytes;
+        int64_t& m_retVal;
+    };
+
+    if (m_fd == INVALID_SOCKET)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new asyncSendFile(m_fd, fd, pos, bytes, retVal, ac, m_lockSend, m_SendOpt))->request();
+}
+#endif
+
 void AsyncIO::run(void (*watchProc)(void*))
 {
     class asyncRun : public evAsyncEvent {
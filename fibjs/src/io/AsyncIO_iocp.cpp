@@ -337,6 +337,7 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
             , m_pos(0)
             , m_bRead(bRead)
             , m_timer(timer)
+            , m_isolate(Isolate::current())
         {
             m_buf.resize(bytes > 0 ? bytes : SOCKET_BUFF_SIZE);
         }
@@ -395,7 +396,7 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
 
                 if (m_pos) {
                     m_buf.resize(m_pos);
-                    m_retVal = new Buffer(m_buf.c_str(), m_buf.length());
+                    m_retVal = new Buffer(m_buf.c_str(), m_buf.length(), m_isolate);
 
                     if (g_tcpdump)
                         outLog(console_base::C_NOTICE, clean_string(m_buf));
@@ -412,6 +413,7 @@ result_t AsyncIO::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
         bool m_bRead;
         exlib::string m_buf;
         obj_ptr<Timer_base> m_timer;
+        Isolate* m_isolate;
     };
 
     if (m_fd == INVALID_SOCKET) {
@@ -484,6 +486,26 @@ result_t AsyncIO::write(Buffer_base* data, AsyncEvent* ac)
     (new asyncSend(m_fd, data, ac, m_lockSend))->post();
     return CHECK_ERROR(CALL_E_PENDDING);
 }
+
+result_t AsyncIO::writev(std::vector<obj_ptr<Buffer>>& datas, AsyncEvent* ac)
+{
+    size_t sz = 0;
+    size_t i;
+
+    // WriteFile takes a single buffer, so the pieces are gathered here
+    for (i = 0; i < datas.size(); i++)
+        sz += datas[i]->length();
+
+    obj_ptr<Buffer> buf = new Buffer(NULL, sz);
+    uint8_t* p = buf->data();
+
+    for (i = 0; i < datas.size(); i++) {
+        memcpy(p, datas[i]->data(), datas[i]->length());
+        p += datas[i]->length();
+    }
+
+    return write(buf, ac);
+}
 }
 
 #endif
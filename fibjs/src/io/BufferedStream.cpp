@@ -9,6 +9,7 @@
 #include "ifs/io.h"
 #include "BufferedStream.h"
 #include "Buffer.h"
+#include <string.h>
 
 namespace fibjs {
 
@@ -30,27 +31,29 @@ public:
     ON_STATE(asyncBuffer, read)
     {
         result_t hr = process(m_streamEnd);
-        if (m_pThis->m_pos == (int32_t)m_pThis->m_buf.length()) {
-            m_pThis->m_buf.clear();
-            m_pThis->m_pos = 0;
-        }
+        if (m_pThis->m_pos == m_pThis->m_len)
+            m_pThis->fill(NULL);
 
         if (hr != CALL_E_PENDDING)
             return next(hr);
 
+        if (m_pThis->m_sock)
+            return m_pThis->m_sock->recv(m_pThis->m_readSize, m_buf, next(ready));
+
         return m_pThis->m_stm->read(-1, m_buf, next(ready));
     }
 
     ON_STATE(asyncBuffer, ready)
     {
-        m_pThis->m_buf.clear();
-        m_pThis->m_pos = 0;
-
         if (n != CALL_RETURN_NULL) {
-            m_buf->toString(m_pThis->m_buf);
+            m_pThis->fill(m_buf);
+            if (m_pThis->m_sock)
+                m_pThis->adapt(m_pThis->m_len);
             m_buf.Release();
-        } else
+        } else {
+            m_pThis->fill(NULL);
             m_streamEnd = true;
+        }
 
         return next(read);
     }
@@ -91,11 +94,16 @@ result_t BufferedStream::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
             obj_ptr<Buffer_base>& retVal, bool streamEnd)
         {
             int32_t n = bytes - (int32_t)pThis->m_strbuf.size();
-            int32_t n1 = (int32_t)pThis->m_buf.length() - pThis->m_pos;
+            int32_t n1 = pThis->m_len - pThis->m_pos;
 
             if (n > n1)
                 n = n1;
 
+            if (n > 0 && n == bytes) {
+                retVal = pThis->slice(n);
+                return 0;
+            }
+
             pThis->append(n);
 
             if (streamEnd || bytes == (int32_t)pThis->m_strbuf.size()) {
@@ -123,11 +131,9 @@ result_t BufferedStream::read(int32_t bytes, obj_ptr<Buffer_base>& retVal,
     };
 
     if (bytes < 0) {
-        int32_t n = (int32_t)m_buf.length() - m_pos;
+        int32_t n = m_len - m_pos;
         if (n > 0) {
-            retVal = new Buffer(m_buf.c_str() + m_pos, n);
-            m_pos += n;
-
+            retVal = slice(n);
             return 0;
         } else
             return m_stm->read(bytes, retVal, ac);
@@ -148,6 +154,11 @@ result_t BufferedStream::write(Buffer_base* data, AsyncEvent* ac)
     return m_stm->write(data, ac);
 }
 
+result_t BufferedStream::writev(std::vector<obj_ptr<Buffer>>& datas, AsyncEvent* ac)
+{
+    return stream_writev(m_stm, datas, ac);
+}
+
 result_t BufferedStream::flush(AsyncEvent* ac)
 {
     return 0;
@@ -181,7 +192,7 @@ result_t BufferedStream::readText(int32_t size, exlib::string& retVal,
             exlib::string& retVal, bool streamEnd)
         {
             int32_t n = size - (int32_t)pThis->m_strbuf.size();
-            int32_t n1 = (int32_t)pThis->m_buf.length() - pThis->m_pos;
+            int32_t n1 = pThis->m_len - pThis->m_pos;
 
             if (n > n1)
                 n = n1;
@@ -277,28 +288,30 @@ result_t BufferedStream::readUntil(exlib::string mk, int32_t maxlen,
         static result_t process(BufferedStream* pThis, exlib::string mk,
             int32_t maxlen, exlib::string& retVal, bool streamEnd)
         {
+            const char* buf = pThis->m_data;
+            int32_t len = pThis->m_len;
             int32_t pos = pThis->m_pos;
             int32_t mklen = (int32_t)mk.length();
 
             if (mklen == 0)
                 mklen = 1;
 
-            while ((pos < (int32_t)pThis->m_buf.length())
-                && (pThis->m_temp < mklen)) {
+            // the scan only ever covers bytes not seen by the previous call,
+            // a partial match at the end of a chunk is carried in m_temp
+            while ((pos < len) && (pThis->m_temp < mklen)) {
                 if (pThis->m_temp == 0) {
-                    char ch = mk.c_str()[0];
+                    const char* p = (const char*)memchr(buf + pos, mk.c_str()[0], len - pos);
 
-                    while (pos < (int32_t)pThis->m_buf.length())
-                        if (pThis->m_buf.c_str()[pos++] == ch) {
-                            pThis->m_temp++;
-                            break;
-                        }
+                    if (p) {
+                        pos = (int32_t)(p - buf) + 1;
+                        pThis->m_temp++;
+                    } else
+                        pos = len;
                 }
 
                 if (pThis->m_temp > 0) {
-                    while ((pos < (int32_t)pThis->m_buf.length())
-                        && (pThis->m_temp < mklen)) {
-                        if (pThis->m_buf.c_str()[pos] != mk.c_str()[pThis->m_temp]) {
+                    while ((pos < len) && (pThis->m_temp < mklen)) {
+                        if (buf[pos] != mk.c_str()[pThis->m_temp]) {
                             pThis->m_temp = 0;
                             break;
                         }
@@ -314,6 +327,18 @@ result_t BufferedStream::readUntil(exlib::string mk, int32_t maxlen,
                     > maxlen + mklen))
                 return CHECK_ERROR(Runtime::setError("readUntil: input data too long"));
 
+            // the whole line sits in the current chunk, decode it in place
+            if (pThis->m_temp == mklen && pThis->m_strbuf.size() == 0
+                && pos - pThis->m_pos >= mklen) {
+                exlib::string s(buf + pThis->m_pos, pos - pThis->m_pos - mklen);
+
+                pThis->m_pos = pos;
+                pThis->m_temp = 0;
+
+                result_t hr = pThis->m_iconv.decode(s, retVal);
+                return hr < 0 ? hr : 0;
+            }
+
             pThis->append(pos - pThis->m_pos);
 
             if (streamEnd || (pThis->m_temp == mklen)) {
@@ -355,6 +380,100 @@ result_t BufferedStream::readUntil(exlib::string mk, int32_t maxlen,
     return (new asyncRead(this, mk, maxlen, retVal, ac))->post(0);
 }
 
+result_t BufferedStream::readHead(int32_t maxline, int32_t maxlines,
+    exlib::string& retVal, AsyncEvent* ac)
+{
+    class asyncRead : public asyncBuffer {
+    public:
+        asyncRead(BufferedStream* pThis, int32_t maxline, int32_t maxlines,
+            exlib::string& retVal, int32_t line, int32_t lines, AsyncEvent* ac)
+            : asyncBuffer(pThis, ac)
+            , m_maxline(maxline)
+            , m_maxlines(maxlines)
+            , m_retVal(retVal)
+            , m_line(line)
+            , m_lines(lines)
+        {
+        }
+
+        static result_t process(BufferedStream* pThis, int32_t maxline, int32_t maxlines,
+            exlib::string& retVal, int32_t& line, int32_t& lines, bool streamEnd)
+        {
+            const char* buf = pThis->m_data;
+            int32_t len = pThis->m_len;
+            int32_t pos = pThis->m_pos;
+
+            while (pos < len) {
+                const char* eol = (const char*)memchr(buf + pos, '\n', len - pos);
+                int32_t end = eol ? (int32_t)(eol - buf) + 1 : len;
+
+                retVal.append(buf + pos, end - pos);
+                pos = end;
+
+                int32_t sz = (int32_t)retVal.length() - line;
+                if (eol) {
+                    sz--;
+                    if (sz > 0 && retVal[retVal.length() - 2] == '\r')
+                        sz--;
+                }
+
+                if (maxline > 0 && sz > (eol ? maxline : maxline + 1)) {
+                    pThis->m_pos = pos;
+                    return CHECK_ERROR(Runtime::setError("readHead: input data too long"));
+                }
+
+                if (!eol)
+                    break;
+
+                if (sz == 0) {
+                    retVal.resize(line);
+                    pThis->m_pos = pos;
+                    return 0;
+                }
+
+                if (maxlines > 0 && ++lines > maxlines) {
+                    pThis->m_pos = pos;
+                    return CHECK_ERROR(Runtime::setError("readHead: too many lines"));
+                }
+
+                line = (int32_t)retVal.length();
+            }
+
+            pThis->m_pos = pos;
+
+            // a head cut off before its blank line is not a head
+            if (streamEnd)
+                return retVal.empty() ? CALL_RETURN_NULL : CHECK_ERROR(Runtime::setError("readHead: incomplete head"));
+
+            return CHECK_ERROR(CALL_E_PENDDING);
+        }
+
+        virtual result_t process(bool streamEnd)
+        {
+            return process(m_pThis, m_maxline, m_maxlines, m_retVal, m_line, m_lines, streamEnd);
+        }
+
+    public:
+        int32_t m_maxline;
+        int32_t m_maxlines;
+        exlib::string& m_retVal;
+        int32_t m_line;
+        int32_t m_lines;
+    };
+
+    int32_t line = (int32_t)retVal.length();
+    int32_t lines = 0;
+
+    result_t hr = asyncRead::process(this, maxline, maxlines, retVal, line, lines, false);
+    if (hr != CALL_E_PENDDING)
+        return hr;
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new asyncRead(this, maxline, maxlines, retVal, line, lines, ac))->post(0);
+}
+
 result_t BufferedStream::writeText(exlib::string txt, AsyncEvent* ac)
 {
     if (ac->isSync())
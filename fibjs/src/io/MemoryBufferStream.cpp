@@ -0,0 +1,176 @@
+/*
+ * MemoryBufferStream.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "ifs/io.h"
+#include "MemoryStream.h"
+#include "Stat.h"
+#include "Buffer.h"
+
+namespace fibjs {
+
+MemoryStream::BufferStream::BufferStream(Buffer_base* buffer, date_t tm)
+    : m_buffer(buffer)
+    , m_time(tm)
+    , m_pos(0)
+{
+}
+
+result_t MemoryStream::BufferStream::get_fd(int32_t& retVal)
+{
+    return CHECK_ERROR(CALL_E_INVALID_CALL);
+}
+
+result_t MemoryStream::BufferStream::read(int32_t bytes,
+    obj_ptr<Buffer_base>& retVal, AsyncEvent* ac)
+{
+    Buffer* buf = Buffer::Cast(m_buffer);
+    int64_t sz = (int64_t)buf->length() - m_pos;
+
+    if (bytes < 0 || bytes > sz)
+        bytes = (int32_t)sz;
+
+    if (bytes <= 0)
+        return CALL_RETURN_NULL;
+
+    retVal = new Buffer(buf->data() + m_pos, bytes);
+    m_pos += bytes;
+
+    return 0;
+}
+
+result_t MemoryStream::BufferStream::readAll(obj_ptr<Buffer_base>& retVal,
+    AsyncEvent* ac)
+{
+    return read(-1, retVal, ac);
+}
+
+result_t MemoryStream::BufferStream::truncate(int64_t bytes, AsyncEvent* ac)
+{
+    return CHECK_ERROR(CALL_E_INVALID_CALL);
+}
+
+result_t MemoryStream::BufferStream::eof(bool& retVal)
+{
+    retVal = m_pos == (int64_t)Buffer::Cast(m_buffer)->length();
+    return 0;
+}
+
+result_t MemoryStream::BufferStream::flush(AsyncEvent* ac)
+{
+    return CHECK_ERROR(CALL_E_INVALID_CALL);
+}
+
+result_t MemoryStream::BufferStream::write(Buffer_base* data,
+    AsyncEvent* ac)
+{
+    return CHECK_ERROR(CALL_E_INVALID_CALL);
+}
+
+result_t MemoryStream::BufferStream::close(AsyncEvent* ac)
+{
+    return 0;
+}
+
+result_t MemoryStream::BufferStream::copyTo(Stream_base* stm, int64_t bytes,
+    int64_t& retVal, AsyncEvent* ac)
+{
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    Buffer* buf = Buffer::Cast(m_buffer);
+    int64_t sz = (int64_t)buf->length() - m_pos;
+
+    if (bytes < 0 || bytes > sz)
+        bytes = sz;
+
+    retVal = bytes;
+    if (bytes <= 0)
+        return 0;
+
+    // the target gets a view of the source, read() still hands out copies
+    obj_ptr<Buffer_base> data = new Buffer(buf, (size_t)m_pos, (size_t)bytes);
+    m_pos += bytes;
+
+    return stm->cc_write(data);
+}
+
+result_t MemoryStream::BufferStream::stat(obj_ptr<Stat_base>& retVal,
+    AsyncEvent* ac)
+{
+    obj_ptr<Stat> st = new Stat();
+
+    st->init();
+    st->m_isMemory = true;
+    st->mtime = st->ctime = m_time;
+    size(st->size);
+
+    retVal = st;
+
+    return 0;
+}
+
+result_t MemoryStream::BufferStream::seek(int64_t offset, int32_t whence)
+{
+    int64_t sz = (int64_t)Buffer::Cast(m_buffer)->length();
+
+    if (whence == fs_base::C_SEEK_SET)
+        m_pos = offset;
+    else if (whence == fs_base::C_SEEK_CUR)
+        m_pos += offset;
+    else if (whence == fs_base::C_SEEK_END)
+        m_pos = offset + sz;
+    else
+        return CHECK_ERROR(CALL_E_INVALIDARG);
+
+    if (m_pos < 0)
+        m_pos = 0;
+    else if (m_pos > sz)
+        m_pos = sz;
+
+    return 0;
+}
+
+result_t MemoryStream::BufferStream::tell(int64_t& retVal)
+{
+    retVal = m_pos;
+    return 0;
+}
+
+result_t MemoryStream::BufferStream::rewind()
+{
+    m_pos = 0;
+    return 0;
+}
+
+result_t MemoryStream::BufferStream::size(int64_t& retVal)
+{
+    retVal = Buffer::Cast(m_buffer)->length();
+    return 0;
+}
+
+result_t MemoryStream::BufferStream::setTime(date_t d)
+{
+    return CHECK_ERROR(CALL_E_INVALID_CALL);
+}
+
+result_t MemoryStream::BufferStream::clone(obj_ptr<MemoryStream_base>& retVal)
+{
+    retVal = new BufferStream(m_buffer, m_time);
+    return 0;
+}
+
+result_t MemoryStream::BufferStream::clear()
+{
+    rewind();
+    m_buffer = new Buffer();
+
+    m_time.now();
+
+    return 0;
+}
+}
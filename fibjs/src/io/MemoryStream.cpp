@@ -106,6 +106,24 @@ result_t MemoryStream::write(Buffer_base* data, AsyncEvent* ac)
     return 0;
 }
 
+result_t MemoryStream::writev(std::vector<obj_ptr<Buffer>>& datas, AsyncEvent* ac)
+{
+    int64_t sz1, sz2;
+
+    size(sz1);
+    for (size_t i = 0; i < datas.size(); i++)
+        m_buffer.write((const char*)datas[i]->data(), datas[i]->length());
+    m_buffer.seekg(m_buffer.tellp(), std::ios::beg);
+    size(sz2);
+
+    if (sz2 > sz1)
+        extMemory((int32_t)(sz2 - sz1));
+
+    m_time.now();
+
+    return 0;
+}
+
 result_t MemoryStream::close(AsyncEvent* ac)
 {
     return 0;
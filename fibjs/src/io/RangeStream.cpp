@@ -10,6 +10,11 @@
 #include "RangeStream.h"
 #include "Buffer.h"
 
+#ifdef Linux
+#include "Socket.h"
+#include "options.h"
+#endif
+
 namespace fibjs {
 
 // follow HTTP 206 Range Request RFC, but should cut off `bytes=` token firstly
@@ -49,6 +54,33 @@ result_t _parseRange(exlib::string range, int64_t fsize, int64_t& bpos, int64_t&
     return 0;
 }
 
+result_t RangeStream::parse(exlib::string range, int64_t fsize, std::vector<std::pair<int64_t, int64_t>>& retVal)
+{
+    size_t p = 0;
+
+    while (p <= range.length()) {
+        size_t p1 = range.find(',', p);
+        if (p1 == exlib::string::npos)
+            p1 = range.length();
+
+        size_t b = p, e = p1;
+        while (b < e && range[b] == ' ')
+            b++;
+        while (e > b && range[e - 1] == ' ')
+            e--;
+
+        int64_t bpos, epos;
+        result_t hr = _parseRange(range.substr(b, e - b), fsize, bpos, epos);
+        if (hr < 0)
+            return hr;
+
+        retVal.push_back(std::pair<int64_t, int64_t>(bpos, epos));
+        p = p1 + 1;
+    }
+
+    return 0;
+}
+
 result_t RangeStream_base::_new(SeekableStream_base* stm, exlib::string range, obj_ptr<RangeStream_base>& retVal, v8::Local<v8::Object> This)
 {
     int64_t sz, begin, end;
@@ -81,6 +113,7 @@ result_t RangeStream_base::_new(SeekableStream_base* stm, int64_t begin, int64_t
 RangeStream::RangeStream(SeekableStream_base* stream, int64_t begin, int64_t end)
 {
     m_stream = stream;
+    m_file = dynamic_cast<File*>(stream);
     b_pos = begin;
     e_pos = end;
 
@@ -103,6 +136,24 @@ result_t RangeStream::read(int32_t bytes, obj_ptr<Buffer_base>& retVal, AsyncEve
     if (e_pos < real_pos || b_pos > real_pos)
         return CALL_RETURN_NULL;
 
+#ifndef _WIN32
+    // positional reads leave the file offset alone, no seek and restore
+    if (m_file) {
+        if (ac->isSync())
+            return CALL_E_NOSYNC;
+
+        int64_t rest_sz = e_pos - real_pos;
+        if (bytes < 0 || bytes > rest_sz)
+            bytes = (int32_t)rest_sz;
+
+        result_t hr = m_file->pread(real_pos, bytes, retVal);
+        if (hr == 0)
+            real_pos += Buffer::Cast(retVal)->length();
+
+        return hr;
+    }
+#endif
+
     class asyncRead : public AsyncState {
     public:
         asyncRead(RangeStream* pThis, AsyncEvent* ac, int32_t bytes, obj_ptr<Buffer_base>& retVal)
@@ -192,6 +243,7 @@ result_t RangeStream::flush(AsyncEvent* ac)
 result_t RangeStream::close(AsyncEvent* ac)
 {
     m_stream = NULL;
+    m_file = NULL;
 
     return 0;
 }
@@ -201,6 +253,59 @@ result_t RangeStream::copyTo(Stream_base* stm, int64_t bytes, int64_t& retVal, A
     if (!m_stream)
         return CALL_E_CLOSED;
 
+#ifdef Linux
+    Socket* sock = m_file ? dynamic_cast<Socket*>(stm) : NULL;
+    if (sock && !g_tcpdump) {
+        class asyncSendFile : public AsyncState {
+        public:
+            asyncSendFile(RangeStream* pThis, Socket* sock, int64_t bytes, int64_t& retVal, AsyncEvent* ac)
+                : AsyncState(ac)
+                , m_pThis(pThis)
+                , m_sock(sock)
+                , m_bytes(bytes)
+                , m_retVal(retVal)
+            {
+                next(send);
+            }
+
+        public:
+            ON_STATE(asyncSendFile, send)
+            {
+                int32_t fd;
+
+                result_t hr = m_pThis->m_file->get_fd(fd);
+                if (hr < 0)
+                    return hr;
+
+                return m_sock->sendfile(fd, m_pThis->real_pos, m_bytes, m_retVal, next(sent));
+            }
+
+            ON_STATE(asyncSendFile, sent)
+            {
+                m_pThis->real_pos += m_retVal;
+                return next();
+            }
+
+        private:
+            obj_ptr<RangeStream> m_pThis;
+            obj_ptr<Socket> m_sock;
+            int64_t m_bytes;
+            int64_t& m_retVal;
+        };
+
+        if (ac->isSync())
+            return CALL_E_NOSYNC;
+
+        int64_t rest_sz = e_pos - real_pos;
+        if (rest_sz < 0)
+            rest_sz = 0;
+        if (bytes < 0 || bytes > rest_sz)
+            bytes = rest_sz;
+
+        return (new asyncSendFile(this, sock, bytes, retVal, ac))->post(0);
+    }
+#endif
+
     return io_base::copyStream(this, stm, bytes, retVal, ac);
 }
 
@@ -311,7 +416,7 @@ result_t RangeStream::eof(bool& retVal)
     if (!m_stream)
         return CALL_E_CLOSED;
 
-    retVal = get_c_pos() >= valid_end();
+    retVal = real_pos >= valid_end();
 
     return 0;
 }
@@ -10,11 +10,38 @@
 #include "object.h"
 #include "ifs/io.h"
 #include "File.h"
+#include "GatherWriter.h"
 
 namespace fibjs {
 
 DECLARE_MODULE(io);
 
+result_t stream_writev(Stream_base* stm, std::vector<obj_ptr<Buffer>>& datas, AsyncEvent* ac)
+{
+    GatherWriter* writer = dynamic_cast<GatherWriter*>(stm);
+    if (writer)
+        return writer->writev(datas, ac);
+
+    if (datas.size() == 1)
+        return stm->write(datas[0], ac);
+
+    size_t sz = 0;
+    size_t i;
+
+    for (i = 0; i < datas.size(); i++)
+        sz += datas[i]->length();
+
+    obj_ptr<Buffer> buf = new Buffer(NULL, sz);
+    uint8_t* p = buf->data();
+
+    for (i = 0; i < datas.size(); i++) {
+        memcpy(p, datas[i]->data(), datas[i]->length());
+        p += datas[i]->length();
+    }
+
+    return stm->write(buf, ac);
+}
+
 result_t io_base::copyStream(Stream_base* from, Stream_base* to, int64_t bytes,
     int64_t& retVal, AsyncEvent* ac)
 {
@@ -0,0 +1,177 @@
+/*
+ * ServerWorker.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lion
+ */
+
+#include "object.h"
+#include "ServerWorker.h"
+#include "TcpServer.h"
+#include "HttpHandler.h"
+#include "SandBox.h"
+#include "Fiber.h"
+#include "ifs/coroutine.h"
+
+namespace fibjs {
+
+ServerWorker::ServerWorker(exlib::string fname, exlib::string addr, int32_t port, int32_t backlog)
+    : m_fname(fname)
+    , m_addr(addr)
+    , m_port(port)
+    , m_backlog(backlog)
+    , m_op(C_START)
+    , m_ac(NULL)
+{
+    m_isolate = new Isolate(fname);
+}
+
+ServerWorker::~ServerWorker()
+{
+    // runs in the worker isolate, its fibers leave once this job returns
+    m_isolate->dispose();
+}
+
+void ServerWorker::Delete()
+{
+    // the isolate is torn down from one of its own fibers, after the connections it serves are done
+    syncCall(m_isolate, exit_fiber, this);
+}
+
+result_t ServerWorker::exit_fiber(ServerWorker* pThis)
+{
+    {
+        JSFiber::EnterJsScope s;
+
+        if (pThis->m_server) {
+            pThis->m_server->ac_stop();
+            pThis->m_stopped.push_back(pThis->m_server);
+            pThis->m_server.Release();
+        }
+
+        // a socket still being served keeps reading into the buffers of this isolate
+        while (pThis->serving())
+            coroutine_base::ac_sleep(10);
+    }
+
+    delete pThis;
+    return 0;
+}
+
+bool ServerWorker::serving()
+{
+    size_t i, n;
+
+    for (i = 0, n = 0; i < m_stopped.size(); i++)
+        if (m_stopped[i]->connections() > 0)
+            m_stopped[n++] = m_stopped[i];
+    m_stopped.resize(n);
+
+    return n > 0;
+}
+
+result_t ServerWorker::post(int32_t op, HttpHandler* http, AsyncEvent* ac)
+{
+    m_op = op;
+    m_http = http;
+    m_ac = ac;
+    m_error.clear();
+
+    syncCall(m_isolate, worker_fiber, this);
+    return CALL_E_PENDDING;
+}
+
+result_t ServerWorker::worker_fiber(ServerWorker* pThis)
+{
+    AsyncEvent* ac = pThis->m_ac;
+    result_t hr;
+
+    {
+        JSFiber::EnterJsScope s;
+
+        hr = pThis->run();
+        if (hr < 0) {
+            pThis->m_error = GetException(s.try_catch, hr);
+            if (pThis->m_error.empty())
+                pThis->m_error = getResultMessage(hr);
+
+            // the master reports the error, keep the worker from logging it again
+            s.try_catch.Reset();
+        }
+    }
+
+    pThis->m_ac = NULL;
+    pThis->m_http.Release();
+
+    ac->apost(hr);
+    return 0;
+}
+
+result_t ServerWorker::load(obj_ptr<Handler_base>& retVal)
+{
+    obj_ptr<SandBox> sbox = new SandBox();
+    v8::Local<v8::Value> v;
+    result_t hr;
+
+    // each load gets a fresh sandbox, so a reload reads the module and its dependencies from disk again
+    sbox->addBuiltinModules();
+    hr = sbox->require(m_fname, "", v);
+    if (hr < 0)
+        return hr;
+
+    hr = GetArgumentValue(m_isolate, v, retVal);
+    if (hr < 0)
+        return CHECK_ERROR(Runtime::setError("TcpServer: worker module must export a handler."));
+
+    m_isolate->m_topSandbox = sbox;
+    return 0;
+}
+
+result_t ServerWorker::run()
+{
+    result_t hr;
+
+    if (m_op == C_STOP) {
+        if (!m_server)
+            return 0;
+
+        // only the listener of this worker goes away, connections in flight are served to the end
+        hr = m_server->ac_stop();
+        m_stopped.push_back(m_server);
+        m_server.Release();
+        serving();
+
+        return hr;
+    }
+
+    if (m_op == C_RELOAD && !m_server)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    obj_ptr<Handler_base> hdlr;
+    hr = load(hdlr);
+    if (hr < 0)
+        return hr;
+
+    if (m_http) {
+        m_http->set_handler(hdlr);
+        hdlr = m_http;
+    }
+
+    // new connections pick up the new handler, the ones already running keep the old one
+    if (m_op == C_RELOAD)
+        return m_server->set_handler(hdlr);
+
+    obj_ptr<TcpServer> svr = new TcpServer();
+    hr = svr->create(m_addr, m_port, hdlr, true, m_backlog);
+    if (hr < 0)
+        return hr;
+
+    hr = svr->start();
+    if (hr < 0)
+        return hr;
+
+    m_server = svr;
+    return 0;
+}
+
+} /* namespace fibjs */
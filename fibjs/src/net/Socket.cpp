@@ -264,6 +264,23 @@ result_t Socket::bind(int32_t port, bool allowIPv4)
     return bind("", port, allowIPv4);
 }
 
+result_t Socket::reusePort()
+{
+    if (m_aio.m_fd == INVALID_SOCKET)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+#ifdef SO_REUSEPORT
+    int32_t on = 1;
+    if (setsockopt(m_aio.m_fd, SOL_SOCKET, SO_REUSEPORT, (const char*)&on, sizeof(on))
+        == SOCKET_ERROR)
+        return CHECK_ERROR(SocketError());
+
+    return 0;
+#else
+    return CHECK_ERROR(Runtime::setError("Socket: SO_REUSEPORT is not supported on this platform."));
+#endif
+}
+
 result_t Socket::listen(int32_t backlog)
 {
     if (m_aio.m_fd == INVALID_SOCKET)
@@ -7,11 +7,18 @@
 
 #include "object.h"
 #include "TcpServer.h"
+#include "inetAddr.h"
 #include "ifs/mq.h"
+#include "ifs/os.h"
+#include "ifs/path.h"
 #include "ifs/console.h"
+#include <map>
 
 namespace fibjs {
 
+static exlib::spinlock s_stats_lock;
+static std::map<exlib::string, TcpServer::Stats> s_stats;
+
 result_t _new_tcpServer(exlib::string addr, int32_t port,
     Handler_base* listener, obj_ptr<TcpServer_base>& retVal,
     v8::Local<v8::Object> This)
@@ -51,13 +58,180 @@ result_t TcpServer_base::_new(exlib::string addr, Handler_base* listener,
     return _new_tcpServer(addr, 0, listener, retVal, This);
 }
 
+result_t TcpServer_base::_new(v8::Local<v8::Object> opts, Handler_base* listener,
+    obj_ptr<TcpServer_base>& retVal, v8::Local<v8::Object> This)
+{
+    obj_ptr<TcpServer> svr = new TcpServer();
+    svr->wrap(This);
+
+    result_t hr = svr->create(opts, listener);
+    if (hr < 0)
+        return hr;
+
+    retVal = svr;
+
+    return 0;
+}
+
+result_t TcpServer_base::_new(v8::Local<v8::Object> opts, obj_ptr<TcpServer_base>& retVal,
+    v8::Local<v8::Object> This)
+{
+    obj_ptr<TcpServer> svr = new TcpServer();
+    svr->wrap(This);
+
+    result_t hr = svr->create_workers(opts);
+    if (hr < 0)
+        return hr;
+
+    retVal = svr;
+
+    return 0;
+}
+
 TcpServer::TcpServer()
 {
     m_running = false;
+    m_stats = &m_local_stats;
+}
+
+TcpServer::~TcpServer()
+{
+    if (m_stats != &m_local_stats)
+        release_stats(m_stats);
+}
+
+result_t TcpServer::create(v8::Local<v8::Object> opts, Handler_base* listener)
+{
+    Isolate* isolate = Isolate::current(opts);
+    result_t hr;
+
+    exlib::string fname;
+    hr = GetConfigValue(isolate, opts, "worker", fname);
+    if (hr != CALL_E_PARAMNOTOPTIONAL)
+        return CHECK_ERROR(Runtime::setError("TcpServer: worker mode loads the handler from the worker module."));
+
+    exlib::string addr;
+    hr = GetConfigValue(isolate, opts, "address", addr);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    int32_t port = 0;
+    hr = GetConfigValue(isolate, opts, "port", port);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    bool reusePort = false;
+    hr = GetConfigValue(isolate, opts, "reusePort", reusePort);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    int32_t backlog = 1024;
+    hr = GetConfigValue(isolate, opts, "backlog", backlog);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    return create(addr, port, listener, reusePort, backlog);
+}
+
+result_t TcpServer::create_workers(v8::Local<v8::Object> opts, HttpHandler* http)
+{
+    Isolate* isolate = Isolate::current(opts);
+    result_t hr;
+
+    exlib::string fname;
+    hr = GetConfigValue(isolate, opts, "worker", fname);
+    if (hr == CALL_E_PARAMNOTOPTIONAL)
+        return CHECK_ERROR(Runtime::setError("TcpServer: missing worker module."));
+    if (hr < 0)
+        return hr;
+
+    bool isAbs = false;
+    path_base::isAbsolute(fname, isAbs);
+    if (!isAbs)
+        return CHECK_ERROR(Runtime::setError("TcpServer: only accept absolute path of worker module."));
+
+    exlib::string addr;
+    hr = GetConfigValue(isolate, opts, "address", addr);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    int32_t port = 0;
+    hr = GetConfigValue(isolate, opts, "port", port);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    // every worker binds the port on its own, they can only meet on a fixed one
+    if (port <= 0 || port > 65535)
+        return CHECK_ERROR(Runtime::setError("TcpServer: worker mode requires a fixed port."));
+
+    int32_t backlog = 1024;
+    hr = GetConfigValue(isolate, opts, "backlog", backlog);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    int32_t workers = 0;
+    hr = GetConfigValue(isolate, opts, "workers", workers);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    if (workers <= 0)
+        os_base::cpuNumbers(workers);
+    if (workers <= 0)
+        workers = 1;
+
+    m_workers.resize(workers);
+    for (int32_t i = 0; i < workers; i++)
+        m_workers[i] = new ServerWorker(fname, addr, port, backlog);
+
+    m_http = http;
+    m_stats = shared_stats(addr, port);
+
+    return 0;
+}
+
+TcpServer::Stats* TcpServer::shared_stats(exlib::string addr, int32_t port)
+{
+    bool ipv4 = false;
+    bool ipv6 = false;
+
+    if (addr.empty())
+        ipv4 = true;
+    else
+        net_base::isIPv4(addr, ipv4);
+    if (!ipv4)
+        net_base::isIPv6(addr, ipv6);
+
+    // key on the canonical form of the address, "" and "0.0.0.0" bind the same port
+    if (ipv4 || ipv6) {
+        inetAddr addr_info;
+
+        addr_info.init(ipv6 ? net_base::C_AF_INET6 : net_base::C_AF_INET);
+        if (addr_info.addr(addr) >= 0)
+            addr = addr_info.str();
+    }
+
+    char buf[16];
+    snprintf(buf, sizeof(buf), ":%d", port);
+
+    s_stats_lock.lock();
+    Stats* stats = &s_stats[addr + buf];
+    stats->m_key = addr + buf;
+    stats->m_refs++;
+    s_stats_lock.unlock();
+
+    return stats;
+}
+
+void TcpServer::release_stats(Stats* stats)
+{
+    s_stats_lock.lock();
+    if (--stats->m_refs == 0)
+        s_stats.erase(stats->m_key);
+    s_stats_lock.unlock();
 }
 
 result_t TcpServer::create(exlib::string addr, int32_t port,
-    Handler_base* listener)
+    Handler_base* listener, bool reusePort, int32_t backlog)
 {
     result_t hr;
     bool ipv4 = false;
@@ -76,14 +250,24 @@ result_t TcpServer::create(exlib::string addr, int32_t port,
     if (hr < 0)
         return hr;
 
+    if (reusePort) {
+        hr = ((Socket*)(Socket_base*)m_socket)->reusePort();
+        if (hr < 0)
+            return hr;
+    }
+
     hr = m_socket->bind(addr, port, false);
     if (hr < 0)
         return hr;
 
-    hr = m_socket->listen(1024);
+    hr = m_socket->listen(backlog);
     if (hr < 0)
         return hr;
 
+    // servers sharing a port through SO_REUSEPORT, usually one per worker, also share their stats
+    if (reusePort && port > 0)
+        m_stats = shared_stats(addr, port);
+
     set_handler(listener);
 
     return 0;
@@ -99,9 +283,17 @@ result_t TcpServer::start()
             , m_sock(pSock)
             , m_holder(holder)
         {
+            m_pThis->m_stats->m_active.inc();
+            m_pThis->m_connections.inc();
             next(invoke);
         }
 
+        ~asyncInvoke()
+        {
+            m_pThis->m_stats->m_active.dec();
+            m_pThis->m_connections.dec();
+        }
+
     public:
         ON_STATE(asyncInvoke, invoke)
         {
@@ -151,6 +343,7 @@ result_t TcpServer::start()
         ON_STATE(asyncAccept, invoke)
         {
             if (m_accept) {
+                m_pThis->m_stats->m_accepted.inc();
                 (new asyncInvoke(m_pThis, m_accept, m_holder))->apost(0);
                 m_accept.Release();
             }
@@ -161,6 +354,7 @@ result_t TcpServer::start()
         virtual int32_t error(int32_t v)
         {
             if (v == CALL_E_BAD_FILE || v == CALL_E_INVALID_CALL || v == CALL_E_NETNAME_DELETED) {
+                m_pThis->m_stats->m_listeners.dec();
                 m_pThis->isolate_unref();
                 return next();
             }
@@ -175,6 +369,18 @@ result_t TcpServer::start()
         obj_ptr<ValueHolder> m_holder;
     };
 
+    if (is_worker()) {
+        if (m_running)
+            return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+        result_t hr = ac_run_workers(ServerWorker::C_START);
+        if (hr < 0)
+            return hr;
+
+        m_running = true;
+        return 0;
+    }
+
     if (!m_socket)
         return CHECK_ERROR(CALL_E_INVALID_CALL);
 
@@ -182,20 +388,113 @@ result_t TcpServer::start()
         return CHECK_ERROR(CALL_E_INVALID_CALL);
 
     m_running = true;
+    m_stats->m_listeners.inc();
 
     obj_ptr<ValueHolder> holder = new ValueHolder(wrap());
     (new asyncAccept(this, holder))->apost(0);
     return 0;
 }
 
+result_t TcpServer::run_workers(int32_t op, AsyncEvent* ac)
+{
+    class asyncRun : public AsyncState {
+    public:
+        asyncRun(TcpServer* pThis, int32_t op, AsyncEvent* ac)
+            : AsyncState(ac)
+            , m_pThis(pThis)
+            , m_op(op)
+            , m_pos(0)
+            , m_end(pThis->m_workers.size())
+            , m_hr(0)
+            , m_settings(pThis->m_settings)
+        {
+            next(step);
+        }
+
+    public:
+        // workers run one at a time, so a reload never has all of them loading the module at once
+        ON_STATE(asyncRun, step)
+        {
+            if (m_pos == m_end)
+                return m_hr < 0 ? m_hr : next();
+
+            obj_ptr<HttpHandler> http;
+            if (m_settings && m_op != ServerWorker::C_STOP) {
+                http = new HttpHandler();
+                http->copy_settings(m_settings);
+            }
+
+            return m_pThis->m_workers[m_pos++]->post(m_op, http, next(step));
+        }
+
+        virtual int32_t error(int32_t v)
+        {
+            if (m_hr < 0 && m_pos == m_end)
+                return CHECK_ERROR(Runtime::setError(m_error));
+
+            if (m_hr == 0) {
+                m_hr = v;
+                m_error = "TcpServer: " + m_pThis->m_workers[m_pos - 1]->m_error;
+            }
+
+            if (m_op == ServerWorker::C_START) {
+                // take down the workers that are already listening
+                m_op = ServerWorker::C_STOP;
+                m_end = m_pos - 1;
+                m_pos = 0;
+                return next(step);
+            }
+
+            if (m_op == ServerWorker::C_STOP && m_pos < m_end)
+                return next(step);
+
+            return CHECK_ERROR(Runtime::setError(m_error));
+        }
+
+    private:
+        obj_ptr<TcpServer> m_pThis;
+        int32_t m_op;
+        size_t m_pos;
+        size_t m_end;
+        result_t m_hr;
+        exlib::string m_error;
+        obj_ptr<HttpHandler> m_settings;
+    };
+
+    if (ac->isSync()) {
+        // take the http settings while still on the js thread, workers copy them later
+        if (m_http && op != ServerWorker::C_STOP) {
+            m_settings = new HttpHandler();
+            m_settings->copy_settings(m_http);
+        }
+
+        return CHECK_ERROR(CALL_E_NOSYNC);
+    }
+
+    return (new asyncRun(this, op, ac))->post(0);
+}
+
 result_t TcpServer::stop(AsyncEvent* ac)
 {
+    if (is_worker()) {
+        m_running = false;
+        return run_workers(ServerWorker::C_STOP, ac);
+    }
+
     if (!m_socket)
         return CHECK_ERROR(CALL_E_INVALID_CALL);
 
     return m_socket->close(ac);
 }
 
+result_t TcpServer::reload(AsyncEvent* ac)
+{
+    if (!is_worker() || !m_running)
+        return CHECK_ERROR(CALL_E_INVALID_CALL);
+
+    return run_workers(ServerWorker::C_RELOAD, ac);
+}
+
 result_t TcpServer::get_socket(obj_ptr<Socket_base>& retVal)
 {
     if (!m_socket)
@@ -213,10 +512,33 @@ result_t TcpServer::get_handler(obj_ptr<Handler_base>& retVal)
 
 result_t TcpServer::set_handler(Handler_base* newVal)
 {
+    if (is_worker())
+        return CHECK_ERROR(Runtime::setError("TcpServer: worker mode loads the handler from the worker module."));
+
     SetPrivate("handler", newVal->wrap());
     m_hdlr = newVal;
 
     return 0;
 }
 
+result_t TcpServer::get_stats(v8::Local<v8::Object>& retVal)
+{
+    Isolate* isolate = holder();
+    v8::Local<v8::Context> context = isolate->context();
+    v8::Local<v8::Object> o = v8::Object::New(isolate->m_isolate);
+
+    o->Set(context, isolate->NewString("accepted"),
+         v8::Number::New(isolate->m_isolate, (double)m_stats->m_accepted.value()))
+        .IsJust();
+    o->Set(context, isolate->NewString("active"),
+         v8::Number::New(isolate->m_isolate, (double)m_stats->m_active.value()))
+        .IsJust();
+    o->Set(context, isolate->NewString("listeners"),
+         v8::Number::New(isolate->m_isolate, (double)m_stats->m_listeners.value()))
+        .IsJust();
+
+    retVal = o;
+    return 0;
+}
+
 } /* namespace fibjs */
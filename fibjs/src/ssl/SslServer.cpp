@@ -56,6 +56,47 @@ result_t SslServer_base::_new(X509Cert_base* crt, PKey_base* key, exlib::string
     return 0;
 }
 
+result_t SslServer_base::_new(v8::Local<v8::Array> certs, v8::Local<v8::Object> opts,
+    Handler_base* listener, obj_ptr<SslServer_base>& retVal,
+    v8::Local<v8::Object> This)
+{
+    obj_ptr<SslServer> svr = new SslServer();
+    svr->wrap(This);
+
+    result_t hr = svr->create(certs, opts, listener);
+    if (hr < 0)
+        return hr;
+
+    retVal = svr;
+
+    return 0;
+}
+
+result_t SslServer_base::_new(X509Cert_base* crt, PKey_base* key, v8::Local<v8::Object> opts,
+    Handler_base* listener, obj_ptr<SslServer_base>& retVal,
+    v8::Local<v8::Object> This)
+{
+    obj_ptr<SslServer> svr = new SslServer();
+    svr->wrap(This);
+
+    result_t hr = svr->create(crt, key, opts, listener);
+    if (hr < 0)
+        return hr;
+
+    retVal = svr;
+
+    return 0;
+}
+
+void SslServer::init(SslHandler_base* handler, TcpServer_base* server)
+{
+    SetPrivate("handler", handler->wrap());
+    m_hdlr = handler;
+
+    SetPrivate("server", server->wrap());
+    m_server = server;
+}
+
 result_t SslServer::create(X509Cert_base* crt, PKey_base* key, exlib::string addr, int32_t port,
     Handler_base* listener)
 {
@@ -71,12 +112,7 @@ result_t SslServer::create(X509Cert_base* crt, PKey_base* key, exlib::string add
     if (hr < 0)
         return hr;
 
-    SetPrivate("handler", _handler->wrap());
-    m_hdlr = _handler;
-
-    SetPrivate("server", _server->wrap());
-    m_server = _server;
-
+    init(_handler, _server);
     return 0;
 }
 
@@ -95,12 +131,45 @@ result_t SslServer::create(v8::Local<v8::Array> certs, exlib::string addr, int32
     if (hr < 0)
         return hr;
 
-    SetPrivate("handler", _handler->wrap());
-    m_hdlr = _handler;
+    init(_handler, _server);
+    return 0;
+}
+
+result_t SslServer::create(X509Cert_base* crt, PKey_base* key, v8::Local<v8::Object> opts,
+    Handler_base* listener)
+{
+    result_t hr;
+    obj_ptr<TcpServer_base> _server;
+    obj_ptr<SslHandler_base> _handler;
+
+    hr = SslHandler_base::_new(crt, key, listener, _handler);
+    if (hr < 0)
+        return hr;
+
+    hr = TcpServer_base::_new(opts, _handler, _server);
+    if (hr < 0)
+        return hr;
 
-    SetPrivate("server", _server->wrap());
-    m_server = _server;
+    init(_handler, _server);
+    return 0;
+}
 
+result_t SslServer::create(v8::Local<v8::Array> certs, v8::Local<v8::Object> opts,
+    Handler_base* listener)
+{
+    result_t hr;
+    obj_ptr<TcpServer_base> _server;
+    obj_ptr<SslHandler_base> _handler;
+
+    hr = SslHandler_base::_new(certs, listener, _handler);
+    if (hr < 0)
+        return hr;
+
+    hr = TcpServer_base::_new(opts, _handler, _server);
+    if (hr < 0)
+        return hr;
+
+    init(_handler, _server);
     return 0;
 }
 
@@ -114,6 +183,11 @@ result_t SslServer::stop(AsyncEvent* ac)
     return m_server->stop(ac);
 }
 
+result_t SslServer::reload(AsyncEvent* ac)
+{
+    return m_server->reload(ac);
+}
+
 result_t SslServer::get_socket(obj_ptr<Socket_base>& retVal)
 {
     return m_server->get_socket(retVal);
@@ -129,6 +203,11 @@ result_t SslServer::set_handler(Handler_base* newVal)
     return m_hdlr->set_handler(newVal);
 }
 
+result_t SslServer::get_stats(v8::Local<v8::Object>& retVal)
+{
+    return m_server->get_stats(retVal);
+}
+
 result_t SslServer::get_verification(int32_t& retVal)
 {
     return m_hdlr->get_verification(retVal);
@@ -15,6 +15,8 @@
 
 namespace fibjs {
 
+#define SSL_RECORD_SIZE 16384
+
 result_t SslSocket_base::_new(X509Cert_base* crt, PKey_base* key,
     obj_ptr<SslSocket_base>& retVal,
     v8::Local<v8::Object> This)
@@ -81,6 +83,7 @@ SslSocket::SslSocket()
     mbedtls_ssl_conf_rng(&m_ssl_conf, mbedtls_ctr_drbg_random, &g_ssl.ctr_drbg);
 
     m_recv_pos = 0;
+    m_alpn = NULL;
 }
 
 SslSocket::~SslSocket()
@@ -277,6 +280,97 @@ result_t SslSocket::write(Buffer_base* data, AsyncEvent* ac)
     return (new asyncWrite(this, data, ac))->post(0);
 }
 
+result_t SslSocket::writev(std::vector<obj_ptr<Buffer>>& datas, AsyncEvent* ac)
+{
+    class asyncWritev : public asyncSsl {
+    public:
+        asyncWritev(SslSocket* pThis, std::vector<obj_ptr<Buffer>>& datas, AsyncEvent* ac)
+            : asyncSsl(pThis, ac)
+            , m_datas(datas)
+            , m_idx(0)
+            , m_pos(0)
+            , m_rec_pos(0)
+        {
+            if (g_ssldump)
+                for (size_t i = 0; i < m_datas.size(); i++)
+                    outLog(console_base::C_WARN, clean_string((const char*)m_datas[i]->data(), m_datas[i]->length()));
+        }
+
+    public:
+        // small pieces are packed into one record, large ones are encrypted
+        // straight from their own memory
+        virtual int32_t process()
+        {
+            while (true) {
+                if (m_rec_pos == m_rec.length()) {
+                    m_rec.resize(0);
+                    m_rec_pos = 0;
+
+                    while (m_idx < m_datas.size() && m_rec.length() < SSL_RECORD_SIZE) {
+                        Buffer* buf = m_datas[m_idx];
+                        size_t len = buf->length() - m_pos;
+
+                        if (m_rec.empty() && len >= SSL_RECORD_SIZE)
+                            break;
+
+                        if (len > SSL_RECORD_SIZE - m_rec.length())
+                            len = SSL_RECORD_SIZE - m_rec.length();
+                        m_rec.append((const char*)buf->data() + m_pos, len);
+
+                        m_pos += len;
+                        if (m_pos == buf->length()) {
+                            m_idx++;
+                            m_pos = 0;
+                        }
+                    }
+                }
+
+                const unsigned char* p;
+                size_t len;
+                bool staged = m_rec_pos < m_rec.length();
+
+                if (staged) {
+                    p = (const unsigned char*)m_rec.c_str() + m_rec_pos;
+                    len = m_rec.length() - m_rec_pos;
+                } else if (m_idx < m_datas.size()) {
+                    p = m_datas[m_idx]->data() + m_pos;
+                    len = m_datas[m_idx]->length() - m_pos;
+                } else
+                    return 0;
+
+                int32_t ret = mbedtls_ssl_write(&m_pThis->m_ssl, p, len);
+                if (ret <= 0)
+                    return ret;
+
+                if (staged)
+                    m_rec_pos += ret;
+                else {
+                    m_pos += ret;
+                    if (m_pos == m_datas[m_idx]->length()) {
+                        m_idx++;
+                        m_pos = 0;
+                    }
+                }
+            }
+        }
+
+    private:
+        std::vector<obj_ptr<Buffer>> m_datas;
+        size_t m_idx;
+        size_t m_pos;
+        exlib::string m_rec;
+        size_t m_rec_pos;
+    };
+
+    if (!m_s)
+        return CHECK_ERROR(CALL_E_CLOSED);
+
+    if (ac->isSync())
+        return CHECK_ERROR(CALL_E_NOSYNC);
+
+    return (new asyncWritev(this, datas, ac))->post(0);
+}
+
 result_t SslSocket::flush(AsyncEvent* ac)
 {
     return 0;
@@ -436,6 +530,9 @@ result_t SslSocket::connect(Stream_base* s, exlib::string server_name,
 
     mbedtls_ssl_conf_ca_chain(&m_ssl_conf, &m_ca->m_crt, NULL);
 
+    if (m_alpn)
+        mbedtls_ssl_conf_alpn_protocols(&m_ssl_conf, m_alpn);
+
     ret = mbedtls_ssl_setup(&m_ssl, &m_ssl_conf);
     if (ret != 0)
         return CHECK_ERROR(_ssl::setError(ret));
@@ -519,6 +616,9 @@ result_t SslSocket::accept(Stream_base* s, obj_ptr<SslSocket_base>& retVal,
     mbedtls_ssl_conf_session_cache(&ss->m_ssl_conf, &g_ssl.m_cache,
         mbedtls_ssl_cache_get, mbedtls_ssl_cache_set);
 
+    if (m_alpn)
+        mbedtls_ssl_conf_alpn_protocols(&ss->m_ssl_conf, m_alpn);
+
     ret = mbedtls_ssl_setup(&ss->m_ssl, &ss->m_ssl_conf);
     if (ret != 0)
         return CHECK_ERROR(_ssl::setError(ret));
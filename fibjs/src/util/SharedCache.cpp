@@ -0,0 +1,395 @@
+/*
+ * SharedCache.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "object.h"
+#include "SharedCache.h"
+#include "Buffer.h"
+#include "Timer.h"
+
+namespace fibjs {
+
+#define SHARED_CACHE_SHARDS 16
+#define SHARED_CACHE_MAX_SHARDS 1024
+#define SHARED_CACHE_SWEEP_INTERVAL 1000
+
+result_t SharedCache_base::_new(exlib::string name, v8::Local<v8::Object> opts,
+    obj_ptr<SharedCache_base>& retVal, v8::Local<v8::Object> This)
+{
+    Isolate* isolate = Isolate::current(opts);
+    int64_t budget = 0;
+    int32_t timeout = 0;
+    int32_t shards = SHARED_CACHE_SHARDS;
+    result_t hr;
+
+    hr = GetConfigValue(isolate, opts, "budget", budget, true);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    hr = GetConfigValue(isolate, opts, "timeout", timeout, true);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    hr = GetConfigValue(isolate, opts, "shards", shards, true);
+    if (hr < 0 && hr != CALL_E_PARAMNOTOPTIONAL)
+        return hr;
+
+    if (shards < 1 || shards > SHARED_CACHE_MAX_SHARDS)
+        return CALL_E_OUTRANGE;
+
+    retVal = new SharedCache(SharedStore::open(name, budget, timeout, shards));
+    return 0;
+}
+
+obj_ptr<SharedStore> SharedStore::open(exlib::string name, int64_t budget, int32_t timeout,
+    int32_t shards)
+{
+    static exlib::spinlock s_lock;
+    static std::unordered_map<exlib::string, obj_ptr<SharedStore>> s_stores;
+    obj_ptr<SharedStore> store;
+
+    s_lock.lock();
+    obj_ptr<SharedStore>& slot = s_stores[name];
+    if (!slot)
+        slot = new SharedStore(name, budget, timeout, shards);
+    store = slot;
+    s_lock.unlock();
+
+    return store;
+}
+
+static int32_t shard_count(int32_t shards)
+{
+    int32_t n = 1;
+
+    while (n < shards)
+        n <<= 1;
+
+    return n;
+}
+
+SharedStore::SharedStore(exlib::string name, int64_t budget, int32_t timeout, int32_t shards)
+    : m_name(name)
+    , m_budget(budget)
+    , m_timeout(timeout)
+    , m_shards(shard_count(shards))
+    , m_sweeping(0)
+{
+    m_shardBudget = 0;
+    if (m_budget > 0) {
+        m_shardBudget = m_budget / (int64_t)m_shards.size();
+        if (m_shardBudget < 1)
+            m_shardBudget = 1;
+    }
+}
+
+void SharedStore::erase(Shard& s, map_t::iterator it, std::vector<obj_ptr<Value>>& drops)
+{
+    Entry& e = it->second;
+
+    s.m_bytes -= e.bytes;
+    s.m_lru.erase(e.lru);
+    if (e.expire > 0)
+        s.m_expires.erase(e.expires);
+
+    drops.push_back(e.value);
+    s.m_map.erase(it);
+}
+
+bool SharedStore::get(exlib::string& key, obj_ptr<Value>& retVal, bool touch)
+{
+    Shard& s = shard(key);
+    std::vector<obj_ptr<Value>> drops;
+    date_t d;
+    bool found = false;
+
+    d.now();
+
+    s.m_lock.lock();
+    map_t::iterator it = s.m_map.find(key);
+    if (it != s.m_map.end()) {
+        Entry& e = it->second;
+
+        if (e.expire > 0 && e.expire <= d.date()) {
+            erase(s, it, drops);
+            s.m_expirations++;
+        } else {
+            if (touch)
+                s.m_lru.splice(s.m_lru.begin(), s.m_lru, e.lru);
+            retVal = e.value;
+            found = true;
+        }
+    }
+
+    if (touch) {
+        if (found)
+            s.m_hits++;
+        else
+            s.m_misses++;
+    }
+    s.m_lock.unlock();
+
+    return found;
+}
+
+void SharedStore::set(exlib::string& key, Value* value, int32_t timeout)
+{
+    Shard& s = shard(key);
+    std::vector<obj_ptr<Value>> drops;
+    size_t bytes = key.length() + value->m_data.length();
+    double expire = 0;
+    bool sweep = false;
+
+    if (timeout < 0)
+        timeout = m_timeout;
+
+    if (timeout > 0) {
+        date_t d;
+
+        d.now();
+        expire = d.date() + timeout;
+    }
+
+    s.m_lock.lock();
+    map_t::iterator it = s.m_map.find(key);
+    if (it != s.m_map.end())
+        erase(s, it, drops);
+
+    // a value larger than the whole shard budget would only flush the shard
+    if (m_shardBudget > 0 && (int64_t)bytes > m_shardBudget)
+        s.m_evictions++;
+    else {
+        it = s.m_map.emplace(key, Entry()).first;
+
+        Entry& e = it->second;
+        const exlib::string* k = &it->first;
+
+        e.value = value;
+        e.bytes = bytes;
+        e.expire = expire;
+        s.m_lru.push_front(k);
+        e.lru = s.m_lru.begin();
+        if (expire > 0) {
+            e.expires = s.m_expires.emplace(expire, k);
+            sweep = true;
+        }
+        s.m_bytes += bytes;
+
+        while (m_shardBudget > 0 && s.m_bytes > m_shardBudget) {
+            erase(s, s.m_map.find(*s.m_lru.back()), drops);
+            s.m_evictions++;
+        }
+    }
+    s.m_lock.unlock();
+
+    if (sweep && m_sweeping.CompareAndSwap(0, 1) == 0) {
+        class SweepTimer : public Timer {
+        public:
+            SweepTimer(SharedStore* store)
+                : Timer(SHARED_CACHE_SWEEP_INTERVAL)
+                , m_store(store)
+            {
+            }
+
+        public:
+            virtual void on_timer()
+            {
+                if (m_store->sweep())
+                    (new SweepTimer(m_store))->sleep();
+            }
+
+        private:
+            obj_ptr<SharedStore> m_store;
+        };
+
+        (new SweepTimer(this))->sleep();
+    }
+}
+
+bool SharedStore::remove(exlib::string& key)
+{
+    Shard& s = shard(key);
+    std::vector<obj_ptr<Value>> drops;
+
+    s.m_lock.lock();
+    map_t::iterator it = s.m_map.find(key);
+    if (it != s.m_map.end())
+        erase(s, it, drops);
+    s.m_lock.unlock();
+
+    return !drops.empty();
+}
+
+void SharedStore::clear()
+{
+    for (size_t i = 0; i < m_shards.size(); i++) {
+        Shard& s = m_shards[i];
+        map_t drops;
+
+        s.m_lock.lock();
+        drops.swap(s.m_map);
+        s.m_lru.clear();
+        s.m_expires.clear();
+        s.m_bytes = 0;
+        s.m_lock.unlock();
+    }
+}
+
+void SharedStore::stats(Stats& st)
+{
+    for (size_t i = 0; i < m_shards.size(); i++) {
+        Shard& s = m_shards[i];
+
+        s.m_lock.lock();
+        st.hits += s.m_hits;
+        st.misses += s.m_misses;
+        st.evictions += s.m_evictions;
+        st.expirations += s.m_expirations;
+        st.size += (int64_t)s.m_map.size();
+        st.bytes += s.m_bytes;
+        s.m_lock.unlock();
+    }
+}
+
+bool SharedStore::sweep()
+{
+    bool remain = false;
+    date_t d;
+
+    d.now();
+
+    for (size_t i = 0; i < m_shards.size(); i++) {
+        Shard& s = m_shards[i];
+        std::vector<obj_ptr<Value>> drops;
+
+        s.m_lock.lock();
+        while (!s.m_expires.empty() && s.m_expires.begin()->first <= d.date()) {
+            erase(s, s.m_map.find(*s.m_expires.begin()->second), drops);
+            s.m_expirations++;
+        }
+        if (!s.m_expires.empty())
+            remain = true;
+        s.m_lock.unlock();
+    }
+
+    if (!remain)
+        m_sweeping = 0;
+
+    return remain;
+}
+
+result_t SharedCache::get_name(exlib::string& retVal)
+{
+    retVal = m_store->m_name;
+    return 0;
+}
+
+result_t SharedCache::get_size(int32_t& retVal)
+{
+    SharedStore::Stats st;
+
+    m_store->stats(st);
+    retVal = (int32_t)st.size;
+    return 0;
+}
+
+result_t SharedCache::get_bytes(int64_t& retVal)
+{
+    SharedStore::Stats st;
+
+    m_store->stats(st);
+    retVal = st.bytes;
+    return 0;
+}
+
+result_t SharedCache::get_budget(int64_t& retVal)
+{
+    retVal = m_store->m_budget;
+    return 0;
+}
+
+result_t SharedCache::get_stats(v8::Local<v8::Object>& retVal)
+{
+    Isolate* isolate = holder();
+    v8::Local<v8::Context> context = isolate->context();
+    v8::Local<v8::Object> o = v8::Object::New(isolate->m_isolate);
+    SharedStore::Stats st;
+
+    m_store->stats(st);
+
+    o->Set(context, isolate->NewString("hits"), v8::Number::New(isolate->m_isolate, (double)st.hits)).IsJust();
+    o->Set(context, isolate->NewString("misses"), v8::Number::New(isolate->m_isolate, (double)st.misses)).IsJust();
+    o->Set(context, isolate->NewString("evictions"), v8::Number::New(isolate->m_isolate, (double)st.evictions)).IsJust();
+    o->Set(context, isolate->NewString("expirations"), v8::Number::New(isolate->m_isolate, (double)st.expirations)).IsJust();
+    o->Set(context, isolate->NewString("size"), v8::Number::New(isolate->m_isolate, (double)st.size)).IsJust();
+    o->Set(context, isolate->NewString("bytes"), v8::Number::New(isolate->m_isolate, (double)st.bytes)).IsJust();
+
+    retVal = o;
+    return 0;
+}
+
+result_t SharedCache::clear()
+{
+    m_store->clear();
+    return 0;
+}
+
+result_t SharedCache::has(exlib::string name, bool& retVal)
+{
+    obj_ptr<SharedStore::Value> v;
+
+    retVal = m_store->get(name, v, false);
+    return 0;
+}
+
+result_t SharedCache::get(exlib::string name, v8::Local<v8::Value>& retVal)
+{
+    obj_ptr<SharedStore::Value> v;
+
+    if (!m_store->get(name, v, true))
+        return CALL_RETURN_UNDEFINED;
+
+    Isolate* isolate = holder();
+
+    if (v->m_string)
+        retVal = isolate->NewString(v->m_data);
+    else {
+        obj_ptr<Buffer> buf = new Buffer(v->m_data.c_str(), v->m_data.length());
+        retVal = buf->wrap(isolate);
+    }
+
+    return 0;
+}
+
+result_t SharedCache::set(exlib::string name, v8::Local<v8::Value> value, int32_t timeout)
+{
+    obj_ptr<SharedStore::Value> v;
+
+    if (value->IsString() || value->IsStringObject()) {
+        exlib::string str;
+        result_t hr = GetArgumentValue(holder(), value, str, true);
+        if (hr < 0)
+            return hr;
+
+        v = new SharedStore::Value(str.c_str(), str.length(), true);
+    } else {
+        Buffer* buf = Buffer::getInstance(value);
+        if (!buf)
+            return CALL_E_TYPEMISMATCH;
+
+        v = new SharedStore::Value((const char*)buf->data(), buf->length(), false);
+    }
+
+    m_store->set(name, v, timeout);
+    return 0;
+}
+
+result_t SharedCache::remove(exlib::string name, bool& retVal)
+{
+    retVal = m_store->remove(name);
+    return 0;
+}
+
+} /* namespace fibjs */
@@ -11,6 +11,7 @@
 #include "WebSocketMessage.h"
 #include "Buffer.h"
 #include "MemoryStream.h"
+#include "GatherWriter.h"
 
 namespace fibjs {
 
@@ -285,9 +286,36 @@ result_t WebSocketMessage::sendTo(Stream_base* stm, WebSocket* wss, AsyncEvent*
             }
 
             m_buffer = new Buffer((const char*)buf, pos);
+
+            // small frames go out as one head + payload chain
+            if (m_size > 0 && m_size <= STREAM_BUFF_SIZE) {
+                m_data->rewind();
+                return m_data->read((int32_t)m_size, m_payload, next(sendFrame));
+            }
+
             return m_stm->write(m_buffer, next(sendData));
         }
 
+        ON_STATE(asyncSendTo, sendFrame)
+        {
+            if (n == CALL_RETURN_NULL || Buffer::Cast(m_payload)->length() != (size_t)m_size)
+                return CHECK_ERROR(Runtime::setError("WebSocketMessage: payload processing failed."));
+
+            Buffer* buf = Buffer::Cast(m_payload);
+            if (m_mask != 0) {
+                uint8_t* mask = (uint8_t*)&m_mask;
+                uint8_t* _strBuffer = buf->data();
+
+                for (int64_t i = 0; i < m_size; i++)
+                    _strBuffer[i] ^= mask[i & 3];
+            }
+
+            m_datas.push_back(Buffer::Cast(m_buffer));
+            m_datas.push_back(buf);
+
+            return stream_writev(m_stm, m_datas, next());
+        }
+
         ON_STATE(asyncSendTo, sendData)
         {
             m_data->rewind();
@@ -311,6 +339,8 @@ result_t WebSocketMessage::sendTo(Stream_base* stm, WebSocket* wss, AsyncEvent*
         int64_t m_size;
         uint32_t m_mask;
         obj_ptr<Buffer_base> m_buffer;
+        obj_ptr<Buffer_base> m_payload;
+        std::vector<obj_ptr<Buffer>> m_datas;
         bool m_take_over;
     };
 
@@ -217,10 +217,7 @@ result_t zip_base::open(Buffer_base* data, exlib::string mod, exlib::string code
     if (ac->isSync())
         return CHECK_ERROR(CALL_E_NOSYNC);
 
-    exlib::string strData;
-
-    data->toString(strData);
-    obj_ptr<SeekableStream_base> strm = new MemoryStream::CloneStream(strData, 0);
+    obj_ptr<SeekableStream_base> strm = new MemoryStream::BufferStream(data, 0);
 
     return open(strm, mod, codec, retVal, ac);
 }
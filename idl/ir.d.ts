@@ -134,6 +134,10 @@ declare namespace FIBJS_IDL {
          * @description 仅为 true 表示是支持异步的方法
          */
         async: null
+        /**
+         * @description 仅为 true 表示同时生成 V8 Fast API 调用入口
+         */
+        fast: null
         /**
          * @description truthy 时表明这是个 symbol 成员
          */
@@ -166,6 +170,7 @@ declare namespace FIBJS_IDL {
             deprecated: IMember['deprecated']
             static: IMember['static']
             async: IMember['async']
+            fast: IMember['fast']
             symbol: IMember['symbol']
             name: IMember['name']
             type: IMember['type']
@@ -1,5 +1,6 @@
 /// <reference path="../_import/_fibjs.d.ts" />
 /// <reference path="../interface/object.d.ts" />
+/// <reference path="../interface/DbCursor.d.ts" />
 /**
  * @description DBConnection 是数据库连接的基类，用于建立和维护一个数据库连接会话。其实现了连接的基本操作，并作为派生类的基础。同时支持开始事务、提交事务、回滚事务等操作。 
  * 
@@ -113,6 +114,71 @@ declare class Class_DbConnection extends Class_object {
      */
     execute(sql: string, ...args: any[]): any[];
 
+    /**
+     * @description 执行一个 sql 命令，并按列返回执行结果
+     * 
+     *      返回的结果按列存放，数值列以类型化数组返回，字符串列以字典编码返回，适合返回大量记录的统计查询：
+     *      ```JavaScript
+     *      {
+     *          rows: 2, // 记录数
+     *          affected: 0,
+     *          insertId: 0,
+     *          fields: ["id", "name"], // 字段名
+     *          columns: {
+     *              id: Int32Array [1, 2], // 整数列，超出 32 位时为 BigInt64Array，含小数时为 Float64Array
+     *              name: { // 字符串列
+     *                  dictionary: ["a"], // 不重复的字符串
+     *                  indices: Int32Array [0, -1] // 每条记录在 dictionary 中的序号，null 为 -1
+     *              }
+     *          },
+     *          nulls: { // 包含 null 的列的 null 位图，第 i 条记录为 null 时第 i 位为 1
+     *              name: Uint8Array [2]
+     *          }
+     *      }
+     *      ```
+     *      日期，二进制等其它类型的列以及类型不一致的列以普通数组返回。sql 包含多条语句时返回最后一条语句的结果。
+     * 
+     *      @param sql 字符串
+     *      @return 返回按列存放的结果
+     *      
+     */
+    executeColumns(sql: string): FIBJS.GeneralObject;
+
+    executeColumns(sql: string, callback: (err: Error | undefined | null, retVal: FIBJS.GeneralObject)=>any): void;
+
+    /**
+     * @description 执行一个 sql 命令，并按列返回执行结果，可根据参数格式化字符串
+     * 
+     *      返回结果的格式与 executeColumns(String sql) 相同。
+     * 
+     *      @param sql 格式化字符串，可选参数用 ? 指定。例如：'SELECT FROM TEST WHERE [id]=?'
+     *      @param args 可选参数列表
+     *      @return 返回按列存放的结果
+     *      
+     */
+    executeColumns(sql: string, ...args: any[]): FIBJS.GeneralObject;
+
+    /**
+     * @description 执行一个 sql 查询，并返回用于分批读取结果的游标
+     * 
+     *      @param sql 字符串
+     *      @return 返回游标对象，通过游标的 next 方法分批读取结果记录
+     *      
+     */
+    cursor(sql: string): Class_DbCursor;
+
+    cursor(sql: string, callback: (err: Error | undefined | null, retVal: Class_DbCursor)=>any): void;
+
+    /**
+     * @description 执行一个 sql 查询，并返回用于分批读取结果的游标，可根据参数格式化字符串
+     * 
+     *      @param sql 格式化字符串，可选参数用 ? 指定。例如：'SELECT FROM TEST WHERE [id]=?'
+     *      @param args 可选参数列表
+     *      @return 返回游标对象，通过游标的 next 方法分批读取结果记录
+     *      
+     */
+    cursor(sql: string, ...args: any[]): Class_DbCursor;
+
     /**
      * @description 创建数据表
      * 
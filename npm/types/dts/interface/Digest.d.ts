@@ -2,6 +2,7 @@
 /// <reference path="../interface/object.d.ts" />
 /// <reference path="../interface/Buffer.d.ts" />
 /// <reference path="../interface/PKey.d.ts" />
+/// <reference path="../interface/Stream.d.ts" />
 /**
  * @description 信息摘要对象 
  * 
@@ -43,6 +44,16 @@ declare class Class_Digest extends Class_object {
      */
     update(data: string, codec?: string): Class_Digest;
 
+    /**
+     * @description 读取流中的全部数据并更新摘要信息
+     *      @param stm 指定读取数据的流
+     *      @return 返回信息摘要对象本身
+     *      
+     */
+    updateFromStream(stm: Class_Stream): Class_Digest;
+
+    updateFromStream(stm: Class_Stream, callback: (err: Error | undefined | null, retVal: Class_Digest)=>any): void;
+
     /**
      * @description 计算并返回摘要
      *      @param codec 指定编码格式，允许值为："buffer", "hex", "base32", "base58", "base64", "utf8", 或者 iconv 模块支持的字符集
@@ -78,6 +78,11 @@ declare class Class_HttpClient extends Class_object {
      */
     enableEncoding: boolean;
 
+    /**
+     * @description HTTP/2 功能开关，默认关闭。开启后 https 请求通过 ALPN 协商 h2，同一 origin 的请求复用一个多路复用会话，不受 poolMaxActive 限制；服务器不支持时退回 HTTP/1.1 
+     */
+    enableHttp2: boolean;
+
     /**
      * @description 查询和设置最大请求头个数，缺省为 128 
      */
@@ -99,7 +104,10 @@ declare class Class_HttpClient extends Class_object {
     userAgent: string;
 
     /**
-     * @description 查询和设置 keep-alive 最大缓存连接数，缺省 128 
+     * @description 查询和设置每个目标地址 keep-alive 最大缓存连接数，缺省 128
+     * 
+     *     连接池按目标地址分别缓存空闲连接，超出上限时淘汰该地址最早缓存的连接，不影响其它目标地址。
+     *      
      */
     poolSize: number;
 
@@ -108,6 +116,29 @@ declare class Class_HttpClient extends Class_object {
      */
     poolTimeout: number;
 
+    /**
+     * @description 查询和设置每个目标地址同时使用的最大连接数，缺省为 0，不限制
+     * 
+     *     达到上限后，新的请求将按到达顺序排队，等待该目标地址有连接归还后再继续执行。等待时间超过 timeout 时请求将抛出超时错误，timeout 为 0 时一直等待。
+     *      
+     */
+    poolMaxActive: number;
+
+    /**
+     * @description 查询连接池统计
+     * 
+     *     返回的对象包含以下字段：
+     *     - hits: 复用缓存连接的次数
+     *     - misses: 需要新建连接的次数
+     *     - evictions: 因超出 poolSize 或超时而淘汰的缓存连接数
+     *     - origins: 当前连接池中的目标地址数
+     *     - idle: 当前缓存的空闲连接数
+     *     - active: 当前正在使用的连接数
+     *     - waiting: 当前因 poolMaxActive 限制而等待的请求数
+     *      
+     */
+    readonly poolStats: FIBJS.GeneralObject;
+
     /**
      * @description 查询和设置 http 请求代理，支持 http/https/socks5 代理 
      */
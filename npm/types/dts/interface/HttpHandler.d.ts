@@ -11,6 +11,8 @@
  *   ```JavaScript
  *   var hdlr = new http.Handler(...);
  *   ```
+ * 
+ *   除 http/1.x 外，HttpHandler 也接受 http/2 连接：明文连接上以 http/2 连接序言开头的客户端（h2c prior knowledge），以及经 ALPN 协商为 h2 的 SslSocket。每个 http/2 流会作为独立的请求交给内置处理器并发处理，请求的 protocol 为 HTTP/2.0。
  *  
  */
 declare class Class_HttpHandler extends Class_Handler {
@@ -28,6 +30,24 @@ declare class Class_HttpHandler extends Class_Handler {
      */
     enableCrossOrigin(allowHeaders?: string): void;
 
+    /**
+     * @description 设置指定内容类型的压缩参数
+     * 
+     *      opts 支持的选项如下：
+     *      ```JavaScript
+     *      {
+     *          minSize: 128, // body 超过此尺寸才进行压缩，缺省为 128
+     *          level: -1 // 压缩级别，取值 -1 至 9，-1 为 zlib 缺省级别，0 表示不压缩此类型
+     *      }
+     *      ```
+     * 
+     *      type 可以是完整的内容类型，如 "application/json"，也可以是 "text/*" 形式，匹配同一大类的所有内容类型。
+     *      @param type 指定内容类型
+     *      @param opts 指定压缩参数
+     *      
+     */
+    setEncodingOptions(type: string, opts: FIBJS.GeneralObject): void;
+
     /**
      * @description 查询和设置最大请求头个数，缺省为 128 
      */
@@ -48,6 +68,23 @@ declare class Class_HttpHandler extends Class_Handler {
      */
     enableEncoding: boolean;
 
+    /**
+     * @description 查询和设置是否在接收时解析 multipart/form-data 请求，缺省为 false
+     * 
+     *      开启后，multipart/form-data 请求的 body 在接收时即逐段解析，超过 1M 的文件段写入临时文件，解析结果作为 request.form，request.body 不再保留原始内容，格式错误的请求将直接被拒绝。
+     *      关闭时保留原始 body，在首次访问 request.form 时才进行解析。
+     *      
+     */
+    streamForm: boolean;
+
+    /**
+     * @description 查询和设置压缩结果缓存的最大尺寸，以字节为单位，缺省为 0，不缓存
+     * 
+     *      启用缓存后，相同的响应内容只压缩一次。响应设置了 ETag 时以请求路径和 ETag 作为缓存键，否则以 body 的 sha1 摘要作为缓存键，超过 1MB 的 body 不缓存。
+     *      
+     */
+    encodingCacheSize: number;
+
     /**
      * @description 查询和设置服务器名称，缺省为：fibjs/0.x.0 
      */
@@ -59,6 +59,10 @@ declare class Class_HttpRequest extends Class_HttpMessage {
 
     /**
      * @description 获取包含消息 form 的容器
+     * 
+     *      form 在首次访问时从 body 解析，multipart/form-data 中超过 1M 的文件段写入临时文件。处理器开启 streamForm 时，form 在接收 body 时即已解析，body 不再保留原始内容。
+     *      格式错误或不完整的 multipart 数据将在访问 form 时抛出错误，而不是返回空的或不完整的 form。
+     *      
      */
     readonly form: Class_HttpCollection;
 
@@ -51,6 +51,49 @@ declare class Class_HttpServer extends Class_TcpServer {
      */
     constructor(addr: string, hdlr: Class_Handler);
 
+    /**
+     * @description HttpServer 构造函数，使用配置对象创建服务器，opts 的选项与 TcpServer 相同
+     * 
+     *     启用 reusePort 后，可以在多个 Worker 中各自运行同一个 http 服务模块，充分利用多核：
+     *     ```JavaScript
+     *     // server.js, run in each worker
+     *     const http = require('http');
+     *     var svr = new http.Server({ port: 8080, reusePort: true }, (req) => {
+     *         req.response.write('hello, world');
+     *     });
+     *     svr.start();
+     *     ```
+     * 
+     *     @param opts 指定服务器配置
+     *     @param hdlr http 内置消息处理器，处理函数，链式处理数组，路由对象，详见 mq.Handler
+     *    
+     */
+    constructor(opts: FIBJS.GeneralObject, hdlr: Class_Handler);
+
+    /**
+     * @description HttpServer 构造函数，以 worker 模式创建服务器，opts 的选项与 TcpServer 的 worker 模式相同
+     * 
+     *     worker 模块导出 http 消息处理器，每个 worker 以当前服务器的 http 设置创建各自的 http 处理器。修改 maxBodySize 等设置后，在下一次 reload 时生效。
+     *     ```JavaScript
+     *     // app.js
+     *     module.exports = (req) => {
+     *         req.response.write('hello, world');
+     *     };
+     * 
+     *     // server.js
+     *     const http = require('http');
+     *     var svr = new http.Server({ port: 8080, worker: __dirname + '/app.js', workers: 4 });
+     *     svr.start();
+     * 
+     *     // update app.js, then
+     *     svr.reload();
+     *     ```
+     * 
+     *     @param opts 指定服务器配置
+     *    
+     */
+    constructor(opts: FIBJS.GeneralObject);
+
     /**
      * @description 允许跨域请求
      *      @param allowHeaders 指定接受的 http 头字段
@@ -58,6 +101,24 @@ declare class Class_HttpServer extends Class_TcpServer {
      */
     enableCrossOrigin(allowHeaders?: string): void;
 
+    /**
+     * @description 设置指定内容类型的压缩参数
+     * 
+     *      opts 支持的选项如下：
+     *      ```JavaScript
+     *      {
+     *          minSize: 128, // body 超过此尺寸才进行压缩，缺省为 128
+     *          level: -1 // 压缩级别，取值 -1 至 9，-1 为 zlib 缺省级别，0 表示不压缩此类型
+     *      }
+     *      ```
+     * 
+     *      type 可以是完整的内容类型，如 "application/json"，也可以是 "text/*" 形式，匹配同一大类的所有内容类型。
+     *      @param type 指定内容类型
+     *      @param opts 指定压缩参数
+     *      
+     */
+    setEncodingOptions(type: string, opts: FIBJS.GeneralObject): void;
+
     /**
      * @description 查询和设置最大请求头个数，缺省为 128 
      */
@@ -78,6 +139,23 @@ declare class Class_HttpServer extends Class_TcpServer {
      */
     enableEncoding: boolean;
 
+    /**
+     * @description 查询和设置是否在接收时解析 multipart/form-data 请求，缺省为 false
+     * 
+     *      开启后，multipart/form-data 请求的 body 在接收时即逐段解析，超过 1M 的文件段写入临时文件，解析结果作为 request.form，request.body 不再保留原始内容，格式错误的请求将直接被拒绝。
+     *      关闭时保留原始 body，在首次访问 request.form 时才进行解析。
+     *      
+     */
+    streamForm: boolean;
+
+    /**
+     * @description 查询和设置压缩结果缓存的最大尺寸，以字节为单位，缺省为 0，不缓存
+     * 
+     *      启用缓存后，相同的响应内容只压缩一次。响应设置了 ETag 时以请求路径和 ETag 作为缓存键，否则以 body 的 sha1 摘要作为缓存键，超过 1MB 的 body 不缓存。
+     *      
+     */
+    encodingCacheSize: number;
+
     /**
      * @description 查询和设置服务器名称，缺省为：fibjs/0.x.0 
      */
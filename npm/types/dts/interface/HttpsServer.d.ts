@@ -32,6 +32,8 @@
  * 在上面的例子中，我们加载了一个名为 "server.crt" 和 "server.key" 的证书和私钥文件，然后使用 HttpsServer 对象创建了一个服务，并开启了监听 8443 端口的服务，当客户端通过"https://localhost:8443/" 访问服务时，就可以受到 ssl 加密保护。
  * 
  * 需要注意的是，如果是需要让外部访问的话，需要确保证书是公信机构颁发的，否则客户端无法验证，降低了性能和安全，并可能触发安全警告。
+ * 
+ * HttpsServer 默认只使用 http/1.1。使用配置对象创建时指定 h2: true，服务器将在握手时通过 ALPN 同时提供 h2 和 http/1.1，支持 http/2 的客户端将直接使用 http/2 通讯。
  *  
  */
 declare class Class_HttpsServer extends Class_HttpServer {
@@ -107,6 +109,25 @@ declare class Class_HttpsServer extends Class_HttpServer {
      */
     constructor(crt: Class_X509Cert, key: Class_PKey, addr: string, port: number, hdlr: Class_Handler);
 
+    /**
+     * @description HttpsServer 构造函数，使用配置对象创建服务器，opts 的选项与 TcpServer 相同，不支持 worker 模式，另外可以指定 h2: true 通过 ALPN 启用 http/2
+     *     @param certs 服务器证书列表，格式同上
+     *     @param opts 指定服务器配置
+     *     @param hdlr http 内置消息处理器，处理函数，链式处理数组，路由对象，详见 mq.Handler
+     *    
+     */
+    constructor(certs: any[], opts: FIBJS.GeneralObject, hdlr: Class_Handler);
+
+    /**
+     * @description HttpsServer 构造函数，使用配置对象创建服务器，opts 的选项与 TcpServer 相同，不支持 worker 模式，另外可以指定 h2: true 通过 ALPN 启用 http/2
+     *     @param crt X509Cert 证书，用于客户端验证服务器
+     *     @param key PKey 私钥，用于与客户端会话
+     *     @param opts 指定服务器配置
+     *     @param hdlr http 内置消息处理器，处理函数，链式处理数组，路由对象，详见 mq.Handler
+     *    
+     */
+    constructor(crt: Class_X509Cert, key: Class_PKey, opts: FIBJS.GeneralObject, hdlr: Class_Handler);
+
     /**
      * @description 设定证书验证模式，缺省为 VERIFY_NONE 
      */
@@ -0,0 +1,117 @@
+/// <reference path="../_import/_fibjs.d.ts" />
+/// <reference path="../interface/object.d.ts" />
+/**
+ * @description SharedCache 是一个进程内共享的 LRU 缓存，数据保存在 JavaScript 堆之外，可以被所有 Worker 同时访问
+ *
+ * SharedCache 只保存 String 和 Buffer 数据，需要缓存对象时，可以先使用 msgpack 或 json 编码为 Buffer 或 String。缓存按照键值的 hash 分为多个分片，每个分片使用独立的锁，不同 Worker 并发读写时相互影响很小。
+ *
+ * 在任何 Worker 中使用相同的名称创建 SharedCache，得到的都是同一份缓存数据：
+ *
+ * ```JavaScript
+ * const util = require('util');
+ *
+ * // 主线程和 Worker 中使用相同的名称，共享同一个缓存
+ * const c = new util.SharedCache('pages', {
+ *     budget: 512 * 1024 * 1024, // 缓存总字节数上限
+ *     timeout: 60000 // 缺省失效时间 60 秒
+ * });
+ *
+ * c.set('index', Buffer.from('<html>...</html>'));
+ * console.log(c.get('index'));
+ * ```
+ *
+ * 缓存的选项只在第一次以该名称创建时生效，之后以相同名称创建时选项将被忽略。字节上限平均分配到每个分片，某个分片超出上限时，淘汰该分片中最近最少使用的数据。带有失效时间的数据会在访问时检查，同时由后台定时器定期清理。
+ *
+ */
+declare class Class_SharedCache extends Class_object {
+    /**
+     * @description SharedCache 对象构造函数
+     *
+     *      opts 支持的选项如下：
+     *      ```JavaScript
+     *      {
+     *          budget: 0, // 缓存数据总字节数上限，小于等于 0 不限制，缺省为 0
+     *          timeout: 0, // 元素缺省失效时间，单位是 ms，小于等于 0 不失效，缺省为 0
+     *          shards: 16 // 分片数量，将被调整为 2 的幂，缺省为 16
+     *      }
+     *      ```
+     *      @param name 缓存名称，相同名称的 SharedCache 共享数据
+     *      @param opts 缓存选项
+     *
+     */
+    constructor(name: string, opts?: FIBJS.GeneralObject);
+
+    /**
+     * @description 查询缓存名称
+     */
+    readonly name: string;
+
+    /**
+     * @description 查询缓存内数值个数
+     */
+    readonly size: number;
+
+    /**
+     * @description 查询缓存数据占用的字节数，包括键值和数据
+     */
+    readonly bytes: number;
+
+    /**
+     * @description 查询缓存字节数上限，小于等于 0 表示不限制
+     */
+    readonly budget: number;
+
+    /**
+     * @description 查询缓存运行统计
+     *
+     *      返回的对象包含以下字段：
+     *      - hits: 查询命中次数
+     *      - misses: 查询未命中次数
+     *      - evictions: 因超出字节上限被淘汰的数据数量
+     *      - expirations: 因超时被清除的数据数量
+     *      - size: 当前缓存内数值个数
+     *      - bytes: 当前缓存数据占用的字节数
+     *
+     */
+    readonly stats: FIBJS.GeneralObject;
+
+    /**
+     * @description 清除缓存数据
+     */
+    clear(): void;
+
+    /**
+     * @description 检查缓存内是否存在指定键值的数据
+     *      @param name 指定要检查的键值
+     *      @return 返回键值是否存在
+     *
+     */
+    has(name: string): boolean;
+
+    /**
+     * @description 查询指定键值的值
+     *      @param name 指定要查询的键值
+     *      @return 返回键值所对应的值，设定时为 Buffer 则返回 Buffer 的副本，若不存在或已失效，则返回 undefined
+     *
+     */
+    get(name: string): any;
+
+    /**
+     * @description 设定一个键值数据，键值不存在则插入一条新数据
+     *      @param name 指定要设定的键值
+     *      @param value 指定要设定的数据，只接受 String 和 Buffer
+     *      @param timeout 指定数据失效时间，单位是 ms，小于 0 时使用缓存的缺省失效时间，等于 0 不失效，缺省为 -1
+     *
+     */
+    set(name: string, value: any, timeout?: number): void;
+
+    /**
+     * @description 删除指定键值的数据
+     *      @param name 指定要删除的键值
+     *      @return 返回数据是否存在
+     *
+     */
+    remove(name: string): boolean;
+
+}
+
@@ -95,6 +95,25 @@ declare class Class_SslServer extends Class_TcpServer {
      */
     constructor(crt: Class_X509Cert, key: Class_PKey, addr: string, port: number, listener: Class_Handler);
 
+    /**
+     * @description SslServer 构造函数，使用配置对象创建服务器，opts 的选项与 TcpServer 相同，不支持 worker 模式
+     *     @param certs 服务器证书列表，格式同上
+     *     @param opts 指定服务器配置
+     *     @param listener 指定 ssl 接收到的连接的内置消息处理器，处理函数，链式处理数组，路由对象，详见 mq.Handler
+     *    
+     */
+    constructor(certs: any[], opts: FIBJS.GeneralObject, listener: Class_Handler);
+
+    /**
+     * @description SslServer 构造函数，使用配置对象创建服务器，opts 的选项与 TcpServer 相同，不支持 worker 模式
+     *     @param crt X509Cert 证书，用于客户端验证服务器
+     *     @param key PKey 私钥，用于与客户端会话
+     *     @param opts 指定服务器配置
+     *     @param listener 指定 ssl 接收到的连接的内置消息处理器，处理函数，链式处理数组，路由对象，详见 mq.Handler
+     *    
+     */
+    constructor(crt: Class_X509Cert, key: Class_PKey, opts: FIBJS.GeneralObject, listener: Class_Handler);
+
     /**
      * @description 设定证书验证模式，缺省为 VERIFY_NONE 
      */
@@ -56,6 +56,63 @@ declare class Class_TcpServer extends Class_object {
      */
     constructor(addr: string, listener: Class_Handler);
 
+    /**
+     * @description TcpServer 构造函数，使用配置对象创建服务器
+     * 
+     *     opts 支持的选项如下：
+     *     ```JavaScript
+     *     {
+     *         address: "", // 侦听地址，为 "" 则在本机所有地址侦听
+     *         port: 8080, // 侦听端口
+     *         reusePort: false, // 是否启用 SO_REUSEPORT，仅在 posix 平台有效
+     *         backlog: 1024 // 侦听队列长度
+     *     }
+     *     ```
+     * 
+     *     启用 reusePort 后，多个 Worker 可以在同一端口各自创建服务器，由系统内核在各个侦听 Socket 之间分配连接：
+     *     ```JavaScript
+     *     // server.js, run in each worker
+     *     const net = require("net");
+     *     new net.TcpServer({ port: 8080, reusePort: true }, onConnect).start();
+     *     ```
+     * 
+     *     @param opts 指定服务器配置
+     *     @param listener 指定 tcp 接收到的连接的内置消息处理器，处理函数，链式处理数组，路由对象，详见 mq.Handler
+     *    
+     */
+    constructor(opts: FIBJS.GeneralObject, listener: Class_Handler);
+
+    /**
+     * @description TcpServer 构造函数，以 worker 模式创建服务器
+     * 
+     *     worker 模式下，服务器会创建 workers 个独立的 Isolate，每个 Isolate 加载 worker 指定的模块，以其导出的处理器作为连接处理器，并各自以 SO_REUSEPORT 侦听同一端口，由系统内核在各个侦听 Socket 之间分配连接。
+     * 
+     *     opts 支持的选项如下：
+     *     ```JavaScript
+     *     {
+     *         worker: "/path/to/handler.js", // worker 模块的绝对路径，模块需导出处理器
+     *         workers: 4, // worker 数量，缺省为 cpu 数量
+     *         address: "", // 侦听地址，为 "" 则在本机所有地址侦听
+     *         port: 8080, // 侦听端口，worker 模式必须指定
+     *         backlog: 1024 // 每个 worker 的侦听队列长度
+     *     }
+     *     ```
+     * 
+     *     worker 模块示例：
+     *     ```JavaScript
+     *     // handler.js
+     *     module.exports = conn => {
+     *         conn.write(conn.read());
+     *     };
+     *     ```
+     * 
+     *     worker 模式的服务器不能修改 handler，需要更新处理逻辑时调用 reload。socket 属性在 worker 模式下不可用。
+     * 
+     *     @param opts 指定服务器配置
+     *    
+     */
+    constructor(opts: FIBJS.GeneralObject);
+
     /**
      * @description 启动当前服务器 
      */
@@ -68,6 +125,18 @@ declare class Class_TcpServer extends Class_object {
 
     stop(callback: (err: Error | undefined | null)=>any): void;
 
+    /**
+     * @description 重新加载 worker 模式服务器的处理器模块
+     * 
+     *     各个 worker 依次在新的沙箱中重新加载 worker 模块，并以新的处理器替换原处理器。重新加载期间侦听 Socket 保持打开，新连接由新的处理器处理，正在处理的连接继续使用原处理器直至结束。
+     * 
+     *     某个 worker 加载失败时，reload 停止并抛出该 worker 的错误，已重新加载的 worker 使用新的处理器，其余 worker 保持原处理器。只能在已启动的 worker 模式服务器上调用。
+     *      
+     */
+    reload(): void;
+
+    reload(callback: (err: Error | undefined | null)=>any): void;
+
     /**
      * @description 服务器当前侦听的 Socket 对象  
      */
@@ -78,5 +147,18 @@ declare class Class_TcpServer extends Class_object {
      */
     handler: Class_Handler;
 
+    /**
+     * @description 查询服务器连接统计
+     * 
+     *     返回的对象包含以下字段：
+     *     - accepted: 累计接受的连接数
+     *     - active: 当前正在处理的连接数
+     *     - listeners: 当前正在运行的侦听服务器数
+     * 
+     *     启用 reusePort 的服务器在同一地址和端口上共享统计，因此在任意一个 Worker 中查询均得到所有 Worker 的汇总数据。地址按规范形式比较，"" 与 "0.0.0.0" 视为同一地址。worker 模式的服务器返回其所有 worker 的汇总数据。
+     *      
+     */
+    readonly stats: FIBJS.GeneralObject;
+
 }
 
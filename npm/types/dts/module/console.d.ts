@@ -146,6 +146,18 @@ declare module 'console' {
      *      });
      *      ```
      * 
+     *      每个设备都有一个预分配的定长日志队列，队列同时受记录数和字节数限制，可通过以下选项控制队列满时的行为：
+     *      ```JavaScript
+     *      console.add({
+     *         type: "file",
+     *         path: "path/to/file_%s.log",
+     *         queue: 8192, // option, queue size in records, selectable from 16 to 1048576, default is 8192
+     *         queueBytes: 67108864, // option, total size of the queued records in bytes, at least 1024, default is 64M
+     *         overflow: "drop", // option, "drop" discards the oldest records, "block" waits for free space, "sample" keeps one record of every `sample` by evicting the oldest, default is "drop"
+     *         sample: 10 // option, sample rate used by "sample" policy, default is 10
+     *      });
+     *      ```
+     * 
      *      @param cfg 输出配置
      *      
      */
@@ -173,6 +185,22 @@ declare module 'console' {
      */
     function reset(): void;
 
+    /**
+     * @description 查询各个输出设备的日志队列状态
+     * 
+     *      返回数组中每一项对应一个输出设备，包含以下字段：
+     *      - type: 设备类型
+     *      - queued: 当前队列中等待输出的记录数
+     *      - size: 队列容量
+     *      - bytes: 当前队列中等待输出的记录的字节数
+     *      - dropped: 因队列已满被丢弃的记录数
+     *      - written: 已交给设备输出的记录数
+     * 
+     *      @return 返回各设备的队列状态
+     *      
+     */
+    function stats(): any[];
+
     /**
      * @description 记录普通日志信息，与 info 等同
      * 
@@ -395,6 +395,29 @@ declare module 'crypto' {
 
     function pbkdf2(password: Class_Buffer, salt: Class_Buffer, iterations: number, size: number, algoName: string, callback: (err: Error | undefined | null, retVal: Class_Buffer)=>any): void;
 
+    /**
+     * @description 批量验证多个签名
+     * 
+     *      items 中每一项为一个对象，包含以下属性：
+     *      ```JavaScript
+     *      {
+     *          key: pkey, // 验证使用的公钥
+     *          data: data, // 签名的数据
+     *          sign: sig, // 待验证的签名
+     *          opts: {} // 可选，与 PKey.verify 的 opts 相同
+     *      }
+     *      ```
+     * 
+     *      同一批次中的 BLS 签名使用随机系数合并为一次多对配对运算完成验证，批量验证失败时再逐一验证以确定失败的签名。其它算法的签名分散到工作线程池中并行验证。
+     * 
+     *      @param items 指定需要验证的签名数组
+     *      @return 返回与 items 一一对应的验证结果数组
+     *      
+     */
+    function verifyBatch(items: any[]): any[];
+
+    function verifyBatch(items: any[], callback: (err: Error | undefined | null, retVal: any[])=>any): void;
+
     /**
      * @description 获取 crypto 模块支持的的 hash(摘要) 算法, 比如 'md5', 'sha224'
      *      @return 返回 fibjs 支持的 hash 算法数组
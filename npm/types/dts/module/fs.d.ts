@@ -180,6 +180,27 @@ declare module 'fs' {
 
     function copyFile(from: string, to: string, mode?: number, callback?: (err: Error | undefined | null)=>any): void;
 
+    /**
+     * @description 将 from 拷贝到 to，可拷贝文件或者整个目录
+     * 
+     *      opts 支持的选项如下:
+     *      ```JavaScript
+     *      {
+     *         "recursive": false, // 是否递归拷贝目录，拷贝目录时必须指定为 true
+     *         "force": true // 目标文件已存在时是否覆盖
+     *      }
+     *      ```
+     *      文件拷贝会优先尝试写时拷贝（copy-on-write），目录内的文件由后台线程并行拷贝，符号链接会按原样重建。
+     * 
+     *      @param from 指定要拷贝的源文件或目录
+     *      @param to 指定要拷贝的目标文件或目录
+     *      @param opts 指定拷贝选项
+     *      
+     */
+    function cp(from: string, to: string, opts?: FIBJS.GeneralObject): void;
+
+    function cp(from: string, to: string, opts?: FIBJS.GeneralObject, callback?: (err: Error | undefined | null)=>any): void;
+
     /**
      * @description 设置指定文件的访问权限，Windows 不支持此方法
      *      @param path 指定操作的文件
@@ -362,9 +383,13 @@ declare module 'fs' {
      *      参数 opts 支持的选项如下：
      *      ```JavaScript
      *      {
-     *          "recursive": false // specify whether all subdirectories should be watched or only the current directory
+     *          "recursive": false, // specify whether all subdirectories should be watched or only the current directory
+     *          "stat": false, // return Stat objects instead of names, Stat.name holds the relative path
+     *          "filter": "*.js", // only return entries matching the glob, a string or an array of globs
+     *          "ignore": "node_modules" // skip entries matching the glob and do not descend into them
      *      }
      *      ```
+     *      recursive 时子目录由多个工作线程并行遍历，返回顺序与逐层遍历一致。glob 支持 `*`，`?`，`[...]` 与跨目录的 `**`，不含 `/` 的 glob 匹配文件名，含 `/` 的 glob 匹配相对路径。
      *      @param path 指定查询的目录
      *      @param opts 指定参数
      *      @return 返回目录的文件信息数组
@@ -480,6 +505,27 @@ declare module 'fs' {
 
     function readFile(fname: string, options: FIBJS.GeneralObject, callback: (err: Error | undefined | null, retVal: any)=>any): void;
 
+    /**
+     * @description 将文件映射到内存，返回以文件映射为存储的 Buffer，读取时不复制文件内容
+     * 
+     *      opts 支持的选项如下：
+     *      ```JavaScript
+     *      {
+     *          "offset": 0, // 映射的起始位置，缺省为 0
+     *          "length": -1, // 映射的字节数，缺省映射到文件末尾
+     *          "advice": "normal" // 访问方式提示，可选 "normal", "sequential", "random", "willneed"
+     *      }
+     *      ```
+     *      映射为写时复制方式，修改 Buffer 内容不会写回文件。映射在 Buffer 及其所有切片被回收后解除。
+     *      @param fname 指定文件名
+     *      @param opts 指定映射选项
+     *      @return 返回映射的 Buffer 对象
+     *      
+     */
+    function mmap(fname: string, opts?: FIBJS.GeneralObject): Class_Buffer;
+
+    function mmap(fname: string, opts?: FIBJS.GeneralObject, callback?: (err: Error | undefined | null, retVal: Class_Buffer)=>any): void;
+
     /**
      * @description 打开文件，以数组方式读取一组文本行，行结尾标识基于 EOL 属性的设置，缺省时，posix:"\n"；windows:"\r\n"
      *      @param fname 指定文件名
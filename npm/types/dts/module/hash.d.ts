@@ -141,6 +141,41 @@ declare module 'hash' {
      */
     function digest(algo: number, data?: Class_Buffer): Class_Digest;
 
+    /**
+     * @description 使用同一个摘要算法一次计算多个数据的摘要
+     * 
+     *      批量计算时只进入一次原生代码，并复用同一个运算上下文。在支持的 CPU 上，SHA1 和 SHA256 会使用 SHA 指令扩展，不支持 SHA 指令扩展但支持 AVX2 时，SHA256 会将长度相近的数据分为每组 8 个并行计算。
+     *      @param algo 指定摘要运算算法
+     *      @param data 指定需要计算摘要的二进制数据数组
+     *      @return 返回与 data 一一对应的摘要数组
+     *      
+     */
+    function hashMany(algo: number, data: any[]): any[];
+
+    /**
+     * @description 计算文件的摘要
+     * 
+     *      文件在工作线程中以大块读取并直接更新摘要，数据不会进入 JavaScript 堆。
+     *      @param path 指定文件路径
+     *      @param algo 指定摘要运算算法
+     *      @return 返回文件的摘要
+     *      
+     */
+    function file(path: string, algo: number): Class_Buffer;
+
+    function file(path: string, algo: number, callback: (err: Error | undefined | null, retVal: Class_Buffer)=>any): void;
+
+    /**
+     * @description 一次读取文件，同时计算多个算法的摘要
+     *      @param path 指定文件路径
+     *      @param algos 指定摘要运算算法数组
+     *      @return 返回与 algos 一一对应的摘要数组
+     *      
+     */
+    function fileMany(path: string, algos: any[]): any[];
+
+    function fileMany(path: string, algos: any[], callback: (err: Error | undefined | null, retVal: any[])=>any): void;
+
     /**
      * @description 创建一个 MD5 信息摘要运算对象
      *      @param data 创建同时更新的二进制数据，缺省为 null，不更新数据
@@ -116,6 +116,11 @@ declare module 'http' {
      */
     var enableEncoding: boolean;
 
+    /**
+     * @description HTTP/2 功能开关，默认关闭。开启后 https 请求通过 ALPN 协商 h2，同一 origin 的请求复用一个多路复用会话，不受 poolMaxActive 限制；服务器不支持时退回 HTTP/1.1 
+     */
+    var enableHttp2: boolean;
+
     /**
      * @description 查询和设置最大请求头个数，缺省为 128 
      */
@@ -137,7 +142,10 @@ declare module 'http' {
     var userAgent: string;
 
     /**
-     * @description 查询和设置 keep-alive 最大缓存连接数，缺省 128 
+     * @description 查询和设置每个目标地址 keep-alive 最大缓存连接数，缺省 128
+     * 
+     *     连接池按目标地址分别缓存空闲连接，超出上限时淘汰该地址最早缓存的连接，不影响其它目标地址。
+     *      
      */
     var poolSize: number;
 
@@ -146,6 +154,29 @@ declare module 'http' {
      */
     var poolTimeout: number;
 
+    /**
+     * @description 查询和设置每个目标地址同时使用的最大连接数，缺省为 0，不限制
+     * 
+     *     达到上限后，新的请求将按到达顺序排队，等待该目标地址有连接归还后再继续执行。等待时间超过 timeout 时请求将抛出超时错误，timeout 为 0 时一直等待。
+     *      
+     */
+    var poolMaxActive: number;
+
+    /**
+     * @description 查询连接池统计
+     * 
+     *     返回的对象包含以下字段：
+     *     - hits: 复用缓存连接的次数
+     *     - misses: 需要新建连接的次数
+     *     - evictions: 因超出 poolSize 或超时而淘汰的缓存连接数
+     *     - origins: 当前连接池中的目标地址数
+     *     - idle: 当前缓存的空闲连接数
+     *     - active: 当前正在使用的连接数
+     *     - waiting: 当前因 poolMaxActive 限制而等待的请求数
+     *      
+     */
+    const poolStats: FIBJS.GeneralObject;
+
     /**
      * @description 查询和设置 http 请求代理，支持 http/https/socks5 代理 
      */
@@ -159,8 +190,9 @@ declare module 'http' {
     /**
      * @description 创建一个 http 静态文件处理器，用以用静态文件响应 http 消息
      * 
-     *      fileHandler 支持 gzip 预压缩，当请求接受 gzip 编码，且相同路径下 filename.ext.gz 文件存在时，将直接返回此文件，
-     *      从而避免重复压缩带来服务器负载。
+     *      fileHandler 支持 brotli 和 gzip 预压缩，当请求接受 br 或 gzip 编码，且相同路径下 filename.ext.br 或 filename.ext.gz 文件存在时，
+     *      将直接返回此文件，从而避免重复压缩带来服务器负载。br 与 gzip 同时可用时优先返回 br。
+     *      不存在的预压缩文件会被记录 5 秒，期间不再尝试打开，原文件修改后立即重新检查。文件响应均带有 Vary: Accept-Encoding。
      *      @param root 文件根路径
      *      @param mimes 扩展 mime 设置
      *      @param autoIndex 是否支持浏览目录文件，缺省为 false，不支持
@@ -1,5 +1,6 @@
 /// <reference path="../_import/_fibjs.d.ts" />
 /// <reference path="../interface/LruCache.d.ts" />
+/// <reference path="../interface/SharedCache.d.ts" />
 /// <reference path="../interface/TextDecoder.d.ts" />
 /// <reference path="../interface/TextEncoder.d.ts" />
 /// <reference path="../module/types.d.ts" />
@@ -64,6 +65,11 @@ declare module 'util' {
      */
     const LruCache: typeof Class_LruCache;
 
+    /**
+     * @description 跨 Worker 共享的 LRU 缓存对象，参见 SharedCache 对象。
+     */
+    const SharedCache: typeof Class_SharedCache;
+
     /**
      * @description TextDecoder 解码对象，参见 TextDecoder 对象。
      */
@@ -646,6 +646,23 @@ describe('Buffer', () => {
         assert.equal(buf.equals(new Buffer([1, 0, 2])), false);
     });
 
+    it('equals & compare in optimized code', () => {
+        var a = new Buffer("abcd");
+        var b = new Buffer("abce");
+        var c = new Buffer("abcd");
+        var s = 0;
+
+        for (var i = 0; i < 100000; i++) {
+            s += Buffer.compare(a, b) < 0 ? 1 : 0;
+            s += a.equals(c) ? 1 : 0;
+            s += a.compare(new Uint8Array([0x61])) > 0 ? 1 : 0;
+        }
+
+        assert.equal(s, 300000);
+        assert.equal(Buffer.compare(a, "abcd"), 0);
+        assert.throws(() => Buffer.compare(a, 100));
+    });
+
     it('copy', () => {
         var buf1 = new Buffer([0x31, 0x32, 0x33]);
         var arr = [0x34, 0x35, 0x36];
@@ -1081,6 +1098,22 @@ describe('Buffer', () => {
 
     });
 
+    it('indexOf in optimized code', () => {
+        var buf = new Buffer("cacdbfcde");
+        var s = 0;
+
+        for (var i = 0; i < 100000; i++) {
+            s += buf.indexOf(new Uint8Array([0x63, 0x64])) === 2 ? 1 : 0;
+            s += buf.indexOf("cd", 3) === 6 ? 1 : 0;
+            s += buf.indexOf(0x65) === 8 ? 1 : 0;
+        }
+
+        assert.equal(s, 300000);
+        assert.equal(buf.indexOf("cd", 9), -1);
+        assert.throws(() => buf.indexOf("cd", -1));
+        assert.throws(() => buf.indexOf("cd", 10));
+    });
+
     var fixtures = [{
         "a": "ffff00",
         "expected": "00ffff"
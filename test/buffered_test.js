@@ -77,6 +77,50 @@ describe("buffered stream", () => {
         }
     });
 
+    it("readUntil across chunks", () => {
+        var ss1 = new net.Socket();
+        ss1.bind(8183 + base_port);
+        ss1.listen();
+
+        coroutine.start(() => {
+            var c = ss1.accept();
+            ["ab\r", "\ncd", "ef\r", "\n\r", "\ngh"].forEach(s => {
+                c.write(s);
+                coroutine.sleep(10);
+            });
+            c.close();
+        });
+
+        var conn = new net.Socket();
+        conn.connect('127.0.0.1', 8183 + base_port);
+
+        var r = new io.BufferedStream(conn);
+        r.EOL = '\r\n';
+
+        assert.equal(r.readLine(), "ab");
+        assert.equal(r.readLine(), "cdef");
+        assert.equal(r.readLine(), "");
+        assert.equal(r.readLine(), "gh");
+        assert.isNull(r.readLine());
+
+        conn.close();
+        ss1.close();
+    });
+
+    it("read after readLine", () => {
+        f = fs.openFile(path.join(__dirname, "test0000" + base_port));
+        var r = new io.BufferedStream(f);
+        r.EOL = '\r\n';
+
+        assert.equal(r.readLine(), '0123456789');
+        assert.equal(r.read(4).toString(), '0123');
+
+        var d = r.read();
+        assert.equal(d.toString(), s.substring(16, 16 + d.length));
+
+        f.close();
+    });
+
     it("readline", () => {
         f = fs.openFile(path.join(__dirname, "test0000" + base_port));
         var r = new io.BufferedStream(f);
@@ -507,6 +507,29 @@ describe("child_process", () => {
         }).stdout, null);
     });
 
+    it("buffer pool", () => {
+        var opt = json.decode(child_process.execFile(cmd, [
+            "--buffer-pool-size=8192",
+            path.join(__dirname, "process", "exec29.js")
+        ]).stdout);
+
+        assert.equal(opt.pooled, 100);
+        assert.isTrue(opt.intact);
+        assert.equal(opt.socketPooled, 100);
+        assert.isTrue(opt.socketIntact);
+        assert.isTrue(opt.large);
+        assert.equal(opt.str, "ab");
+
+        opt = json.decode(child_process.execFile(cmd, [
+            path.join(__dirname, "process", "exec29.js")
+        ]).stdout);
+
+        assert.equal(opt.pooled, 0);
+        assert.isTrue(opt.intact);
+        assert.equal(opt.socketPooled, 0);
+        assert.isTrue(opt.socketIntact);
+    });
+
     it("execArgv", () => {
         assert.deepEqual(json.decode(child_process.execFile(cmd, [
             "--use_strict",
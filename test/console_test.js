@@ -2,6 +2,9 @@ var test = require("test");
 test.setup();
 
 var os = require('os');
+var fs = require('fs');
+var path = require('path');
+var coroutine = require('coroutine');
 
 describe("console", () => {
     it("add", () => {
@@ -190,6 +193,150 @@ describe("console", () => {
         console.reset();
     });
 
+    it("logger queue", () => {
+        console.add({
+            type: "console",
+            queue: 16,
+            overflow: "sample",
+            sample: 4
+        });
+
+        assert.throws(() => {
+            console.add({
+                type: "console",
+                queue: 8
+            });
+        });
+
+        assert.throws(() => {
+            console.add({
+                type: "console",
+                overflow: "unknown"
+            });
+        });
+
+        assert.throws(() => {
+            console.add({
+                type: "console",
+                overflow: "sample",
+                sample: 0
+            });
+        });
+
+        var stats = console.stats();
+        assert.equal(stats.length, 1);
+        assert.equal(stats[0].type, "console");
+        assert.equal(stats[0].size, 16);
+        assert.equal(stats[0].dropped, 0);
+
+        console.reset();
+
+        stats = console.stats();
+        assert.equal(stats.length, 1);
+        assert.equal(stats[0].size, 8192);
+    });
+
+    describe("logger overflow", () => {
+        var name = 'fibjs_log_queue_' + process.pid;
+        var logPath = path.join(os.tmpdir(), name);
+
+        function flood(opts, n, msg) {
+            opts.type = "file";
+            opts.path = logPath;
+            console.add(opts);
+
+            var queueBytes = opts.queueBytes || 64 * 1024 * 1024;
+            var s;
+
+            for (var i = 0; i < n; i++) {
+                console.log(msg);
+                if (i % 64 == 0) {
+                    s = console.stats()[0];
+                    assert.notGreaterThan(s.queued, opts.queue || 8192);
+                    assert.notGreaterThan(s.bytes, queueBytes);
+                }
+            }
+
+            for (var i = 0; i < 1000; i++) {
+                s = console.stats()[0];
+                if (s.written + s.dropped == n)
+                    break;
+                coroutine.sleep(10);
+            }
+
+            console.reset();
+            return s;
+        }
+
+        after(() => {
+            coroutine.sleep(100);
+            fs.readdir(os.tmpdir()).forEach(f => {
+                if (f.startsWith(name))
+                    try {
+                        fs.unlink(path.join(os.tmpdir(), f));
+                    } catch (e) { }
+            });
+        });
+
+        it("drop", () => {
+            var s = flood({
+                queue: 16,
+                overflow: "drop"
+            }, 5000, 'drop test message');
+            assert.equal(s.written + s.dropped, 5000);
+            assert.equal(s.queued, 0);
+            assert.equal(s.bytes, 0);
+        });
+
+        it("sample", () => {
+            var s = flood({
+                queue: 16,
+                overflow: "sample",
+                sample: 4
+            }, 5000, 'sample test message');
+            assert.equal(s.written + s.dropped, 5000);
+            assert.equal(s.queued, 0);
+            assert.equal(s.bytes, 0);
+        });
+
+        it("block", () => {
+            var s = flood({
+                queue: 16,
+                overflow: "block"
+            }, 5000, 'block test message');
+            assert.equal(s.written, 5000);
+            assert.equal(s.dropped, 0);
+            assert.equal(s.bytes, 0);
+        });
+
+        it("bounded by bytes", () => {
+            var msg = 'x'.repeat(400);
+
+            var s = flood({
+                queue: 1024,
+                queueBytes: 1024
+            }, 2000, msg);
+            assert.equal(s.written + s.dropped, 2000);
+            assert.equal(s.bytes, 0);
+
+            ["drop", "sample", "block"].forEach(overflow => {
+                var s = flood({
+                    queueBytes: 1024,
+                    overflow: overflow
+                }, 10, 'x'.repeat(2000));
+                assert.equal(s.written, 0);
+                assert.equal(s.dropped, 10);
+            });
+
+            assert.throws(() => {
+                console.add({
+                    type: "console",
+                    queueBytes: 100
+                });
+            });
+        });
+    });
+
     it("fix: eval scriptname crash", () => {
         eval('console.log("Rock Lee")');
     })
@@ -1833,6 +1833,47 @@ MCowBQYDK2VwAyEA11qYAYKxCrfVS/7TyWQHOg7hcvPapiMlrwIaaPcHURo=
         });
     });
 
+    it("verifyBatch", () => {
+        var keys = [
+            crypto.generateKey('secp256k1'),
+            crypto.generateKey('ed25519'),
+            crypto.generateKey('Bls12381G1'),
+            crypto.generateKey('Bls12381G2')
+        ];
+
+        var items = [];
+        for (var i = 0; i < 40; i++) {
+            var key = keys[i % keys.length];
+            var data = crypto.randomBytes(32);
+            items.push({
+                key: key.publicKey,
+                data: data,
+                sign: key.sign(data)
+            });
+        }
+
+        assert.deepEqual(crypto.verifyBatch(items), items.map(() => true));
+
+        items[5].data = crypto.randomBytes(32);
+        items[10].data = crypto.randomBytes(32);
+        items[11].sign = items[15].sign;
+
+        var r = crypto.verifyBatch(items);
+        assert.equal(r.length, items.length);
+        r.forEach((v, i) => assert.equal(v, i != 5 && i != 10 && i != 11, `item ${i}`));
+
+        var data = crypto.randomBytes(32);
+        assert.deepEqual(crypto.verifyBatch([{
+            key: keys[0],
+            data: data,
+            sign: keys[0].sign(data, { format: 'raw' }),
+            opts: { format: 'raw' }
+        }]), [true]);
+
+        assert.deepEqual(crypto.verifyBatch([]), []);
+        assert.throws(() => crypto.verifyBatch([{ key: keys[0] }]));
+    });
+
     it("getHashes", () => {
         var hashes = crypto.getHashes();
         assert.isArray(hashes);
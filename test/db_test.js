@@ -29,7 +29,7 @@ var sql_server = {
 describe("db", () => {
     function _test(type, conn_str) {
         var conn;
-        var tables = ['test', 'test_null', 'test2', 'test3', 'test4'];
+        var tables = ['test', 'test_null', 'test2', 'test3', 'test4', 'test_cursor', 'test_columns'];
 
         var initDb = () => {
             switch (type) {
@@ -1312,6 +1312,62 @@ describe("db", () => {
             assert.equal(a, 1);
         });
 
+        it("cursor", () => {
+            conn.execute('create table test_cursor (id integer)');
+            for (var i = 0; i < 25; i++)
+                conn.execute('insert into test_cursor values(?)', i);
+
+            var cur = conn.cursor('select id from test_cursor where id >= ? order by id', 5);
+            var ids = [];
+            var rs;
+            while ((rs = cur.next(8)).length) {
+                assert.ok(rs.length <= 8);
+                rs.forEach(r => ids.push(r.id));
+            }
+            assert.equal(ids.length, 20);
+            assert.equal(ids[0], 5);
+            assert.equal(ids[19], 24);
+            assert.equal(cur.next().length, 0);
+            cur.close();
+
+            cur = conn.cursor('select id from test_cursor order by id');
+            assert.equal(cur.next(3).length, 3);
+            cur.close();
+
+            assert.equal(conn.execute('select count(*) as c from test_cursor')[0].c, 25);
+            assert.throws(() => conn.cursor('select * from test_cursor_not_exists'));
+        });
+
+        it("executeColumns", () => {
+            conn.execute('create table test_columns (id integer, v float, t varchar(32))');
+            conn.execute('insert into test_columns values(?, ?, ?)', 1, 1.5, 'a');
+            conn.execute('insert into test_columns values(?, ?, ?)', 2, 2.25, 'b');
+            conn.execute('insert into test_columns values(?, ?, ?)', 3, null, 'a');
+            conn.execute('insert into test_columns values(?, ?, ?)', 4, 4.5, null);
+
+            var rs = conn.executeColumns('select id, v, t from test_columns where id > ? order by id', 0);
+            assert.equal(rs.rows, 4);
+            assert.deepEqual(rs.fields, ['id', 'v', 't']);
+
+            assert.ok(rs.columns.id instanceof Int32Array);
+            assert.deepEqual(Array.from(rs.columns.id), [1, 2, 3, 4]);
+
+            assert.ok(rs.columns.v instanceof Float64Array);
+            assert.deepEqual(Array.from(rs.columns.v), [1.5, 2.25, 0, 4.5]);
+            assert.deepEqual(Array.from(rs.nulls.v), [4]);
+
+            assert.deepEqual(rs.columns.t.dictionary, ['a', 'b']);
+            assert.ok(rs.columns.t.indices instanceof Int32Array);
+            assert.deepEqual(Array.from(rs.columns.t.indices), [0, 1, 0, -1]);
+            assert.deepEqual(Array.from(rs.nulls.t), [8]);
+
+            assert.equal(rs.nulls.id, undefined);
+
+            rs = conn.executeColumns('select id from test_columns where id > 100');
+            assert.equal(rs.rows, 0);
+            assert.equal(rs.columns.id.length, 0);
+        });
+
         switch (type) {
             case 'mssql':
             case 'mysql':
@@ -1369,6 +1425,173 @@ describe("db", () => {
             conn.close();
             conn1.close();
         });
+
+        it("statement cache follows schema change", () => {
+            var conn = db.open(conn_str);
+
+            conn.execute("create table test_stmt (a integer)");
+            conn.execute("insert into test_stmt values (1)");
+            assert.deepEqual(Object.keys(conn.execute("select * from test_stmt")[0]), ["a"]);
+
+            conn.execute("alter table test_stmt add column b integer");
+            assert.deepEqual(Object.keys(conn.execute("select * from test_stmt")[0]), ["a", "b"]);
+
+            conn.execute("drop table test_stmt");
+            conn.close();
+        });
+
+        describe("Pool", () => {
+            it("execute", () => {
+                var pool = new db.Pool(conn_str, {
+                    min: 2,
+                    max: 4
+                });
+
+                assert.equal(pool.size, 2);
+                assert.equal(pool.execute("select ? as v", 100)[0].v, 100);
+                assert.equal(pool.size, 2);
+
+                var st = pool.stats;
+                assert.equal(st.idle, 2);
+                assert.equal(st.active, 0);
+                assert.equal(st.acquires, 1);
+
+                pool.close();
+                assert.equal(pool.size, 0);
+            });
+
+            it("concurrent", () => {
+                var pool = new db.Pool(conn_str, {
+                    max: 3
+                });
+                var max = 0;
+                var active = 0;
+
+                coroutine.parallel([0, 1, 2, 3, 4, 5, 6, 7, 8, 9], () => {
+                    pool.run(conn => {
+                        active++;
+                        if (active > max)
+                            max = active;
+                        coroutine.sleep(10);
+                        active--;
+                    });
+                });
+
+                assert.equal(max, 3);
+                assert.equal(pool.size, 3);
+                assert.equal(pool.stats.acquires, 10);
+                assert.greaterThan(pool.stats.waitTime, 0);
+
+                pool.close();
+            });
+
+            it("timeout", () => {
+                var pool = new db.Pool(conn_str, {
+                    max: 1,
+                    timeout: 50
+                });
+
+                var conn = pool.acquire();
+                assert.throws(() => {
+                    pool.acquire();
+                });
+                assert.equal(pool.stats.timeouts, 1);
+
+                pool.release(conn);
+                pool.release(pool.acquire());
+
+                assert.throws(() => {
+                    pool.release(conn);
+                });
+
+                pool.close();
+            });
+
+            it("recycle broken connection", () => {
+                var pool = new db.Pool(conn_str, {
+                    max: 1
+                });
+
+                assert.throws(() => {
+                    pool.run(conn => {
+                        conn.close();
+                        throw new Error("closed");
+                    });
+                });
+
+                assert.equal(pool.size, 0);
+                assert.equal(pool.stats.errors, 1);
+
+                assert.throws(() => {
+                    pool.execute("select * from not_exists_table");
+                });
+                assert.equal(pool.size, 1);
+
+                assert.equal(pool.execute("select 1 as v")[0].v, 1);
+
+                pool.close();
+            });
+
+            it("close wakes every waiter", () => {
+                var pool = new db.Pool(conn_str, {
+                    max: 1,
+                    timeout: 10000
+                });
+
+                var conn = pool.acquire();
+                var errors = [];
+                var fibers = [1, 2, 3].map(() => coroutine.start(() => {
+                    try {
+                        pool.acquire();
+                    } catch (e) {
+                        errors.push(e.message);
+                    }
+                }));
+
+                coroutine.sleep(10);
+                assert.equal(pool.stats.waiting, 3);
+
+                pool.close();
+                fibers.forEach(f => f.join());
+
+                assert.deepEqual(errors, [
+                    "Pool: pool is closed.",
+                    "Pool: pool is closed.",
+                    "Pool: pool is closed."
+                ]);
+                assert.equal(pool.stats.timeouts, 0);
+
+                pool.release(conn);
+                assert.equal(pool.size, 0);
+            });
+
+            it("reap idle connections", () => {
+                var pool = new db.Pool(conn_str, {
+                    max: 3,
+                    idle: 10
+                });
+
+                coroutine.parallel([0, 1, 2], () => {
+                    pool.run(conn => coroutine.sleep(10));
+                });
+                assert.equal(pool.size, 3);
+
+                for (var i = 0; i < 30 && pool.size > 0; i++)
+                    coroutine.sleep(100);
+
+                assert.equal(pool.size, 0);
+                assert.equal(pool.stats.idle, 0);
+
+                pool.close();
+            });
+
+            it("run returns value", () => {
+                var pool = new db.Pool(conn_str);
+
+                assert.equal(pool.run(conn => conn.execute("select 2 as v")[0].v), 2);
+                pool.close();
+            });
+        });
     });
 
     // if (global.full_test)
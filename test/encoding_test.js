@@ -208,6 +208,37 @@ describe('encoding', () => {
         }
     });
 
+    it('long data', () => {
+        for (var sz = 0; sz < 300; sz += 7) {
+            var data = Buffer.alloc(sz);
+            for (var i = 0; i < sz; i++)
+                data[i] = (i * 131 + sz) & 0xff;
+
+            var hexStr = '';
+            for (var i = 0; i < sz; i++)
+                hexStr += (data[i] < 16 ? '0' : '') + data[i].toString(16);
+
+            assert.equal(hex.encode(data), hexStr);
+            assert.deepEqual(hex.decode(hexStr), data);
+            assert.deepEqual(hex.decode(hexStr.toUpperCase()), data);
+            assert.deepEqual(hex.decode(hexStr.replace(/(.{40})/g, '$1\n')), data);
+            assert.deepEqual(hex.decode(' ' + hexStr), data);
+            assert.deepEqual(Buffer.from(hexStr, 'hex'), data);
+
+            var b64 = base64.encode(data);
+            assert.equal(b64, data.toString('base64'));
+            assert.deepEqual(base64.decode(b64), data);
+            assert.deepEqual(base64.decode(b64.replace(/(.{76})/g, '$1\r\n')), data);
+            assert.deepEqual(base64.decode('\n' + b64), data);
+            assert.deepEqual(Buffer.from(b64, 'base64'), data);
+
+            var b64url = base64.encode(data, true);
+            assert.equal(b64url, b64.replace(/\+/g, '-').replace(/\//g, '_').replace(/=/g, ''));
+            assert.deepEqual(base64.decode(b64url), data);
+            assert.deepEqual(Buffer.from(b64url, 'base64url'), data);
+        }
+    });
+
     describe('multibase', () => {
         const encoded = [
             {
@@ -467,6 +498,26 @@ describe('encoding', () => {
                 assert.equal(iconv.decode(d.name, buf), d.text);
             }
         });
+
+        it("utf8 strings", () => {
+            const texts = [
+                'hello world, ascii only',
+                'café ñandú ÿ ©',
+                '中文测试，汉字与标点。',
+                'mix 中文 and ascii, ü and 😀 emoji'
+            ];
+
+            texts.forEach(t => {
+                [1, 7, 100, 1000].forEach(n => {
+                    var s = t.repeat(n);
+                    var buf = iconv.encode('utf8', s);
+
+                    assert.equal(buf.hex(), Buffer.from(s).hex());
+                    assert.equal(iconv.decode('utf8', buf), s);
+                    assert.equal(iconv.decode('utf8', buf.slice(1)), Buffer.from(s).slice(1).toString());
+                });
+            });
+        });
     });
 
     it('uri', () => {
@@ -379,6 +379,66 @@ describe('fs', () => {
         f.close();
     });
 
+    it("mmap", () => {
+        var fname = path.join(__dirname, "fs_test.js");
+        var d = fs.readFile(fname);
+
+        var b = fs.mmap(fname);
+        assert.deepEqual(b, d);
+
+        b = fs.mmap(fname, {
+            offset: 5000,
+            length: 100,
+            advice: "random"
+        });
+        assert.deepEqual(b, d.slice(5000, 5100));
+
+        b = fs.mmap(fname, {
+            offset: d.length - 10,
+            advice: "sequential"
+        });
+        assert.deepEqual(b, d.slice(d.length - 10));
+
+        assert.equal(fs.mmap(fname, {
+            offset: d.length
+        }).length, 0);
+
+        b = fs.mmap(fname, {
+            advice: "willneed"
+        });
+        b[0] = 0;
+        assert.deepEqual(fs.readFile(fname), d);
+
+        var zname = path.join(__dirname, 'mmap_test.zip' + vmid);
+        var zipfile = zip.open(zname, "w");
+        zipfile.write(new Buffer('test mmap'), 'test.txt');
+        zipfile.close();
+
+        zipfile = zip.open(fs.mmap(zname));
+        assert.equal(zipfile.read('test.txt').toString(), 'test mmap');
+        zipfile.close();
+
+        // windows keeps a mapped file until the mapping is collected
+        if (!win)
+            fs.unlink(zname);
+
+        assert.throws(() => {
+            fs.mmap(fname, {
+                offset: d.length + 1
+            });
+        });
+
+        assert.throws(() => {
+            fs.mmap(fname, {
+                advice: "unknown"
+            });
+        });
+
+        assert.throws(() => {
+            fs.mmap(fname + ".not_exists");
+        });
+    });
+
     it("readTextFile", () => {
         var f = fs.openFile(path.join(__dirname, 'fs_test.js'));
 
@@ -422,6 +482,57 @@ describe('fs', () => {
         f.close();
     });
 
+    it("cp", () => {
+        var src = path.join(__dirname, 'cp_src' + vmid);
+        var dst = path.join(__dirname, 'cp_dst' + vmid);
+
+        fs.cp(path.join(__dirname, 'fs_test.js'), dst);
+        assert.equal(fs.readTextFile(dst), fs.readTextFile(path.join(__dirname, 'fs_test.js')));
+
+        fs.writeFile(dst, "old");
+        assert.throws(() => {
+            fs.cp(path.join(__dirname, 'fs_test.js'), dst, {
+                force: false
+            });
+        });
+        assert.equal(fs.readTextFile(dst), "old");
+        fs.unlink(dst);
+
+        fs.mkdir(src);
+        for (var i = 0; i < 4; i++) {
+            fs.mkdir(path.join(src, "d" + i));
+            for (var j = 0; j < 16; j++)
+                fs.writeFile(path.join(src, "d" + i, "f" + j), "data " + i + "-" + j);
+        }
+
+        assert.throws(() => {
+            fs.cp(src, dst);
+        });
+
+        fs.cp(src, dst, {
+            recursive: true
+        });
+
+        assert.deepEqual(fs.readdir(dst, {
+            recursive: true
+        }), fs.readdir(src, {
+            recursive: true
+        }));
+
+        for (var i = 0; i < 4; i++)
+            for (var j = 0; j < 16; j++)
+                assert.equal(fs.readTextFile(path.join(dst, "d" + i, "f" + j)), "data " + i + "-" + j);
+
+        [src, dst].forEach(dir => {
+            for (var i = 0; i < 4; i++) {
+                for (var j = 0; j < 16; j++)
+                    fs.unlink(path.join(dir, "d" + i, "f" + j));
+                fs.rmdir(path.join(dir, "d" + i));
+            }
+            fs.rmdir(dir);
+        });
+    });
+
     it("seek 64 bits", () => {
         var f = fs.openFile(path.join(__dirname, 'fs_test.js'));
         f.seek(f.size() + 8589934592n, fs.SEEK_SET);
@@ -442,6 +553,9 @@ describe('fs', () => {
         f.close();
         f1.close();
 
+        assert.equal(fs.readTextFile(path.join(__dirname, 'fs_test.js.bak' + vmid)),
+            fs.readTextFile(path.join(__dirname, 'fs_test.js')));
+
         fs.unlink(path.join(__dirname, 'fs_test.js.bak' + vmid));
     });
 
@@ -880,6 +994,74 @@ describe('fs', () => {
             assert.deepEqual(fl, ["dir1", "file1", "file2", "dir1/file3"]);
     });
 
+    it("readdir with stat & glob", () => {
+        var dir = path.join(__dirname, 'dir_test');
+        var file3 = path.join("dir1", "file3");
+
+        var fl = fs.readdir(dir, {
+            recursive: true,
+            stat: true
+        });
+        assert.deepEqual(fl.map(st => st.name), ["dir1", "file1", "file2", file3]);
+        assert.isTrue(fl[0].isDirectory());
+        assert.isTrue(fl[3].isFile());
+        assert.equal(fl[3].size, fs.stat(path.join(dir, file3)).size);
+
+        fl = fs.readdir(dir, {
+            recursive: true,
+            filter: "file[13]"
+        });
+        assert.deepEqual(fl, ["file1", file3]);
+
+        fl = fs.readdir(dir, {
+            recursive: true,
+            filter: ["**/file3", "file2"]
+        });
+        assert.deepEqual(fl, ["file2", file3]);
+
+        fl = fs.readdir(dir, {
+            recursive: true,
+            ignore: "dir?"
+        });
+        assert.deepEqual(fl, ["file1", "file2"]);
+
+        fl = fs.readdir(dir, {
+            ignore: "*1"
+        });
+        assert.deepEqual(fl, ["file2"]);
+
+        var tree = path.join(__dirname, 'readdir_test' + vmid);
+        var expected = [];
+        fs.mkdir(tree);
+        for (var i = 0; i < 8; i++) {
+            var sub = path.join(tree, "d" + i);
+            fs.mkdir(sub);
+            expected.push("d" + i);
+            for (var j = 0; j < 8; j++)
+                fs.writeFile(path.join(sub, "f" + j), "");
+        }
+        for (var i = 0; i < 8; i++)
+            for (var j = 0; j < 8; j++)
+                expected.push(path.join("d" + i, "f" + j));
+
+        assert.deepEqual(fs.readdir(tree, {
+            recursive: true
+        }), expected);
+
+        for (var i = 0; i < 8; i++) {
+            for (var j = 0; j < 8; j++)
+                fs.unlink(path.join(tree, "d" + i, "f" + j));
+            fs.rmdir(path.join(tree, "d" + i));
+        }
+        fs.rmdir(tree);
+
+        assert.throws(() => {
+            fs.readdir(dir, {
+                filter: 100
+            });
+        });
+    });
+
     it("writeFile & appendFile", () => {
         var fn = path.join(__dirname, 'fs_test.js' + vmid);
 
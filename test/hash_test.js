@@ -645,6 +645,53 @@ describe("hash", () => {
         digest_case.forEach(hash_test);
     });
 
+    it("hashMany", () => {
+        var data = [];
+        for (var i = 0; i < 300; i++)
+            data.push(crypto.randomBytes(i));
+        for (var i = 0; i < 20; i++)
+            data.push(crypto.randomBytes(100));
+
+        ['MD5', 'SHA1', 'SHA256', 'SHA512', 'SHA3_256', 'BLAKE2B'].forEach(name => {
+            var r = hash.hashMany(hash[name], data);
+            assert.equal(r.length, data.length);
+            r.forEach((d, i) => assert.equal(d.hex(), hash.digest(hash[name], data[i]).digest().hex(), `${name} ${i}`));
+        });
+
+        assert.deepEqual(hash.hashMany(hash.SHA256, []), []);
+        assert.throws(() => hash.hashMany(1000, data));
+    });
+
+    it("file", () => {
+        var fs = require('fs');
+        var path = require('path');
+        var fname = path.join(__dirname, 'hash_file_' + require('coroutine').vmid);
+        var data = crypto.randomBytes(3 * 1024 * 1024 + 17);
+
+        fs.writeFile(fname, data);
+        try {
+            ['MD5', 'SHA1', 'SHA256', 'SHA512', 'SHA3_256', 'BLAKE2B'].forEach(name => {
+                assert.equal(hash.file(fname, hash[name]).hex(), hash.digest(hash[name], data).digest().hex());
+
+                var f = fs.openFile(fname);
+                assert.equal(hash.digest(hash[name]).updateFromStream(f).digest().hex(),
+                    hash.digest(hash[name], data).digest().hex());
+                f.close();
+            });
+
+            var r = hash.fileMany(fname, [hash.MD5, hash.SHA256]);
+            assert.equal(r.length, 2);
+            assert.equal(r[0].hex(), hash.md5(data).digest().hex());
+            assert.equal(r[1].hex(), hash.sha256(data).digest().hex());
+
+            assert.throws(() => hash.file(fname, 1000));
+            assert.throws(() => hash.fileMany(fname, [hash.MD5, 1000]));
+            assert.throws(() => hash.file(fname + '_none', hash.MD5));
+        } finally {
+            fs.unlink(fname);
+        }
+    });
+
     it("md5_hmac", () => {
         var hmac_case = [{
             name: 'MD5',
@@ -8,7 +8,9 @@ var os = require('os');
 var fs = require('fs');
 var http = require('http');
 var net = require('net');
+var ws = require('ws');
 var zip = require('zip');
+var zlib = require('zlib');
 var coroutine = require("coroutine");
 var path = require("path");
 
@@ -604,6 +606,46 @@ describe("http", () => {
             }
         });
 
+        it("raw headers", () => {
+            var req = get_request("GET / HTTP/1.1\r\nHost: fibjs.org\r\nAccept: */*\nX-Test:  a b \r\nx-test: c\r\n\r\n");
+
+            assert.equal(req.firstHeader('host'), 'fibjs.org');
+            assert.isTrue(req.hasHeader('ACCEPT'));
+            assert.equal(req.headers['x-test'][0], 'a b ');
+            assert.deepEqual(req.allHeader('X-TEST'), ['a b ', 'c']);
+
+            req.addHeader('x-add', '1');
+            assert.deepEqual(req.headers.keys(), ['Host', 'Accept', 'X-Test', 'x-test', 'x-add']);
+
+            var req = get_request("GET / HTTP/1.1\r\nHost: fibjs.org\r\n\r\n", req);
+            assert.deepEqual(req.headers.keys(), ['Host']);
+
+            assert.throws(() => {
+                get_request("GET / HTTP/1.1\r\nbad name: 1\r\n\r\n");
+            });
+
+            assert.throws(() => {
+                get_request("GET / HTTP/1.1\r\nx-long: " + "a".repeat(8192) + "\r\n\r\n");
+            });
+
+            assert.throws(() => {
+                get_request("GET / HTTP/1.1\r\nHost: fibjs.org\r\n");
+            });
+
+            assert.throws(() => {
+                get_request("GET / HTTP/1.1\r\nHost: fibjs.org");
+            });
+        });
+
+        it("delete raw header", () => {
+            var req = get_request("GET / HTTP/1.1\r\nHost: fibjs.org\r\nX-Test: a\r\n\r\n");
+
+            delete req.headers['x-test'];
+            assert.isFalse(req.hasHeader('x-test'));
+            assert.equal(req.firstHeader('host'), 'fibjs.org');
+            assert.deepEqual(req.headers.keys(), ['Host']);
+        });
+
         it("request cookie", () => {
             function get_cookie(txt) {
                 return get_request(txt).cookies.toJSON();
@@ -751,6 +793,47 @@ describe("http", () => {
 
             var c = get_form('GET /test HTTP/1.0\r\nContent-type:multipart/form-data;boundary=7d33a816d302b6\r\nContent-length:82\r\n\r\n--7d33a816d302b6\r\nContent-Disposition: form-data; name="pid"\r\n\r\n--7d33a816d302b6\r\n');
             assert.equal(c['pid'], '');
+
+            var data = '0123456789abcdef'.repeat(100000);
+            var body = '--7d33a816d302b6\r\nContent-Disposition: form-data;name="a"\r\n\r\n100\r\n--7d33a816d302b6\r\nContent-Disposition: form-data;name="b";filename="test"\r\n\r\n' + data + '\r\n--7d33a816d302b6--\r\n';
+            var c = get_form('GET /test HTTP/1.0\r\nContent-type:multipart/form-data;boundary=7d33a816d302b6\r\nContent-length:' + body.length + '\r\n\r\n' + body);
+            assert.equal(c['a'], '100');
+            assert.equal(c['b'].fileName, 'test');
+            assert.equal(c['b'].body.size(), data.length);
+            assert.equal(c['b'].body.readAll().toString(), data);
+
+            var r = get_request('GET /test HTTP/1.0\r\nContent-type:multipart/form-data;boundary=7d33a816d302b6\r\nContent-length:' + body.length + '\r\n\r\n' + body);
+            assert.equal(r.body.size(), body.length);
+            assert.equal(r.form['b'].body.size(), data.length);
+            r.body.rewind();
+            assert.equal(r.body.readAll().toString(), body);
+
+            var r = new http.Request();
+            r.setHeader('Content-Type', 'multipart/form-data;boundary=7d33a816d302b6');
+            r.body.write(body);
+            assert.equal(r.form['a'], '100');
+            assert.equal(r.form['b'].body.readAll().toString(), data);
+
+            var r = get_request('GET /test HTTP/1.0\r\nContent-type:multipart/form-data;boundary=7d33a816d302b6\r\nContent-length:64\r\n\r\n--7d33a816d302b6\r\nContent-Disposition: form-data;name="a"\r\n\r\n100');
+            assert.equal(r.body.size(), 64);
+            assert.throws(() => {
+                r.form;
+            });
+
+            var field = '0123456789abcdef'.repeat(600000);
+            var body = '--7d33a816d302b6\r\nContent-Disposition: form-data;name="a"\r\n\r\n' + field + '\r\n--7d33a816d302b6--\r\n';
+            var r = get_request('GET /test HTTP/1.0\r\nContent-type:multipart/form-data;boundary=7d33a816d302b6\r\nContent-length:' + body.length + '\r\n\r\n' + body);
+            assert.throws(() => {
+                r.form;
+            });
+
+            assert.throws(() => {
+                get_form('GET /test HTTP/1.0\r\nContent-type:multipart/form-data;boundary=7d33a816d302b6\r\nContent-length:11\r\n\r\nhello world');
+            });
+
+            assert.throws(() => {
+                get_form('GET /test HTTP/1.0\r\nContent-type:multipart/form-data\r\nContent-length:11\r\n\r\nhello world');
+            });
         });
 
         it("chunk", () => {
@@ -1130,6 +1213,7 @@ describe("http", () => {
         var svr, hdr;
         var c, bs;
         var st;
+        var handled = 0;
 
         before(() => {
             hdr = new http.Handler((r) => {
@@ -1151,6 +1235,15 @@ describe("http", () => {
                     r.response.write("01234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567");
                 } else if (r.value == '/gzip_bin') {
                     r.response.write("0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789");
+                } else if (r.value == '/big') {
+                    r.response.write(Buffer.alloc(4 * 1024 * 1024, 'a'));
+                } else if (r.value == '/count') {
+                    handled++;
+                    r.response.write(Buffer.alloc(1024 * 1024, 'c'));
+                } else if (r.value == '/ws') {
+                    return ws.upgrade((s) => {
+                        s.onmessage = (m) => s.send(m.data);
+                    });
                 }
             });
 
@@ -1218,6 +1311,51 @@ describe("http", () => {
             assert.equal(req.firstHeader('Content-Encoding'), null);
         });
 
+        it("encoding options", () => {
+            hdr.setEncodingOptions("application/json", {
+                level: 0
+            });
+
+            c.write("GET /gzip_json HTTP/1.1\r\nAccept-Encoding: gzip,deflate\r\n\r\n");
+            var req = get_response();
+            assert.equal(req.firstHeader('Content-Encoding'), null);
+
+            hdr.setEncodingOptions("text/*", {
+                minSize: 1024
+            });
+
+            c.write("GET /gzip_test HTTP/1.1\r\nAccept-Encoding: gzip,deflate\r\n\r\n");
+            var req = get_response();
+            assert.equal(req.firstHeader('Content-Encoding'), null);
+
+            hdr.setEncodingOptions("application/json", {
+                level: 9
+            });
+            hdr.setEncodingOptions("text/*", {
+                minSize: 128
+            });
+
+            assert.throws(() => {
+                hdr.setEncodingOptions("text/html", {
+                    level: 10
+                });
+            });
+        });
+
+        it("encoding cache", () => {
+            hdr.encodingCacheSize = 1024 * 1024;
+
+            for (var i = 0; i < 3; i++) {
+                c.write("GET /gzip_json HTTP/1.1\r\nAccept-Encoding: gzip\r\n\r\n");
+                var req = get_response();
+                assert.equal(req.firstHeader('Content-Encoding'), 'gzip');
+                assert.equal(zlib.gunzip(req.readAll()).toString(),
+                    "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789");
+            }
+
+            hdr.encodingCacheSize = 0;
+        });
+
         it("bad request(error 400)", () => {
             c.write("GET /\r\n\r\n");
             var req = get_response();
@@ -1292,6 +1430,119 @@ describe("http", () => {
             assert.equal(req.statusCode, 200);
             assert.equal(req.firstHeader('Cache-Control'), 'no-cache, no-store');
         });
+
+        it("pipelined requests", () => {
+            c.write("GET /gzip_test HTTP/1.1\r\n\r\nGET /not_found HTTP/1.1\r\n\r\nGET /gzip_small HTTP/1.1\r\n\r\n");
+
+            var req = get_response();
+            assert.equal(req.statusCode, 200);
+            assert.equal(req.data.toString(), "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789");
+
+            var req = get_response();
+            assert.equal(req.statusCode, 404);
+
+            var req = get_response();
+            assert.equal(req.statusCode, 200);
+            assert.equal(req.data.toString(), "01234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567");
+        });
+
+        it("pipelined requests without reading stall the server", () => {
+            var n = 100;
+            var reqs = [];
+
+            handled = 0;
+            for (var i = 0; i < n; i++)
+                reqs.push("GET /count HTTP/1.1\r\n\r\n");
+            c.write(reqs.join(""));
+
+            for (var i = 0; i < 10; i++)
+                coroutine.sleep(50);
+
+            // the socket buffers and a bounded queue of responses, not the whole pipeline
+            assert.lessThan(handled, 48);
+
+            for (var i = 0; i < n; i++) {
+                var req = get_response();
+                assert.equal(req.statusCode, 200);
+                assert.equal(req.data.length, 1024 * 1024);
+            }
+
+            assert.equal(handled, n);
+        });
+
+        it("pipelined request before upgrade", () => {
+            c.write("GET /big HTTP/1.1\r\n\r\n" +
+                "GET /ws HTTP/1.1\r\n" +
+                "Upgrade: websocket\r\n" +
+                "Connection: Upgrade\r\n" +
+                "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n" +
+                "Sec-WebSocket-Version: 13\r\n\r\n");
+
+            var req = get_response();
+            assert.equal(req.statusCode, 200);
+
+            var data = req.data;
+            assert.equal(data.length, 4 * 1024 * 1024);
+            assert.equal(data.toString().replace(/a/g, ""), "");
+
+            assert.equal(bs.readLine(), "HTTP/1.1 101 Switching Protocols");
+
+            var line;
+            var accept;
+            while ((line = bs.readLine()) !== "") {
+                var pos = line.indexOf(":");
+                if (line.substr(0, pos).toLowerCase() == "sec-websocket-accept")
+                    accept = line.substr(pos + 1).trim();
+            }
+            assert.equal(accept, "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+        });
+
+        it("h2c prior knowledge", () => {
+            function frame(type, flags, id, payload) {
+                var head = Buffer.alloc(9);
+                head.writeUInt32BE(payload.length * 256 + type, 0);
+                head.writeUInt8(flags, 4);
+                head.writeUInt32BE(id, 5);
+                return Buffer.concat([head, payload]);
+            }
+
+            c.write("PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n");
+            c.write(frame(4, 0, 0, Buffer.alloc(0)));
+
+            // :method GET, :scheme http, :path /gzip_test
+            var block = Buffer.concat([Buffer.from([0x82, 0x86, 0x04, 10]), Buffer.from("/gzip_test")]);
+            c.write(frame(1, 5, 1, block));
+
+            var settings = 0;
+            var headers;
+            var body = [];
+
+            while (true) {
+                var head = bs.read(9);
+                var len = head.readUInt32BE(0) >> 8;
+                var type = head[3];
+                var flags = head[4];
+                var payload = len ? bs.read(len) : Buffer.alloc(0);
+
+                if (type == 4) {
+                    if (!(flags & 1))
+                        settings++;
+                } else if (type == 1) {
+                    assert.equal(head.readUInt32BE(5), 1);
+                    headers = payload;
+                } else if (type == 0) {
+                    assert.equal(head.readUInt32BE(5), 1);
+                    body.push(payload);
+                    if (flags & 1)
+                        break;
+                }
+            }
+
+            assert.equal(settings, 1);
+            assert.equal(headers[0], 0x88);
+            assert.equal(Buffer.concat(body).toString(),
+                "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789");
+        });
     });
 
     describe("file handler", () => {
@@ -1317,6 +1568,9 @@ describe("http", () => {
             try {
                 fs.unlink(filePath + '.gz');
             } catch (e) { };
+            try {
+                fs.unlink(filePath + '.br');
+            } catch (e) { };
         }
 
         before(clean);
@@ -1363,6 +1617,100 @@ describe("http", () => {
             rep.clear();
         });
 
+        it("precompressed", () => {
+            var gz = zlib.gzip(fs.readFile(filePath));
+            fs.writeFile(filePath + '.gz', gz);
+            fs.writeFile(filePath + '.br', 'br data');
+
+            var rep = hfh_test(url, {
+                'Accept-Encoding': 'gzip, deflate, br'
+            });
+            assert.equal(200, rep.statusCode);
+            assert.equal('br', rep.firstHeader('Content-Encoding'));
+            assert.equal('text/html', rep.firstHeader('Content-Type'));
+            assert.equal('br data', rep.readAll().toString());
+            var etag = rep.firstHeader('ETag');
+            assert.ok(/-br"$/.test(etag));
+            rep.clear();
+
+            var rep = hfh_test(url, {
+                'Accept-Encoding': 'gzip, deflate, br',
+                'If-None-Match': etag
+            });
+            assert.equal(304, rep.statusCode);
+            assert.equal(etag, rep.firstHeader('ETag'));
+            rep.clear();
+
+            var rep = hfh_test(url, {
+                'If-None-Match': etag
+            });
+            assert.equal(200, rep.statusCode);
+            assert.equal(null, rep.firstHeader('Content-Encoding'));
+            rep.clear();
+
+            var rep = hfh_test(url, {
+                'Accept-Encoding': 'br',
+                'Range': 'bytes=3-',
+                'If-Range': etag
+            });
+            assert.equal(206, rep.statusCode);
+            assert.equal('br', rep.firstHeader('Content-Encoding'));
+            rep.body.rewind();
+            assert.equal('data', rep.readAll().toString());
+            rep.clear();
+
+            var rep = hfh_test(url, {
+                'Accept-Encoding': 'gzip, br;q=0'
+            });
+            assert.equal('gzip', rep.firstHeader('Content-Encoding'));
+            assert.equal(gz.length, rep.length);
+            rep.clear();
+
+            var rep = hfh_test(url);
+            assert.equal(null, rep.firstHeader('Content-Encoding'));
+            assert.equal('Accept-Encoding', rep.firstHeader('Vary'));
+            assert.equal(14, rep.length);
+            rep.clear();
+
+            fs.unlink(filePath + '.br');
+            var rep = hfh_test(url, {
+                'Accept-Encoding': 'gzip, br'
+            });
+            assert.equal('gzip', rep.firstHeader('Content-Encoding'));
+            assert.equal('Accept-Encoding', rep.firstHeader('Vary'));
+            rep.clear();
+
+            fs.unlink(filePath + '.gz');
+        });
+
+        it("missing precompressed files are not probed again", () => {
+            var rep = hfh_test(url, {
+                'Accept-Encoding': 'gzip, br'
+            });
+            assert.equal(null, rep.firstHeader('Content-Encoding'));
+            assert.equal('Accept-Encoding', rep.firstHeader('Vary'));
+            rep.clear();
+
+            fs.writeFile(filePath + '.br', 'br data');
+
+            var rep = hfh_test(url, {
+                'Accept-Encoding': 'gzip, br'
+            });
+            assert.equal(null, rep.firstHeader('Content-Encoding'));
+            rep.clear();
+
+            fs.writeFile(filePath, 'test html file, changed');
+
+            var rep = hfh_test(url, {
+                'Accept-Encoding': 'gzip, br'
+            });
+            assert.equal('br', rep.firstHeader('Content-Encoding'));
+            rep.clear();
+
+            fs.unlink(filePath + '.br');
+            fs.writeFile(filePath, 'test html file');
+        });
+
         it("index.html", () => {
             var rep = hfh_test("/");
             assert.equal(200, rep.statusCode);
@@ -1467,6 +1815,56 @@ describe("http", () => {
                     });
                 })
             });
+
+            it("multipart/byteranges", () => {
+                var rep = hfh_test("http_files/range_test/fake_http_206.mp4", {
+                    "Range": "bytes=0-9, 20-29,-5"
+                });
+                assert.equal(206, rep.statusCode);
+
+                var [_, boundary] = rep.firstHeader('Content-Type').match(/^multipart\/byteranges; boundary=(.+)$/);
+                var body = rep.readAll().toString('latin1');
+                var fsize = Number(mp4File.size());
+                var parts = body.split(`--${boundary}`);
+
+                assert.equal(parts.length, 5);
+                assert.equal(parts[4], "--\r\n");
+
+                [[0, 9], [20, 29], [fsize - 5, fsize - 1]].forEach((r, i) => {
+                    var part = parts[i + 1];
+                    assert.notEqual(part.indexOf(`Content-Range: bytes ${r[0]}-${r[1]}/${fsize}\r\n`), -1);
+                    assert.notEqual(part.indexOf('Content-Type: video/mp4\r\n'), -1);
+
+                    mp4File.seek(r[0], fs.SEEK_SET);
+                    var data = part.substr(part.indexOf('\r\n\r\n') + 4, r[1] - r[0] + 1);
+                    assert.equal(data, mp4File.read(r[1] - r[0] + 1).toString('latin1'));
+                });
+            });
+
+            it("ETag & If-Range", () => {
+                var rep = hfh_test("http_files/range_test/fake_http_206.mp4");
+                var etag = rep.firstHeader('ETag');
+                assert.ok(etag);
+
+                rep = hfh_test("http_files/range_test/fake_http_206.mp4", {
+                    "If-None-Match": etag
+                });
+                assert.equal(304, rep.statusCode);
+
+                rep = hfh_test("http_files/range_test/fake_http_206.mp4", {
+                    "Range": "bytes=0-9",
+                    "If-Range": etag
+                });
+                assert.equal(206, rep.statusCode);
+                assert.equal(rep.length, 10);
+
+                rep = hfh_test("http_files/range_test/fake_http_206.mp4", {
+                    "Range": "bytes=0-9",
+                    "If-Range": '"stale"'
+                });
+                assert.equal(200, rep.statusCode);
+                assert.equal(rep.length, Number(mp4File.size()));
+            });
         });
 
         describe("zip virtual file", () => {
@@ -1672,12 +2070,18 @@ describe("http", () => {
                 } else if (r.address == "/agent") {
                     if (r.allHeader("user-agent").length == 1)
                         r.response.write(r.firstHeader("user-agent"));
+                } else if (r.address == "/slow") {
+                    coroutine.sleep(200);
+                    r.response.write(r.address);
                 } else if (r.address == "/request_query:") {
                     r.response.write(r.address);
                     r.response.write(r.query.test_field);
                 } else if (r.address == "/request_url:") {
                     r.response.write(r.address);
                     r.response.write(r.form.test_field);
+                } else if (r.address == "/request_form:") {
+                    r.response.write(r.address);
+                    r.response.write(r.body.size() + ':' + r.form.a);
                 } else if (r.address == "/request_json:") {
                     r.response.write(r.address);
                     r.response.write(r.json().test_field);
@@ -1911,6 +2315,99 @@ describe("http", () => {
                 var r2 = http.get("http://127.0.0.1:" + (8882 + base_port) + "/request");
                 assert.equal(r1.stream.stream, r2.stream.stream);
             });
+
+            it("poolStats of keep-alive", () => {
+                var hc = new http.Client();
+                assert.deepEqual(hc.poolStats, {
+                    hits: 0,
+                    misses: 0,
+                    evictions: 0,
+                    origins: 0,
+                    idle: 0,
+                    active: 0,
+                    waiting: 0
+                });
+
+                hc.get("http://127.0.0.1:" + (8882 + base_port) + "/request");
+                hc.get("http://127.0.0.1:" + (8882 + base_port) + "/request");
+
+                var stats = hc.poolStats;
+                assert.equal(stats.hits, 1);
+                assert.equal(stats.misses, 1);
+                assert.equal(stats.origins, 1);
+                assert.equal(stats.idle, 1);
+                assert.equal(stats.active, 0);
+
+                hc.poolSize = 0;
+                hc.get("http://127.0.0.1:" + (8882 + base_port) + "/request");
+                stats = hc.poolStats;
+                assert.equal(stats.evictions, 1);
+                assert.equal(stats.idle, 0);
+            });
+
+            it("poolMaxActive of keep-alive", () => {
+                var hc = new http.Client();
+                assert.equal(hc.poolMaxActive, 0);
+
+                assert.throws(() => {
+                    hc.poolMaxActive = -1;
+                });
+
+                hc.poolMaxActive = 1;
+                assert.equal(hc.poolMaxActive, 1);
+
+                var rs = coroutine.parallel([1, 2, 3, 4], () => {
+                    var r = hc.get("http://127.0.0.1:" + (8882 + base_port) + "/request");
+                    return r.stream.stream;
+                });
+
+                assert.equal(rs[0], rs[1]);
+                assert.equal(rs[0], rs[2]);
+                assert.equal(rs[0], rs[3]);
+
+                var stats = hc.poolStats;
+                assert.equal(stats.misses, 1);
+                assert.equal(stats.hits, 3);
+                assert.equal(stats.active, 0);
+                assert.equal(stats.waiting, 0);
+            });
+
+            it("poolMaxActive waiters are served in order", () => {
+                var hc = new http.Client();
+                hc.poolMaxActive = 1;
+
+                var order = [];
+                coroutine.parallel([0, 1, 2, 3], (i) => {
+                    coroutine.sleep(i * 10);
+                    hc.get("http://127.0.0.1:" + (8882 + base_port) + (i ? "/request" : "/slow"));
+                    order.push(i);
+                });
+
+                assert.deepEqual(order, [0, 1, 2, 3]);
+            });
+
+            it("poolMaxActive waiters honour the timeout", () => {
+                var hc = new http.Client();
+                hc.poolMaxActive = 1;
+                hc.timeout = 300;
+
+                // the third request waits for two slow ones, longer than the timeout
+                var rs = coroutine.parallel([0, 1, 2], (i) => {
+                    coroutine.sleep(i * 10);
+                    try {
+                        hc.get("http://127.0.0.1:" + (8882 + base_port) + "/slow");
+                        return "ok";
+                    } catch (e) {
+                        return "timeout";
+                    }
+                });
+
+                assert.deepEqual(rs, ["ok", "ok", "timeout"]);
+
+                var stats = hc.poolStats;
+                assert.equal(stats.active, 0);
+                assert.equal(stats.waiting, 0);
+            });
         });
 
         describe("head", () => {
@@ -2016,6 +2513,39 @@ describe("http", () => {
                 }).headers['Content-Length'], null);
             });
 
+            it("multipart form", () => {
+                var url = "http://127.0.0.1:" + (8882 + base_port) + "/request_form:";
+                var headers = {
+                    "Content-Type": "multipart/form-data;boundary=7d33a816d302b6"
+                };
+                var body = '--7d33a816d302b6\r\nContent-Disposition: form-data;name="a"\r\n\r\n100\r\n--7d33a816d302b6--\r\n';
+                var bad = '--7d33a816d302b6\r\nContent-Disposition: form-data;name="a"\r\n\r\n100';
+
+                assert.equal(http.post(url, {
+                    headers: headers,
+                    body: body
+                }).body.read().toString(), "/request_form:" + body.length + ":100");
+                assert.equal(http.post(url, {
+                    headers: headers,
+                    body: bad
+                }).statusCode, 500);
+
+                assert.isFalse(svr.streamForm);
+                svr.streamForm = true;
+                try {
+                    assert.equal(http.post(url, {
+                        headers: headers,
+                        body: body
+                    }).body.read().toString(), "/request_form:0:100");
+                    assert.equal(http.post(url, {
+                        headers: headers,
+                        body: bad
+                    }).statusCode, 400);
+                } finally {
+                    svr.streamForm = false;
+                }
+            });
+
             it("async body", (done) => {
                 http.post("http://127.0.0.1:" + (8882 + base_port) + "/request:", {
                     body: "body"
@@ -2222,6 +2752,98 @@ describe("http", () => {
         });
     });
 
+    describe("https http/2", () => {
+        var svr, svr1;
+        var protocols = [];
+
+        before(() => {
+            ssl.ca.import(ca_pem);
+
+            svr = new http.HttpsServer(crt, pk, {
+                port: 8889 + base_port,
+                h2: true
+            }, (r) => {
+                protocols.push(r.protocol);
+                r.response.write(r.address);
+                r.body.copyTo(r.response.body);
+            });
+            svr.start();
+            test_util.push(svr.socket);
+
+            svr1 = new http.HttpsServer(crt, pk, 8890 + base_port, (r) => {
+                protocols.push(r.protocol);
+                r.response.write(r.address);
+            });
+            svr1.start();
+            test_util.push(svr1.socket);
+        });
+
+        after(() => {
+            ssl.ca.clear();
+        });
+
+        beforeEach(() => {
+            protocols = [];
+        });
+
+        it("disabled by default", () => {
+            var hc = new http.Client();
+            assert.isFalse(hc.enableHttp2);
+
+            var r = hc.get("https://localhost:" + (8889 + base_port) + "/request");
+            assert.equal(r.protocol, "HTTP/1.1");
+            assert.equal(r.body.readAll().toString(), "/request");
+            assert.deepEqual(protocols, ["HTTP/1.1"]);
+        });
+
+        it("negotiate h2 through ALPN", () => {
+            var hc = new http.Client();
+            hc.enableHttp2 = true;
+
+            var r = hc.get("https://localhost:" + (8889 + base_port) + "/request");
+            assert.equal(r.protocol, "HTTP/2.0");
+            assert.equal(r.statusCode, 200);
+            assert.equal(r.body.readAll().toString(), "/request");
+
+            r = hc.post("https://localhost:" + (8889 + base_port) + "/post:", {
+                body: "body"
+            });
+            assert.equal(r.protocol, "HTTP/2.0");
+            assert.equal(r.body.readAll().toString(), "/post:body");
+
+            assert.deepEqual(protocols, ["HTTP/2.0", "HTTP/2.0"]);
+        });
+
+        it("reuse one session per origin", () => {
+            var hc = new http.Client();
+            hc.enableHttp2 = true;
+
+            hc.get("https://localhost:" + (8889 + base_port) + "/request");
+
+            var rs = coroutine.parallel([1, 2, 3, 4, 5], (n) => {
+                return hc.get("https://localhost:" + (8889 + base_port) + "/request" + n).body.readAll().toString();
+            });
+            assert.deepEqual(rs, ["/request1", "/request2", "/request3", "/request4", "/request5"]);
+
+            var stats = hc.poolStats;
+            assert.equal(stats.misses, 1);
+            assert.equal(stats.hits, 5);
+            assert.equal(stats.origins, 1);
+            assert.equal(stats.idle, 0);
+            assert.equal(stats.active, 0);
+        });
+
+        it("fall back to http/1.1 when the server does not offer h2", () => {
+            var hc = new http.Client();
+            hc.enableHttp2 = true;
+
+            var r = hc.get("https://localhost:" + (8890 + base_port) + "/request");
+            assert.equal(r.protocol, "HTTP/1.1");
+            assert.equal(r.body.readAll().toString(), "/request");
+            assert.deepEqual(protocols, ["HTTP/1.1"]);
+        });
+    });
+
     describe("server/client", () => {
         var svr;
 
@@ -2512,6 +3134,8 @@ describe("http", () => {
                     r.response.json(r.allHeader());
                 } else if (r.address === '/query/test') {
                     r.response.write(r.queryString)
+                } else if (r.address.startsWith('/form/')) {
+                    r.response.write(r.body.size() + ':' + r.form.a + ':' + r.form.b.body.size());
                 } else {
                     r.response.write(r.address);
                 }
@@ -2689,6 +3313,28 @@ describe("http", () => {
                 assert.equal(req_method(hr, 'test'), "method: test");
             });
 
+            it("forward multipart body", () => {
+                var hr = new http.Repeater('http://127.0.0.1:' + (8885 + base_port) + '/form');
+                var svr1 = new http.Server(8891 + base_port, hr);
+                svr1.start();
+                test_util.push(svr1.socket);
+
+                var data = '0123456789abcdef'.repeat(100000);
+                var body = '--7d33a816d302b6\r\nContent-Disposition: form-data;name="a"\r\n\r\n100\r\n--7d33a816d302b6\r\nContent-Disposition: form-data;name="b";filename="test"\r\n\r\n' + data + '\r\n--7d33a816d302b6--\r\n';
+
+                try {
+                    var r = http.post('http://127.0.0.1:' + (8891 + base_port) + '/test', {
+                        headers: {
+                            "Content-Type": "multipart/form-data;boundary=7d33a816d302b6"
+                        },
+                        body: body
+                    });
+                    assert.equal(r.body.read().toString(), body.length + ':100:' + data.length);
+                } finally {
+                    svr1.stop();
+                }
+            });
+
             it("header", () => {
                 var hr = new http.Repeater('http://127.0.0.1:' + (8885 + base_port) + '/header');
                 assert.deepEqual(req_header(hr, 'test'), {
@@ -2924,6 +3570,47 @@ describe("http", () => {
 
         assert.equal(http.get(u_path).readAll().toString(), "hello, /unix");
     });
+
+    if (process.platform !== 'win32')
+        it("worker mode", () => {
+            var _port = (8888 + base_port);
+            var fname = path.join(os.tmpdir(), 'http_worker_' + _port + '.js');
+
+            fs.writeFile(fname, 'module.exports = r => { r.response.write("v1"); };');
+
+            var svr = new http.Server({
+                port: _port,
+                worker: fname,
+                workers: 2
+            });
+            svr.serverName = "worker-test";
+            svr.start();
+
+            try {
+                // keep-alive connections stay with the handler they started with, use a fresh client each time
+                var url = "http://127.0.0.1:" + _port + "/";
+                var r = new http.Client().get(url);
+                assert.equal(r.readAll().toString(), "v1");
+                assert.equal(r.firstHeader("Server"), "worker-test");
+
+                assert.throws(() => {
+                    svr.handler = r => { };
+                });
+
+                fs.writeFile(fname, 'module.exports = r => { r.response.write("v2"); };');
+                svr.serverName = "worker-test2";
+                assert.equal(new http.Client().get(url).firstHeader("Server"), "worker-test");
+
+                svr.reload();
+
+                var r = new http.Client().get(url);
+                assert.equal(r.readAll().toString(), "v2");
+                assert.equal(r.firstHeader("Server"), "worker-test2");
+            } finally {
+                svr.stop();
+                fs.unlink(fname);
+            }
+        });
 });
 
 require.main === module && test.run(console.DEBUG);
\ No newline at end of file
@@ -5,6 +5,8 @@ const io = require("io");
 const fs = require("fs");
 const path = require("path");
 const coroutine = require("coroutine");
+const http = require("http");
+const net = require("net");
 
 const {
     generateFakeMp4
@@ -72,6 +74,110 @@ describe('io', () => {
         })
     });
 
+    describe('gather write', () => {
+        // HttpMessage.sendTo writes its head and a small body as one chain of two buffers
+        function make_chain(head, body) {
+            const rep = new http.Response();
+            rep.setHeader("X-Pad", "p".repeat(head));
+
+            const data = Buffer.alloc(body);
+            for (let i = 0; i < body; i++)
+                data[i] = i % 251;
+            rep.body.write(data);
+
+            const ms = new io.MemoryStream();
+            rep.sendHeader(ms);
+            ms.rewind();
+
+            return {
+                rep: rep,
+                bytes: Buffer.concat([ms.readAll(), data])
+            };
+        }
+
+        const sizes = [
+            [10, 10],
+            [100, 16000],
+            [10000, 10000],
+            [16384, 16385],
+            [20000, 30000]
+        ];
+
+        it('MemoryStream append', () => {
+            sizes.forEach(([head, body]) => {
+                const c = make_chain(head, body);
+                const ms = new io.MemoryStream();
+
+                ms.write("prefix");
+                c.rep.sendTo(ms);
+                c.rep.sendTo(ms);
+
+                ms.rewind();
+                assert.equal(ms.readAll().compare(Buffer.concat([Buffer.from("prefix"), c.bytes, c.bytes])), 0);
+            });
+        });
+
+        it('BufferedStream', () => {
+            sizes.forEach(([head, body]) => {
+                const c = make_chain(head, body);
+                const ms = new io.MemoryStream();
+                const bs = new io.BufferedStream(ms);
+
+                c.rep.sendTo(bs);
+
+                ms.rewind();
+                assert.equal(ms.readAll().compare(c.bytes), 0);
+            });
+        });
+
+        it('join for streams without gather write', () => {
+            const fname = path.join(__dirname, 'io_writev_' + coroutine.vmid);
+
+            sizes.forEach(([head, body]) => {
+                const c = make_chain(head, body);
+                const f = fs.openFile(fname, 'w+');
+
+                c.rep.sendTo(f);
+                f.rewind();
+                const data = f.readAll();
+                f.close();
+
+                assert.equal(data.compare(c.bytes), 0);
+            });
+
+            fs.unlink(fname);
+        });
+
+        it('Socket', () => {
+            const port = 9890 + coroutine.vmid * 10000;
+            let received;
+            const ev = new coroutine.Event();
+
+            const svr = new net.TcpServer(port, (c) => {
+                received = c.readAll();
+                ev.set();
+            });
+            svr.start();
+
+            try {
+                sizes.forEach(([head, body]) => {
+                    const c = make_chain(head, body);
+                    const s = new net.Socket();
+
+                    ev.clear();
+                    s.connect('127.0.0.1', port);
+                    c.rep.sendTo(s);
+                    s.close();
+                    ev.wait();
+
+                    assert.equal(received.compare(c.bytes), 0);
+                });
+            } finally {
+                svr.stop();
+            }
+        });
+    });
+
     describe('io.RangeStream', () => {
         var filePath;
         var file;
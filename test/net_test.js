@@ -304,6 +304,69 @@ function test_net(eng, use_uv) {
             del(path.join(__dirname, 'net_temp_000002' + base_port));
         });
 
+        it("copyTo a large file", () => {
+            var fname = path.join(__dirname, 'net_temp_000003' + base_port);
+            // well past the socket buffers, so the sender has to wait and resume more than once
+            var data = Buffer.alloc(32 * 1024 * 1024);
+            for (var i = 0; i < data.length; i += 4)
+                data.writeUInt32LE(i, i);
+            fs.writeFile(fname, data);
+
+            var ev = new coroutine.Event();
+            var sent;
+            var err;
+
+            function accept3(s) {
+                try {
+                    while (true) {
+                        var c = s.accept();
+                        var f = fs.openFile(fname);
+
+                        try {
+                            sent = f.copyTo(c);
+                        } catch (e) {
+                            err = e;
+                        }
+
+                        f.close();
+                        c.close();
+                        ev.set();
+                    }
+                } catch (e) { }
+            }
+
+            var _port = getPort();
+
+            var s1 = new net.Socket(net_config.family);
+            test_util.push(s1);
+
+            s1.bind(_port);
+            s1.listen();
+            coroutine.start(accept3, s1);
+
+            var c1 = new net.Socket();
+            c1.connect('127.0.0.1', _port);
+            var r = c1.readAll();
+            c1.close();
+
+            ev.wait();
+            ev.clear();
+            assert.equal(sent, data.length);
+            assert.isUndefined(err);
+            assert.equal(r.length, data.length);
+            assert.isTrue(r.equals(data));
+
+            var c2 = new net.Socket();
+            c2.connect('127.0.0.1', _port);
+            assert.ok(c2.read(1024));
+            c2.close();
+
+            ev.wait();
+            assert.ok(err);
+
+            del(fname);
+        });
+
         it("read & recv", () => {
             function accept2(s) {
                 try {
@@ -481,6 +544,228 @@ function test_net(eng, use_uv) {
             test_util.push(svr.socket);
         });
 
+        if (process.platform !== 'win32')
+            it("reusePort", () => {
+                var _port = getPort();
+                var svr1 = new net.TcpServer({
+                    port: _port,
+                    reusePort: true
+                }, (c) => { });
+                var svr2 = new net.TcpServer({
+                    port: _port,
+                    reusePort: true
+                }, (c) => { });
+                test_util.push(svr1.socket);
+                test_util.push(svr2.socket);
+
+                svr1.start();
+                svr2.start();
+
+                for (var i = 0; i < 10; i++) {
+                    var c = new net.Socket();
+                    c.connect('127.0.0.1', _port);
+                    c.close();
+                }
+
+                for (var i = 0; i < 100 && svr1.stats.accepted < 10; i++)
+                    coroutine.sleep(10);
+
+                assert.equal(svr1.stats.accepted, 10);
+                assert.equal(svr2.stats.accepted, 10);
+                assert.equal(svr1.stats.listeners, 2);
+
+                svr1.stop();
+                svr2.stop();
+            });
+
+        if (process.platform !== 'win32')
+            it("reusePort stats on the same address", () => {
+                var _port = getPort();
+                var svr1 = new net.TcpServer({
+                    port: _port,
+                    reusePort: true
+                }, (c) => { });
+                var svr2 = new net.TcpServer({
+                    address: "0.0.0.0",
+                    port: _port,
+                    reusePort: true
+                }, (c) => { });
+                test_util.push(svr1.socket);
+                test_util.push(svr2.socket);
+
+                svr1.start();
+                svr2.start();
+
+                assert.equal(svr1.stats.listeners, 2);
+                assert.equal(svr2.stats.listeners, 2);
+
+                svr1.stop();
+                svr2.stop();
+            });
+
+        if (process.platform !== 'win32')
+            describe("worker mode", () => {
+                var fname = path.join(os.tmpdir(), 'net_worker_' + base_port + '.js');
+
+                function write_worker(tag) {
+                    fs.writeFile(fname, `module.exports = c => { c.write("${tag}"); };`);
+                }
+
+                function read_tag(port) {
+                    var c = new net.Socket();
+                    c.connect('127.0.0.1', port);
+                    var r = c.read();
+                    c.close();
+                    return r.toString();
+                }
+
+                after(() => {
+                    try {
+                        fs.unlink(fname);
+                    } catch (e) { }
+                });
+
+                it("serve and reload", () => {
+                    var _port = getPort();
+
+                    write_worker("v1");
+                    var svr = new net.TcpServer({
+                        port: _port,
+                        worker: fname,
+                        workers: 2
+                    });
+
+                    assert.throws(() => {
+                        svr.reload();
+                    });
+
+                    svr.start();
+
+                    for (var i = 0; i < 10; i++)
+                        assert.equal(read_tag(_port), "v1");
+
+                    write_worker("v2");
+                    svr.reload();
+
+                    for (var i = 0; i < 10; i++)
+                        assert.equal(read_tag(_port), "v2");
+
+                    for (var i = 0; i < 100 && svr.stats.active > 0; i++)
+                        coroutine.sleep(10);
+
+                    assert.equal(svr.stats.accepted, 20);
+                    assert.equal(svr.stats.listeners, 2);
+
+                    svr.stop();
+                    for (var i = 0; i < 100 && svr.stats.listeners > 0; i++)
+                        coroutine.sleep(10);
+                    assert.equal(svr.stats.listeners, 0);
+                });
+
+                it("release workers and stats when the server goes away", () => {
+                    var _port = getPort();
+
+                    test_util.gc();
+                    var no1 = test_util.countObject('TcpServer');
+
+                    write_worker("v1");
+                    var svr = new net.TcpServer({
+                        port: _port,
+                        worker: fname,
+                        workers: 2
+                    });
+                    svr.start();
+
+                    for (var i = 0; i < 10; i++)
+                        assert.equal(read_tag(_port), "v1");
+
+                    assert.equal(test_util.countObject('TcpServer'), no1 + 3);
+
+                    svr.stop();
+                    svr = undefined;
+
+                    for (var i = 0; i < 10 && test_util.countObject('TcpServer') > no1; i++)
+                        test_util.gc();
+                    assert.equal(test_util.countObject('TcpServer'), no1);
+
+                    var svr1 = new net.TcpServer({
+                        port: _port,
+                        reusePort: true
+                    }, (c) => { });
+                    test_util.push(svr1.socket);
+
+                    assert.equal(svr1.stats.accepted, 0);
+                    assert.equal(svr1.stats.listeners, 0);
+                });
+
+                it("keep the old handler when reload fails", () => {
+                    var _port = getPort();
+
+                    write_worker("v1");
+                    var svr = new net.TcpServer({
+                        port: _port,
+                        worker: fname,
+                        workers: 2
+                    });
+                    svr.start();
+
+                    fs.writeFile(fname, 'module.exports = 100;');
+                    assert.throws(() => {
+                        svr.reload();
+                    });
+
+                    assert.equal(read_tag(_port), "v1");
+
+                    svr.stop();
+                });
+
+                it("handler is read only", () => {
+                    write_worker("v1");
+                    var svr = new net.TcpServer({
+                        port: getPort(),
+                        worker: fname
+                    });
+
+                    assert.throws(() => {
+                        svr.handler = (c) => { };
+                    });
+                    assert.throws(() => {
+                        svr.socket;
+                    });
+                });
+
+                it("bad options", () => {
+                    assert.throws(() => {
+                        new net.TcpServer({
+                            port: getPort(),
+                            worker: "net_worker.js"
+                        });
+                    });
+
+                    assert.throws(() => {
+                        new net.TcpServer({
+                            worker: fname
+                        });
+                    });
+
+                    assert.throws(() => {
+                        new net.TcpServer({
+                            port: getPort(),
+                            worker: fname
+                        }, (c) => { });
+                    });
+
+                    var svr = new net.TcpServer({
+                        port: getPort(),
+                        reusePort: true
+                    }, (c) => { });
+                    test_util.push(svr.socket);
+                    assert.throws(() => {
+                        svr.reload();
+                    });
+                });
+            });
+
         describe("abort Pending I/O", () => {
             function close_it(s) {
                 coroutine.sleep(50);
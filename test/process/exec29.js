@@ -0,0 +1,52 @@
+var json = require('json');
+var hex = require('hex');
+var net = require('net');
+var coroutine = require('coroutine');
+
+var bufs = [];
+for (var i = 0; i < 100; i++)
+    bufs.push(hex.decode('0102030405060708090a' + (i < 16 ? '0' : '') + i.toString(16)));
+
+var pooled = bufs.filter(b => b.buffer.byteLength > b.length).length;
+var intact = bufs.every((b, i) => b.length == 11 && b[0] == 1 && b[9] == 10 && b[10] == i);
+
+// socket reads finish on the io thread, their buffers still come from the slab of this isolate
+var svr = new net.Socket();
+svr.bind('127.0.0.1', 0);
+svr.listen();
+
+coroutine.start(() => {
+    var c = svr.accept();
+    for (var i = 0; i < 100; i++) {
+        c.write(bufs[i]);
+        c.read(1);
+    }
+    c.close();
+});
+
+var sock = new net.Socket();
+sock.connect('127.0.0.1', svr.localPort);
+
+var reads = [];
+for (var i = 0; i < 100; i++) {
+    reads.push(sock.read(11));
+    sock.write(Buffer.from('k'));
+}
+
+sock.close();
+svr.close();
+
+var socketPooled = reads.filter(b => b.buffer.byteLength > b.length).length;
+var socketIntact = reads.every((b, i) => b.length == 11 && b[0] == 1 && b[9] == 10 && b[10] == i);
+
+var large = hex.decode('ff'.repeat(8192));
+var str = Buffer.from('6162', 'hex');
+
+console.log(json.encode({
+    pooled: pooled,
+    intact: intact,
+    socketPooled: socketPooled,
+    socketIntact: socketIntact,
+    large: large.buffer.byteLength == large.length,
+    str: str.toString()
+}));
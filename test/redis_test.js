@@ -78,6 +78,24 @@ describe("redis", () => {
             assert.isFalse(rdb.exists("test2"));
         });
 
+        it("large value", () => {
+            var buf = Buffer.alloc(100000);
+            for (var i = 0; i < buf.length; i++)
+                buf[i] = i % 251;
+
+            rdb.set("test_big", buf);
+            assert.equal(rdb.get("test_big").compare(buf), 0);
+
+            rdb.command("set", "test_big", buf.slice(1));
+            assert.equal(rdb.get("test_big").compare(buf.slice(1)), 0);
+
+            rdb.mset("test_big", buf, "test_big1", "small");
+            listEquals(rdb.mget("test_big1"), ["small"]);
+            assert.equal(rdb.get("test_big").compare(buf), 0);
+
+            rdb.del("test_big", "test_big1");
+        });
+
         it("mset", () => {
             rdb.mset("test", "bbb", "test1", "bbb1");
             listEquals(rdb.mget("test", "test1"), ["bbb", "bbb1"]);
@@ -11,6 +11,8 @@ var path = require('path');
 var os = require('os');
 var util = require('util');
 var coroutine = require('coroutine');
+var http = require('http');
+var io = require('io');
 
 var base_port = coroutine.vmid * 10000;
 
@@ -264,6 +266,67 @@ describe('ssl', () => {
         del(path.join(__dirname, 'net_temp_000002' + base_port));
     });
 
+    it("gather write", () => {
+        var sss = new ssl.Socket(crt, pk);
+        sss.verification = ssl.VERIFY_NONE;
+
+        var received;
+        var ev = new coroutine.Event();
+
+        var svr = new net.TcpServer(9090 + base_port, (s) => {
+            var ss = sss.accept(s);
+
+            received = ss.readAll();
+            ev.set();
+
+            ss.close();
+            s.close();
+        });
+        test_util.push(svr.socket);
+        svr.start();
+
+        // head and body of a small http message go out as one chain, the
+        // pieces are packed into 16K records or encrypted on their own
+        function test_chain(head, body) {
+            var rep = new http.Response();
+            rep.setHeader("X-Pad", "p".repeat(head));
+
+            var data = Buffer.alloc(body);
+            for (var i = 0; i < body; i++)
+                data[i] = i % 251;
+            rep.body.write(data);
+
+            var ms = new io.MemoryStream();
+            rep.sendHeader(ms);
+            ms.rewind();
+            var bytes = Buffer.concat([ms.readAll(), data]);
+
+            var c1 = new net.Socket();
+            c1.connect('127.0.0.1', 9090 + base_port);
+
+            var ss = new ssl.Socket();
+            ss.connect(c1);
+
+            ev.clear();
+            rep.sendTo(ss);
+            ss.close();
+            c1.close();
+            ev.wait();
+
+            assert.equal(received.length, bytes.length);
+            assert.equal(received.compare(bytes), 0);
+        }
+
+        test_chain(10, 10);
+        test_chain(100, 16000);
+        test_chain(16000, 100);
+        test_chain(10000, 10000);
+        test_chain(16300, 16384);
+        test_chain(16384, 16384);
+        test_chain(16385, 30000);
+        test_chain(20000, 32000);
+    });
+
     it("Handler", () => {
         var svr = new net.TcpServer(9083 + base_port, new ssl.Handler(crt, pk, (s) => {
             var buf;
@@ -314,6 +377,40 @@ describe('ssl', () => {
         }
     });
 
+    it("Server with options", () => {
+        var svr = new ssl.Server(crt, pk, {
+            address: "127.0.0.1",
+            port: 9088 + base_port,
+            backlog: 16
+        }, (s) => {
+            var buf;
+
+            while (buf = s.read())
+                s.write(buf);
+        });
+        test_util.push(svr.socket);
+        svr.start();
+
+        var s1 = new net.Socket();
+        s1.connect("127.0.0.1", 9088 + base_port);
+
+        var cs = new ssl.Socket();
+        cs.connect(s1);
+
+        cs.write("GET / HTTP/1.0");
+        assert.equal("GET / HTTP/1.0", cs.read());
+
+        cs.close();
+        s1.close();
+
+        assert.throws(() => {
+            new ssl.Server(crt, pk, {
+                port: 9089 + base_port,
+                worker: "/tmp/ssl_worker.js"
+            }, (s) => { });
+        });
+    });
+
     it('secp256k1 speed', () => {
         var pk = crypto.generateKey('secp256k1');
         var ca = new crypto.X509Req("CN=localhost", pk).sign("CN=localhost", pk, {
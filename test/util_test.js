@@ -1979,6 +1979,136 @@ describe('util', () => {
         });
     });
 
+    describe('SharedCache', () => {
+        var path = require('path');
+        var id = 0;
+
+        function name() {
+            return 'test_' + (id++);
+        }
+
+        it("set/get", () => {
+            var c = new util.SharedCache(name());
+
+            c.set('a', 'hello');
+            c.set('b', Buffer.from('world'));
+
+            assert.equal(c.get('a'), 'hello');
+            assert.isTrue(Buffer.isBuffer(c.get('b')));
+            assert.equal(c.get('b').toString(), 'world');
+            assert.isUndefined(c.get('c'));
+
+            assert.equal(c.size, 2);
+            assert.equal(c.bytes, 12);
+
+            assert.throws(() => {
+                c.set('c', 100);
+            });
+
+            assert.isTrue(c.has('a'));
+            assert.isTrue(c.remove('a'));
+            assert.isFalse(c.remove('a'));
+            assert.isFalse(c.has('a'));
+
+            c.clear();
+            assert.equal(c.size, 0);
+            assert.equal(c.bytes, 0);
+        });
+
+        it("copy on get", () => {
+            var c = new util.SharedCache(name());
+            var b = Buffer.from('abc');
+
+            c.set('a', b);
+            b[0] = 0x41;
+            assert.equal(c.get('a').toString(), 'abc');
+
+            c.get('a')[0] = 0x41;
+            assert.equal(c.get('a').toString(), 'abc');
+        });
+
+        it("same name", () => {
+            var n = name();
+            var c1 = new util.SharedCache(n, {
+                budget: 1024
+            });
+            var c2 = new util.SharedCache(n);
+
+            c1.set('a', 'value');
+            assert.equal(c2.get('a'), 'value');
+            assert.equal(c2.budget, 1024);
+        });
+
+        it("budget", () => {
+            var c = new util.SharedCache(name(), {
+                budget: 100,
+                shards: 1
+            });
+
+            for (var i = 0; i < 10; i++)
+                c.set('k' + i, '012345678901234567');
+
+            assert.equal(c.size, 5);
+            assert.isFalse(c.has('k0'));
+            assert.isTrue(c.has('k9'));
+
+            c.get('k5');
+            c.set('ka', '012345678901234567');
+            assert.isTrue(c.has('k5'));
+            assert.isFalse(c.has('k6'));
+
+            c.set('big', Buffer.alloc(200));
+            assert.isFalse(c.has('big'));
+
+            var st = c.stats;
+            assert.equal(st.evictions, 7);
+            assert.equal(st.size, 5);
+            assert.equal(st.bytes, 100);
+        });
+
+        it("timeout", () => {
+            var c = new util.SharedCache(name(), {
+                timeout: 100
+            });
+
+            c.set('a', 'a');
+            c.set('b', 'b', 0);
+
+            assert.equal(c.get('a'), 'a');
+            coroutine.sleep(200);
+
+            assert.isUndefined(c.get('a'));
+            assert.equal(c.get('b'), 'b');
+
+            c.set('c', 'c', 100);
+            coroutine.sleep(1500);
+            assert.equal(c.size, 1);
+
+            var st = c.stats;
+            assert.equal(st.expirations, 2);
+            assert.equal(st.hits, 2);
+            assert.equal(st.misses, 1);
+        });
+
+        it("shared with worker", () => {
+            var c = new util.SharedCache('worker_test');
+            var done = false;
+
+            c.set('from_main', 'hello');
+
+            var worker = new coroutine.Worker(path.join(__dirname, 'worker_files/shared_cache.js'));
+            worker.onmessage = e => {
+                done = true;
+            };
+
+            for (var i = 0; i < 1000 && !done; i++)
+                coroutine.sleep(10);
+
+            assert.isTrue(done);
+            assert.equal(c.get('from_worker').toString(), 'hello world');
+        });
+    });
+
     it("FIX: flatten a circular reference object will cause fibjs to crash", () => {
         var arr = [100, 200];
         arr.push(arr);
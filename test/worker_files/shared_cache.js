@@ -0,0 +1,6 @@
+var util = require('util');
+
+var c = new util.SharedCache('worker_test');
+c.set('from_worker', Buffer.from(c.get('from_main') + ' world'));
+
+Master.postMessage('done');
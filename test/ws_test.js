@@ -202,6 +202,61 @@ describe('ws', () => {
             test_msg_1(65535);
             test_msg_1(65536);
         });
+
+        it("sendTo frame bytes", () => {
+            function frame_head(n, masked) {
+                var m = masked ? 0x80 : 0;
+
+                if (n < 126)
+                    return Buffer.from([0x82, m | n]);
+                if (n < 65536)
+                    return Buffer.from([0x82, m | 126, n >> 8, n & 0xff]);
+                return Buffer.from([0x82, m | 127, 0, 0, 0, 0,
+                    (n >> 24) & 0xff, (n >> 16) & 0xff, (n >> 8) & 0xff, n & 0xff
+                ]);
+            }
+
+            function test_frame(n, masked) {
+                var data = Buffer.alloc(n);
+                for (var i = 0; i < n; i++)
+                    data[i] = i % 251;
+
+                var msg = new ws.Message();
+                msg.type = ws.BINARY;
+                msg.masked = masked;
+                msg.body.write(data);
+
+                var ms = new io.MemoryStream();
+                msg.sendTo(ms);
+                ms.rewind();
+                var frame = ms.readAll();
+
+                var head = frame_head(n, masked);
+                var pos = head.length;
+
+                assert.equal(frame.slice(0, pos).compare(head), 0);
+
+                var payload = frame.slice(pos + (masked ? 4 : 0));
+                assert.equal(payload.length, n);
+
+                if (masked) {
+                    var mask = frame.slice(pos, pos + 4);
+                    for (var i = 0; i < n; i++)
+                        payload[i] ^= mask[i & 3];
+                }
+
+                assert.equal(payload.compare(data), 0);
+
+                // masking works on a copy, the body stays as it was
+                msg.body.rewind();
+                assert.equal(msg.body.readAll().compare(data), 0);
+            }
+
+            [1, 125, 126, 16384, 65535, 65536, 65537, 100000].forEach(n => {
+                test_frame(n, false);
+                test_frame(n, true);
+            });
+        });
     });
 
     describe('WebSocketHandler', () => {
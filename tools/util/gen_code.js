@@ -48,6 +48,13 @@ function gen_code(cls, def, baseFolder) {
         "...": "OptArgs"
     };
 
+    var fastTypeMap = {
+        "Integer": "int32_t",
+        "Long": "int64_t",
+        "Number": "double",
+        "Boolean": "bool"
+    };
+
     var member_gens = {
         "method": {
             "declare": fn => {
@@ -131,6 +138,10 @@ function gen_code(cls, def, baseFolder) {
                     if (!recorder.isRecorded(line)) txts.push(line);
                     recorder.record(line);
                 });
+
+                var fast_ov = get_fast_over(fn);
+                if (fast_ov)
+                    txts.push(`    static ${get_fast_rtype(fast_ov)} ${get_stub_func_prefix(fast_ov, def)}${get_name(fast_ov.name, fast_ov, def)}_fast(${get_fast_params(fast_ov).join(', ')});`);
             },
             "stub_func": fn => {
                 var {
@@ -278,6 +289,33 @@ function gen_code(cls, def, baseFolder) {
 
                     recorder_insts.record(ov.name);
                 });
+
+                var fast_ov = get_fast_over(fn);
+                if (fast_ov) {
+                    var rtype = get_fast_rtype(fast_ov);
+                    var args = [];
+
+                    if (fast_ov.params)
+                        fast_ov.params.forEach((p, i) => args.push('v' + i));
+                    if (fast_ov.type)
+                        args.push('vr');
+
+                    txts.push(`inline ${rtype} ${cls}_base::${get_stub_func_prefix(fast_ov, def)}${get_name(fast_ov.name, fast_ov, def)}_fast(${get_fast_params(fast_ov).join(', ')})\n{`);
+
+                    if (fast_ov.type) txts.push(`    ${rtype} vr;\n`);
+
+                    if (!fast_ov.static)
+                        txts.push(`    FAST_METHOD_INSTANCE(${cls}_base);`);
+                    txts.push(`    FAST_METHOD_ENTER();\n`);
+
+                    if (fast_ov.static)
+                        txts.push(`    hr = ${get_name(get_fname(fast_ov, def), fast_ov, def)}(${args.join(', ')});\n`);
+                    else
+                        txts.push(`    hr = pInst->${get_name(get_fname(fast_ov, def), fast_ov, def)}(${args.join(', ')});\n`);
+
+                    if (fast_ov.type) txts.push('    FAST_METHOD_RETURN();\n}\n');
+                    else txts.push('    FAST_METHOD_VOID();\n}\n');
+                }
             }
         },
         "prop": {
@@ -558,6 +596,38 @@ function gen_code(cls, def, baseFolder) {
         return base
     }
 
+    function get_fast_over(fn) {
+        if (fn.memType != "method")
+            return null;
+
+        var ovs = fn.overs.filter(ov => ov.fast);
+        if (!ovs.length)
+            return null;
+
+        var ov = ovs[0];
+        if (fn.overs.length > 1 || ov.async || ov.symbol || is_func_new(ov, def) || is_func_Function(ov, def))
+            throw new Error(`Fast method '${cls}.${fn.name}' can not be overloaded, async or a constructor.`);
+
+        if ((ov.type && !fastTypeMap[ov.type]) || (ov.params && ov.params.some(p => !fastTypeMap[p.type])))
+            throw new Error(`Fast method '${cls}.${fn.name}' only accepts Integer, Long, Number and Boolean.`);
+
+        return ov;
+    }
+
+    function get_fast_rtype(ov) {
+        return ov.type ? fastTypeMap[ov.type] : "void";
+    }
+
+    function get_fast_params(ov) {
+        var ps = ["v8::Local<v8::Object> receiver"];
+
+        if (ov.params)
+            ov.params.forEach((p, i) => ps.push(fastTypeMap[p.type] + " v" + i));
+        ps.push("v8::FastApiCallbackOptions& options");
+
+        return ps;
+    }
+
     function get_stub_func_prefix(fn, def) {
         var base = 's_'
 
@@ -798,9 +868,18 @@ function gen_code(cls, def, baseFolder) {
 
         function gen_method_info() {
             var deflist = [];
+            var fastlist = [];
 
             def.members.forEach(fn => {
                 var fname = fn.name;
+                var fast_ov = get_fast_over(fn);
+                var fast_ref = '';
+
+                if (fast_ov) {
+                    var fast_name = get_stub_func_prefix(fast_ov, def) + get_name(fname, fast_ov, def);
+                    fastlist.push(`    static const v8::CFunction ${fast_name}_cfunc = v8::CFunction::Make(${fast_name}_fast);`);
+                    fast_ref = `, &${fast_name}_cfunc`;
+                }
 
                 var {
                     inst_mem_ovs,
@@ -812,7 +891,7 @@ function gen_code(cls, def, baseFolder) {
                     if (recorder_insts.isRecorded(ov.name)) return;
 
                     if (ov.memType == "method") {
-                        deflist.push(`        { "${fn.symbol}${fname}", ${get_stub_func_prefix(ov, def)}${get_name(fname, ov, def)}, false, ${!!ov.async} }`);
+                        deflist.push(`        { "${fn.symbol}${fname}", ${get_stub_func_prefix(ov, def)}${get_name(fname, ov, def)}, false, ${!!ov.async}${fast_ref} }`);
                         if (ov.async) {
                             has_async = true;
                             deflist.push(`        { "${fn.symbol}${fname}Sync", ${get_stub_func_prefix(ov, def)}${get_name(fname, ov, def)}, false, false }`);
@@ -827,7 +906,7 @@ function gen_code(cls, def, baseFolder) {
                     if (recorder_statics.isRecorded(ov.name)) return;
 
                     if (ov.memType == "method") {
-                        deflist.push(`        { "${fn.symbol}${fname}", ${get_stub_func_prefix(ov, def)}${get_name(fname, ov, def)}, true, ${!!ov.async} }`);
+                        deflist.push(`        { "${fn.symbol}${fname}", ${get_stub_func_prefix(ov, def)}${get_name(fname, ov, def)}, true, ${!!ov.async}${fast_ref} }`);
                         if (ov.async) {
                             has_async = true;
                             deflist.push(`        { "${fn.symbol}${fname}Sync", ${get_stub_func_prefix(ov, def)}${get_name(fname, ov, def)}, true, false }`);
@@ -838,6 +917,11 @@ function gen_code(cls, def, baseFolder) {
                 });
             });
 
+            if (fastlist.length) {
+                txts.push(fastlist.join("\n"));
+                txts.push('');
+            }
+
             if (deflist.length) {
                 method_count = deflist.length;
                 txts.push('    static ClassData::ClassMethod s_method[] = {');